@@ -141,6 +141,8 @@ void BackendCommandTarget::getAllCommands(Array<CommandID>& commands)
 		MenuToolsConvertAllSamplesToMonolith,
 		MenuToolsUpdateSampleMapIdsBasedOnFileName,
 		MenuToolsConvertSfzToSampleMaps,
+		MenuToolsDumpStreamingUnderruns,
+		MenuToolsShowStreamingReport,
 		MenuExportUnloadAllSampleMaps,
 		MenuExportUnloadAllAudioFiles,
 		MenuToolsRecordOneSecond,
@@ -493,6 +495,14 @@ void BackendCommandTarget::getCommandInfo(CommandID commandID, ApplicationComman
 		setCommandTarget(result, "Force duplicate search in pool when loading samples", true, bpe->getBackendProcessor()->getSampleManager().getModulatorSamplerSoundPool()->isPoolSearchForced(), 'X', false);
 		result.categoryName = "Tools";
 		break;
+	case MenuToolsDumpStreamingUnderruns:
+		setCommandTarget(result, "Dump streaming activity after buffer underruns", true, bpe->getBackendProcessor()->getSampleManager().getGlobalSampleThreadPool()->getTelemetry().getPostMortemDirectory() != File(), 'X', false);
+		result.categoryName = "Tools";
+		break;
+	case MenuToolsShowStreamingReport:
+		setCommandTarget(result, "Show streaming latency report", true, false, 'X', false);
+		result.categoryName = "Tools";
+		break;
 	case MenuToolsConvertAllSamplesToMonolith:
 		setCommandTarget(result, "Convert all samples to Monolith + Samplemap", true, false, 'X', false);
 		result.categoryName = "Tools";
@@ -670,6 +680,8 @@ bool BackendCommandTarget::perform(const InvocationInfo &info)
 	case MenuExportSetupWizard:			Actions::setupExportWizard(bpe); return true;
 	case MenuToolsShowDspNetworkDllInfo: Actions::showNetworkDllInfo(bpe); return true;
 	case MenuToolsForcePoolSearch:		Actions::toggleForcePoolSearch(bpe); updateCommands(); return true;
+	case MenuToolsDumpStreamingUnderruns: Actions::toggleStreamingUnderrunDump(bpe); updateCommands(); return true;
+	case MenuToolsShowStreamingReport:	Actions::showStreamingReport(bpe); return true;
 	case MenuToolsConvertSampleMapToWavetableBanks:	Actions::convertSampleMapToWavetableBanks(bpe); return true;
 	case MenuToolsConvertAllSamplesToMonolith:	Actions::convertAllSamplesToMonolith(bpe); return true;
 	case MenuToolsUpdateSampleMapIdsBasedOnFileName:	Actions::updateSampleMapIds(bpe); return true;
@@ -1008,6 +1020,8 @@ PopupMenu BackendCommandTarget::getMenuForIndex(int topLevelMenuIndex, const Str
 			ADD_MENU_ITEM(MenuToolsConvertAllSamplesToMonolith);
 			ADD_MENU_ITEM(MenuToolsUpdateSampleMapIdsBasedOnFileName);
 			ADD_MENU_ITEM(MenuToolsConvertSfzToSampleMaps);
+			ADD_MENU_ITEM(MenuToolsDumpStreamingUnderruns);
+			ADD_MENU_ITEM(MenuToolsShowStreamingReport);
 			
 			p.addSeparator();
 
@@ -2313,6 +2327,42 @@ void BackendCommandTarget::Actions::toggleForcePoolSearch(BackendRootWindow * bp
 	pool->setForcePoolSearch(!pool->isPoolSearchForced());
 }
 
+void BackendCommandTarget::Actions::toggleStreamingUnderrunDump(BackendRootWindow * bpe)
+{
+	auto& telemetry = bpe->getBackendProcessor()->getSampleManager().getGlobalSampleThreadPool()->getTelemetry();
+
+	if (telemetry.getPostMortemDirectory() != File())
+	{
+		telemetry.setPostMortemDirectory(File());
+		return;
+	}
+
+	auto dumpDirectory = GET_PROJECT_HANDLER(bpe->getMainSynthChain()).getWorkDirectory().getChildFile("StreamingDumps");
+
+	telemetry.setEnabled(true);
+	telemetry.setPostMortemDirectory(dumpDirectory);
+
+	debugToConsole(bpe->getMainSynthChain(), "Buffer underruns will be dumped to " + dumpDirectory.getFullPathName());
+}
+
+void BackendCommandTarget::Actions::showStreamingReport(BackendRootWindow * bpe)
+{
+	auto& telemetry = bpe->getBackendProcessor()->getSampleManager().getGlobalSampleThreadPool()->getTelemetry();
+
+	if (!telemetry.isEnabled())
+	{
+		telemetry.setEnabled(true);
+		PresetHandler::showMessageWindow("Streaming telemetry enabled", "The streaming activity wasn't recorded. Play some notes and open the report again.", PresetHandler::IconType::Info);
+		return;
+	}
+
+	String t;
+
+	t << "```\n" << telemetry.createHistogramReport() << "\n```";
+
+	PresetHandler::showMessageWindow("Streaming latency report", t, PresetHandler::IconType::Info);
+}
+
 
 
 void BackendCommandTarget::Actions::showMainMenu(BackendRootWindow * /*bpe*/)
@@ -198,6 +198,10 @@ public:
 		// License Management
 		MenuToolsCreateRSAKeys,
 		MenuToolsCreateDummyLicenseFile,
+		// ----------------------------------
+		// Streaming Tools (added to the Sample Management section)
+		MenuToolsDumpStreamingUnderruns,
+		MenuToolsShowStreamingReport,
 
 		// HELP Menu
 		MenuHelpShowDocumentation  = 0x70000,
@@ -348,6 +352,8 @@ public:
 		static void createRSAKeys(BackendRootWindow * bpe);
 		static void createDummyLicenseFile(BackendRootWindow * bpe);
 		static void toggleForcePoolSearch(BackendRootWindow * bpe);
+		static void toggleStreamingUnderrunDump(BackendRootWindow * bpe);
+		static void showStreamingReport(BackendRootWindow * bpe);
 		static void showMainMenu(BackendRootWindow * bpe);
 		static void moveModule(CopyPasteTarget *currentCopyPasteTarget, bool moveUp);
 		static void createExternalScriptFile(BackendRootWindow * bpe);
@@ -157,6 +157,11 @@ scriptUnlocker(this)
 
 	dllManager = new BackendDllManager(this);
 
+#if HISE_INCLUDE_SNEX && SNEX_MIR_BACKEND
+	if (!inUnitTestMode())
+		snex::mir::MirCodeCache::setCacheDirectory(ProjectHandler::getAppDataDirectory(this).getChildFile("SnexCodeCache"));
+#endif
+
 	if(getCurrentFileHandler().getRootFolder().isDirectory())
 		refreshExpansionType();
 
@@ -285,6 +285,36 @@ Enable this to add a glitch detector to some performance crititcal functions
 #define USE_GLITCH_DETECTION 0
 #endif
 
+/** Config: HISE_ENABLE_DSP_BENCHMARK
+
+Enable this to measure the rendering time of the modules, voices and scriptnode nodes while a DspBenchmark
+is running (the `benchmark` command line tool uses this). If no benchmark is running, the overhead is a single 
+atomic load per measured location.
+*/
+#ifndef HISE_ENABLE_DSP_BENCHMARK
+#define HISE_ENABLE_DSP_BENCHMARK USE_BACKEND
+#endif
+
+/** Config: HISE_NUM_AUDIO_RENDERING_THREADS
+
+The number of real-time worker threads that render the voices of a sound generator or the child 
+sound generators of a container in parallel. Only sound generators and containers that support this
+will use it. Set this to zero in order to render everything on the audio thread.
+*/
+#ifndef HISE_NUM_AUDIO_RENDERING_THREADS
+#define HISE_NUM_AUDIO_RENDERING_THREADS 0
+#endif
+
+/** Config: HISE_NUM_PRELOAD_THREADS
+
+The number of worker threads that help the sample loading thread to fill the preload buffers when a 
+samplemap is loaded. Samples in the same monolith file are preloaded by the same thread. Set this to 
+zero in order to preload everything on the sample loading thread.
+*/
+#ifndef HISE_NUM_PRELOAD_THREADS
+#define HISE_NUM_PRELOAD_THREADS 4
+#endif
+
 /** Config: ENABLE_PLOTTER
 
 Set this to 0 to deactivate the plotter data collection
@@ -0,0 +1,477 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+std::atomic<DspBenchmark*> DspBenchmark::currentBenchmark { nullptr };
+
+DspBenchmark::ScopedMeasurement::ScopedMeasurement(Processor* p, int location) noexcept:
+	ScopedMeasurement(p, Category::Processor, location)
+{}
+
+DspBenchmark::ScopedMeasurement::ScopedMeasurement(Processor* p, Category c, int index_) noexcept:
+	benchmark(getCurrent()),
+	processor(p),
+	category(c),
+	index(index_)
+{
+	if(benchmark != nullptr)
+	{
+		// Skip other plugin instances that are running at the same time
+		if(processor == nullptr || processor->getMainController() != benchmark->getMainController())
+			benchmark = nullptr;
+		else
+			start = Time::getMillisecondCounterHiRes();
+	}
+}
+
+DspBenchmark::ScopedMeasurement::~ScopedMeasurement()
+{
+	if(benchmark != nullptr)
+	{
+		auto delta = Time::getMillisecondCounterHiRes() - start;
+		auto p = processor;
+
+		benchmark->addMeasurement(category, processor, index, delta, [p](){ return p->getId(); });
+	}
+}
+
+DspBenchmark::DspBenchmark(MainController* mc, const Options& options_):
+	Thread("DSP Benchmark"),
+	ControlledObject(mc),
+	options(options_),
+	blocks("Blocks"),
+	slots(new Slot[MaxNumSlots])
+{
+	jassert(options.blockSize % HISE_EVENT_RASTER == 0);
+}
+
+DspBenchmark::~DspBenchmark()
+{
+	stopThread(5000);
+}
+
+Result DspBenchmark::loadMidiFile(const File& midiFile)
+{
+	FileInputStream fis(midiFile);
+
+	if(!fis.openedOk())
+		return Result::fail("Can't open " + midiFile.getFullPathName());
+
+	MidiFile mf;
+
+	if(!mf.readFrom(fis))
+		return Result::fail(midiFile.getFileName() + " is not a valid MIDI file");
+
+	mf.convertTimestampTicksToSeconds();
+
+	sequence.clear();
+
+	int lastSample = 0;
+
+	for(int i = 0; i < mf.getNumTracks(); i++)
+	{
+		for(auto e: *mf.getTrack(i))
+		{
+			const auto& m = e->message;
+
+			if(m.isMetaEvent())
+				continue;
+
+			auto samplePos = roundToInt(m.getTimeStamp() * options.sampleRate);
+
+			// align the events so that the result does not depend on the raster logic
+			samplePos -= samplePos % HISE_EVENT_RASTER;
+
+			sequence.addEvent(m, samplePos);
+			lastSample = jmax(lastSample, samplePos);
+		}
+	}
+
+	if(sequence.isEmpty())
+		return Result::fail(midiFile.getFileName() + " doesn't contain any MIDI events");
+
+	numSamplesToRender = lastSample + roundToInt(options.tailSeconds * options.sampleRate);
+
+	if(auto leftOver = numSamplesToRender % options.blockSize)
+		numSamplesToRender += options.blockSize - leftOver;
+
+	return Result::ok();
+}
+
+var DspBenchmark::renderAndWait()
+{
+	// There's no audio device when running from the command line, so we need to
+	// prepare the processing chain like a host would do it.
+	auto ap = dynamic_cast<AudioProcessor*>(getMainController());
+	ap->setRateAndBufferSizeDetails(options.sampleRate, options.blockSize);
+	ap->prepareToPlay(options.sampleRate, options.blockSize);
+
+	result = var();
+
+	startThread(8);
+	waitForThreadToExit(-1);
+
+	return result;
+}
+
+void DspBenchmark::run()
+{
+	if(!render())
+		return;
+
+	auto audioMilliSeconds = 1000.0 * (double)numSamplesToRender / options.sampleRate;
+
+	DynamicObject::Ptr obj = new DynamicObject();
+
+	obj->setProperty("SampleRate", options.sampleRate);
+	obj->setProperty("BlockSize", options.blockSize);
+	obj->setProperty("NumBlocks", (int)blocks.timings.size());
+	obj->setProperty("AudioDuration", audioMilliSeconds);
+	obj->setProperty("RenderDuration", totalRenderTime);
+	obj->setProperty("RealtimeFactor", totalRenderTime > 0.0 ? audioMilliSeconds / totalRenderTime : 0.0);
+	obj->setProperty("Blocks", blocks.toJSON(audioMilliSeconds));
+
+	if(auto numDropped = numDroppedRecords.load())
+		obj->setProperty("NumDroppedMeasurements", numDropped);
+
+	std::map<int, Item> items;
+
+	for(int i = 0; i < MaxNumSlots; i++)
+	{
+		if(slots[i].used)
+			items.emplace(i, Item(slots[i].name));
+	}
+
+	for(const auto& r: records)
+	{
+		if(r.slotIndex != -1)
+			items.at(r.slotIndex).timings.push_back(r.milliSeconds);
+	}
+
+	Array<var> lists[(int)Category::numCategories];
+
+	for(const auto& m: items)
+	{
+		const auto& key = slots[m.first].key;
+
+		if(m.second.timings.empty())
+			continue;
+
+		auto v = m.second.toJSON(audioMilliSeconds);
+		auto item = v.getDynamicObject();
+
+		switch(key.category)
+		{
+		case Category::Processor:
+			item->setProperty("Location", DebugLogger::getNameForLocation((DebugLogger::Location)key.index));
+			break;
+		case Category::Voice:
+			item->setProperty("Voice", key.index);
+			break;
+		default:
+			break;
+		}
+
+		lists[(int)key.category].add(v);
+	}
+
+	struct Sorter
+	{
+		static int compareElements(const var& v1, const var& v2)
+		{
+			auto t1 = (double)v1["Total"];
+			auto t2 = (double)v2["Total"];
+
+			if(t1 > t2)
+				return -1;
+			if(t1 < t2)
+				return 1;
+
+			return 0;
+		}
+	} sorter;
+
+	for(auto& l: lists)
+		l.sort(sorter, true);
+
+	obj->setProperty("Processors", var(lists[(int)Category::Processor]));
+	obj->setProperty("Voices", var(lists[(int)Category::Voice]));
+	obj->setProperty("Nodes", var(lists[(int)Category::Node]));
+
+	result = var(obj.get());
+}
+
+bool DspBenchmark::render()
+{
+	auto mc = getMainController();
+	auto ap = dynamic_cast<AudioProcessor*>(mc);
+
+	SuspendHelpers::ScopedTicket st(mc);
+
+	while (mc->getKillStateHandler().isAudioRunning())
+	{
+		if (threadShouldExit())
+			return false;
+
+		Thread::wait(100);
+	}
+
+	mc->getKillStateHandler().setCurrentExportThread(getCurrentThreadId());
+
+	ap->setNonRealtime(true);
+	mc->getSampleManager().handleNonRealtimeState();
+
+	auto ok = true;
+
+	{
+		LockHelpers::SafeLock sl(mc, LockHelpers::Type::AudioLock);
+
+		auto numChannels = mc->getMainSynthChain()->getMatrix().getNumSourceChannels();
+
+		AudioSampleBuffer buffer(numChannels, options.blockSize);
+		MidiBuffer mb;
+
+		jassert(getCurrent() == nullptr);
+
+		// the warmup registers the measured items without recording them so that
+		// the measurements don't have to allocate anything
+		currentBenchmark.store(this);
+
+		for(int i = 0; i < options.numWarmupBlocks; i++)
+		{
+			buffer.clear();
+			mb.clear();
+			mc->processBlockCommon(buffer, mb);
+		}
+
+		blocks.timings.reserve(numSamplesToRender / options.blockSize);
+		allocateRecords();
+		measuring.store(true);
+
+		for(int pos = 0; pos < numSamplesToRender; pos += options.blockSize)
+		{
+			if(threadShouldExit())
+			{
+				ok = false;
+				break;
+			}
+
+			buffer.clear();
+			mb.clear();
+			mb.addEvents(sequence, pos, options.blockSize, -pos);
+
+			auto start = Time::getMillisecondCounterHiRes();
+
+			mc->processBlockCommon(buffer, mb);
+
+			auto delta = Time::getMillisecondCounterHiRes() - start;
+
+			blocks.timings.push_back(delta);
+			totalRenderTime += delta;
+		}
+
+		measuring.store(false);
+		currentBenchmark.store(nullptr);
+	}
+
+	mc->getKillStateHandler().setCurrentExportThread(nullptr);
+	ap->setNonRealtime(false);
+	mc->getSampleManager().handleNonRealtimeState();
+
+	return ok;
+}
+
+uint32 DspBenchmark::Key::getHash() const noexcept
+{
+	auto h = (uint64)reinterpret_cast<pointer_sized_uint>(object);
+
+	h = h * 31 + (uint64)index;
+	h = h * 31 + (uint64)category;
+
+	h ^= h >> 33;
+	h *= 0xff51afd7ed558ccdULL;
+	h ^= h >> 33;
+
+	return (uint32)h;
+}
+
+int DspBenchmark::findSlot(const Key& k) const noexcept
+{
+	auto start = (int)(k.getHash() % (uint32)MaxNumSlots);
+
+	for(int i = 0; i < MaxNumSlots; i++)
+	{
+		auto index = (start + i) % MaxNumSlots;
+		const auto& s = slots[index];
+
+		// the slots are never removed so the first empty one ends the search
+		if(!s.used.load(std::memory_order_acquire))
+			return -1;
+
+		if(s.key == k)
+			return index;
+	}
+
+	return -1;
+}
+
+int DspBenchmark::addSlot(const Key& k, const String& name)
+{
+	SpinLock::ScopedLockType sl(measurementLock);
+
+	auto start = (int)(k.getHash() % (uint32)MaxNumSlots);
+
+	for(int i = 0; i < MaxNumSlots; i++)
+	{
+		auto index = (start + i) % MaxNumSlots;
+		auto& s = slots[index];
+
+		if(!s.used.load(std::memory_order_relaxed))
+		{
+			s.key = k;
+			s.name = name;
+			s.used.store(true, std::memory_order_release);
+			numSlots++;
+			return index;
+		}
+
+		// another thread has added it in the meantime
+		if(s.key == k)
+			return index;
+	}
+
+	numDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+	return -1;
+}
+
+DspBenchmark::ThreadBuffer* DspBenchmark::getThreadBuffer() noexcept
+{
+	auto id = Thread::getCurrentThreadId();
+
+	for(auto& b: threadBuffers)
+	{
+		if(b.threadId.load(std::memory_order_relaxed) == id)
+			return &b;
+	}
+
+	for(auto& b: threadBuffers)
+	{
+		void* expected = nullptr;
+
+		if(b.threadId.compare_exchange_strong(expected, id))
+			return &b;
+	}
+
+	return nullptr;
+}
+
+void DspBenchmark::addRecord(int slotIndex, double milliSeconds) noexcept
+{
+	if(auto b = getThreadBuffer())
+	{
+		if(b->chunk == nullptr || b->numUsed == ChunkSize)
+		{
+			auto start = nextChunk.fetch_add(ChunkSize, std::memory_order_relaxed);
+
+			if(start + ChunkSize > records.size())
+			{
+				b->chunk = nullptr;
+				numDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+				return;
+			}
+
+			b->chunk = records.data() + start;
+			b->numUsed = 0;
+		}
+
+		b->chunk[b->numUsed++] = { slotIndex, milliSeconds };
+	}
+	else
+		numDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+}
+
+void DspBenchmark::allocateRecords()
+{
+	int numRegistered;
+
+	{
+		SpinLock::ScopedLockType sl(measurementLock);
+		numRegistered = numSlots;
+	}
+
+	auto numBlocks = (size_t)(numSamplesToRender / options.blockSize);
+	auto numRecords = numBlocks * (size_t)(numRegistered + NumExtraRecordsPerBlock) + (size_t)(MaxNumThreads * ChunkSize);
+
+	// the unused records of a chunk keep the slot index -1 and are skipped
+	records.assign(numRecords, Record());
+	nextChunk.store(0);
+}
+
+var DspBenchmark::Item::toJSON(double audioMilliSeconds) const
+{
+	DynamicObject::Ptr obj = new DynamicObject();
+
+	obj->setProperty("ID", name);
+
+	auto sorted = timings;
+	std::sort(sorted.begin(), sorted.end());
+
+	auto numTimings = (int)sorted.size();
+
+	double total = 0.0;
+
+	for(auto t: sorted)
+		total += t;
+
+	auto getPercentile = [&](double p)
+	{
+		if(numTimings == 0)
+			return 0.0;
+
+		auto index = (int)std::ceil(p * (double)numTimings) - 1;
+		return sorted[jlimit(0, numTimings - 1, index)];
+	};
+
+	obj->setProperty("Count", numTimings);
+	obj->setProperty("Total", total);
+	obj->setProperty("Mean", numTimings > 0 ? total / (double)numTimings : 0.0);
+	obj->setProperty("P50", getPercentile(0.5));
+	obj->setProperty("P90", getPercentile(0.9));
+	obj->setProperty("P99", getPercentile(0.99));
+	obj->setProperty("Max", numTimings > 0 ? sorted.back() : 0.0);
+	obj->setProperty("Percent", audioMilliSeconds > 0.0 ? 100.0 * total / audioMilliSeconds : 0.0);
+
+	return var(obj.get());
+}
+
+} // namespace hise
@@ -0,0 +1,239 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef DSPBENCHMARK_H_INCLUDED
+#define DSPBENCHMARK_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+class Processor;
+
+/** A headless benchmark that renders a MIDI file through MainController::processBlockCommon()
+*
+*	The MIDI file is rendered with a fixed block size and sample rate as fast as possible (in non-realtime
+*	mode so that the streaming engine loads the samples synchronously). While the benchmark is running,
+*	every location that is marked with ADD_GLITCH_DETECTOR() will report its timing along with the voice
+*	rendering of each sound generator and the scriptnode nodes.
+*
+*	The result is a JSON object with the timing percentiles of every measured item:
+*
+*		{
+*		  "SampleRate": 44100.0, "BlockSize": 512, "NumBlocks": 1200, ...
+*		  "Blocks": { "Count": 1200, "Total": 812.3, "Mean": 0.67, "P50": 0.6, "P90": 0.9, "P99": 1.4, "Max": 2.1, "Percent": 5.8 },
+*		  "Processors": [ { "ID": "Sampler1", "Location": "SynthRendering", ... } ],
+*		  "Voices": [ { "ID": "Sampler1", "Voice": 0, ... } ],
+*		  "Nodes": [ { "ID": "dsp.svf", ... } ]
+*		}
+*
+*	All times are in milliseconds and "Percent" is the total time relative to the duration of the rendered audio.
+*/
+class DspBenchmark: public Thread,
+					public ControlledObject
+{
+public:
+
+	enum class Category
+	{
+		Processor,
+		Voice,
+		Node,
+		numCategories
+	};
+
+	struct Options
+	{
+		double sampleRate = 44100.0;
+		int blockSize = 512;
+
+		/** The amount of silent blocks that are rendered before the measurement starts. */
+		int numWarmupBlocks = 16;
+
+		/** The time in seconds that is rendered after the last MIDI event. */
+		double tailSeconds = 2.0;
+	};
+
+	/** Measures the lifetime of this object and adds it to the current benchmark (if there is one).
+	*
+	*	Use ADD_GLITCH_DETECTOR() or ADD_DSP_BENCHMARK() instead of creating this directly.
+	*/
+	struct ScopedMeasurement
+	{
+		ScopedMeasurement(Processor* p, int location) noexcept;
+		ScopedMeasurement(Processor* p, Category c, int index) noexcept;
+
+		~ScopedMeasurement();
+
+	private:
+
+		DspBenchmark* benchmark;
+		Processor* processor;
+		Category category;
+		int index;
+		double start = 0.0;
+
+		JUCE_DECLARE_NON_COPYABLE(ScopedMeasurement);
+	};
+
+	DspBenchmark(MainController* mc, const Options& options);
+	~DspBenchmark() override;
+
+	/** Loads the MIDI file and converts the events to sample positions. */
+	Result loadMidiFile(const File& midiFile);
+
+	/** Renders the MIDI sequence on the benchmark thread and blocks until it is finished. */
+	var renderAndWait();
+
+	/** Returns the benchmark that is currently rendering or nullptr. */
+	static DspBenchmark* getCurrent() noexcept { return currentBenchmark.load(std::memory_order_relaxed); }
+
+	/** Adds a measurement. The name function will only be called when the item is measured for the first time.
+	*
+	*	The items are registered during the warmup blocks. After that, this is lock-free and doesn't allocate
+	*	(unless an item shows up for the first time, eg. a voice that starts with the first note).
+	*/
+	template <typename NameFunction> void addMeasurement(Category c, const void* object, int index, double milliSeconds, const NameFunction& createName)
+	{
+		Key k = { c, object, index };
+
+		auto slotIndex = findSlot(k);
+
+		if(slotIndex == -1)
+			slotIndex = addSlot(k, createName());
+
+		if(slotIndex != -1 && measuring.load(std::memory_order_relaxed))
+			addRecord(slotIndex, milliSeconds);
+	}
+
+private:
+
+	struct Key
+	{
+		bool operator==(const Key& other) const
+		{
+			return category == other.category && object == other.object && index == other.index;
+		}
+
+		uint32 getHash() const noexcept;
+
+		Category category;
+		const void* object;
+		int index;
+	};
+
+	struct Item
+	{
+		Item(const String& name_): name(name_) {};
+
+		var toJSON(double audioMilliSeconds) const;
+
+		String name;
+		std::vector<double> timings;
+	};
+
+	/** An entry of the open addressing table that is filled during the warmup. */
+	struct Slot
+	{
+		std::atomic<bool> used { false };
+		Key key;
+		String name;
+	};
+
+	struct Record
+	{
+		int slotIndex = -1;
+		double milliSeconds = 0.0;
+	};
+
+	/** The chunk of records that a thread is writing into. The chunks are taken from a pool that is
+	*	preallocated after the warmup so that the threads don't have to share a write position.
+	*/
+	struct ThreadBuffer
+	{
+		std::atomic<void*> threadId { nullptr };
+		Record* chunk = nullptr;
+		int numUsed = 0;
+	};
+
+	static constexpr int MaxNumSlots = 4096;
+	static constexpr int MaxNumThreads = 16;
+	static constexpr int ChunkSize = 256;
+
+	/** The amount of records per block that are reserved on top of the items that were registered during the warmup. */
+	static constexpr int NumExtraRecordsPerBlock = 64;
+
+	int findSlot(const Key& k) const noexcept;
+	int addSlot(const Key& k, const String& name);
+	void addRecord(int slotIndex, double milliSeconds) noexcept;
+	ThreadBuffer* getThreadBuffer() noexcept;
+
+	void allocateRecords();
+
+	void run() override;
+
+	bool render();
+
+	static std::atomic<DspBenchmark*> currentBenchmark;
+
+	const Options options;
+
+	MidiBuffer sequence;
+	int numSamplesToRender = 0;
+
+	Item blocks;
+	double totalRenderTime = 0.0;
+
+	SpinLock measurementLock;
+	std::unique_ptr<Slot[]> slots;
+	int numSlots = 0;
+
+	ThreadBuffer threadBuffers[MaxNumThreads];
+	std::vector<Record> records;
+	std::atomic<size_t> nextChunk { 0 };
+	std::atomic<bool> measuring { false };
+	std::atomic<int> numDroppedRecords { 0 };
+
+	var result;
+
+	JUCE_DECLARE_NON_COPYABLE(DspBenchmark);
+};
+
+#if HISE_ENABLE_DSP_BENCHMARK
+#define ADD_DSP_BENCHMARK(processor, location) DspBenchmark::ScopedMeasurement sdbm(processor, (int)location)
+#define ADD_DSP_BENCHMARK_VOICE(processor, voiceIndex) DspBenchmark::ScopedMeasurement sdbmv(processor, DspBenchmark::Category::Voice, voiceIndex)
+#else
+#define ADD_DSP_BENCHMARK(processor, location)
+#define ADD_DSP_BENCHMARK_VOICE(processor, voiceIndex)
+#endif
+
+} // namespace hise
+
+#endif  // DSPBENCHMARK_H_INCLUDED
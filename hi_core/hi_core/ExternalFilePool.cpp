@@ -168,9 +168,19 @@ void PoolHelpers::loadData(AudioFormatManager& /*afm*/, InputStream* ownedStream
 
 	if (auto fis = dynamic_cast<FileInputStream*>(inputStream.get()))
 	{
-		if (auto xml = XmlDocument::parse(fis->getFile()))
+		// Prefer the binary samplemap if it's newer than the XML file (this skips the XML parsing)
+		BinarySampleMap bm(BinarySampleMap::getUpToDateBinaryFile(fis->getFile()));
+
+		if (bm.isValid())
+		{
+			data = bm.createValueTree();
+		}
+		else
 		{
-			data = ValueTree::fromXml(*xml);
+			if (auto xml = XmlDocument::parse(fis->getFile()))
+			{
+				data = ValueTree::fromXml(*xml);
+			}
 		}
 	}
 	else
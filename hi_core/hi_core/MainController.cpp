@@ -161,6 +161,10 @@ bool MainController::unitTestMode = false;
 
 	javascriptThreadPool->startThread(8);
 	getKillStateHandler().setScriptingThreadId(javascriptThreadPool->getThreadId());
+
+#if HISE_NUM_AUDIO_RENDERING_THREADS > 0
+	audioRenderingThreadPool = new AudioRenderingThreadPool(this, HISE_NUM_AUDIO_RENDERING_THREADS);
+#endif
 };
 
 
@@ -182,9 +186,23 @@ MainController::~MainController()
 
 	sampleManager = nullptr;
 	javascriptThreadPool = nullptr;
-}
-
-
+	audioRenderingThreadPool = nullptr;
+}
+
+
+void MainController::setNumAudioRenderingThreads(int numThreads)
+{
+	ScopedPointer<AudioRenderingThreadPool> newPool;
+
+	if (numThreads > 0)
+		newPool = new AudioRenderingThreadPool(this, numThreads);
+
+	{
+		LockHelpers::SafeLock sl(this, LockHelpers::Type::AudioLock);
+		audioRenderingThreadPool.swapWith(newPool);
+	}
+}
+
 void MainController::notifyShutdownToRegisteredObjects()
 {
 	for (auto obj : registeredObjects)
@@ -36,6 +36,7 @@
 namespace hise { using namespace juce;
 
 class ProjectDocDatabaseHolder;
+class AudioRenderingThreadPool;
 
 /** The grand central station of HISE.
 *	@ingroup core
@@ -190,6 +191,9 @@ public:
 		/** returns a pointer to the thread pool that streams the samples from disk. */
 		SampleThreadPool *getGlobalSampleThreadPool() { return samplerLoaderThreadPool; }
 
+		/** returns the object that calculates the preload sizes in the adaptive preload mode. */
+		AdaptivePreloadSizer& getAdaptivePreloadSizer() { return *adaptivePreloadSizer; }
+
 		/** returns a pointer to the global sample pool */
 		ModulatorSamplerSoundPool *getModulatorSamplerSoundPool2() const;
 
@@ -231,6 +235,22 @@ public:
 		/** Preload everything since the last call to setShouldSkipPreloading. */
 		void preloadEverything();
 
+		/** Sets the number of worker threads that help the sample loading thread with preloading. */
+		void setNumPreloadThreads(int numThreads);
+
+		int getNumPreloadThreads() const { return numPreloadThreads; }
+
+		/** Calls the function for every index on the calling thread and the preload worker threads.
+		
+			It returns when all calls are finished. If a call returns false or the sample loading
+			thread should exit, the remaining jobs will be skipped and this method returns false.
+			In HDD mode, all jobs will be executed on the calling thread to avoid random access.
+
+			The progress function will only be called on the calling thread (between its own jobs
+			and while it waits for the workers), so it can safely update the preload progress.
+		*/
+		bool runPreloadJobs(int numJobs, const std::function<bool(int)>& preloadFunction, const std::function<void()>& progressFunction = {});
+
 		void clearPreloadFlag();
 		void setPreloadFlag();
 
@@ -357,6 +377,12 @@ public:
 		ValueTree sampleMaps;
 
 		ScopedPointer<SampleThreadPool> samplerLoaderThreadPool;
+		ScopedPointer<AdaptivePreloadSizer> adaptivePreloadSizer;
+
+		CriticalSection preloadThreadLock;
+		int numPreloadThreads = HISE_NUM_PRELOAD_THREADS;
+		ScopedPointer<ThreadPool> preloadThreadPool;
+		WaitableEvent preloadWorkersFinished;
 
 		bool hddMode = false;
 		bool skipPreloading = false;
@@ -1497,6 +1523,15 @@ public:
 	JavascriptThreadPool& getJavascriptThreadPool() noexcept { return *javascriptThreadPool.get(); }
 	const JavascriptThreadPool& getJavascriptThreadPool() const noexcept { return *javascriptThreadPool.get(); }
 
+	/** Returns the thread pool for parallel audio rendering or nullptr if HISE_NUM_AUDIO_RENDERING_THREADS is zero. */
+	AudioRenderingThreadPool* getAudioRenderingThreadPool() noexcept { return audioRenderingThreadPool.get(); }
+
+	/** Replaces the thread pool for parallel audio rendering (or removes it if numThreads is zero).
+	*
+	*	The sound generators pick this up in their next prepareToPlay() call, so make sure to call it after this.
+	*/
+	void setNumAudioRenderingThreads(int numThreads);
+
 	PooledUIUpdater* getGlobalUIUpdater() { return &globalUIUpdater; }
 	const PooledUIUpdater* getGlobalUIUpdater() const { return &globalUIUpdater; }
 
@@ -1993,6 +2028,7 @@ private: // Never call this directly, but wrap it through DelayedRenderer...
 	// except for the audio rendererbase as this does not need to use the outer interface
 	// (in order to avoid messing with the leftover sample logic from misbehFL!avinStudio!!1!g hosts...)
 	friend class AudioRendererBase;
+	friend class DspBenchmark;
 
 	/** This is the main processing loop that is shared among all subclasses. */
 	void processBlockCommon(AudioSampleBuffer &b, MidiBuffer &mb);
@@ -2138,6 +2174,8 @@ private:
 
 	ScopedPointer<JavascriptThreadPool> javascriptThreadPool;
 
+	ScopedPointer<AudioRenderingThreadPool> audioRenderingThreadPool;
+
 	friend class UserPresetHandler;
     friend class PresetLoadingThread;
 	friend class DelayedRenderer;
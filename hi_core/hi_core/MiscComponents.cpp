@@ -559,6 +559,9 @@ void MouseCallbackComponent::sendToListeners(var clickInformation)
 bool DrawActions::PostActionBase::needsStackData() const
 { return false; }
 
+bool DrawActions::PostActionBase::addToContentHash(ContentHash& h) const
+{ return false; }
+
 DrawActions::ActionBase::ActionBase()
 {}
 
@@ -577,6 +580,164 @@ void DrawActions::ActionBase::setCachedImage(Image& actionImage_, Image& mainIma
 void DrawActions::ActionBase::setScaleFactor(float sf)
 { scaleFactor = sf; }
 
+bool DrawActions::ActionBase::addToContentHash(ContentHash& h) const
+{ return false; }
+
+Rectangle<float> DrawActions::ActionBase::getDrawBounds() const
+{ return {}; }
+
+bool DrawActions::ActionBase::transformsCoordinates() const
+{ return false; }
+
+void DrawActions::ContentHash::addBytes(const void* data, size_t numBytes) noexcept
+{
+	auto ptr = static_cast<const uint8*>(data);
+
+	for (size_t i = 0; i < numBytes; i++)
+	{
+		value ^= ptr[i];
+		value *= 1099511628211ull;
+	}
+}
+
+DrawActions::PrimitiveList::Command::Command(Type t, Rectangle<float> area, float thickness):
+	type(t)
+{
+	data[0] = area.getX();
+	data[1] = area.getY();
+	data[2] = area.getWidth();
+	data[3] = area.getHeight();
+	data[4] = thickness;
+}
+
+DrawActions::PrimitiveList::Command::Command(Type t, float v1, float v2, float v3, float v4, float v5):
+	type(t)
+{
+	data[0] = v1;
+	data[1] = v2;
+	data[2] = v3;
+	data[3] = v4;
+	data[4] = v5;
+}
+
+DrawActions::PrimitiveList::Command::Command(Type t, Colour c):
+	type(t),
+	colour(c.getARGB())
+{}
+
+bool DrawActions::PrimitiveList::Command::operator==(const Command& other) const noexcept
+{
+	if (type != other.type || colour != other.colour)
+		return false;
+
+	for (int i = 0; i < 5; i++)
+	{
+		if (data[i] != other.data[i])
+			return false;
+	}
+
+	return true;
+}
+
+bool DrawActions::PrimitiveList::Command::changesState() const noexcept
+{
+	return type == Type::SetColour || type == Type::SetOpacity;
+}
+
+Rectangle<float> DrawActions::PrimitiveList::Command::getBounds() const noexcept
+{
+	Rectangle<float> area(data[0], data[1], data[2], data[3]);
+
+	switch (type)
+	{
+	case Type::FillRect:
+	case Type::DrawRect:
+	case Type::FillEllipse:		   return area;
+	case Type::DrawEllipse:		   return area.expanded(data[4] * 0.5f);
+	case Type::DrawLine:		   return Rectangle<float>({ data[0], data[1] }, { data[2], data[3] }).expanded(data[4] * 0.5f);
+	case Type::DrawHorizontalLine: return Rectangle<float>::leftTopRightBottom(data[1], data[0], data[2], data[0] + 1.0f);
+	case Type::DrawVerticalLine:   return Rectangle<float>::leftTopRightBottom(data[0], data[1], data[0] + 1.0f, data[2]);
+	default:					   return {};
+	}
+}
+
+void DrawActions::PrimitiveList::Command::perform(Graphics& g) const
+{
+	Rectangle<float> area(data[0], data[1], data[2], data[3]);
+
+	switch (type)
+	{
+	case Type::FillAll:			   g.fillAll(Colour(colour)); break;
+	case Type::SetColour:		   g.setColour(Colour(colour)); break;
+	case Type::SetOpacity:		   g.setOpacity(data[0]); break;
+	case Type::FillRect:		   g.fillRect(area); break;
+	case Type::DrawRect:		   g.drawRect(area, data[4]); break;
+	case Type::FillEllipse:		   g.fillEllipse(area); break;
+	case Type::DrawEllipse:		   g.drawEllipse(area, data[4]); break;
+	case Type::DrawLine:		   g.drawLine(data[0], data[1], data[2], data[3], data[4]); break;
+	case Type::DrawHorizontalLine: g.drawHorizontalLine((int)data[0], data[1], data[2]); break;
+	case Type::DrawVerticalLine:   g.drawVerticalLine((int)data[0], data[1], data[2]); break;
+	default:					   jassertfalse; break;
+	}
+}
+
+void DrawActions::PrimitiveList::perform(Graphics& g)
+{
+	for (const auto& c : commands)
+		c.perform(g);
+}
+
+bool DrawActions::PrimitiveList::addToContentHash(ContentHash& h) const
+{
+	h.add(commands.size());
+
+	for (const auto& c : commands)
+	{
+		h.add(c.type);
+		h.add(c.colour);
+		h.add(c.data);
+	}
+
+	return true;
+}
+
+Rectangle<float> DrawActions::PrimitiveList::getDrawBounds() const
+{
+	Rectangle<float> area;
+
+	for (const auto& c : commands)
+	{
+		if (c.changesState() || c.type == Type::FillAll)
+			return {};
+
+		area = area.getUnion(c.getBounds());
+	}
+
+	return area;
+}
+
+bool DrawActions::PrimitiveList::addChangedArea(const PrimitiveList& other, Rectangle<float>& area) const
+{
+	if (commands.size() != other.commands.size())
+		return false;
+
+	for (int i = 0; i < commands.size(); i++)
+	{
+		const auto& c = commands.getReference(i);
+		const auto& o = other.commands.getReference(i);
+
+		if (c == o)
+			continue;
+
+		if (c.changesState() || o.changesState() || c.type == Type::FillAll || o.type == Type::FillAll)
+			return false;
+
+		area = area.getUnion(c.getBounds()).getUnion(o.getBounds());
+	}
+
+	return true;
+}
+
 DrawActions::MarkdownAction::MarkdownAction(const MarkdownLayout::StringWidthFunction& f):
 	renderer("", f)
 {}
@@ -632,23 +793,47 @@ void DrawActions::ActionLayer::perform(Graphics& g)
 		action->perform(g);
 			
 	if (postActions.size() > 0)
-	{
-		PostGraphicsRenderer r(stack, actionImage, scaleFactor);
-		int numDataRequired = 0;
+		applyPostActions(stack, actionImage, scaleFactor);
+}
 
-		for (auto p : postActions)
+void DrawActions::ActionLayer::renderWithState(Graphics& g, const RenderState& state) const
+{
+	for (auto action : internalActions)
+	{
+		if (auto l = dynamic_cast<ActionLayer*>(action))
+			l->renderWithState(g, { state.actionImage, state.actionImage, state.scaleFactor });
+		else
 		{
-			if (p->needsStackData())
-				numDataRequired++;
+			jassert(!action->wantsCachedImage());
+			action->perform(g);
 		}
-				
-		r.reserveStackOperations(numDataRequired);
+	}
 
-		for (auto p : postActions)
-			p->perform(r);
+	if (postActions.size() > 0)
+	{
+		PostGraphicsRenderer::DataStack localStack;
+		auto img = state.actionImage;
+		applyPostActions(localStack, img, state.scaleFactor);
 	}
 }
 
+void DrawActions::ActionLayer::applyPostActions(PostGraphicsRenderer::DataStack& dataStack, Image& img, float sf) const
+{
+	PostGraphicsRenderer r(dataStack, img, sf);
+	int numDataRequired = 0;
+
+	for (auto p : postActions)
+	{
+		if (p->needsStackData())
+			numDataRequired++;
+	}
+			
+	r.reserveStackOperations(numDataRequired);
+
+	for (auto p : postActions)
+		p->perform(r);
+}
+
 void DrawActions::ActionLayer::addDrawAction(ActionBase* a)
 {
 	internalActions.add(a);
@@ -659,6 +844,41 @@ void DrawActions::ActionLayer::addPostAction(PostActionBase* a)
 	postActions.add(a);
 }
 
+bool DrawActions::ActionLayer::addToContentHash(ContentHash& h) const
+{
+	h.add(drawOnParent);
+	h.add(internalActions.size());
+
+	for (auto a : internalActions)
+	{
+		h.add(a->getDispatchId().hash());
+
+		if (!a->addToContentHash(h))
+			return false;
+	}
+
+	h.add(postActions.size());
+
+	for (auto p : postActions)
+	{
+		if (!p->addToContentHash(h))
+			return false;
+	}
+
+	return true;
+}
+
+bool DrawActions::ActionLayer::transformsCoordinates() const
+{
+	for (auto a : internalActions)
+	{
+		if (a->transformsCoordinates())
+			return true;
+	}
+
+	return false;
+}
+
 DrawActions::BlendingLayer::BlendingLayer(gin::BlendMode m, float alpha_):
 	ActionLayer(true),
 	blendMode(m),
@@ -670,6 +890,13 @@ DrawActions::BlendingLayer::BlendingLayer(gin::BlendMode m, float alpha_):
 bool DrawActions::BlendingLayer::wantsCachedImage() const
 { return true; }
 
+bool DrawActions::BlendingLayer::addToContentHash(ContentHash& h) const
+{
+	h.add(alpha);
+	h.add(blendMode);
+	return ActionLayer::addToContentHash(h);
+}
+
 void DrawActions::NoiseMapManager::drawNoiseMap(Graphics& g, Rectangle<int> area, float alpha, bool monochrom,
 	float scale)
 {
@@ -762,12 +989,15 @@ DrawActions::Handler::Listener::~Listener()
 
 DrawActions::Handler::~Handler()
 {
+	// the job checks shouldExit() after each layer so this will not block for long
+	rasteriser->removeJob(&rasteriseJob, true, -1);
 	cancelPendingUpdate();
 }
 
 void DrawActions::Handler::beginDrawing()
 {
 	currentActions.clear();
+	currentPrimitiveList = nullptr;
 }
 
 void DrawActions::Handler::beginLayer(bool drawOnParent)
@@ -786,32 +1016,411 @@ DrawActions::ActionLayer::Ptr DrawActions::Handler::getCurrentLayer()
 void DrawActions::Handler::endLayer()
 {
 	layerStack.removeLast();
+	currentPrimitiveList = nullptr;
 }
 
 void DrawActions::Handler::addDrawAction(ActionBase* newDrawAction)
 {
+	currentPrimitiveList = nullptr;
+
 	if (layerStack.getLast() != nullptr)
 		layerStack.getLast()->addDrawAction(newDrawAction);
 	else
 		currentActions.add(newDrawAction);
 }
 
+void DrawActions::Handler::addPrimitive(const PrimitiveList::Command& c)
+{
+	if (currentPrimitiveList == nullptr)
+	{
+		if (layerStack.getLast() != nullptr)
+		{
+			// the layer owns its actions, so we can't use a recycled list here
+			currentPrimitiveList = new PrimitiveList();
+			layerStack.getLast()->addDrawAction(currentPrimitiveList);
+		}
+		else
+		{
+			currentPrimitiveList = createPrimitiveList().get();
+			currentActions.add(currentPrimitiveList);
+		}
+	}
+
+	currentPrimitiveList->commands.add(c);
+}
+
 void DrawActions::Handler::flush(uint64_t perfettoTrackId)
 {
+	currentPrimitiveList = nullptr;
+
+	// nextActions is only written on this thread, so we can compare it without the lock
+	uint64 newHash = 0;
+	auto hashValid = !currentActions.isEmpty() && createContentHash(currentActions, newHash);
+
+	if (hashValid && nextActionsHashValid && newHash == nextActionsHash)
+	{
+		recyclePrimitiveLists(currentActions);
+		currentActions.clear();
+		layerStack.clear();
+		return;
+	}
+
+	Rectangle<float> changedArea;
+	auto partialRepaint = hashValid && nextActionsHashValid && addChangedArea(nextActions, currentActions, changedArea);
+
 	{
 		SpinLock::ScopedLockType sl(lock);
 
+		if (partialRepaint && !changedArea.isEmpty())
+			pendingDirtyArea = pendingDirtyArea.getUnion(changedArea.getSmallestIntegerContainer().expanded(1));
+		else
+			fullRepaintPending = true;
+
 		nextActions.swapWith(currentActions);
-		currentActions.clear();
-		layerStack.clear();
 	}
 
+	nextActionsHash = newHash;
+	nextActionsHashValid = hashValid;
+
+	recyclePrimitiveLists(currentActions);
+	currentActions.clear();
+	layerStack.clear();
+
+	scheduleLayerRasterising();
+
 	if(perfettoTrackId != 0)
 		flowManager.continueFlow(perfettoTrackId, "flush draw handler");
 
 	triggerAsyncUpdate();
 }
 
+Rectangle<int> DrawActions::Handler::getDirtyArea() const
+{
+	return dirtyArea;
+}
+
+Image DrawActions::Handler::LayerCache::get(uint64 key)
+{
+	ScopedLock sl(lock);
+
+	for (int i = 0; i < entries.size(); i++)
+	{
+		if (entries.getReference(i).key == key)
+		{
+			// move it to the front so that the least recently used entry is removed first
+			entries.move(i, 0);
+			return entries.getReference(0).img;
+		}
+	}
+
+	return {};
+}
+
+bool DrawActions::Handler::LayerCache::contains(uint64 key) const
+{
+	ScopedLock sl(lock);
+
+	for (const auto& e : entries)
+	{
+		if (e.key == key)
+			return true;
+	}
+
+	return false;
+}
+
+void DrawActions::Handler::LayerCache::add(uint64 key, const Image& img)
+{
+	ScopedLock sl(lock);
+
+	for (auto& e : entries)
+	{
+		if (e.key == key)
+		{
+			numBytes += getNumBytes(img) - getNumBytes(e.img);
+			e.img = img;
+			return;
+		}
+	}
+
+	entries.insert(0, { key, img });
+	numBytes += getNumBytes(img);
+
+	// always keep the new image even if it exceeds the budget on its own
+	while (numBytes > MaxNumBytes && entries.size() > 1)
+		numBytes -= getNumBytes(entries.removeAndReturn(entries.size() - 1).img);
+}
+
+int64 DrawActions::Handler::LayerCache::getNumBytes(const Image& img)
+{
+	if (!img.isValid())
+		return 0;
+
+	return (int64)img.getWidth() * (int64)img.getHeight() * (img.isARGB() ? 4 : 3);
+}
+
+DrawActions::Handler::Rasteriser::Rasteriser():
+	ThreadPool(2)
+{}
+
+DrawActions::Handler::RasteriseJob::RasteriseJob(Handler& h):
+	ThreadPoolJob("Layer rasteriser"),
+	parent(h)
+{}
+
+ThreadPoolJob::JobStatus DrawActions::Handler::RasteriseJob::runJob()
+{
+	while (!shouldExit())
+	{
+		std::pair<ActionBase::Ptr, uint64> next;
+		int w, h;
+		float sf;
+
+		{
+			ScopedLock sl(lock);
+
+			currentLayer = nullptr;
+
+			if (pendingLayers.isEmpty())
+				break;
+
+			next = pendingLayers.removeAndReturn(0);
+			currentLayer = next.first.get();
+			w = width;
+			h = height;
+			sf = scaleFactor;
+		}
+
+		if (!parent.layerCache->contains(next.second))
+			parent.layerCache->add(next.second, rasteriseLayer(next.first.get(), w, h, sf));
+	}
+
+	bool needsRepaint;
+
+	{
+		ScopedLock sl(lock);
+		currentLayer = nullptr;
+		needsRepaint = repaintWhenFinished;
+		repaintWhenFinished = false;
+	}
+
+	if (needsRepaint && !shouldExit())
+	{
+		{
+			SpinLock::ScopedLockType sl(parent.lock);
+			parent.fullRepaintPending = true;
+		}
+
+		parent.triggerAsyncUpdate();
+	}
+
+	return jobHasFinished;
+}
+
+bool DrawActions::Handler::getLayerCacheKey(ActionBase* a, int width, int height, float sf, uint64& key)
+{
+	if (a->wantsToDrawOnParent() || !a->wantsCachedImage())
+		return false;
+
+	ContentHash h;
+	h.add(a->getDispatchId().hash());
+
+	if (!a->addToContentHash(h))
+		return false;
+
+	h.add(width);
+	h.add(height);
+	h.add(sf);
+
+	key = h.value;
+	return true;
+}
+
+Image DrawActions::Handler::rasteriseLayer(ActionBase* layer, int width, int height, float sf)
+{
+	// Use the software renderer so that this can be called from a background thread
+	Image actionImage(Image::ARGB, width, height, true, SoftwareImageType());
+
+	// Render with a local state, the message thread might paint the same layer right now
+	if (auto l = dynamic_cast<ActionLayer*>(layer))
+	{
+		Graphics g(actionImage);
+		l->renderWithState(g, { actionImage, actionImage, sf });
+	}
+	else
+		jassertfalse;
+
+	return actionImage;
+}
+
+void DrawActions::Handler::setLastRenderSize(int width, int height, float sf)
+{
+	ScopedLock sl(rasteriseJob.lock);
+
+	rasteriseJob.width = width;
+	rasteriseJob.height = height;
+	rasteriseJob.scaleFactor = sf;
+}
+
+bool DrawActions::Handler::deferLayer(ActionBase* layer)
+{
+	ScopedLock sl(rasteriseJob.lock);
+
+	auto isPending = rasteriseJob.currentLayer == layer;
+
+	for (const auto& p : rasteriseJob.pendingLayers)
+		isPending |= p.first.get() == layer;
+
+	if (isPending)
+		rasteriseJob.repaintWhenFinished = true;
+
+	return isPending;
+}
+
+Image DrawActions::Handler::getPreviousLayerImage(int layerIndex)
+{
+	if (isPositiveAndBelow(layerIndex, previousLayerKeys.size()))
+		return layerCache->get(previousLayerKeys[layerIndex]);
+
+	return {};
+}
+
+void DrawActions::Handler::setPreviousLayerKey(int layerIndex, uint64 key)
+{
+	while (previousLayerKeys.size() <= layerIndex)
+		previousLayerKeys.add(0);
+
+	previousLayerKeys.set(layerIndex, key);
+}
+
+void DrawActions::Handler::scheduleLayerRasterising()
+{
+	bool somethingToDo = false;
+
+	{
+		ScopedLock sl(rasteriseJob.lock);
+
+		// the size is unknown until the first render call
+		if (rasteriseJob.width == 0 || rasteriseJob.height == 0)
+			return;
+
+		rasteriseJob.pendingLayers.clearQuick();
+
+		for (auto a : nextActions)
+		{
+			uint64 key;
+
+			// only layers can be rendered without changing their state
+			if (dynamic_cast<ActionLayer*>(a) == nullptr)
+				continue;
+
+			if (getLayerCacheKey(a, rasteriseJob.width, rasteriseJob.height, rasteriseJob.scaleFactor, key) && !layerCache->contains(key))
+			{
+				rasteriseJob.pendingLayers.add({ a, key });
+				somethingToDo = true;
+			}
+		}
+	}
+
+	if (somethingToDo && !rasteriser->contains(&rasteriseJob))
+		rasteriser->addJob(&rasteriseJob, false);
+}
+
+bool DrawActions::Handler::createContentHash(const ReferenceCountedArray<ActionBase>& list, uint64& hash)
+{
+	ContentHash h;
+
+	for (auto a : list)
+	{
+		h.add(a->getDispatchId().hash());
+
+		if (!a->addToContentHash(h))
+			return false;
+	}
+
+	hash = h.value;
+	return true;
+}
+
+bool DrawActions::Handler::addChangedArea(const ReferenceCountedArray<ActionBase>& oldList, const ReferenceCountedArray<ActionBase>& newList, Rectangle<float>& area)
+{
+	if (oldList.size() != newList.size())
+		return false;
+
+	for (int i = 0; i < newList.size(); i++)
+	{
+		auto o = oldList.getUnchecked(i).get();
+		auto n = newList.getUnchecked(i).get();
+
+		if (o->getDispatchId().hash() != n->getDispatchId().hash())
+			return false;
+
+		// the bounds of every action are in the transformed space so we can't use them
+		if (o->transformsCoordinates() || n->transformsCoordinates())
+			return false;
+
+		ContentHash oh, nh;
+		o->addToContentHash(oh);
+		n->addToContentHash(nh);
+
+		if (oh.value == nh.value)
+			continue;
+
+		auto op = dynamic_cast<PrimitiveList*>(o);
+		auto np = dynamic_cast<PrimitiveList*>(n);
+
+		if (op != nullptr && np != nullptr)
+		{
+			if (!np->addChangedArea(*op, area))
+				return false;
+
+			continue;
+		}
+
+		auto ob = o->getDrawBounds();
+		auto nb = n->getDrawBounds();
+
+		if (ob.isEmpty() || nb.isEmpty())
+			return false;
+
+		area = area.getUnion(ob).getUnion(nb);
+	}
+
+	return true;
+}
+
+DrawActions::PrimitiveList::Ptr DrawActions::Handler::createPrimitiveList()
+{
+	if (auto p = primitivePool.getLast())
+	{
+		primitivePool.removeLast();
+		return p;
+	}
+
+	return new PrimitiveList();
+}
+
+void DrawActions::Handler::recyclePrimitiveLists(ReferenceCountedArray<ActionBase>& list)
+{
+	static constexpr int MaxPoolSize = 16;
+
+	for (auto a : list)
+	{
+		if (primitivePool.size() >= MaxPoolSize)
+			break;
+
+		// if an iterator still holds a reference, it's not safe to reuse the list
+		if (a->getReferenceCount() != 1)
+			continue;
+
+		if (auto p = dynamic_cast<PrimitiveList*>(a))
+		{
+			p->commands.clearQuick();
+			primitivePool.add(p);
+		}
+	}
+}
+
 void DrawActions::Handler::logError(const String& message)
 {
 	if (errorLogger)
@@ -844,6 +1453,14 @@ void DrawActions::Handler::handleAsyncUpdate()
 {
 	auto x = flowManager.flushAllButLastOne("flush draw handler", {});
 
+	{
+		SpinLock::ScopedLockType sl(lock);
+
+		dirtyArea = fullRepaintPending ? Rectangle<int>() : pendingDirtyArea;
+		fullRepaintPending = false;
+		pendingDirtyArea = {};
+	}
+
 	for (auto l : listeners)
 	{
 		if (l != nullptr)
@@ -944,7 +1561,13 @@ void BorderPanel::openGLContextClosing()
 void BorderPanel::newPaintActionsAvailable(uint64_t flowId)
 {
 	flowManager.continueFlow(flowId, "repaint request");
-	repaint();
+
+	auto area = drawHandler != nullptr ? drawHandler->getDirtyArea() : Rectangle<int>();
+
+	if (area.isEmpty())
+		repaint();
+	else
+		repaint(area);
 }
 
 void BorderPanel::registerToTopLevelComponent()
@@ -1417,6 +2040,18 @@ void DrawActions::BlendingLayer::perform(Graphics& g)
 	gin::applyBlend(imageToBlendOn, blendSource, blendMode, alpha);
 }
 
+void DrawActions::BlendingLayer::renderWithState(Graphics& g, const RenderState& state) const
+{
+	auto imageToBlendOn = state.actionImage;
+	Image localBlendSource(Image::ARGB, imageToBlendOn.getWidth(), imageToBlendOn.getHeight(), true);
+
+	Graphics g2(localBlendSource);
+	g2.addTransform(AffineTransform::scale(state.scaleFactor));
+
+	ActionLayer::renderWithState(g2, { localBlendSource, imageToBlendOn, state.scaleFactor });
+	gin::applyBlend(imageToBlendOn, localBlendSource, blendMode, alpha);
+}
+
 void DrawActions::Handler::Iterator::render(Graphics& g, Component* c)
 {
 	if (handler->recursion)
@@ -1459,6 +2094,10 @@ void DrawActions::Handler::Iterator::render(Graphics& g, Component* c)
 		Graphics g2(cachedImg);
 		g2.addTransform(st);
 
+		handler->setLastRenderSize(cachedImg.getWidth(), cachedImg.getHeight(), sf);
+
+		int layerIndex = 0;
+
 		while (auto action = getNextAction())
 		{
 #if PERFETTO
@@ -1469,6 +2108,36 @@ void DrawActions::Handler::Iterator::render(Graphics& g, Component* c)
 
 			if (action->wantsCachedImage())
 			{
+				uint64 layerKey = 0;
+				auto cacheable = Handler::getLayerCacheKey(action.get(), cachedImg.getWidth(), cachedImg.getHeight(), sf, layerKey);
+
+				if (cacheable)
+				{
+					auto thisIndex = layerIndex++;
+					auto cachedLayer = handler->getLayerCache().get(layerKey);
+
+					if (cachedLayer.isValid())
+					{
+						handler->setPreviousLayerKey(thisIndex, layerKey);
+						g2.drawImageAt(cachedLayer, 0, 0);
+						continue;
+					}
+
+					// don't wait for the background thread, but draw the last image of this layer
+					// until the handler repaints with the new one
+					if (handler->deferLayer(action.get()))
+					{
+						auto previousLayer = handler->getPreviousLayerImage(thisIndex);
+
+						if (previousLayer.getBounds() == cachedImg.getBounds())
+							g2.drawImageAt(previousLayer, 0, 0);
+
+						continue;
+					}
+
+					handler->setPreviousLayerKey(thisIndex, layerKey);
+				}
+
 				Image actionImage;
 
 				if (action->wantsToDrawOnParent())
@@ -1488,6 +2157,9 @@ void DrawActions::Handler::Iterator::render(Graphics& g, Component* c)
                 {
                     g2.drawImageAt(actionImage, 0, 0);
                 }
+
+				if (cacheable)
+					handler->getLayerCache().add(layerKey, actionImage);
 					//GraphicHelpers::quickDraw(cachedImg, actionImage);
 			}
 			else
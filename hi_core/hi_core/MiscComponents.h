@@ -297,12 +297,29 @@ private:
 
 struct DrawActions
 {
+	/** A FNV-1a hash that is used to check whether a paint routine created the same actions as before. */
+	struct ContentHash
+	{
+		template <typename T> void add(const T& v) noexcept
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "not a POD type");
+			addBytes(&v, sizeof(T));
+		}
+
+		void addBytes(const void* data, size_t numBytes) noexcept;
+
+		uint64 value = 14695981039346656037ull;
+	};
+
 	class PostActionBase : public ReferenceCountedObject
 	{
 	public:
 
 		virtual void perform(PostGraphicsRenderer& r) = 0;
 		virtual bool needsStackData() const;
+
+		/** Add all parameters to the hash. If this returns false (the default), the layer can't be cached. */
+		virtual bool addToContentHash(ContentHash& h) const;
 	};
 
 	class ActionBase: public ReferenceCountedObject
@@ -319,6 +336,25 @@ struct DrawActions
 
 		virtual dispatch::HashedCharPtr getDispatchId() const = 0;
 
+		/** Override this and add everything that affects the rendering to the hash.
+		 *
+		 *	If this returns false (the default), the action can't be compared and the handler will
+		 *	always repaint.
+		 */
+		virtual bool addToContentHash(ContentHash& h) const;
+
+		/** Returns the area that this action draws into. If the action changes the graphics state
+		 *	or the area is unknown, it returns an empty rectangle and a change will repaint everything.
+		 */
+		virtual Rectangle<float> getDrawBounds() const;
+
+		/** Return true if this action changes the coordinate space of all following actions.
+		 *
+		 *	The draw bounds of the other actions can't be compared then and the handler will
+		 *	always repaint everything.
+		 */
+		virtual bool transformsCoordinates() const;
+
 		virtual void setCachedImage(Image& actionImage_, Image& mainImage_);
 		virtual void setScaleFactor(float sf);
 
@@ -370,12 +406,34 @@ struct DrawActions
 
 		void perform(Graphics& g);
 
+		/** The images and the scale factor that a layer is rendered with. */
+		struct RenderState
+		{
+			Image actionImage;
+			Image mainImage;
+			float scaleFactor = 1.0f;
+		};
+
+		/** Renders the layer with the given state instead of the cached image and scale factor of the layer.
+		 *
+		 *	This doesn't change the layer or its child actions, so the background rasteriser can call it
+		 *	while the message thread paints the same layer. Child actions that read their own cached image
+		 *	can't be added to the content hash, so they are never part of a layer that is rendered this way.
+		 */
+		virtual void renderWithState(Graphics& g, const RenderState& state) const;
+
 		void addDrawAction(ActionBase* a);
 
 		void addPostAction(PostActionBase* a);
 
+		bool addToContentHash(ContentHash& h) const override;
+
+		bool transformsCoordinates() const override;
+
 	protected:
 
+		void applyPostActions(PostGraphicsRenderer::DataStack& dataStack, Image& img, float sf) const;
+
 		bool drawOnParent = false;
 
 		OwnedArray<ActionBase> internalActions;
@@ -393,14 +451,80 @@ struct DrawActions
 
 		bool wantsCachedImage() const override;
 
+		bool addToContentHash(ContentHash& h) const override;
+
 		void perform(Graphics& g) override;
 
+		void renderWithState(Graphics& g, const RenderState& state) const override;
+
 		float alpha;
 		
 		Image blendSource;
 		gin::BlendMode blendMode;
 	};
 
+	/** A list of simple draw calls that are recorded as POD commands into a single action.
+	 *
+	 *	The handler merges consecutive calls into one list and recycles the lists after they were
+	 *	rendered, so the most common draw calls don't need a heap allocation.
+	 */
+	class PrimitiveList : public ActionBase
+	{
+	public:
+
+		using Ptr = ReferenceCountedObjectPtr<PrimitiveList>;
+
+		enum class Type : uint8
+		{
+			FillAll,
+			SetColour,
+			SetOpacity,
+			FillRect,
+			DrawRect,
+			FillEllipse,
+			DrawEllipse,
+			DrawLine,
+			DrawHorizontalLine,
+			DrawVerticalLine,
+			numTypes
+		};
+
+		struct Command
+		{
+			Command() = default;
+			Command(Type t, Rectangle<float> area, float thickness=0.0f);
+			Command(Type t, float v1, float v2, float v3, float v4=0.0f, float v5=0.0f);
+			Command(Type t, Colour c);
+
+			bool operator==(const Command& other) const noexcept;
+
+			/** Returns true if the command changes the graphics state for the subsequent calls. */
+			bool changesState() const noexcept;
+
+			Rectangle<float> getBounds() const noexcept;
+
+			void perform(Graphics& g) const;
+
+			Type type = Type::numTypes;
+			uint32 colour = 0;
+			float data[5] = { 0.0f, 0.0f, 0.0f, 0.0f, 0.0f };
+		};
+
+		SET_ACTION_ID(primitives);
+
+		void perform(Graphics& g) override;
+
+		bool addToContentHash(ContentHash& h) const override;
+
+		Rectangle<float> getDrawBounds() const override;
+
+		/** Compares the commands with the other list and adds the area of all changed commands.
+		 *  Returns false if a full repaint is required. */
+		bool addChangedArea(const PrimitiveList& other, Rectangle<float>& area) const;
+
+		Array<Command> commands;
+	};
+
 	struct NoiseMapManager
 	{
 		struct NoiseMap
@@ -432,6 +556,41 @@ struct DrawActions
 
 	struct Handler: private AsyncUpdater
 	{
+		/** Stores the rendered images of layers with post effects. A layer will be reused as long as
+		 *	its actions, the image size and the scale factor don't change.
+		 *
+		 *	It's shared between all handlers and removes the least recently used images when they
+		 *	exceed the memory budget.
+		 */
+		struct LayerCache
+		{
+			Image get(uint64 key);
+			bool contains(uint64 key) const;
+			void add(uint64 key, const Image& img);
+
+		private:
+
+			struct Entry
+			{
+				uint64 key = 0;
+				Image img;
+			};
+
+			static int64 getNumBytes(const Image& img);
+
+			static constexpr int64 MaxNumBytes = 64 * 1024 * 1024;
+
+			CriticalSection lock;
+			Array<Entry> entries;
+			int64 numBytes = 0;
+		};
+
+		/** The thread pool that renders the cacheable layers after a flush. It's shared between all handlers. */
+		struct Rasteriser : public ThreadPool
+		{
+			Rasteriser();
+		};
+
 		struct Iterator
 		{
 			Iterator(Handler* handler_);
@@ -471,8 +630,24 @@ struct DrawActions
 
 		void addDrawAction(ActionBase* newDrawAction);
 
+		/** Adds a simple draw call. Consecutive calls will be recorded into the same PrimitiveList. */
+		void addPrimitive(const PrimitiveList::Command& c);
+
+		/** Swaps the recorded actions so that they will be rendered.
+		 *
+		 *	If the actions are identical to the last ones, they will be discarded and the
+		 *	listeners won't be notified.
+		 */
 		void flush(uint64_t perfettoTrackId);
 
+		/** Returns the area that changed since the last notification. An empty rectangle means that
+		 *  everything needs to be repainted. Call this in Listener::newPaintActionsAvailable().
+		 */
+		Rectangle<int> getDirtyArea() const;
+
+		/** Notifies the listeners synchronously if there is a pending flush. */
+		using AsyncUpdater::handleUpdateNowIfNeeded;
+
 		void logError(const String& message);
 
 		void addDrawActionListener(Listener* l);
@@ -491,8 +666,57 @@ struct DrawActions
 
 		NoiseMapManager* getNoiseMapManager();
 
+		/** Returns the key for the layer cache or false if the action can't be cached. */
+		static bool getLayerCacheKey(ActionBase* a, int width, int height, float sf, uint64& key);
+
+		/** Renders the layer into a new image the same way as Iterator::render() does, but without changing the layer. */
+		static Image rasteriseLayer(ActionBase* layer, int width, int height, float sf);
+
+		LayerCache& getLayerCache() { return *layerCache; }
+
+		/** Stores the size of the last rendered image so that the layers of the next flush can be rendered in the background. */
+		void setLastRenderSize(int width, int height, float sf);
+
+		/** Returns true if the layer is rendered on the background thread right now.
+		 *
+		 *	In this case the layer must not be drawn and the listeners will be notified again
+		 *	with a full repaint once the background thread is done.
+		 */
+		bool deferLayer(ActionBase* layer);
+
+		/** Returns the image that was drawn for the cacheable layer with the given index in the last render call.
+		 *	It can be used in place of a layer that is still being rasterised. */
+		Image getPreviousLayerImage(int layerIndex);
+
+		void setPreviousLayerKey(int layerIndex, uint64 key);
+
 	private:
 
+		struct RasteriseJob : public ThreadPoolJob
+		{
+			RasteriseJob(Handler& h);
+
+			JobStatus runJob() override;
+
+			Handler& parent;
+
+			CriticalSection lock;
+			Array<std::pair<ActionBase::Ptr, uint64>> pendingLayers;
+			ActionBase* currentLayer = nullptr;
+			bool repaintWhenFinished = false;
+
+			int width = 0;
+			int height = 0;
+			float scaleFactor = 1.0f;
+		};
+
+		void scheduleLayerRasterising();
+
+		SharedResourcePointer<LayerCache> layerCache;
+		SharedResourcePointer<Rasteriser> rasteriser;
+		Array<uint64> previousLayerKeys;
+		RasteriseJob rasteriseJob { *this };
+
 		dispatch::AccumulatedFlowManager flowManager;
 
 		SharedResourcePointer<NoiseMapManager> noiseManager;
@@ -507,11 +731,27 @@ struct DrawActions
 
 		SpinLock lock;
 
+		static bool createContentHash(const ReferenceCountedArray<ActionBase>& list, uint64& hash);
+		static bool addChangedArea(const ReferenceCountedArray<ActionBase>& oldList, const ReferenceCountedArray<ActionBase>& newList, Rectangle<float>& area);
+
+		PrimitiveList::Ptr createPrimitiveList();
+		void recyclePrimitiveLists(ReferenceCountedArray<ActionBase>& list);
+
 		ReferenceCountedArray<ActionLayer> layerStack;
 
 		ReferenceCountedArray<ActionBase> nextActions;
 		ReferenceCountedArray<ActionBase> currentActions;
 
+		PrimitiveList* currentPrimitiveList = nullptr;
+		ReferenceCountedArray<PrimitiveList> primitivePool;
+
+		uint64 nextActionsHash = 0;
+		bool nextActionsHashValid = false;
+
+		bool fullRepaintPending = false;
+		Rectangle<int> pendingDirtyArea;
+		Rectangle<int> dirtyArea;
+
 		JUCE_DECLARE_WEAK_REFERENCEABLE(Handler);
 	};
 
@@ -45,6 +45,7 @@ namespace hise { using namespace juce;
 MainController::SampleManager::SampleManager(MainController *mc_) :
 	mc(mc_),
 	samplerLoaderThreadPool(new SampleThreadPool()),
+	adaptivePreloadSizer(new AdaptivePreloadSizer(samplerLoaderThreadPool->getTelemetry())),
 	projectHandler(mc_),
 	sampleClipboard(ValueTree("clipboard")),
 	internalPreloadJob(mc_),
@@ -64,11 +65,13 @@ MainController::SampleManager::~SampleManager()
 	internalPreloadJob.signalJobShouldExit();
 	samplerLoaderThreadPool->stopThread(2000);
 
+	preloadThreadPool = nullptr;
+
 	pendingFunctions.clear();
 
 	jassert(pendingFunctions.isEmpty());
 
-
+	adaptivePreloadSizer = nullptr;
 
 	samplerLoaderThreadPool = nullptr;
 }
@@ -110,6 +113,83 @@ void MainController::SampleManager::preloadEverything()
 	}
 }
 
+void MainController::SampleManager::setNumPreloadThreads(int numThreads)
+{
+	ScopedLock sl(preloadThreadLock);
+
+	numThreads = jmax(0, numThreads);
+
+	if (numThreads != numPreloadThreads)
+	{
+		numPreloadThreads = numThreads;
+		preloadThreadPool = nullptr;
+	}
+}
+
+bool MainController::SampleManager::runPreloadJobs(int numJobs, const std::function<bool(int)>& preloadFunction, const std::function<void()>& progressFunction)
+{
+	ScopedLock sl(preloadThreadLock);
+
+	std::atomic<int> nextJob = { 0 };
+	std::atomic<int> numActiveWorkers = { 0 };
+	std::atomic<bool> ok = { true };
+
+	auto loadingThread = samplerLoaderThreadPool.get();
+
+	auto runJobs = [&](bool isCallingThread)
+	{
+		while (ok.load() && !loadingThread->threadShouldExit())
+		{
+			auto jobIndex = nextJob++;
+
+			if (jobIndex >= numJobs)
+				break;
+
+			if (!preloadFunction(jobIndex))
+				ok.store(false);
+
+			if (isCallingThread && progressFunction)
+				progressFunction();
+		}
+	};
+
+	auto numWorkers = hddMode ? 0 : jmin(numPreloadThreads, numJobs - 1);
+
+	if (numWorkers > 0)
+	{
+		if (preloadThreadPool == nullptr)
+			preloadThreadPool = new ThreadPool(numPreloadThreads);
+
+		numActiveWorkers.store(numWorkers);
+		preloadWorkersFinished.reset();
+
+		for (int i = 0; i < numWorkers; i++)
+		{
+			preloadThreadPool->addJob([&runJobs, &numActiveWorkers, this]()
+			{
+				runJobs(false);
+
+				// Don't touch the local variables after the last worker has decremented the counter
+				if (numActiveWorkers.fetch_sub(1) == 1)
+					preloadWorkersFinished.signal();
+			});
+		}
+	}
+
+	runJobs(true);
+
+	// the jobs reference the local variables, so we need to wait for every worker
+	while (numActiveWorkers.load() > 0)
+	{
+		preloadWorkersFinished.wait(50);
+
+		if (progressFunction)
+			progressFunction();
+	}
+
+	return ok.load() && !loadingThread->threadShouldExit();
+}
+
 hise::ModulatorSamplerSoundPool * MainController::SampleManager::getModulatorSamplerSoundPool2() const
 {
 
@@ -372,9 +372,9 @@ private:
 
 
 #if USE_GLITCH_DETECTION // && !JUCE_DEBUG
-#define ADD_GLITCH_DETECTOR(processor, location) TRACE_DSP(); ScopedGlitchDetector sgd(processor, (int)location)
+#define ADD_GLITCH_DETECTOR(processor, location) TRACE_DSP(); ScopedGlitchDetector sgd(processor, (int)location); ADD_DSP_BENCHMARK(processor, location)
 #else
-#define ADD_GLITCH_DETECTOR(processor, loc) TRACE_DSP();
+#define ADD_GLITCH_DETECTOR(processor, loc) TRACE_DSP(); ADD_DSP_BENCHMARK(processor, loc)
 #endif
 
 
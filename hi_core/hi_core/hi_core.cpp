@@ -59,6 +59,7 @@
 #include "ExpansionHandler.cpp"
 #include "GlobalScriptCompileBroadcaster.cpp"
 #include "MainControllerHelpers.cpp"
+#include "DspBenchmark.cpp"
 #include "LockHelpers.cpp"
 #include "LockfreeDispatcher.cpp"
 #include "MainController.cpp"
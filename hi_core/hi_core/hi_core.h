@@ -97,6 +97,7 @@
 #include "MainControllerHelpers.h"
 #include "LockHelpers.h"
 #include "MainController.h"
+#include "DspBenchmark.h"
 #include "Console.h"
 
 #include "MacroControlBroadcaster.h"
@@ -590,6 +590,10 @@ void Processor::setIsOnAir(bool shouldBeOnAir)
 
 	onAir = shouldBeOnAir;
 
+	// A new processor might add a dependency between the child synths of a container
+	if (shouldBeOnAir)
+		ModulatorSynthChain::invalidateChildRenderGraphs(this);
+
 	for (int i = 0; i < getNumChildProcessors(); i++)
 	{
 		getChildProcessor(i)->setIsOnAir(shouldBeOnAir);
@@ -148,6 +148,20 @@ bool EffectProcessorChain::hasTailingMasterEffects() const noexcept
 	return resetCounter > 0;
 }
 
+bool EffectProcessorChain::hasActiveVoiceEffects() const
+{
+	if (isBypassed())
+		return false;
+
+	for (auto fx : voiceEffects)
+	{
+		if (!fx->isBypassed())
+			return true;
+	}
+
+	return false;
+}
+
 bool EffectProcessorChain::hasTailingPolyEffects() const
 {
 	for (int i = 0; i < voiceEffects.size(); i++)
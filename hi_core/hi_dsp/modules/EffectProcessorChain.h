@@ -92,6 +92,9 @@ public:
 
 	bool hasTailingPolyEffects() const;
 
+	/** Returns true if there is a polyphonic effect that isn't bypassed. */
+	bool hasActiveVoiceEffects() const;
+
 	void killMasterEffects();
 
 	void updateSoftBypassState();
@@ -394,6 +394,85 @@ void ModulatorChain::ModChainWithBuffer::prepareToPlay(double sampleRate, int sa
 
 	if (type == Type::Normal)
 		modBuffer.setMaxSize(samplesPerBlock);
+
+	if (type == Type::Normal && useVoiceSnapshots)
+	{
+		if (snapshotStride < samplesPerBlock)
+		{
+			snapshotStride = samplesPerBlock;
+			snapshotData.calloc(NUM_POLYPHONIC_VOICES * snapshotStride);
+			voiceSnapshots.calloc(NUM_POLYPHONIC_VOICES);
+		}
+	}
+	else
+	{
+		snapshotStride = 0;
+		snapshotData.free();
+		voiceSnapshots.free();
+	}
+}
+
+void ModulatorChain::ModChainWithBuffer::setUseVoiceSnapshots(bool shouldUseSnapshots)
+{
+	useVoiceSnapshots = shouldUseSnapshots;
+}
+
+void ModulatorChain::ModChainWithBuffer::storeVoiceSnapshot(int voiceIndex, int startSample, int numSamples)
+{
+	if (voiceSnapshots == nullptr)
+		return;
+
+	jassert(isPositiveAndBelow(voiceIndex, NUM_POLYPHONIC_VOICES));
+
+	auto& s = voiceSnapshots[voiceIndex];
+
+	s.constantValue = currentConstantValue;
+	s.data = nullptr;
+
+	if (currentVoiceData != nullptr)
+	{
+		// The values are only expanded for audio rate chains, otherwise we need to copy the control rate range
+		const int factor = isAudioRateModulation() ? 1 : HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
+		const int offset = startSample / factor;
+
+		// round up so that the last control rate value of a block that isn't a multiple of the factor is included
+		const int numValues = jmin(snapshotStride - offset, (numSamples + factor - 1) / factor);
+
+		auto dst = snapshotData.get() + voiceIndex * snapshotStride;
+
+		FloatVectorOperations::copy(dst + offset, currentVoiceData + offset, numValues);
+		s.data = dst;
+	}
+}
+
+ModulatorChain::ModChainWithBuffer::ScopedVoiceSnapshot::ScopedVoiceSnapshot(int voiceIndex):
+	previousVoiceIndex(getSnapshotVoiceIndex())
+{
+	getSnapshotVoiceIndex() = voiceIndex;
+}
+
+ModulatorChain::ModChainWithBuffer::ScopedVoiceSnapshot::~ScopedVoiceSnapshot()
+{
+	getSnapshotVoiceIndex() = previousVoiceIndex;
+}
+
+const ModulatorChain::ModChainWithBuffer::VoiceSnapshot* ModulatorChain::ModChainWithBuffer::getSnapshotForCurrentThread() const noexcept
+{
+	if (voiceSnapshots != nullptr)
+	{
+		auto voiceIndex = getSnapshotVoiceIndex();
+
+		if (voiceIndex != -1)
+			return voiceSnapshots.get() + voiceIndex;
+	}
+
+	return nullptr;
+}
+
+int& ModulatorChain::ModChainWithBuffer::getSnapshotVoiceIndex() noexcept
+{
+	static thread_local int voiceIndex = -1;
+	return voiceIndex;
 }
 
 void ModulatorChain::ModChainWithBuffer::handleHiseEvent(const HiseEvent& m)
@@ -706,6 +785,9 @@ void ModulatorChain::ModChainWithBuffer::applyMonophonicModulationValues(AudioSa
 
 const float* ModulatorChain::ModChainWithBuffer::getReadPointerForVoiceValues(int startSample) const
 {
+	if (auto s = getSnapshotForCurrentThread())
+		return s->data != nullptr ? s->data + startSample : nullptr;
+
 	// You need to expand the modulation values to audio rate before calling this method.
 	// Either call setExpandAudioRate(true) in the constructor, or manually expand them
 	jassert(currentVoiceData == nullptr || polyExpandChecker);
@@ -717,6 +799,9 @@ float* ModulatorChain::ModChainWithBuffer::getWritePointerForVoiceValues(int sta
 {
 	jassert(!options.voiceValuesReadOnly);
 
+	if (auto s = getSnapshotForCurrentThread())
+		return s->data != nullptr ? const_cast<float*>(s->data) + startSample : nullptr;
+
 	// You need to expand the modulation values to audio rate before calling this method.
 	// Either call setExpandAudioRate(true) in the constructor, or manually expand them
 	jassert(currentVoiceData == nullptr || polyExpandChecker);
@@ -734,6 +819,9 @@ float* ModulatorChain::ModChainWithBuffer::getWritePointerForManualExpansion(int
 
 	int startSample_cr = startSample / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR;
 
+	// Manual expansion isn't supported when the voices are rendered in parallel
+	jassert(getSnapshotForCurrentThread() == nullptr);
+
 	manualExpansionPending = true;
 
 	return currentVoiceData != nullptr ? const_cast<float*>(currentVoiceData) + startSample_cr : nullptr;
@@ -754,11 +842,17 @@ const float* ModulatorChain::ModChainWithBuffer::getMonophonicModulationValues(i
 
 float ModulatorChain::ModChainWithBuffer::getConstantModulationValue() const
 {
+	if (auto s = getSnapshotForCurrentThread())
+		return s->constantValue;
+
 	return currentConstantValue;
 }
 
 float ModulatorChain::ModChainWithBuffer::getModValueForVoiceWithOffset(int startSample) const
 {
+	if (auto s = getSnapshotForCurrentThread())
+		return s->data != nullptr ? s->data[startSample] : s->constantValue;
+
 	return currentVoiceData != nullptr ? currentVoiceData[startSample] : currentConstantValue;
 }
 
@@ -767,6 +861,9 @@ float ModulatorChain::ModChainWithBuffer::getOneModulationValue(int startSample)
 	// If you set this, you probably don't need this method...
 	jassert(!options.expandToAudioRate);
 
+	if (auto s = getSnapshotForCurrentThread())
+		return s->data != nullptr ? s->data[startSample / HISE_CONTROL_RATE_DOWNSAMPLING_FACTOR] : s->constantValue;
+
 	if (currentVoiceData == nullptr)
 		return getConstantModulationValue();
 
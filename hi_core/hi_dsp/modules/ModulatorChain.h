@@ -275,8 +275,43 @@ public:
 
 		void setScratchBufferFunction(const std::function<void(int, Modulator* m, float*, int, int)>& f);
 
+		/** Enables the per-voice copies of the modulation values that are required for parallel voice rendering.
+		*
+		*	Call this before prepareToPlay(), which allocates the memory for all voices.
+		*/
+		void setUseVoiceSnapshots(bool shouldUseSnapshots);
+
+		/** Stores the current voice modulation values so that the voice can be rendered later on another thread. */
+		void storeVoiceSnapshot(int voiceIndex, int startSample, int numSamples);
+
+		/** Makes all chains with voice snapshots return the stored values of the given voice on the current thread. */
+		struct ScopedVoiceSnapshot
+		{
+			ScopedVoiceSnapshot(int voiceIndex);
+			~ScopedVoiceSnapshot();
+
+		private:
+
+			const int previousVoiceIndex;
+		};
+
 	private:
 
+		struct VoiceSnapshot
+		{
+			float const* data;
+			float constantValue;
+		};
+
+		const VoiceSnapshot* getSnapshotForCurrentThread() const noexcept;
+
+		static int& getSnapshotVoiceIndex() noexcept;
+
+		bool useVoiceSnapshots = false;
+		int snapshotStride = 0;
+		HeapBlock<float> snapshotData;
+		HeapBlock<VoiceSnapshot> voiceSnapshots;
+
 		std::function<void(int, Modulator* m, float*, int, int)> scratchBufferFunction;
 
 		void applyMonophonicValuesToVoiceInternal(float* voiceBuffer, float* monoBuffer, int numSamples);
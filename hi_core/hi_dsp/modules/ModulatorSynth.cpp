@@ -631,17 +631,77 @@ void ModulatorSynth::renderVoice(int startSample, int numThisTime)
     
 	clearPendingRemoveVoices();
 
+	if (canRenderVoicesInParallel())
+	{
+		renderVoicesInParallel(startSample, numThisTime);
+	}
+	else
+	{
+		for (auto v : activeVoices)
+		{
+			jassert(!v->isInactive());
+
+			calculateModulationValuesForVoice(v, startSample, numThisTime);
+
+			v->renderNextBlock(internalBuffer, startSample, numThisTime);
+		}
+	}
+
+	clearPendingRemoveVoices();
+};
+
+bool ModulatorSynth::canRenderVoicesInParallel() const
+{
+	return parallelVoices != nullptr &&
+		   activeVoices.size() >= AudioRenderingThreadPool::MinNumVoices &&
+		   !effectChain->hasActiveVoiceEffects() &&
+		   !hasSharedVoiceState();
+}
+
+void ModulatorSynth::renderVoicesInParallel(int startSample, int numThisTime)
+{
+	int numParallelVoices = 0;
+
 	for (auto v : activeVoices)
 	{
 		jassert(!v->isInactive());
 
 		calculateModulationValuesForVoice(v, startSample, numThisTime);
 
-		v->renderNextBlock(internalBuffer, startSample, numThisTime);
+		if (useScratchBufferForArtificialPitch)
+		{
+			// The pitch fade values are in the scratch buffer that is shared
+			// between the voices so we need to render this voice right away
+			v->renderVoiceBuffer(startSample, numThisTime);
+			continue;
+		}
+
+		for (auto& mb : modChains)
+			mb.storeVoiceSnapshot(v->getVoiceIndex(), startSample, numThisTime);
+
+		parallelVoices[numParallelVoices++] = v;
 	}
 
-	clearPendingRemoveVoices();
-};
+	// The remaining voices don't use the scratch buffer, but the flag is still set if the last voice did
+	useScratchBufferForArtificialPitch = false;
+
+	VoiceRenderJob job;
+	job.voices = parallelVoices.get();
+	job.startSample = startSample;
+	job.numSamples = numThisTime;
+
+	auto pool = getMainController()->getAudioRenderingThreadPool();
+
+	if (!pool->render(job, numParallelVoices))
+	{
+		for (int i = 0; i < numParallelVoices; i++)
+			job.renderItem(i);
+	}
+
+	// Add the voices in the same order as the serial rendering so that the output is identical
+	for (auto v : activeVoices)
+		v->addVoiceBufferToOutput(internalBuffer, startSample, numThisTime);
+}
 
 	
 void ModulatorSynth::calculateModulationValuesForVoice(ModulatorSynthVoice * v, int startSample, int numThisTime)
@@ -996,8 +1056,18 @@ void ModulatorSynth::prepareToPlay(double newSampleRate, int samplesPerBlock)
 		
 		midiProcessorChain->prepareToPlay(newSampleRate, samplesPerBlock);
 
+		const bool useParallelVoices = getMainController()->getAudioRenderingThreadPool() != nullptr && supportsParallelVoiceRendering();
+
+		if (useParallelVoices && parallelVoices == nullptr)
+			parallelVoices.calloc(NUM_POLYPHONIC_VOICES);
+		else if (!useParallelVoices)
+			parallelVoices.free();
+
 		for (auto& mb : modChains)
+		{
+			mb.setUseVoiceSnapshots(useParallelVoices);
 			mb.prepareToPlay(newSampleRate, samplesPerBlock);
+		}
 
 		CHECK_COPY_AND_RETURN_12(effectChain);
 
@@ -1380,20 +1450,6 @@ void ModulatorSynthVoice::resetVoice()
 
 	clearCurrentNote();
 
-	ModulatorSynth *os = getOwnerSynth();
-
-	ModulatorChain *g = static_cast<ModulatorChain*>(os->getChildProcessor(ModulatorSynth::GainModulation));
-	ModulatorChain *p = static_cast<ModulatorChain*>(os->getChildProcessor(ModulatorSynth::PitchModulation));
-	EffectProcessorChain *e = static_cast<EffectProcessorChain*>(os->getChildProcessor(ModulatorSynth::EffectChain));
-
-	if(g->hasActiveEnvelopesAtAll())
-		g->reset(voiceIndex);
-
-	if(p->hasActiveEnvelopesAtAll())
-		p->reset(voiceIndex);
-
-	e->reset(voiceIndex);
-
 	uptimeDelta = 0.0;
 	voiceUptime = 0.0;
 	startUptime = DBL_MAX;
@@ -1409,13 +1465,37 @@ void ModulatorSynthVoice::resetVoice()
 
 	pitchFader.setValueWithoutSmoothing(1.0);
 
-	os->flagVoiceAsRemoved(this);
-
 	currentHiseEvent = HiseEvent();
 
-	if (auto uvh = getOwnerSynth()->getUniformVoiceHandler())
+	// The other voices might be rendered at the same time, so the shared state
+	// is reset on the audio thread when the voice buffer is added to the output
+	if (renderedInParallel)
+		sharedResetPending = true;
+	else
+		resetSharedVoiceState();
+}
+
+void ModulatorSynthVoice::resetSharedVoiceState()
+{
+	ModulatorSynth *os = getOwnerSynth();
+
+	ModulatorChain *g = static_cast<ModulatorChain*>(os->getChildProcessor(ModulatorSynth::GainModulation));
+	ModulatorChain *p = static_cast<ModulatorChain*>(os->getChildProcessor(ModulatorSynth::PitchModulation));
+	EffectProcessorChain *e = static_cast<EffectProcessorChain*>(os->getChildProcessor(ModulatorSynth::EffectChain));
+
+	if(g->hasActiveEnvelopesAtAll())
+		g->reset(voiceIndex);
+
+	if(p->hasActiveEnvelopesAtAll())
+		p->reset(voiceIndex);
+
+	e->reset(voiceIndex);
+
+	os->flagVoiceAsRemoved(this);
+
+	if (auto uvh = os->getUniformVoiceHandler())
 	{
-		uvh->decVoiceCounter(getOwnerSynth(), getVoiceIndex());
+		uvh->decVoiceCounter(os, getVoiceIndex());
 	}
 }
 
@@ -2165,33 +2245,49 @@ void ModulatorSynthVoice::renderNextBlock (AudioSampleBuffer& outputBuffer, int
 {
 	if (isActive)
     { 
-		calculateBlock(startSample, numSamples);
+		renderVoiceBuffer(startSample, numSamples);
+		addVoiceBufferToOutput(outputBuffer, startSample, numSamples);
+    }
+}
 
-		if (gainFader.isSmoothing())
-		{
-			applyEventVolumeFade(startSample, numSamples);
-		}
-		else if (eventGainFactor != 1.0f)
-		{
-			applyEventVolumeFactor(startSample, numSamples);
-		}
+void ModulatorSynthVoice::renderVoiceBuffer(int startSample, int numSamples)
+{
+	ADD_DSP_BENCHMARK_VOICE(getOwnerSynth(), getVoiceIndex());
 
-		if(killThisVoice)
-		{
-			applyKillFadeout(startSample, numSamples);
-		}
+	calculateBlock(startSample, numSamples);
 
-		const int maxChannelAmount = jmin<int>(voiceBuffer.getNumChannels(), outputBuffer.getNumChannels());
+	if (gainFader.isSmoothing())
+	{
+		applyEventVolumeFade(startSample, numSamples);
+	}
+	else if (eventGainFactor != 1.0f)
+	{
+		applyEventVolumeFactor(startSample, numSamples);
+	}
 
-		for (int i = 0; i < maxChannelAmount; i++)
-		{
-			FloatVectorOperations::add(outputBuffer.getWritePointer(i, startSample), voiceBuffer.getReadPointer(i, startSample), numSamples);
-		}
+	if(killThisVoice)
+	{
+		applyKillFadeout(startSample, numSamples);
+	}
+}
 
+void ModulatorSynthVoice::addVoiceBufferToOutput(AudioSampleBuffer& outputBuffer, int startSample, int numSamples)
+{
+	const int maxChannelAmount = jmin<int>(voiceBuffer.getNumChannels(), outputBuffer.getNumChannels());
 
-		// checks if any envelopes are active and in their release state and calls stopNote until they are finished.
-		checkRelease();
-    }
+	for (int i = 0; i < maxChannelAmount; i++)
+	{
+		FloatVectorOperations::add(outputBuffer.getWritePointer(i, startSample), voiceBuffer.getReadPointer(i, startSample), numSamples);
+	}
+
+	if (sharedResetPending)
+	{
+		sharedResetPending = false;
+		resetSharedVoiceState();
+	}
+
+	// checks if any envelopes are active and in their release state and calls stopNote until they are finished.
+	checkRelease();
 }
 
 void ModulatorSynthVoice::setCurrentHiseEvent(const HiseEvent &m)
@@ -2206,6 +2302,146 @@ void ModulatorSynthVoice::setCurrentHiseEvent(const HiseEvent &m)
 }
 
 
+class AudioRenderingThreadPool::Worker: public Thread
+{
+public:
+
+	Worker(AudioRenderingThreadPool& parent_, int index_):
+		Thread("Audio Rendering Thread " + String(index_ + 1)),
+		parent(parent_),
+		index(index_)
+	{}
+
+	void run() override
+	{
+		// The flush-to-zero mode must match the audio thread or the output won't be identical
+		ScopedNoDenormals snd;
+
+		// The workers execute audio callback code, so they must pass the thread checks of the audio thread
+		parent.mc->getKillStateHandler().addThreadIdToAudioThreadList();
+
+		getThreadIndexRef() = index + 1;
+
+		while (!threadShouldExit())
+		{
+			wait(-1);
+
+			if (threadShouldExit())
+				break;
+
+			parent.renderPendingItems(true);
+		}
+	}
+
+private:
+
+	AudioRenderingThreadPool& parent;
+	const int index;
+};
+
+AudioRenderingThreadPool::AudioRenderingThreadPool(MainController* mc_, int numWorkers):
+	mc(mc_)
+{
+	for (int i = 0; i < numWorkers; i++)
+	{
+		workers.add(new Worker(*this, i));
+		workers.getLast()->startThread(10);
+	}
+}
+
+AudioRenderingThreadPool::~AudioRenderingThreadPool()
+{
+	for (auto w : workers)
+	{
+		w->signalThreadShouldExit();
+		w->notify();
+	}
+
+	for (auto w : workers)
+		w->stopThread(1000);
+
+	workers.clear();
+}
+
+int& AudioRenderingThreadPool::getThreadIndexRef() noexcept
+{
+	static thread_local int threadIndex = 0;
+	return threadIndex;
+}
+
+bool AudioRenderingThreadPool::render(Job& job, int numItems)
+{
+	jassert(numItems <= 0xFFFF);
+
+	bool expected = false;
+
+	if (!busy.compare_exchange_strong(expected, true))
+		return false;
+
+	pendingJob.store(&job);
+	numRenderedItems.store(0);
+	itemState.store(ItemState::create(++generation, numItems), std::memory_order_release);
+
+	for (int i = 0; i < jmin(workers.size(), numItems - 1); i++)
+		workers[i]->notify();
+
+	renderPendingItems(false);
+
+	// The calling thread has taken every item that the workers haven't picked up yet,
+	// so this only waits for the items that are currently rendered on a worker.
+	int numSpins = 0;
+
+	while (numRenderedItems.load(std::memory_order_acquire) < numItems)
+	{
+		if (++numSpins < NumSpinIterations)
+			continue;
+
+		// A worker might have been preempted, so we must not burn the CPU it needs to finish
+		itemsFinished.wait(1);
+	}
+
+	busy.store(false);
+
+	return true;
+}
+
+void AudioRenderingThreadPool::renderPendingItems(bool isWorker)
+{
+	for (;;)
+	{
+		auto s = itemState.load(std::memory_order_acquire);
+
+		// If a worker wakes up after the job is done, the item index is already at the end
+		// and the generation of the next job prevents it from taking an item with this state.
+		do
+		{
+			if (ItemState::getNextIndex(s) >= ItemState::getNumItems(s))
+				return;
+		}
+		while (!itemState.compare_exchange_weak(s, s + 1, std::memory_order_acq_rel));
+
+		// The job can't change until every item that was taken is rendered
+		auto job = pendingJob.load(std::memory_order_acquire);
+		job->renderItem(ItemState::getNextIndex(s));
+
+		const auto numRendered = numRenderedItems.fetch_add(1, std::memory_order_acq_rel) + 1;
+
+		if (isWorker && numRendered == ItemState::getNumItems(s))
+			itemsFinished.signal();
+	}
+}
+
+void ModulatorSynth::VoiceRenderJob::renderItem(int index)
+{
+	auto v = voices[index];
+
+	ModulatorChain::ModChainWithBuffer::ScopedVoiceSnapshot svs(v->getVoiceIndex());
+
+	v->setRenderedInParallel(true);
+	v->renderVoiceBuffer(startSample, numSamples);
+	v->setRenderedInParallel(false);
+}
+
 UniformVoiceHandler::UniformVoiceHandler(ModulatorSynth* parent_): parent(parent_)
 { rebuildChildSynthList(); }
 
@@ -46,6 +46,90 @@ typedef HiseEventBuffer EVENT_BUFFER_TO_USE;
 
 using VoiceStack = UnorderedStack<ModulatorSynthVoice*>;
 
+/** A small pool of real-time worker threads that render independent parts of the audio callback in parallel.
+*
+*	This is used by the ModulatorSynth to render its voices and by the ModulatorSynthChain to render its child synths.
+*	The caller prepares everything that has to happen in order on the audio thread, then the items are rendered
+*	into private buffers by the workers and the audio thread and finally added to the output in a fixed order
+*	so that the result does not depend on the thread scheduling.
+*
+*	The pool is owned by the MainController and only created if HISE_NUM_AUDIO_RENDERING_THREADS is not zero
+*	(or if MainController::setNumAudioRenderingThreads() is called).
+*/
+class AudioRenderingThreadPool
+{
+public:
+
+	/** The minimum amount of active voices for parallel rendering. Below this, waking up the workers isn't worth it. */
+	static constexpr int MinNumVoices = 8;
+
+	/** A job that can be split into independent items that are rendered by the audio thread and the workers. */
+	struct Job
+	{
+		virtual ~Job() {};
+
+		/** Renders the item with the given index. This will be called exactly once for each item, but on any thread. */
+		virtual void renderItem(int index) = 0;
+	};
+
+	AudioRenderingThreadPool(MainController* mc, int numWorkers);
+	~AudioRenderingThreadPool();
+
+	/** Renders all items of the job and returns when every item is rendered.
+	*
+	*	The calling thread renders every item that hasn't been picked up by a worker, so it only waits
+	*	for the items that are currently rendered on a worker thread. It spins for a short time and then
+	*	blocks until the last worker is done so that it doesn't take away the CPU from a preempted worker.
+	*
+	*	If the pool is already in use (eg. by a synth that is rendered on one of the workers), it will return false without rendering anything.
+	*/
+	bool render(Job& job, int numItems);
+
+	int getNumWorkers() const noexcept { return workers.size(); }
+
+	/** Returns the index of the worker that calls this method (starting with 1) or 0 if it's not called from a worker. 
+	
+		You can use this to pick a scratch buffer that is not shared with the other threads.
+	*/
+	static int getCurrentThreadIndex() noexcept { return getThreadIndexRef(); }
+
+private:
+
+	class Worker;
+
+	static int& getThreadIndexRef() noexcept;
+
+	/** The generation, the number of items and the next item index are packed into a single atomic
+	    so that a worker that wakes up too late can't pick up an item of the next job. */
+	struct ItemState
+	{
+		static uint64 create(uint32 generation, int numItems) noexcept { return ((uint64)generation << 32) | ((uint64)(uint16)numItems << 16); }
+		static int getNumItems(uint64 s) noexcept { return (int)((s >> 16) & 0xFFFF); }
+		static int getNextIndex(uint64 s) noexcept { return (int)(s & 0xFFFF); }
+	};
+
+	/** Renders items until every item has been picked up. */
+	void renderPendingItems(bool isWorker);
+
+	/** The amount of spin iterations before the calling thread blocks on the event. */
+	static constexpr int NumSpinIterations = 2000;
+
+	MainController* mc;
+
+	OwnedArray<Worker> workers;
+
+	std::atomic<bool> busy = { false };
+	std::atomic<uint64> itemState = { 0 };
+	std::atomic<int> numRenderedItems = { 0 };
+	std::atomic<Job*> pendingJob = { nullptr };
+
+	uint32 generation = 0;
+
+	WaitableEvent itemsFinished;
+
+	JUCE_DECLARE_NON_COPYABLE(AudioRenderingThreadPool);
+};
+
 /** The uniform voice handler will unify the voice indexes of a container so that all sound generators will use the
     same voice index (derived by the event ID of the HiseEvent that started the voice).
     
@@ -218,6 +302,20 @@ public:
 
 	void calculateModulationValuesForVoice(ModulatorSynthVoice * v, int startSample, int numThisTime);;
 
+	/** Override this and return true if the voices can be rendered in parallel by the AudioRenderingThreadPool.
+	*
+	*	The voices must only access the modulation values through the modulation chains of this synth and
+	*	must not write to any state that is shared between the voices in ModulatorSynthVoice::calculateBlock().
+	*/
+	virtual bool supportsParallelVoiceRendering() const { return false; }
+
+	/** Override this and return true if the current settings make the voices write to shared state.
+	*
+	*	This is checked before every block, so you can use it to fall back to the serial rendering for
+	*	features that can't be rendered in parallel.
+	*/
+	virtual bool hasSharedVoiceState() const { return false; }
+
 	void clearPendingRemoveVoices();
 
 	/** This method is called to handle all modulatorchains after the voice rendering and handles the GUI metering. It assumes stereo mode.
@@ -532,6 +630,22 @@ private:
 	// and it must be used.
 	bool useScratchBufferForArtificialPitch = false;
 
+	bool canRenderVoicesInParallel() const;
+
+	void renderVoicesInParallel(int startSample, int numThisTime);
+
+	struct VoiceRenderJob: public AudioRenderingThreadPool::Job
+	{
+		void renderItem(int index) override;
+
+		ModulatorSynthVoice* const* voices = nullptr;
+		int startSample = 0;
+		int numSamples = 0;
+	};
+
+	// only allocated if the voices can be rendered in parallel
+	HeapBlock<ModulatorSynthVoice*> parallelVoices;
+
 	
 
 	bool shouldKillRetriggeredNote = true;
@@ -586,6 +700,19 @@ public:
                                   int startSample,
                                   int numSamples) override;
 
+	/** Renders the active voice into its voice buffer. This is called by renderNextBlock() or by the AudioRenderingThreadPool. */
+	void renderVoiceBuffer(int startSample, int numSamples);
+
+	/** Adds the rendered voice buffer to the output and checks if the voice can be released. */
+	void addVoiceBufferToOutput(AudioSampleBuffer& outputBuffer, int startSample, int numSamples);
+
+	/** Call this before the voice is rendered concurrently with other voices of the same synth.
+	*
+	*	While this is set, resetVoice() will only reset the state of this voice and defer the reset of the
+	*	state that is shared with the other voices (see resetSharedVoiceState()) until addVoiceBufferToOutput().
+	*/
+	void setRenderedInParallel(bool shouldBeRenderedInParallel) noexcept { renderedInParallel = shouldBeRenderedInParallel; }
+
 
 	virtual void calculateBlock(int startSample, int numSamples) = 0;
 	
@@ -672,6 +799,12 @@ public:
 
 protected:
 
+	/** Resets the envelopes and effects of this voice and removes it from the active voices of the owner synth.
+	*
+	*	This is called by resetVoice(). Override this if you need to reset other state that is shared between the voices.
+	*/
+	virtual void resetSharedVoiceState();
+
 	
 
 	/** Returns the ModulatorSynth instance that this voice belongs to.
@@ -724,7 +857,8 @@ private:
 
 	bool isTailing;
 
-	
+	bool renderedInParallel = false;
+	bool sharedResetPending = false;
 	
 	double startUptime;
 
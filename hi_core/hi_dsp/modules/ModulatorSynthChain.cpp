@@ -72,6 +72,8 @@ ModulatorSynthChain::ModulatorSynthChain(MainController *mc, const String &id, i
 
 ModulatorSynthChain::~ModulatorSynthChain()
 {
+	childRenderGraphUpdater = nullptr;
+
 	getHandler()->clear();
 
 	modChains.clear();
@@ -172,6 +174,8 @@ void ModulatorSynthChain::prepareToPlay(double newSampleRate, int samplesPerBloc
 
 	if (ownedUniformVoiceHandler != nullptr)
         ownedUniformVoiceHandler->rebuildChildSynthList();
+
+	invalidateChildRenderGraph();
 }
 
 void ModulatorSynthChain::numSourceChannelsChanged()
@@ -193,7 +197,7 @@ void ModulatorSynthChain::numSourceChannelsChanged()
 
 	ModulatorSynth::numSourceChannelsChanged();
 
-	
+	invalidateChildRenderGraph();
 }
 
 void ModulatorSynthChain::numDestinationChannelsChanged()
@@ -277,11 +281,7 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 	
 	internalBuffer.setSize(getMatrix().getNumSourceChannels(), numSamples, true, false, true);
 
-	for (int i = 0; i < synths.size(); i++)
-	{
-		if (!synths[i]->isSoftBypassed())
-			synths[i]->renderNextBlockWithModulators(internalBuffer, eventBuffer);
-	}
+	renderChildSynths(numSamples);
 #endif
 
 	effectChain->renderNextBlock(buffer, 0, numSamples);
@@ -326,13 +326,7 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 	ScopedAnalyser sa(getMainController(), this, internalBuffer, buffer.getNumSamples());
 
 	// Process the Synths and add store their output in the internal buffer
-	for (int i = 0; i < synths.size(); i++)
-    {
-		ScopedAnalyser sa(getMainController(), synths[i], internalBuffer, internalBuffer.getNumSamples());
-
-        if (!synths[i]->isSoftBypassed())
-            synths[i]->renderNextBlockWithModulators(internalBuffer, eventBuffer);
-    }
+	renderChildSynths(numSamples);
 
 	HiseEventBuffer::Iterator eventIterator(eventBuffer);
 
@@ -387,6 +381,259 @@ void ModulatorSynthChain::renderNextBlockWithModulators(AudioSampleBuffer &buffe
 }
 
 
+void ModulatorSynthChain::renderChildSynths(int numSamples)
+{
+	auto pool = getMainController()->getAudioRenderingThreadPool();
+	auto graph = childRenderGraph.get();
+
+	const bool useGraph = pool != nullptr &&
+						  graph != nullptr &&
+						  graph->version == childRenderGraphVersion.load() &&
+						  graph->batchSizes.size() == synths.size() &&
+						  graph->numChannels == internalBuffer.getNumChannels() &&
+						  numSamples <= graph->blockSize &&
+						  !isUsingUniformVoiceHandler();
+
+	for (int i = 0; i < synths.size();)
+	{
+		const int numParallel = useGraph ? graph->batchSizes[i] : 0;
+
+		if (numParallel <= 1)
+		{
+			ScopedAnalyser sa(getMainController(), synths[i], internalBuffer, internalBuffer.getNumSamples());
+
+			if (!synths[i]->isSoftBypassed())
+				synths[i]->renderNextBlockWithModulators(internalBuffer, eventBuffer);
+
+			i++;
+			continue;
+		}
+
+		ChildRenderJob job(*this, *graph, i, numSamples);
+
+		if (!pool->render(job, numParallel))
+		{
+			for (int j = 0; j < numParallel; j++)
+				job.renderItem(j);
+		}
+
+		// Add the private buffers in the order of the child synths so that the result doesn't depend on the thread scheduling
+		for (int j = i; j < i + numParallel; j++)
+		{
+			if (!graph->rendered[j])
+				continue;
+
+			// The child synth only writes to the channels that its routing matrix is connected to
+			const auto& m = synths[j]->getMatrix();
+			auto& usedChannels = graph->usedChannels;
+
+			usedChannels.fill(false);
+
+			for (int c = 0; c < m.getNumSourceChannels(); c++)
+			{
+				const int destination = m.getConnectionForSourceChannel(c);
+
+				if (isPositiveAndBelow(destination, usedChannels.size()))
+					usedChannels.set(destination, true);
+			}
+
+			for (int c = 0; c < usedChannels.size(); c++)
+			{
+				if (usedChannels[c])
+					FloatVectorOperations::add(internalBuffer.getWritePointer(c), graph->buffers[j]->getReadPointer(c), numSamples);
+			}
+		}
+
+		i += numParallel;
+	}
+}
+
+void ModulatorSynthChain::ChildRenderJob::renderItem(int index)
+{
+	const int childIndex = offset + index;
+
+	auto s = parent.synths[childIndex];
+	auto& b = *graph.buffers[childIndex];
+
+	b.setSize(graph.numChannels, numSamples, false, false, true);
+	b.clear();
+
+	const bool shouldRender = !s->isSoftBypassed();
+
+	graph.rendered.getReference(childIndex) = shouldRender;
+
+	if (shouldRender)
+	{
+		ScopedAnalyser sa(parent.getMainController(), s, b, numSamples);
+		s->renderNextBlockWithModulators(b, parent.eventBuffer);
+	}
+}
+
+ModulatorSynthChain::ChildRenderGraph::Node::Node(ModulatorSynth* s)
+{
+	Processor::Iterator<Processor> iter(s, false);
+
+	while (auto p = iter.getNextProcessor())
+	{
+		// The send container is rendered by this child synth and the send effects
+		// of the other child synths add their signal to its buffer
+		if (auto sc = dynamic_cast<SendContainer*>(p))
+			writes.addIfNotAlreadyThere(sc);
+
+		if (auto se = dynamic_cast<SendEffect*>(p))
+		{
+			SimpleReadWriteLock::ScopedReadLock sl(se->lock);
+
+			if (auto c = se->container.get())
+				writes.addIfNotAlreadyThere(c);
+		}
+
+		// The global modulators read the values that the container calculates when it's rendered
+		if (auto gc = dynamic_cast<GlobalModulatorContainer*>(p))
+			writes.addIfNotAlreadyThere(gc);
+
+		if (auto gm = dynamic_cast<GlobalModulator*>(p))
+		{
+			if (auto c = gm->getConnectedContainer())
+				reads.addIfNotAlreadyThere(c);
+		}
+
+		// The macro modulation source changes the parameters of any module
+		if (dynamic_cast<MacroModulationSource*>(p) != nullptr ||
+			dynamic_cast<JavascriptProcessor*>(p) != nullptr ||
+			dynamic_cast<HardcodedSwappableEffect*>(p) != nullptr)
+			accessesAnyModule = true;
+	}
+}
+
+bool ModulatorSynthChain::ChildRenderGraph::Node::dependsOn(const Node& other) const
+{
+	if (accessesAnyModule || other.accessesAnyModule)
+		return true;
+
+	for (auto w : writes)
+	{
+		if (other.writes.contains(w) || other.reads.contains(w))
+			return true;
+	}
+
+	for (auto r : reads)
+	{
+		if (other.writes.contains(r))
+			return true;
+	}
+
+	return false;
+}
+
+void ModulatorSynthChain::ChildRenderGraph::build(const OwnedArray<ModulatorSynth>& synths)
+{
+	Array<Node> nodes;
+
+	for (auto s : synths)
+		nodes.add(Node(s));
+
+	batchSizes.insertMultiple(0, 0, synths.size());
+
+	for (int i = 0; i < nodes.size();)
+	{
+		int numInBatch = 1;
+
+		// Add the next child synth to the batch if it doesn't depend on any child synth in the batch.
+		// Otherwise it starts the next batch so it's rendered after them like in the serial rendering
+		while (i + numInBatch < nodes.size())
+		{
+			const auto& next = nodes.getReference(i + numInBatch);
+			bool independent = true;
+
+			for (int j = i; j < i + numInBatch; j++)
+				independent &= !next.dependsOn(nodes.getReference(j));
+
+			if (!independent)
+				break;
+
+			numInBatch++;
+		}
+
+		batchSizes.set(i, numInBatch);
+		i += numInBatch;
+	}
+
+	for (int i = 0; i < synths.size(); i++)
+	{
+		rendered.add(false);
+		buffers.add(nullptr);
+	}
+
+	usedChannels.insertMultiple(0, false, numChannels);
+
+	for (int i = 0; i < synths.size(); i++)
+	{
+		if (batchSizes[i] > 1)
+		{
+			for (int j = i; j < i + batchSizes[i]; j++)
+				buffers.set(j, new AudioSampleBuffer(numChannels, blockSize));
+		}
+	}
+}
+
+void ModulatorSynthChain::setUseParallelChildRendering(bool shouldRenderInParallel)
+{
+	if (shouldRenderInParallel == isUsingParallelChildRendering())
+		return;
+
+	ScopedPointer<ChildRenderGraphUpdater> newUpdater;
+
+	if (shouldRenderInParallel)
+		newUpdater = new ChildRenderGraphUpdater(*this);
+
+	{
+		LockHelpers::SafeLock sl(getMainController(), LockHelpers::Type::IteratorLock);
+		newUpdater.swapWith(childRenderGraphUpdater);
+	}
+
+	rebuildChildRenderGraph();
+}
+
+void ModulatorSynthChain::invalidateChildRenderGraph()
+{
+	++childRenderGraphVersion;
+
+	if (childRenderGraphUpdater != nullptr)
+		childRenderGraphUpdater->triggerAsyncUpdate();
+}
+
+void ModulatorSynthChain::invalidateChildRenderGraphs(Processor* p)
+{
+	for (auto parent = p->getParentProcessor(true, false); parent != nullptr; parent = parent->getParentProcessor(true, false))
+	{
+		if (auto chain = dynamic_cast<ModulatorSynthChain*>(parent))
+			chain->invalidateChildRenderGraph();
+	}
+}
+
+void ModulatorSynthChain::rebuildChildRenderGraph()
+{
+	ScopedPointer<ChildRenderGraph> newGraph;
+
+	{
+		// This prevents processors from being inserted until the new graph is in place
+		LockHelpers::SafeLock itLock(getMainController(), LockHelpers::Type::IteratorLock);
+
+		if (isUsingParallelChildRendering() && getLargestBlockSize() > 0)
+		{
+			newGraph = new ChildRenderGraph();
+			newGraph->version = childRenderGraphVersion.load();
+			newGraph->numChannels = getMatrix().getNumSourceChannels();
+			newGraph->blockSize = getLargestBlockSize();
+			newGraph->build(synths);
+		}
+
+		LockHelpers::SafeLock audioLock(getMainController(), LockHelpers::Type::AudioLock);
+		newGraph.swapWith(childRenderGraph);
+	}
+}
+
 void ModulatorSynthChain::restoreFromValueTree(const ValueTree &v)
 {
 	packageName = v.getProperty("packageName", "");
@@ -718,6 +965,7 @@ void ModulatorSynthChain::ModulatorSynthChainHandler::remove(Processor *processo
 		LOCK_PROCESSING_CHAIN(synth);
 		processorToBeRemoved->setIsOnAir(false);
 		synth->synths.removeObject(dynamic_cast<ModulatorSynth*>(processorToBeRemoved), false);
+		synth->invalidateChildRenderGraph();
 	}
 
 	if (removeSynth)
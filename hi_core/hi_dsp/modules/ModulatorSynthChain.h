@@ -220,9 +220,100 @@ public:
 	void setUseUniformVoiceHandler(bool shouldUseVoiceHandler, UniformVoiceHandler* externalVoiceHandler) override;
 
     bool isUniformVoiceHandlerRoot() const;;
+
+	/** Enables the parallel rendering of the child synths on the AudioRenderingThreadPool.
+	*
+	*	The child synths are split into batches of consecutive child synths that don't depend on each other (eg. a send effect
+	*	and the send container it writes to or a global modulator and its container). Child synths that contain scripts, macro
+	*	modulation sources or hardcoded networks might access any other module, so they are still rendered on the audio thread
+	*	in their original order. If there is no AudioRenderingThreadPool, this has no effect.
+	*/
+	void setUseParallelChildRendering(bool shouldRenderInParallel);
+
+	bool isUsingParallelChildRendering() const noexcept { return childRenderGraphUpdater != nullptr; }
+
+	/** Invalidates the information which child synths can be rendered in parallel.
+	*
+	*	This is called whenever a processor is inserted somewhere below this container and will make the container fall back
+	*	to serial rendering until the graph is rebuilt on the message thread.
+	*/
+	void invalidateChildRenderGraph();
+
+	/** Invalidates the child render graph of every container above the given processor.
+	*
+	*	Call this whenever a module changes the connection to a module in another child synth.
+	*/
+	static void invalidateChildRenderGraphs(Processor* p);
 	
 private:
 
+	struct ChildRenderGraph
+	{
+		/** The shared modules that a child synth accesses while it's rendered. */
+		struct Node
+		{
+			Node(ModulatorSynth* s);
+
+			/** Returns true if the child synths can't be rendered at the same time. */
+			bool dependsOn(const Node& other) const;
+
+			Array<const void*> reads;
+			Array<const void*> writes;
+
+			// Scripts and networks can access other modules and global cables
+			bool accessesAnyModule = false;
+		};
+
+		/** Splits the child synths into batches that can be rendered in parallel without changing the result. */
+		void build(const OwnedArray<ModulatorSynth>& synths);
+
+		int version = -1;
+		int numChannels = 0;
+		int blockSize = 0;
+
+		// one entry for each child synth. If it's bigger than 1, the child synth starts a batch of
+		// child synths that are rendered into their private buffers in parallel
+		Array<int> batchSizes;
+		Array<bool> rendered;
+		OwnedArray<AudioSampleBuffer> buffers;
+
+		// the channels of the private buffer that the current child synth writes to
+		Array<bool> usedChannels;
+	};
+
+	struct ChildRenderJob: public AudioRenderingThreadPool::Job
+	{
+		ChildRenderJob(ModulatorSynthChain& parent_, ChildRenderGraph& graph_, int offset_, int numSamples_):
+		  parent(parent_),
+		  graph(graph_),
+		  offset(offset_),
+		  numSamples(numSamples_)
+		{}
+
+		void renderItem(int index) override;
+
+		ModulatorSynthChain& parent;
+		ChildRenderGraph& graph;
+		const int offset;
+		const int numSamples;
+	};
+
+	struct ChildRenderGraphUpdater: public LockfreeAsyncUpdater
+	{
+		ChildRenderGraphUpdater(ModulatorSynthChain& parent_):
+		  parent(parent_)
+		{}
+
+		void handleAsyncUpdate() override { parent.rebuildChildRenderGraph(); }
+
+		ModulatorSynthChain& parent;
+	};
+
+	void rebuildChildRenderGraph();
+
+	/** Renders the child synths into the internal buffer. */
+	void renderChildSynths(int numSamples);
+
 	ScopedPointer<UniformVoiceHandler> ownedUniformVoiceHandler;
 
 	HiseEvent::ChannelFilterData activeChannels;
@@ -234,6 +325,10 @@ private:
 	ScopedPointer<FactoryType::Constrainer> constrainer;
 	String packageName;
 
+	ScopedPointer<ChildRenderGraphUpdater> childRenderGraphUpdater;
+	ScopedPointer<ChildRenderGraph> childRenderGraph;
+	std::atomic<int> childRenderGraphVersion = { 0 };
+
 	JUCE_DECLARE_WEAK_REFERENCEABLE(ModulatorSynthChain);
 };
 
@@ -491,22 +491,15 @@ struct SendEffect : public MasterEffectProcessor
         sendIndex = index;
         auto list = ProcessorHelpers::getListOfAllProcessors<SendContainer>(getMainController()->getMainSynthChain());
         
-        if(index == 0)
-        {
-            SimpleReadWriteLock::ScopedWriteLock sl(lock);
-            container = nullptr;
-            return;
-        }
+        SendContainer* newContainer = index > 0 ? list[index-1].get() : nullptr;
         
-        if(auto c = list[index-1])
         {
             SimpleReadWriteLock::ScopedWriteLock sl(lock);
-            container = c;
-            return;
+            container = newContainer;
         }
         
-		SimpleReadWriteLock::ScopedWriteLock sl(lock);
-		container = nullptr;
+        // The child synth of this effect now depends on the child synth of the new container
+        ModulatorSynthChain::invalidateChildRenderGraphs(this);
 	}
 
 	juce::SmoothedValue<float> gain;
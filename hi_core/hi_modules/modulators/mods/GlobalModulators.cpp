@@ -257,6 +257,9 @@ bool GlobalModulator::connectToGlobalModulator(const String &itemEntry)
         
 #endif
         
+		// The child synth of this modulator now depends on the child synth of the container
+		ModulatorSynthChain::invalidateChildRenderGraphs(dynamic_cast<Processor*>(this));
+
         // return false if the connection can't be established (yet)
         return isConnected();
 	}
@@ -35,6 +35,7 @@
 #include <regex>
 
 #include "sampler/ModulatorSamplerData.cpp"
+#include "sampler/BinarySampleMap.cpp"
 #include "sampler/ModulatorSamplerSound.cpp"
 #include "sampler/ModulatorSamplerVoice.cpp"
 #include "sampler/ModulatorSampler.cpp"
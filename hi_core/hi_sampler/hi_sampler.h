@@ -69,6 +69,7 @@ END_JUCE_MODULE_DECLARATION
 
 
 #include "sampler/ModulatorSamplerData.h"
+#include "sampler/BinarySampleMap.h"
 #include "sampler/ModulatorSamplerSound.h"
 #include "sampler/ModulatorSamplerVoice.h"
 #include "sampler/ModulatorSampler.h"
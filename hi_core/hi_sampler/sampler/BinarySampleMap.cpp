@@ -0,0 +1,500 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+namespace BinarySampleMapHelpers
+{
+static bool getNumericValue(const var& v, double& result, bool& isInteger)
+{
+	if (v.isBool() || v.isInt() || v.isInt64())
+	{
+		result = (double)(int64)v;
+		isInteger = true;
+		return true;
+	}
+
+	if (v.isDouble())
+	{
+		result = (double)v;
+		isInteger = false;
+		return true;
+	}
+
+	if (v.isString())
+	{
+		auto s = v.toString();
+
+		if (s.isEmpty())
+			return false;
+
+		// Only store the number if it will be converted back to the exact same string
+		auto i = s.getLargeIntValue();
+
+		if (String(i) == s && std::abs(i) < ((int64)1 << 53))
+		{
+			result = (double)i;
+			isInteger = true;
+			return true;
+		}
+
+		auto d = s.getDoubleValue();
+
+		if (var(d).toString() == s)
+		{
+			result = d;
+			isInteger = false;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static var createVar(double value, bool isInteger)
+{
+	if (!isInteger)
+		return var(value);
+
+	auto i = (int64)value;
+
+	if (i >= std::numeric_limits<int>::min() && i <= std::numeric_limits<int>::max())
+		return var((int)i);
+
+	return var(i);
+}
+}
+
+const Array<Identifier>& BinarySampleMap::getFixedPropertyIds()
+{
+	static const Array<Identifier> ids = 
+	{
+		SampleIds::ID,
+		SampleIds::Root,
+		SampleIds::HiKey,
+		SampleIds::LoKey,
+		SampleIds::LoVel,
+		SampleIds::HiVel,
+		SampleIds::RRGroup,
+		SampleIds::Volume,
+		SampleIds::Pan,
+		SampleIds::Normalized,
+		SampleIds::NormalizedPeak,
+		SampleIds::Pitch,
+		SampleIds::SampleStart,
+		SampleIds::SampleEnd,
+		SampleIds::SampleStartMod,
+		SampleIds::LoopStart,
+		SampleIds::LoopEnd,
+		SampleIds::LoopXFade,
+		SampleIds::LoopEnabled,
+		SampleIds::LowerVelocityXFade,
+		SampleIds::UpperVelocityXFade,
+		SampleIds::SampleState,
+		SampleIds::Reversed,
+		SampleIds::NumQuarters,
+		Identifier("Duplicate"),
+		Identifier("MonolithOffset"),
+		Identifier("MonolithLength"),
+		Identifier("SampleRate")
+	};
+
+	jassert(ids.size() == numFixedProperties);
+
+	return ids;
+}
+
+Result BinarySampleMap::write(const ValueTree& sampleMap, OutputStream& output)
+{
+	static const Identifier sampleType("sample");
+	static const Identifier fileType("file");
+
+	const auto& fixedIds = getFixedPropertyIds();
+
+	StringArray strings;
+	HashMap<String, uint32> stringIndexes;
+
+	auto addString = [&](const String& s)
+	{
+		if (stringIndexes.contains(s))
+			return stringIndexes[s];
+
+		auto index = (uint32)strings.size();
+		strings.add(s);
+		stringIndexes.set(s, index);
+		return index;
+	};
+
+	auto isStorable = [](const var& v)
+	{
+		return !(v.isArray() || v.isObject() || v.isBinaryData() || v.isMethod());
+	};
+
+	Header h;
+	zerostruct(h);
+
+	h.magic = Magic;
+	h.version = Version;
+	h.rootType = addString(sampleMap.getType().toString());
+	h.numSamples = (uint32)sampleMap.getNumChildren();
+	h.numFixedProperties = numFixedProperties;
+
+	Array<PropertyRecord> rootProperties;
+	Array<PropertyRecord> extraProperties;
+	Array<uint32> fileNames;
+
+	for (int i = 0; i < sampleMap.getNumProperties(); i++)
+	{
+		auto id = sampleMap.getPropertyName(i);
+		auto v = sampleMap[id];
+
+		if (!isStorable(v))
+			return Result::fail("Unsupported samplemap property " + id.toString());
+
+		rootProperties.add({ addString(id.toString()), addString(v.toString()) });
+	}
+
+	HeapBlock<SampleRecord> records(h.numSamples, true);
+
+	for (uint32 i = 0; i < h.numSamples; i++)
+	{
+		auto sample = sampleMap.getChild((int)i);
+		auto& r = records[i];
+
+		if (sample.getType() != sampleType)
+			return Result::fail("Unsupported child type " + sample.getType().toString());
+
+		r.fileName = NoString;
+		r.firstExtraProperty = (uint32)extraProperties.size();
+		r.firstMicFileName = (uint32)fileNames.size();
+
+		for (int j = 0; j < sample.getNumProperties(); j++)
+		{
+			auto id = sample.getPropertyName(j);
+			auto v = sample[id];
+
+			if (!isStorable(v))
+				return Result::fail("Unsupported sample property " + id.toString());
+
+			if (id == SampleIds::FileName)
+			{
+				r.fileName = addString(v.toString());
+				continue;
+			}
+
+			auto fixedIndex = fixedIds.indexOf(id);
+			double value;
+			bool isInteger;
+
+			if (fixedIndex != -1 && BinarySampleMapHelpers::getNumericValue(v, value, isInteger))
+			{
+				r.presentMask |= (1u << fixedIndex);
+
+				if (isInteger)
+					r.integerMask |= (1u << fixedIndex);
+
+				r.values[fixedIndex] = value;
+			}
+			else
+			{
+				extraProperties.add({ addString(id.toString()), addString(v.toString()) });
+			}
+		}
+
+		for (auto micFile : sample)
+		{
+			if (micFile.getType() != fileType || micFile.getNumChildren() != 0 || 
+				micFile.getNumProperties() != 1 || !micFile.hasProperty(SampleIds::FileName))
+			{
+				return Result::fail("Unsupported mic position data in sample " + sample[SampleIds::ID].toString());
+			}
+
+			fileNames.add(addString(micFile[SampleIds::FileName].toString()));
+		}
+
+		r.numExtraProperties = (uint32)extraProperties.size() - r.firstExtraProperty;
+		r.numMicFileNames = (uint32)fileNames.size() - r.firstMicFileName;
+	}
+
+	MemoryOutputStream stringData;
+	Array<uint32> stringOffsets;
+
+	for (const auto& s : strings)
+	{
+		stringOffsets.add((uint32)stringData.getDataSize());
+		stringData.write(s.toRawUTF8(), s.getNumBytesAsUTF8());
+		stringData.writeByte(0);
+	}
+
+	h.numFileNames = (uint32)fileNames.size();
+	h.numExtraProperties = (uint32)extraProperties.size();
+	h.numRootProperties = (uint32)rootProperties.size();
+	h.numStrings = (uint32)strings.size();
+
+	size_t offset = sizeof(Header);
+
+	h.sampleTableOffset = (uint32)offset;
+	offset += sizeof(SampleRecord) * h.numSamples;
+	h.fileNameListOffset = (uint32)offset;
+	offset += sizeof(uint32) * h.numFileNames;
+	h.extraPropertyOffset = (uint32)offset;
+	offset += sizeof(PropertyRecord) * h.numExtraProperties;
+	h.rootPropertyOffset = (uint32)offset;
+	offset += sizeof(PropertyRecord) * h.numRootProperties;
+	h.stringTableOffset = (uint32)offset;
+	offset += sizeof(uint32) * h.numStrings + stringData.getDataSize();
+
+	if (offset > (size_t)std::numeric_limits<uint32>::max())
+		return Result::fail("Samplemap too big");
+
+	h.totalSize = (uint32)offset;
+
+	// The records are written in the native byte order
+	static_assert(sizeof(Header) % 8 == 0, "the sample table must be aligned");
+
+	bool ok = output.write(&h, sizeof(Header));
+	ok &= output.write(records.get(), sizeof(SampleRecord) * h.numSamples);
+	ok &= output.write(fileNames.getRawDataPointer(), sizeof(uint32) * h.numFileNames);
+	ok &= output.write(extraProperties.getRawDataPointer(), sizeof(PropertyRecord) * h.numExtraProperties);
+	ok &= output.write(rootProperties.getRawDataPointer(), sizeof(PropertyRecord) * h.numRootProperties);
+	ok &= output.write(stringOffsets.getRawDataPointer(), sizeof(uint32) * h.numStrings);
+	ok &= output.write(stringData.getData(), stringData.getDataSize());
+
+	return ok ? Result::ok() : Result::fail("Can't write samplemap data");
+}
+
+Result BinarySampleMap::writeToFile(const ValueTree& sampleMap, const File& targetFile)
+{
+	MemoryOutputStream mos;
+
+	auto r = write(sampleMap, mos);
+
+	if (r.failed())
+		return r;
+
+	if (!targetFile.replaceWithData(mos.getData(), mos.getDataSize()))
+		return Result::fail("Can't write file " + targetFile.getFullPathName());
+
+	return Result::ok();
+}
+
+File BinarySampleMap::getUpToDateBinaryFile(const File& xmlFile)
+{
+	auto binaryFile = xmlFile.withFileExtension(getFileExtension());
+
+	if (binaryFile.existsAsFile() && 
+		(!xmlFile.existsAsFile() || binaryFile.getLastModificationTime() >= xmlFile.getLastModificationTime()))
+	{
+		return binaryFile;
+	}
+
+	return {};
+}
+
+BinarySampleMap::BinarySampleMap(const File& binaryFile)
+{
+	if (!binaryFile.existsAsFile())
+		return;
+
+	mappedFile = new MemoryMappedFile(binaryFile, MemoryMappedFile::readOnly);
+
+	if (mappedFile->getData() == nullptr || !initialise(mappedFile->getData(), mappedFile->getSize()))
+	{
+		header = nullptr;
+		mappedFile = nullptr;
+	}
+}
+
+BinarySampleMap::BinarySampleMap(const void* data, size_t numBytes):
+	ownedData(data, numBytes)
+{
+	if (!initialise(ownedData.getData(), ownedData.getSize()))
+		header = nullptr;
+}
+
+bool BinarySampleMap::initialise(const void* data, size_t numBytes)
+{
+	if (numBytes < sizeof(Header))
+		return false;
+
+	auto start = static_cast<const uint8*>(data);
+	auto h = reinterpret_cast<const Header*>(start);
+
+	if (h->magic != Magic || h->version != Version || h->totalSize != numBytes || h->numFixedProperties != numFixedProperties)
+		return false;
+
+	auto fits = [numBytes](uint32 offset, size_t numSectionBytes)
+	{
+		return (size_t)offset + numSectionBytes <= numBytes;
+	};
+
+	if (h->sampleTableOffset % 8 != 0 ||
+		!fits(h->sampleTableOffset, sizeof(SampleRecord) * h->numSamples) ||
+		!fits(h->fileNameListOffset, sizeof(uint32) * h->numFileNames) ||
+		!fits(h->extraPropertyOffset, sizeof(PropertyRecord) * h->numExtraProperties) ||
+		!fits(h->rootPropertyOffset, sizeof(PropertyRecord) * h->numRootProperties) ||
+		!fits(h->stringTableOffset, sizeof(uint32) * h->numStrings))
+	{
+		return false;
+	}
+
+	auto so = reinterpret_cast<const uint32*>(start + h->stringTableOffset);
+	auto sd = reinterpret_cast<const char*>(so + h->numStrings);
+	auto sdSize = numBytes - (size_t)(sd - reinterpret_cast<const char*>(start));
+
+	// Every string must be null terminated
+	if (h->numStrings > 0 && (sdSize == 0 || sd[sdSize - 1] != 0))
+		return false;
+
+	for (uint32 i = 0; i < h->numStrings; i++)
+	{
+		if (so[i] >= sdSize)
+			return false;
+	}
+
+	header = h;
+	samples = reinterpret_cast<const SampleRecord*>(start + h->sampleTableOffset);
+	fileNames = reinterpret_cast<const uint32*>(start + h->fileNameListOffset);
+	extraProperties = reinterpret_cast<const PropertyRecord*>(start + h->extraPropertyOffset);
+	rootProperties = reinterpret_cast<const PropertyRecord*>(start + h->rootPropertyOffset);
+	stringOffsets = so;
+	stringData = sd;
+	stringDataSize = sdSize;
+
+	return true;
+}
+
+int BinarySampleMap::getNumSamples() const
+{
+	return isValid() ? (int)header->numSamples : 0;
+}
+
+const BinarySampleMap::SampleRecord& BinarySampleMap::getSample(int sampleIndex) const
+{
+	jassert(isPositiveAndBelow(sampleIndex, getNumSamples()));
+	return samples[sampleIndex];
+}
+
+String BinarySampleMap::getString(uint32 stringIndex) const
+{
+	if (stringIndex >= header->numStrings)
+		return {};
+
+	return String::fromUTF8(stringData + stringOffsets[stringIndex]);
+}
+
+String BinarySampleMap::getFileName(int sampleIndex, int micIndex) const
+{
+	const auto& r = getSample(sampleIndex);
+
+	if (r.numMicFileNames > 0)
+	{
+		auto index = (size_t)r.firstMicFileName + (size_t)micIndex;
+
+		if (isPositiveAndBelow(micIndex, (int)r.numMicFileNames) && index < header->numFileNames)
+			return getString(fileNames[index]);
+
+		return {};
+	}
+
+	return micIndex == 0 ? getString(r.fileName) : String();
+}
+
+void BinarySampleMap::addProperties(ValueTree& v, const PropertyRecord* properties, uint32 numProperties) const
+{
+	for (uint32 i = 0; i < numProperties; i++)
+	{
+		auto name = getString(properties[i].name);
+
+		if (name.isNotEmpty())
+			v.setProperty(Identifier(name), getString(properties[i].value), nullptr);
+	}
+}
+
+ValueTree BinarySampleMap::createSampleTree(int sampleIndex) const
+{
+	static const Identifier sampleType("sample");
+	static const Identifier fileType("file");
+
+	const auto& r = getSample(sampleIndex);
+	const auto& fixedIds = getFixedPropertyIds();
+
+	ValueTree v(sampleType);
+
+	auto addFixedProperty = [&](int p)
+	{
+		if ((r.presentMask & (1u << p)) != 0)
+		{
+			auto isInteger = (r.integerMask & (1u << p)) != 0;
+			v.setProperty(fixedIds[p], BinarySampleMapHelpers::createVar(r.values[p], isInteger), nullptr);
+		}
+	};
+
+	addFixedProperty(ID);
+
+	if (r.fileName != NoString)
+		v.setProperty(SampleIds::FileName, getString(r.fileName), nullptr);
+
+	for (int p = ID + 1; p < numFixedProperties; p++)
+		addFixedProperty(p);
+
+	if ((size_t)r.firstExtraProperty + r.numExtraProperties <= header->numExtraProperties)
+		addProperties(v, extraProperties + r.firstExtraProperty, r.numExtraProperties);
+
+	for (int i = 0; i < (int)r.numMicFileNames; i++)
+	{
+		ValueTree micFile(fileType);
+		micFile.setProperty(SampleIds::FileName, getFileName(sampleIndex, i), nullptr);
+		v.addChild(micFile, -1, nullptr);
+	}
+
+	return v;
+}
+
+ValueTree BinarySampleMap::createValueTree() const
+{
+	if (!isValid())
+		return {};
+
+	auto type = getString(header->rootType);
+
+	ValueTree v(type.isEmpty() ? Identifier("samplemap") : Identifier(type));
+
+	addProperties(v, rootProperties, header->numRootProperties);
+
+	for (int i = 0; i < getNumSamples(); i++)
+		v.addChild(createSampleTree(i), -1, nullptr);
+
+	return v;
+}
+
+} // namespace hise
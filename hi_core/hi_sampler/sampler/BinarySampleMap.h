@@ -0,0 +1,178 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef BINARYSAMPLEMAP_H_INCLUDED
+#define BINARYSAMPLEMAP_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** A compact binary representation of a samplemap that can be memory-mapped.
+*	@ingroup sampler
+*
+*	Parsing the XML file of a samplemap with tens of thousands of samples takes a considerable
+*	amount of time, so you can store a binary version next to the XML file (with the file 
+*	extension `.hsm`). If it's newer than the XML file, the samplemap pool of the project folder
+*	will create the ValueTree from the mapped records instead of parsing the XML file. 
+*
+*	The file contains:
+*
+*	- a header with the offsets of every section
+*	- a fixed-size record for every sample with all numeric properties
+*	- a string table for the file names and all other properties
+*
+*	The sampler still needs the ValueTree of every sample, so this only saves the XML parsing
+*	(and the string to number conversions of the sample properties). Embedded samplemaps in 
+*	compiled plugins are already stored as binary ValueTree and don't use this format.
+*/
+class BinarySampleMap
+{
+public:
+
+	/** The file extension of binary samplemaps. */
+	static String getFileExtension() { return ".hsm"; }
+
+	/** Writes the samplemap to the output stream. 
+	
+		This will fail if the samplemap contains data that can't be represented by the format. 
+	*/
+	static Result write(const ValueTree& sampleMap, OutputStream& output);
+
+	/** Writes the samplemap to the given file. */
+	static Result writeToFile(const ValueTree& sampleMap, const File& targetFile);
+
+	/** Returns the binary samplemap next to the given XML file if it exists and is up to date. */
+	static File getUpToDateBinaryFile(const File& xmlFile);
+
+	/** Opens the given file as memory mapped file. */
+	BinarySampleMap(const File& binaryFile);
+
+	/** Creates a binary samplemap from the data (which will be copied). */
+	BinarySampleMap(const void* data, size_t numBytes);
+
+	/** Returns true if the data is a valid binary samplemap. */
+	bool isValid() const { return header != nullptr; }
+
+	/** Returns the number of samples in the map. */
+	int getNumSamples() const;
+
+	/** Returns the file name of the sample (or the file name of the given mic position in a multimic map). */
+	String getFileName(int sampleIndex, int micIndex=0) const;
+
+	/** Creates the ValueTree for a single sample. */
+	ValueTree createSampleTree(int sampleIndex) const;
+
+	/** Creates the ValueTree for the entire samplemap. */
+	ValueTree createValueTree() const;
+
+private:
+
+	static constexpr uint32 Magic = 0x424d5348; // "HSMB"
+	static constexpr uint32 Version = 2;
+	static constexpr uint32 NoString = 0xFFFFFFFF;
+
+	static const Array<Identifier>& getFixedPropertyIds();
+
+	enum FixedProperties
+	{
+		ID = 0,
+		Root,
+		HiKey,
+		LoKey,
+		LoVel,
+		HiVel,
+		RRGroup,
+		numFixedProperties = 28
+	};
+
+	struct Header
+	{
+		uint32 magic;
+		uint32 version;
+		uint32 totalSize;
+		uint32 rootType;
+		uint32 numSamples;
+		uint32 numFixedProperties;
+		uint32 sampleTableOffset;
+		uint32 fileNameListOffset;
+		uint32 numFileNames;
+		uint32 extraPropertyOffset;
+		uint32 numExtraProperties;
+		uint32 rootPropertyOffset;
+		uint32 numRootProperties;
+		uint32 stringTableOffset;
+		uint32 numStrings;
+		uint32 unused;
+	};
+
+	struct SampleRecord
+	{
+		uint32 presentMask;
+		uint32 integerMask;
+		uint32 fileName;
+		uint32 firstMicFileName;
+		uint32 numMicFileNames;
+		uint32 firstExtraProperty;
+		uint32 numExtraProperties;
+		uint32 unused;
+		double values[numFixedProperties];
+	};
+
+	struct PropertyRecord
+	{
+		uint32 name;
+		uint32 value;
+	};
+
+	bool initialise(const void* data, size_t numBytes);
+
+	const SampleRecord& getSample(int sampleIndex) const;
+	String getString(uint32 stringIndex) const;
+	void addProperties(ValueTree& v, const PropertyRecord* properties, uint32 numProperties) const;
+
+	ScopedPointer<MemoryMappedFile> mappedFile;
+	MemoryBlock ownedData;
+
+	const Header* header = nullptr;
+	const SampleRecord* samples = nullptr;
+	const uint32* fileNames = nullptr;
+	const PropertyRecord* extraProperties = nullptr;
+	const PropertyRecord* rootProperties = nullptr;
+	const uint32* stringOffsets = nullptr;
+	const char* stringData = nullptr;
+	size_t stringDataSize = 0;
+
+	JUCE_DECLARE_NON_COPYABLE(BinarySampleMap);
+};
+
+} // namespace hise
+
+#endif  // BINARYSAMPLEMAP_H_INCLUDED
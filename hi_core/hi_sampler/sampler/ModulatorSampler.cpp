@@ -98,6 +98,7 @@ ModulatorSynth(mc, id, numVoices),
 LookupTableProcessor(mc, 8),
 preloadSize(PRELOAD_SIZE),
 asyncPurger(this),
+adaptivePreloadUpdater(this),
 sampleMap(new SampleMap(this)),
 rrGroupAmount(1),
 bufferSize(4096),
@@ -121,6 +122,8 @@ syncVoiceHandler(false)
 	sampleEditHandler = new SampleEditHandler(this);
 #endif
 
+	soundLookupIndex = new SoundLookupIndex(this);
+
 	modChains += {this, "Sample Start", ModulatorChain::ModulationType::VoiceStartOnly, Modulation::GainMode};
 	modChains += {this, "Group Fade"};
 
@@ -189,6 +192,7 @@ syncVoiceHandler(false)
 ModulatorSampler::~ModulatorSampler()
 {
 	soundCollector = nullptr;
+	soundLookupIndex = nullptr;
 	sampleMap = nullptr;
 	abortIteration = true;
 	deleteAllSounds();
@@ -613,7 +617,16 @@ void ModulatorSampler::prepareToPlay(double newSampleRate, int samplesPerBlock)
     
 	ModulatorSynth::prepareToPlay(newSampleRate, samplesPerBlock);
 
-	if (samplesPerBlock > 0 && prevBlockSize != samplesPerBlock)
+	auto pool = getMainController()->getAudioRenderingThreadPool();
+	auto numWorkers = pool != nullptr ? pool->getNumWorkers() : 0;
+	auto workersChanged = numWorkers != workerBuffers.size();
+
+	while (workerBuffers.size() < numWorkers)
+		workerBuffers.add(new WorkerBuffers());
+
+	workerBuffers.removeRange(numWorkers, workerBuffers.size() - numWorkers);
+
+	if (samplesPerBlock > 0 && (prevBlockSize != samplesPerBlock || workersChanged))
 	{
         refreshMemoryUsage();
 
@@ -672,6 +685,7 @@ void ModulatorSampler::deleteSound(int index)
 
 		{
 			LockHelpers::SafeLock sl(getMainController(), LockHelpers::Type::SampleLock);
+			soundLookupIndex->clearTable();
 			removeSound(index);
 		}
 
@@ -708,6 +722,7 @@ void ModulatorSampler::deleteAllSounds()
 
 		if (getNumSounds() != 0)
 		{
+			soundLookupIndex->clearTable();
 			clearSounds();
 
 			if(getSampleMap() != nullptr)
@@ -794,6 +809,15 @@ void ModulatorSampler::refreshMemoryUsage(bool fastMode)
 		ps.numChannels = 2;
 
 		DspHelpers::increaseBuffer(stretchBuffer, ps);
+
+		for (auto wb : workerBuffers)
+		{
+			if (wb->voiceBuffer.isFloatingPoint() != temporaryBufferShouldBeFloatingPoint)
+				wb->voiceBuffer = hlac::HiseSampleBuffer(temporaryBufferShouldBeFloatingPoint, 2, 0);
+
+			StreamingSamplerVoice::initTemporaryVoiceBuffer(&wb->voiceBuffer, getLargestBlockSize(), (double)MAX_SAMPLER_PITCH);
+			DspHelpers::increaseBuffer(wb->stretchBuffer, ps);
+		}
 	}
 
 	int64 actualPreloadSize = 0;
@@ -818,6 +842,9 @@ void ModulatorSampler::refreshMemoryUsage(bool fastMode)
         if(!fastMode && maxPitch > (double)MAX_SAMPLER_PITCH)
         {
             StreamingSamplerVoice::initTemporaryVoiceBuffer(&temporaryVoiceBuffer, getLargestBlockSize(), maxPitch * 1.2); // give it a little more to be safe...
+
+			for (auto wb : workerBuffers)
+				StreamingSamplerVoice::initTemporaryVoiceBuffer(&wb->voiceBuffer, getLargestBlockSize(), maxPitch * 1.2);
         }
 	}
 
@@ -948,6 +975,17 @@ void ModulatorSampler::setSortByGroup(bool shouldSortByGroup)
 	}
 }
 
+void ModulatorSampler::invalidateSoundLookupIndex()
+{
+	if (soundLookupIndex != nullptr)
+		soundLookupIndex->invalidate();
+}
+
+bool ModulatorSampler::rebuildSoundLookupIndexIfOutdated()
+{
+	return soundLookupIndex != nullptr && soundLookupIndex->rebuildIfOutdated();
+}
+
 bool ModulatorSampler::hasPendingAsyncJobs() const
 {
 	return getMainController()->getSampleManager().hasPendingFunction(const_cast<ModulatorSampler*>(this));
@@ -1077,6 +1115,119 @@ void ModulatorSampler::AsyncPurger::handleAsyncUpdate()
 	sampler->refreshChannelsForSounds();
 }
 
+ModulatorSampler::AdaptivePreloadUpdater::AdaptivePreloadUpdater(ModulatorSampler *sampler_) :
+	sampler(sampler_)
+{
+	auto& sizer = sampler->getMainController()->getSampleManager().getAdaptivePreloadSizer();
+
+	sizer.addListener(this);
+	adaptivePreloadStateChanged(sizer.isEnabled());
+}
+
+ModulatorSampler::AdaptivePreloadUpdater::~AdaptivePreloadUpdater()
+{
+	sampler->getMainController()->getSampleManager().getAdaptivePreloadSizer().removeListener(this);
+	stopTimer();
+}
+
+void ModulatorSampler::AdaptivePreloadUpdater::adaptivePreloadStateChanged(bool isEnabled)
+{
+	if (isEnabled)
+		startTimer(3000);
+	else
+		stopTimer();
+}
+
+void ModulatorSampler::AdaptivePreloadUpdater::timerCallback()
+{
+	auto mc = sampler->getMainController();
+	auto& sampleManager = mc->getSampleManager();
+
+	if (!sampleManager.getAdaptivePreloadSizer().isEnabled() || sampleManager.isNonRealtime() || sampleManager.isPreloading())
+		return;
+
+	// The play from purge mode and the "load entire sample" setting handle the preloading themselves
+	if (sampler->purged || sampler->enablePlayFromPurge || sampler->preloadSize == -1)
+		return;
+
+	if (sampler->getNumSounds() == 0 || sampler->hasPendingSampleLoad())
+		return;
+
+	// Killing the voices would be audible, so we wait until nothing is playing.
+	if (mc->getNumActiveVoices() != 0)
+		return;
+
+	sampler->killAllVoicesAndCall([](Processor* p)
+	{
+		if (static_cast<ModulatorSampler*>(p)->applyAdaptivePreloadSizes())
+			return SafeFunctionCall::OK;
+
+		return SafeFunctionCall::cancelled;
+	});
+}
+
+bool ModulatorSampler::applyAdaptivePreloadSizes()
+{
+	auto& sizer = getMainController()->getSampleManager().getAdaptivePreloadSizer();
+
+	sizer.updateLatencyStatistics();
+
+	// The memory budget is shared between all samplers
+	auto availableBytes = sizer.getMemoryBudget();
+
+	Processor::Iterator<ModulatorSampler> iter(getMainController()->getMainSynthChain());
+
+	while (auto s = iter.getNextProcessor())
+	{
+		if (s != this)
+			availableBytes -= s->memoryUsage;
+	}
+
+	const int basePreloadSize = preloadSize * preloadScaleFactor;
+
+	Array<AdaptivePreloadSizer::Entry> entries;
+
+	{
+		SoundIterator sIter(this, false);
+
+		while (const auto sound = sIter.getNextSound())
+		{
+			for (int j = 0; j < numChannels; j++)
+			{
+				auto micS = sound->getReferenceToSound(j);
+
+				if (micS != nullptr && !micS->isPurged() && micS->hasActiveState())
+					entries.add({ micS.get(), basePreloadSize, 0 });
+			}
+		}
+	}
+
+	const auto budgetIsMet = sizer.calculatePreloadSizes(entries, availableBytes);
+
+	if (!budgetIsMet && !adaptivePreloadUpdater.budgetExceeded)
+		debugError(this, "The adaptive preload sizes don't fit into the memory budget of " + String(sizer.getMemoryBudget() / (1024 * 1024)) + " MB, so they can't cover the streaming latency");
+
+	adaptivePreloadUpdater.budgetExceeded = !budgetIsMet;
+
+	bool somethingChanged = false;
+
+	for (const auto& e : entries)
+	{
+		if (e.newPreloadSize != e.sound->getPreloadSize())
+		{
+			if (!preloadSample(e.sound, e.newPreloadSize))
+				return false;
+
+			somethingChanged = true;
+		}
+	}
+
+	if (somethingChanged)
+		refreshMemoryUsage(true);
+
+	return true;
+}
+
 void ModulatorSampler::setPreloadSize(int newPreloadSize)
 {
 	if (newPreloadSize != 0 && newPreloadSize != preloadSize)
@@ -1242,6 +1393,26 @@ bool ModulatorSampler::soundCanBePlayed(ModulatorSynthSound *sound, int midiChan
 	return true;
 }
 
+int ModulatorSampler::collectSoundsToBeStarted(const HiseEvent& m)
+{
+	jassert(m.isNoteOn());
+
+	if (soundLookupIndex != nullptr)
+	{
+#if JUCE_DEBUG
+		eventForSoundCollection = m;
+#endif
+
+		soundsToBeStarted.clearQuick();
+
+		// The grouped collector only checks the sounds of the current group
+		if (soundLookupIndex->collectSounds(m, soundsToBeStarted, soundCollector != nullptr))
+			return soundsToBeStarted.size();
+	}
+
+	return ModulatorSynth::collectSoundsToBeStarted(m);
+}
+
 void ModulatorSampler::handleRetriggeredNote(ModulatorSynthVoice *voice)
 {
 	jassert(getMainController()->getSampleManager().isNonRealtime() || getMainController()->getKillStateHandler().getCurrentThread() == MainController::KillStateHandler::TargetThread::AudioThread ||
@@ -1341,6 +1512,15 @@ void ModulatorSampler::preHiseEventCallback(HiseEvent &m)
 	}
 }
 
+bool ModulatorSampler::hasSharedVoiceState() const
+{
+	// The voices write the crossfade values and set the voice index of the
+	// envelope filter and the sync voice handler before they use them
+	return crossfadeGroups ||
+		   envelopeFilter != nullptr ||
+		   currentTimestretchOptions.mode == TimestretchOptions::TimestretchMode::TempoSynced;
+}
+
 float* ModulatorSampler::calculateCrossfadeModulationValuesForVoice(int voiceIndex, int startSample, int numSamples, int groupIndex)
 {
 	// If we have set multiple groups to be active manually
@@ -1709,6 +1889,8 @@ void ModulatorSampler::setRRGroupAmount(int newGroupLimit)
 	while (auto sound = sIter.getNextSound())
 		sound->setMaxRRGroupIndex(rrGroupAmount);
 
+	invalidateSoundLookupIndex();
+
 	rrGroupGains.ensureStorageAllocated(rrGroupAmount);
 
 	for (int i = rrGroupGains.size(); i < rrGroupAmount; i++)
@@ -1786,12 +1968,43 @@ bool ModulatorSampler::preloadAllSamples()
 	jassert(sIter.canIterate());
 
 	const int numToLoad = jmax<int>(1, sounds.size() * getNumMicPositions());
-	int currentIndex = 0;
+	std::atomic<int> numLoaded = { 0 };
 
 	auto& progress = getMainController()->getSampleManager().getPreloadProgress();
 
 	auto threadPool = getMainController()->getSampleManager().getGlobalSampleThreadPool();
 
+	// Samples from the same monolith file are sorted by their offset and split into
+	// ranges that are read sequentially by a single thread. This way the threads can
+	// load different parts of a big monolith at the same time without random access.
+	Array<Array<StreamingSamplerSound*>> preloadBatches;
+	Array<Array<StreamingSamplerSound*>> monoliths;
+	HashMap<String, int> monolithIndexes;
+	Array<ModulatorSamplerSound*> soundsToReverse;
+
+	preloadBatches.ensureStorageAllocated(numToLoad);
+
+	auto addToBatch = [&](StreamingSamplerSound* s)
+	{
+		auto monolithFile = s->getMonolithFile();
+
+		if (monolithFile == File())
+		{
+			preloadBatches.add({ s });
+			return;
+		}
+
+		auto key = monolithFile.getFullPathName();
+
+		if (!monolithIndexes.contains(key))
+		{
+			monolithIndexes.set(key, monoliths.size());
+			monoliths.add({});
+		}
+
+		monoliths.getReference(monolithIndexes[key]).add(s);
+	};
+
 	while (auto sound = sIter.getNextSound())
 	{
 		if (threadPool->threadShouldExit())
@@ -1801,12 +2014,8 @@ bool ModulatorSampler::preloadAllSamples()
 
 		if (getNumMicPositions() == 1)
 		{
-			auto s = sound->getReferenceToSound().get();
-
-			progress = (double)currentIndex++ / (double)numToLoad;
-
-			if (!preloadSample(s, preloadSizeToUse))
-				return false;
+			if (auto s = sound->getReferenceToSound().get())
+				addToBatch(s);
 		}
 		else
 		{
@@ -1814,24 +2023,87 @@ bool ModulatorSampler::preloadAllSamples()
 			{
 				const bool isEnabled = getChannelData(j).enabled;
 
-				progress = (double)currentIndex++ / (double)numToLoad;
-
 				if (auto s = sound->getReferenceToSound(j))
 				{
 					if (isEnabled)
-					{
-						if (!preloadSample(s.get(), preloadSizeToUse))
-							return false;
-					}
+						addToBatch(s.get());
 					else
 						s->setPurged(true);
 				}
 			}
 		}
 
-		sound->setReversed(isReversed);
+		soundsToReverse.add(sound.get());
 	}
 
+	struct OffsetSorter
+	{
+		static int compareElements(StreamingSamplerSound* first, StreamingSamplerSound* second)
+		{
+			auto o1 = first->getMonolithOffset();
+			auto o2 = second->getMonolithOffset();
+
+			return o1 < o2 ? -1 : (o1 > o2 ? 1 : 0);
+		}
+	} sorter;
+
+	// Use a few ranges per thread so that the threads are still busy when one range is finished
+	static constexpr int MinNumSamplesPerRange = 8;
+	static constexpr int NumRangesPerThread = 4;
+
+	auto numThreads = getMainController()->getSampleManager().getNumPreloadThreads() + 1;
+
+	// The ranges of a split monolith are decoded with a private reader on each thread, 
+	// otherwise they would wait for the read lock of the shared decoder.
+	Array<File> privateReaderFiles;
+	privateReaderFiles.insertMultiple(0, File(), preloadBatches.size());
+
+	for (auto& m : monoliths)
+	{
+		m.sort(sorter);
+
+		auto numPerRange = jmax(MinNumSamplesPerRange, (m.size() + numThreads * NumRangesPerThread - 1) / (numThreads * NumRangesPerThread));
+		auto privateReaderFile = m.size() > numPerRange ? m.getFirst()->getMonolithFile() : File();
+
+		for (int i = 0; i < m.size(); i += numPerRange)
+		{
+			Array<StreamingSamplerSound*> range;
+			range.addArray(m, i, numPerRange);
+			preloadBatches.add(range);
+			privateReaderFiles.add(privateReaderFile);
+		}
+	}
+
+	auto preloadBatch = [&](int batchIndex)
+	{
+		ScopedPointer<hlac::HlacSubSectionReader::ScopedThreadReader> threadReader;
+
+		if (privateReaderFiles[batchIndex] != File())
+			threadReader = new hlac::HlacSubSectionReader::ScopedThreadReader(privateReaderFiles[batchIndex]);
+
+		for (auto s : preloadBatches.getReference(batchIndex))
+		{
+			if (!preloadSample(s, preloadSizeToUse))
+				return false;
+
+			numLoaded++;
+		}
+
+		return true;
+	};
+
+	// The progress is written by the calling thread only
+	auto updateProgress = [&]()
+	{
+		progress = (double)numLoaded.load() / (double)numToLoad;
+	};
+
+	if (!getMainController()->getSampleManager().runPreloadJobs(preloadBatches.size(), preloadBatch, updateProgress))
+		return false;
+
+	for (auto sound : soundsToReverse)
+		sound->setReversed(isReversed);
+
 	refreshMemoryUsage();
 	setShouldUpdateUI(true);
 	setHasPendingSampleLoad(false);
@@ -1961,4 +2233,222 @@ void ModulatorSampler::GroupedRoundRobinCollector::handleAsyncUpdate()
 	ready.store(true);
 }
 
+ModulatorSampler::SoundLookupIndex::SoundLookupIndex(ModulatorSampler* s) :
+	sampler(s)
+{
+	invalidate();
+}
+
+ModulatorSampler::SoundLookupIndex::~SoundLookupIndex()
+{
+	cancelPendingUpdate();
+	stopTimer();
+}
+
+void ModulatorSampler::SoundLookupIndex::invalidate()
+{
+	version.fetch_add(1);
+	triggerAsyncUpdate();
+}
+
+void ModulatorSampler::SoundLookupIndex::clearTable()
+{
+	// A reader that has checked the version before this holds the read lock,
+	// so the write lock waits until it's done with the sounds
+	version.fetch_add(1);
+
+	ScopedPointer<Table> oldTable;
+
+	{
+		// This might be called on the loading thread while the message thread rebuilds the table
+		SimpleReadWriteLock::ScopedMultiWriteLock sl(tableLock);
+		std::swap(table, oldTable);
+	}
+
+	triggerAsyncUpdate();
+}
+
+bool ModulatorSampler::SoundLookupIndex::collectSounds(const HiseEvent& m, UnorderedStack<ModulatorSynthSound *>& soundsToBeStarted, bool onlyCurrentGroup)
+{
+	SimpleReadWriteLock::ScopedTryReadLock sl(tableLock);
+
+	if (!sl || table == nullptr || table->version != version.load())
+		return false;
+
+	auto s = sampler.get();
+
+	if (s == nullptr)
+		return false;
+
+	const int midiChannel = m.getChannel();
+	const int noteNumber = m.getNoteNumber() + m.getTransposeAmount();
+	const float velocity = m.getFloatVelocity();
+
+	if (!isPositiveAndBelow(noteNumber, 128))
+		return true;
+
+	// use the same conversion as soundCanBePlayed()
+	const auto band = getVelocityBand(jlimit(0, 127, (int)(velocity * 127)));
+
+	auto addSoundsForGroup = [&](int group)
+	{
+		auto cellIndex = Table::getCellIndex(group, noteNumber, band);
+		auto end = table->cellOffsets.getUnchecked(cellIndex + 1);
+
+		for (int i = table->cellOffsets.getUnchecked(cellIndex); i < end; i++)
+		{
+			auto sound = table->soundList.getUnchecked(i);
+
+			if (s->soundCanBePlayed(sound, midiChannel, noteNumber, velocity))
+				soundsToBeStarted.insertWithoutSearch(sound);
+		}
+	};
+
+	if (onlyCurrentGroup || (!s->multiRRGroupState && !s->crossfadeGroups))
+	{
+		auto currentGroup = s->multiRRGroupState.getSingleGroupIndex();
+
+		if (isPositiveAndBelow(currentGroup, table->numGroups))
+			addSoundsForGroup(currentGroup);
+	}
+	else
+	{
+		for (int i = 0; i < table->numGroups; i++)
+			addSoundsForGroup(i);
+	}
+
+	return true;
+}
+
+bool ModulatorSampler::SoundLookupIndex::rebuildIfOutdated()
+{
+	{
+		SimpleReadWriteLock::ScopedReadLock sl(tableLock);
+
+		if (table != nullptr && table->version == version.load())
+			return true;
+	}
+
+	cancelPendingUpdate();
+	stopTimer();
+
+	if (!rebuild())
+	{
+		startTimer(50);
+		return false;
+	}
+
+	SimpleReadWriteLock::ScopedReadLock sl(tableLock);
+	return table != nullptr && table->version == version.load();
+}
+
+void ModulatorSampler::SoundLookupIndex::handleAsyncUpdate()
+{
+	// The sounds are currently modified, so try again later
+	if (!rebuild())
+		startTimer(50);
+}
+
+void ModulatorSampler::SoundLookupIndex::timerCallback()
+{
+	stopTimer();
+	handleAsyncUpdate();
+}
+
+bool ModulatorSampler::SoundLookupIndex::rebuild()
+{
+	if (sampler == nullptr)
+		return true;
+
+	struct Entry
+	{
+		ModulatorSynthSound* sound;
+		int group;
+		Range<int> notes;
+		Range<int> bands;
+	};
+
+	ScopedPointer<Table> newTable = new Table();
+	newTable->version = version.load();
+	newTable->numGroups = 1;
+
+	Array<Entry> entries;
+
+	{
+		ModulatorSampler::SoundIterator it(sampler);
+
+		if (!it.canIterate())
+			return false;
+
+		entries.ensureStorageAllocated(it.size());
+
+		int numIterated = 0;
+
+		while (auto s = it.getNextSound())
+		{
+			numIterated++;
+
+			auto notes = s->getNoteRange().getIntersectionWith({ 0, 128 });
+			auto velocities = s->getVelocityRange().getIntersectionWith({ 0, 128 });
+
+			if (notes.isEmpty() || velocities.isEmpty())
+				continue;
+
+			Entry e;
+			e.sound = s.get();
+			e.group = jmax(0, s->getRRGroup());
+			e.notes = notes;
+			e.bands = { getVelocityBand(velocities.getStart()), getVelocityBand(velocities.getEnd() - 1) + 1 };
+
+			newTable->numGroups = jmax(newTable->numGroups, e.group + 1);
+			entries.add(e);
+		}
+
+		// The iteration was aborted
+		if (numIterated != it.size())
+			return false;
+	}
+
+	auto numCells = Table::getCellIndex(newTable->numGroups, 0, 0);
+
+	newTable->cellOffsets.insertMultiple(0, 0, numCells + 1);
+	auto offsets = newTable->cellOffsets.getRawDataPointer();
+
+	for (const auto& e : entries)
+	{
+		for (int n = e.notes.getStart(); n < e.notes.getEnd(); n++)
+		{
+			for (int b = e.bands.getStart(); b < e.bands.getEnd(); b++)
+				offsets[Table::getCellIndex(e.group, n, b) + 1]++;
+		}
+	}
+
+	for (int i = 0; i < numCells; i++)
+		offsets[i + 1] += offsets[i];
+
+	newTable->soundList.insertMultiple(0, nullptr, offsets[numCells]);
+
+	Array<int> writePositions;
+	writePositions.addArray(newTable->cellOffsets);
+
+	for (const auto& e : entries)
+	{
+		for (int n = e.notes.getStart(); n < e.notes.getEnd(); n++)
+		{
+			for (int b = e.bands.getStart(); b < e.bands.getEnd(); b++)
+			{
+				auto& pos = writePositions.getReference(Table::getCellIndex(e.group, n, b));
+				newTable->soundList.setUnchecked(pos++, e.sound);
+			}
+		}
+	}
+
+	{
+		SimpleReadWriteLock::ScopedMultiWriteLock sl(tableLock);
+		std::swap(table, newTable);
+	}
+
+	return true;
+}
+
 } // namespace hise
@@ -129,6 +129,81 @@ public:
 		Array<ReferenceCountedArray<ModulatorSynthSound>> groups;
 	};
 
+	/** A precalculated lookup table for the sounds that can be started by a note on message.
+
+		It sorts the sounds by their RR group, MIDI note and velocity range, so that collecting the
+		sounds for a note on message only has to check the few sounds in the matching cells instead
+		of the entire samplemap. 
+		
+		The table is rebuilt on the message thread whenever the mapping changes and swapped in
+		atomically. Until the new table is ready, the sounds will be collected by iterating over
+		all sounds like before.
+	*/
+	class SoundLookupIndex : public AsyncUpdater,
+							 public Timer
+	{
+	public:
+
+		/** The amount of velocity ranges that each note is divided into. */
+		static constexpr int NumVelocityBands = 8;
+
+		SoundLookupIndex(ModulatorSampler* s);
+
+		~SoundLookupIndex();
+
+		/** Marks the current table as outdated and triggers an asynchronous rebuild. */
+		void invalidate();
+
+		/** Deletes the current table and triggers an asynchronous rebuild.
+		
+			The table only stores raw pointers to the sounds, so call this before the sounds are deleted.
+		*/
+		void clearTable();
+
+		/** Adds all sounds that can be played by the note on message to the stack.
+		
+			Returns false if there is no up to date table (and nothing was collected).
+		*/
+		bool collectSounds(const HiseEvent& m, UnorderedStack<ModulatorSynthSound *>& soundsToBeStarted, bool onlyCurrentGroup);
+
+		/** Rebuilds the table synchronously if it's outdated. Returns true if there is an up to date table. */
+		bool rebuildIfOutdated();
+
+	private:
+
+		static int getVelocityBand(int velocity) { return velocity * NumVelocityBands / 128; }
+
+		struct Table
+		{
+			static int getCellIndex(int group, int noteNumber, int velocityBand)
+			{
+				return (group * 128 + noteNumber) * NumVelocityBands + velocityBand;
+			}
+
+			// the sounds are only valid as long as this matches the version of the index
+			int version = -1;
+			int numGroups = 0;
+
+			// the start index in soundList for every cell (plus the end index of the last cell)
+			Array<int> cellOffsets;
+			Array<ModulatorSynthSound*> soundList;
+		};
+
+		void handleAsyncUpdate() override;
+
+		void timerCallback() override;
+
+		/** Creates a new table and swaps it in. Returns false if the sounds couldn't be iterated. */
+		bool rebuild();
+
+		WeakReference<ModulatorSampler> sampler;
+
+		std::atomic<int> version = { 0 };
+
+		SimpleReadWriteLock tableLock;
+		ScopedPointer<Table> table;
+	};
+
 	/** A small helper tool that iterates over the sound array in a thread-safe way.
 	*
 	*/
@@ -276,6 +351,7 @@ public:
 		TimestretchMode mode = TimestretchMode::Disabled;
 		double tonality = 0.0;
 		bool skipStart = false;
+		bool background = false; ///< runs the stretcher on the streaming thread (skipStart is ignored then)
 		double numQuarters = 0.0;
 		Identifier engineId;
 
@@ -284,6 +360,7 @@ public:
 			mode = TimestretchMode::Disabled;
 			tonality = 0.0;
 			skipStart = false;
+			background = false;
 			numQuarters = 0.0;
 			engineId = {};
 		}
@@ -295,6 +372,7 @@ public:
 			const DynamicObject::Ptr obj = new DynamicObject();
 			obj->setProperty("Tonality", tonality);
 			obj->setProperty("SkipLatency", skipStart);
+			obj->setProperty("Background", background);
 			obj->setProperty("Mode", modes[static_cast<int>(mode)]);
 			obj->setProperty("NumQuarters", numQuarters);
 			obj->setProperty("PreferredEngine", engineId.toString());
@@ -308,6 +386,7 @@ public:
 
 			tonality = jlimit(0.0, 1.0, static_cast<double>(json.getProperty("Tonality", 0.0)));
 			skipStart = json.getProperty("SkipLatency", false);
+			background = json.getProperty("Background", false);
 			mode = static_cast<TimestretchMode>(modes.indexOf(json.getProperty("Mode", "Disabled").toString()));
 			numQuarters = json.getProperty("NumQuarters", 0.0);
 
@@ -384,6 +463,12 @@ public:
 	*	This is the actual loading process, so it is put into a seperate thread with a progress window. */
 	void refreshPreloadSizes();
 
+	/** Applies the preload sizes calculated by the AdaptivePreloadSizer to all sounds.
+	*
+	*	This reloads the preload buffers of the sounds that need to be resized, so you must only call this with all voices killed.
+	*/
+	bool applyAdaptivePreloadSizes();
+
 	/** Returns the time spent reading samples from disk. */
 	double getDiskUsage();
 
@@ -437,8 +522,17 @@ public:
 	void setShouldUpdateUI(bool shouldUpdate) noexcept{ deactivateUIUpdate = !shouldUpdate; };
 
 	void preStartVoice(int voiceIndex, const HiseEvent& e) override;
+
+	bool supportsParallelVoiceRendering() const override { return true; }
+
+	/** The crossfade groups, the envelope filter and the tempo synced timestretching write to shared state. */
+	bool hasSharedVoiceState() const override;
+
 	void soundsChanged() {};
 	bool soundCanBePlayed(ModulatorSynthSound *sound, int midiChannel, int midiNoteNumber, float velocity) override;;
+
+	/** Uses the sound lookup index to collect the sounds if it's up to date. */
+	int collectSoundsToBeStarted(const HiseEvent& m) override;
 	void handleRetriggeredNote(ModulatorSynthVoice *voice) override;
 
 	/** Overwrites the base class method and ignores the note off event if Parameters::OneShot is enabled. */
@@ -683,9 +777,23 @@ public:
 		return saveString;
 	}
 
-	AudioSampleBuffer* getTemporaryStretchBuffer() { return &stretchBuffer; }
+	/** Returns the stretch buffer for the thread that renders the voice. */
+	AudioSampleBuffer* getTemporaryStretchBuffer()
+	{
+		if (auto wb = workerBuffers[AudioRenderingThreadPool::getCurrentThreadIndex() - 1])
+			return &wb->stretchBuffer;
 
-	hlac::HiseSampleBuffer* getTemporaryVoiceBuffer() { return &temporaryVoiceBuffer; }
+		return &stretchBuffer;
+	}
+
+	/** Returns the voice buffer for the thread that renders the voice. */
+	hlac::HiseSampleBuffer* getTemporaryVoiceBuffer()
+	{
+		if (auto wb = workerBuffers[AudioRenderingThreadPool::getCurrentThreadIndex() - 1])
+			return &wb->voiceBuffer;
+
+		return &temporaryVoiceBuffer;
+	}
 
 	bool checkAndLogIsSoftBypassed(DebugLogger::Location location) const;
 
@@ -709,6 +817,12 @@ public:
 	
 	void setSortByGroup(bool shouldSortByGroup);
 
+	/** Call this whenever the sounds or their mapping changes so that the sound lookup index will be rebuilt. */
+	void invalidateSoundLookupIndex();
+
+	/** Rebuilds the sound lookup index right away if it's outdated. Returns true if the note ons will use the index. */
+	bool rebuildSoundLookupIndexIfOutdated();
+
 	bool shouldDelayUpdate() const noexcept { return delayUpdate; }
 
 	/** Checks the global queue if there are any jobs that will be executed sometime in the future. 
@@ -805,6 +919,31 @@ private:
 		ModulatorSampler *sampler;
 	};
 
+	/** Periodically checks if the preload sizes need to be changed in the adaptive preload mode. 
+	
+		The timer only runs while the adaptive preload sizing is enabled.
+	*/
+	struct AdaptivePreloadUpdater : public Timer,
+									public AdaptivePreloadSizer::Listener
+	{
+	public:
+
+		AdaptivePreloadUpdater(ModulatorSampler *sampler_);
+
+		~AdaptivePreloadUpdater();
+
+		void adaptivePreloadStateChanged(bool isEnabled) override;
+
+		void timerCallback() override;
+
+		/** Set when the memory budget was too small so that the warning is only printed once. */
+		bool budgetExceeded = false;
+
+	private:
+
+		ModulatorSampler *sampler;
+	};
+
 	
     /** Sets the streaming buffer and preload buffer sizes. */
     void setPreloadSize(int newPreloadSize);
@@ -812,6 +951,7 @@ private:
 	CriticalSection exportLock;
 
 	AsyncPurger asyncPurger;
+	AdaptivePreloadUpdater adaptivePreloadUpdater;
 
 	void refreshCrossfadeTables();
 
@@ -916,6 +1056,17 @@ private:
 	hlac::HiseSampleBuffer temporaryVoiceBuffer;
 	AudioSampleBuffer stretchBuffer;
 
+	/** The temporary buffers for the voices that are rendered by a worker of the AudioRenderingThreadPool. */
+	struct WorkerBuffers
+	{
+		WorkerBuffers() : voiceBuffer(DEFAULT_BUFFER_TYPE_IS_FLOAT, 2, 0) {};
+
+		hlac::HiseSampleBuffer voiceBuffer;
+		AudioSampleBuffer stretchBuffer;
+	};
+
+	OwnedArray<WorkerBuffers> workerBuffers;
+
 	bool delayUpdate = false;
 	int lowPassOrder = 0;
 
@@ -926,6 +1077,7 @@ private:
 	int numChannels;
 
 	ScopedPointer<SampleMap> sampleMap;
+	ScopedPointer<SoundLookupIndex> soundLookupIndex;
 	ModulatorChain* sampleStartChain = nullptr;
 	ModulatorChain* crossFadeChain = nullptr;
 	ScopedPointer<AudioThumbnailCache> soundCache;
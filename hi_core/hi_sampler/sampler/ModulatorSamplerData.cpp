@@ -462,6 +462,8 @@ void SampleMap::saveAndReloadMap()
 	auto xml = data.createXml();
 	xml->writeToFile(f, "");
 
+	updateBinaryFile(f);
+
 	auto pool = sampler->getMainController()->getCurrentSampleMapPool();
 	pool->removeListener(this);
 	pool->loadFromReference(getReference(), PoolHelpers::ForceReloadStrong);
@@ -472,6 +474,20 @@ void SampleMap::saveAndReloadMap()
 	changeWatcher = new ChangeWatcher(data);
 }
 
+void SampleMap::updateBinaryFile(const File& xmlFile) const
+{
+	auto binaryFile = xmlFile.withFileExtension(BinarySampleMap::getFileExtension());
+
+	if (binaryFile.existsAsFile())
+	{
+		auto r = BinarySampleMap::writeToFile(data, binaryFile);
+
+		// Don't leave a stale binary file around that would shadow the XML file
+		if (r.failed())
+			binaryFile.deleteFile();
+	}
+}
+
 void SampleMap::valueTreePropertyChanged(ValueTree& treeWhosePropertyHasChanged, const Identifier& property)
 {
 	if (treeWhosePropertyHasChanged == data)
@@ -527,6 +543,7 @@ void SampleMap::addSampleFromValueTree(ValueTree childWhichHasBeenAdded)
 	{
 		LockHelpers::SafeLock sl(sampler->getMainController(), LockHelpers::Type::SampleLock);
 		sampler->addSound(newSound);
+		sampler->invalidateSoundLookupIndex();
 	}
 
 	if (!sampler->shouldPlayFromPurge())
@@ -721,6 +738,8 @@ bool SampleMap::save(const File& fileToUse)
 	auto xml = data.createXml();
 	f.replaceWithText(xml->createDocument(""));
 
+	updateBinaryFile(f);
+
 	PoolReference ref(getSampler()->getMainController(), f.getFullPathName(), FileHandlerBase::SubDirectories::SampleMaps);
 
 	
@@ -1250,7 +1269,8 @@ juce::AudioFormatWriter* MonolithExporter::createWriter(hlac::HiseLosslessAudioF
 
 	hWriter->setOptions(options);
 
-	
+	// The blocks are independent, so we can encode them on all cores
+	hWriter->setNumEncodingThreads(SystemStats::getNumCpus());
 
 	return writer.release();
 }
@@ -234,6 +234,9 @@ public:
 
 	void saveAndReloadMap();
 
+	/** Rewrites the binary samplemap next to the given XML file if there is one. */
+	void updateBinaryFile(const File& xmlFile) const;
+
 	void suspendInternalTimers(bool shouldBeSuspended)
 	{
 		notifier.asyncUpdateCollector.suspend(shouldBeSuspended);
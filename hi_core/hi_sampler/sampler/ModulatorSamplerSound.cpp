@@ -673,6 +673,12 @@ void ModulatorSamplerSound::updateInternalData(const Identifier& id, const var&
 {
 	int newValue = (int)newValueVar;
 
+	if (id == SampleIds::LoKey || id == SampleIds::HiKey || id == SampleIds::LoVel || id == SampleIds::HiVel || id == SampleIds::RRGroup)
+	{
+		if (parentMap != nullptr && parentMap->getSampler() != nullptr)
+			parentMap->getSampler()->invalidateSoundLookupIndex();
+	}
+
 	if (!isAsyncProperty(id))
 	{
 		if (id == SampleIds::Root)
@@ -178,6 +178,9 @@ void ModulatorSamplerVoice::calculateBlock(int startSample, int numSamples)
 
 	wrappedVoice.uptimeDelta = uptimeDelta;
 
+	// The temporary buffers depend on the thread that renders this voice
+	wrappedVoice.setTemporaryVoiceBuffer(owner->getTemporaryVoiceBuffer(), owner->getTemporaryStretchBuffer());
+
 	voiceBuffer.clear();
 
 	
@@ -383,7 +386,8 @@ void ModulatorSamplerVoice::resetVoice()
 {
 	if(sampler->isLastStartedVoice(this))
 	{
-		sampler->resetNoteDisplay(this->getCurrentlyPlayingNote() + getTransposeAmount());
+		noteDisplayToReset = this->getCurrentlyPlayingNote() + getTransposeAmount();
+		resetNoteDisplay = true;
 	}
 	
 	wrappedVoice.resetVoice();
@@ -392,6 +396,17 @@ void ModulatorSamplerVoice::resetVoice()
 
 };
 
+void ModulatorSamplerVoice::resetSharedVoiceState()
+{
+	if (resetNoteDisplay)
+	{
+		resetNoteDisplay = false;
+		sampler->resetNoteDisplay(noteDisplayToReset);
+	}
+
+	ModulatorSynthVoice::resetSharedVoiceState();
+}
+
 
 
 ModulatorSamplerVoice::ModulatorSamplerVoice(ModulatorSynth *ownerSynth) :
@@ -525,6 +540,7 @@ void MultiMicModulatorSamplerVoice::calculateBlock(int startSample, int numSampl
 		wrappedVoices[i]->setPitchValues(voicePitchValues);
 		wrappedVoices[i]->setPitchCounterForThisBlock(pitchCounter);
 		wrappedVoices[i]->uptimeDelta = uptimeDelta * propertyPitch;
+		wrappedVoices[i]->setTemporaryVoiceBuffer(sampler->getTemporaryVoiceBuffer(), sampler->getTemporaryStretchBuffer());
 
 		float *leftChannel = voiceBuffer.getWritePointer(2*i);
 		float *rightChannel = voiceBuffer.getWritePointer(2*i + 1);
@@ -670,7 +686,8 @@ void MultiMicModulatorSamplerVoice::setStreamingBufferDataType(bool shouldBeFloa
 
 void MultiMicModulatorSamplerVoice::resetVoice()
 {
-	sampler->resetNoteDisplay(this->getCurrentlyPlayingNote());
+	noteDisplayToReset = this->getCurrentlyPlayingNote();
+	resetNoteDisplay = true;
 
 	for (int i = 0; i < wrappedVoices.size(); i++)
 	{
@@ -113,6 +113,7 @@ public:
 
 	virtual void setTimestretchOptions(const ModulatorSampler::TimestretchOptions& options)
 	{
+		wrappedVoice.setUseBackgroundTimestretch(options.background);
 		wrappedVoice.setEnableTimestretch((bool)options, options.engineId);
 		wrappedVoice.setSkipLatency(options.skipStart);
 		wrappedVoice.setTimestretchTonality(options.tonality);
@@ -138,11 +139,17 @@ protected:
 		float velocity;
 	};
 
+	/** Resets the note display of the sampler after the voice was rendered. */
+	void resetSharedVoiceState() override;
+
 	ModulatorSamplerSound *currentlyPlayingSamplerSound;
 
 
 	ModulatorSampler *sampler;
 
+	int noteDisplayToReset = 0;
+	bool resetNoteDisplay = false;
+
 
 	float velocityXFadeValue;
 	float sampleStartModValue;
@@ -215,6 +222,7 @@ public:
 	{
 		for (auto v : wrappedVoices)
 		{
+			v->setUseBackgroundTimestretch(options.background);
 			v->setEnableTimestretch(options);
 			v->setSkipLatency(options.skipStart);
 			v->setTimestretchTonality(options.tonality);
@@ -206,7 +206,7 @@ void SampleEditHandler::SampleEditingActions::checkMicPositionAmountBeforePastin
 		}
 		else if (PresetHandler::showYesNoWindow("Different mic amount detected.", "Do you want to replace all existing samples in this sampler?"))
 		{
-			s->clearSounds();
+			s->deleteAllSounds();
 
 			s->setNumChannels(numMics);
 
@@ -1007,6 +1007,12 @@ void SampleMapEditor::getCommandInfo(CommandID commandID, ApplicationCommandInfo
 	case SaveSampleMapAsXml:	result.setInfo("Save as XML", "Save the current SampleMap as XML file", "SampleMap Handling", 0);
 		result.setActive(true);
 		break;
+	case SaveSampleMapAsBinary:	result.setInfo("Save as binary samplemap", "Writes a binary copy of the current SampleMap that will be used for faster loading", "SampleMap Handling", 0);
+		result.setActive(sampler->getSampleMap()->getReference().isValid());
+		break;
+	case ConvertBinarySampleMapToXml:	result.setInfo("Convert binary samplemap to XML", "Restores the XML file from a binary samplemap", "SampleMap Handling", 0);
+		result.setActive(true);
+		break;
 	case RemoveNormalisationInfo: result.setInfo("Remove Normalisation Info", "Resets the normalisation value", "SampleMap Handling", 0);
 		result.setActive(true);
 		break;
@@ -1235,6 +1241,55 @@ bool SampleMapEditor::perform (const InvocationInfo &info)
 			refreshSampleMapPool(); 
 		return true;
 	case DuplicateSampleMapAsReference:	sampler->saveSampleMapAsReference(); refreshSampleMapPool(); return true;
+	case SaveSampleMapAsBinary:
+	{
+		if (sampler->getSampleMap()->hasUnsavedChanges() && !sampler->saveSampleMap())
+			return true;
+
+		auto xmlFile = sampler->getSampleMap()->getReference().getFile();
+		auto binaryFile = xmlFile.withFileExtension(BinarySampleMap::getFileExtension());
+
+		auto r = BinarySampleMap::writeToFile(sampler->getSampleMap()->getValueTree(), binaryFile);
+
+		if (r.failed())
+			PresetHandler::showMessageWindow("Can't write binary samplemap", r.getErrorMessage(), PresetHandler::IconType::Error);
+
+		return true;
+	}
+	case ConvertBinarySampleMapToXml:
+	{
+		auto root = sampler->getSampleEditHandler()->getCurrentSampleMapDirectory();
+
+		FileChooser fc("Convert binary samplemap", root, "*" + BinarySampleMap::getFileExtension(), true);
+
+		if (fc.browseForFileToOpen())
+		{
+			auto binaryFile = fc.getResult();
+			BinarySampleMap bm(binaryFile);
+
+			if (!bm.isValid())
+			{
+				PresetHandler::showMessageWindow("Invalid file", "The file is not a valid binary samplemap", PresetHandler::IconType::Error);
+				return true;
+			}
+
+			auto xmlFile = binaryFile.withFileExtension(".xml");
+
+			if (xmlFile.existsAsFile() && !PresetHandler::showYesNoWindow("Overwrite SampleMap", "Press OK to overwrite " + xmlFile.getFileName()))
+				return true;
+
+			if (auto xml = bm.createValueTree().createXml())
+			{
+				xmlFile.replaceWithText(xml->createDocument(""));
+
+				// Touch the binary file so that it stays the preferred source
+				binaryFile.setLastModificationTime(Time::getCurrentTime());
+				refreshSampleMapPool();
+			}
+		}
+
+		return true;
+	}
 	case ExportAiffWithMetadata:
 		SampleEditHandler::SampleEditingActions::writeSamplesWithAiffData(sampler); return true;
 	case SaveSampleMapAsMonolith:	
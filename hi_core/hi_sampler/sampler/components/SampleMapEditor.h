@@ -140,6 +140,8 @@ public:
 		SaveSampleMap,
 		SaveSampleMapAsXml,
 		SaveSampleMapAsMonolith,
+		SaveSampleMapAsBinary,
+		ConvertBinarySampleMapToXml,
 		DuplicateSampleMapAsReference,
 		RevertSampleMap,
 		ImportSfz,
@@ -190,6 +192,8 @@ public:
 								SaveSampleMap,
 								SaveSampleMapAsXml,
 								SaveSampleMapAsMonolith,
+								SaveSampleMapAsBinary,
+								ConvertBinarySampleMapToXml,
 								DuplicateSampleMapAsReference,
 								RevertSampleMap,
 								ImportSfz,
@@ -549,6 +553,8 @@ public:
 
 		saveAs.addCommandItem(a, SaveSampleMapAsXml);
 		saveAs.addCommandItem(a, SaveSampleMapAsMonolith);
+		saveAs.addCommandItem(a, SaveSampleMapAsBinary);
+		saveAs.addCommandItem(a, ConvertBinarySampleMapToXml);
 		saveAs.addCommandItem(a, DuplicateSampleMapAsReference);
 
 		p.addSubMenu("Save as", saveAs, true);
@@ -161,11 +161,116 @@ double MultithreadedConvolver::getResampleFactor(double sampleRate, double impul
 	}
 }
 
+class MultithreadedConvolver::BackgroundPool::Worker : public Thread
+{
+public:
+
+	Worker(BackgroundPool& parent_, int index) :
+		Thread("Convolution Background Thread " + String(index + 1)),
+		parent(parent_)
+	{}
+
+	void run() override
+	{
+		while (!threadShouldExit())
+		{
+			parent.runPendingJobs(*this);
+			parent.clearConvolversToBeDeleted();
+			parent.jobEvent.wait(500);
+		}
+	}
+
+private:
+
+	BackgroundPool& parent;
+};
+
+MultithreadedConvolver::BackgroundPool::~BackgroundPool()
+{
+	for (auto w : workers)
+		w->signalThreadShouldExit();
+
+	for (auto w : workers)
+	{
+		jobEvent.signal();
+		w->stopThread(1000);
+	}
+
+	workers.clear();
+
+	Job j;
+
+	while (jobs.try_dequeue(j))
+		j = {};
+
+	soonToBeDeleted.clear();
+	jassert(numRegisteredConvolvers == 0);
+}
+
+void MultithreadedConvolver::BackgroundPool::startWorkers()
+{
+	ScopedLock sl(workerLock);
+
+	if (!workers.isEmpty())
+		return;
+
+	auto numWorkers = jlimit(1, MaxNumWorkers, SystemStats::getNumCpus() - 1);
+
+	for (int i = 0; i < numWorkers; i++)
+		workers.add(new Worker(*this, i))->startThread(10);
+}
+
+bool MultithreadedConvolver::BackgroundPool::addConvolverJob(MultithreadedConvolver::Ptr c, int stageIndex)
+{
+	if (jobs.try_enqueue({ c, stageIndex }))
+	{
+		jobEvent.signal();
+		return true;
+	}
+
+	return false;
+}
+
+void MultithreadedConvolver::BackgroundPool::addConvolverToBeDeleted(MultithreadedConvolver::Ptr c)
+{
+	SpinLock::ScopedLockType sl(deleteLock);
+	soonToBeDeleted.add(c);
+}
+
+void MultithreadedConvolver::BackgroundPool::runPendingJobs(Thread& worker)
+{
+	Job j;
+
+	while (!worker.threadShouldExit() && jobs.try_dequeue(j))
+	{
+		// wake up another worker so that the remaining stages are processed in parallel
+		if (jobs.size_approx() > 0)
+			jobEvent.signal();
+
+		// if the audio thread has already processed this stage, this will do nothing
+		j.convolver->processQueuedStage(j.stageIndex, true);
+		j = {};
+	}
+}
+
+void MultithreadedConvolver::BackgroundPool::clearConvolversToBeDeleted()
+{
+	ReferenceCountedArray<MultithreadedConvolver> copy;
+
+	if (!soonToBeDeleted.isEmpty())
+	{
+		SpinLock::ScopedLockType sl(deleteLock);
+		copy.swapWith(soonToBeDeleted);
+	}
+
+	copy.clear();
+}
+
 MultithreadedConvolver::Ptr ConvolutionEffectBase::createNewEngine(audiofft::ImplementationType fftType)
 {
     MultithreadedConvolver::Ptr newConvolver = new MultithreadedConvolver(fftType);
 	newConvolver->reset();
-	newConvolver->setUseBackgroundThread(useBackgroundThread ? &backgroundThread : nullptr, true);
+	newConvolver->setUseBackgroundThread(useBackgroundThread ? &backgroundPool.get() : nullptr, true);
 
 	return newConvolver;
 }
@@ -486,8 +591,8 @@ void ConvolutionEffectBase::processBase(ProcessDataDyn& d)
                 
                 if(fadeValue >= 1.0f)
                 {
-                    backgroundThread.addConvolverToBeDeleted(fadeOutConvolverL);
-                    backgroundThread.addConvolverToBeDeleted(fadeOutConvolverR);
+                    backgroundPool->addConvolverToBeDeleted(fadeOutConvolverL);
+                    backgroundPool->addConvolverToBeDeleted(fadeOutConvolverR);
                     
                     fadeOutConvolverL = nullptr;
                     fadeOutConvolverR = nullptr;
@@ -574,9 +679,6 @@ bool ConvolutionEffectBase::reloadInternal()
 		getImpulseBufferBase().getBuffer().getNumChannels() == 0|| 
 		getImpulseBufferBase().getBuffer().getNumSamples() == 0 )
 	{
-		while(backgroundThread.isBusy())
-            Thread::getCurrentThread()->wait(10);
-
 		SimpleReadWriteLock::ScopedMultiWriteLock sl(swapLock);
 
 		convolverL->reset();
@@ -613,7 +715,6 @@ bool ConvolutionEffectBase::reloadInternal()
 		applyHighFrequencyDamping(scratchBuffer, resampledLength, cutoffFrequency, sampleRate);
 
 	headSize = nextPowerOfTwo(headSize);
-	const auto fullTailLength = jmax(headSize, nextPowerOfTwo(resampledLength - headSize));
 
 	MultithreadedConvolver::Ptr s1, s2;
 
@@ -633,8 +734,8 @@ bool ConvolutionEffectBase::reloadInternal()
 
 	s1 = createNewEngine(currentType);
 	s2 = createNewEngine(currentType);
-	s1->init(headSize, jmin<int>(8192, fullTailLength), scratchBuffer.getReadPointer(0), resampledLength);
-	s2->init(headSize, jmin<int>(8192, fullTailLength), scratchBuffer.getReadPointer(1), resampledLength);
+	s1->init(headSize, scratchBuffer.getReadPointer(0), resampledLength);
+	s2->init(headSize, scratchBuffer.getReadPointer(1), resampledLength);
 
     s1->cleanPipeline();
     s2->cleanPipeline();
@@ -649,14 +750,6 @@ bool ConvolutionEffectBase::reloadInternal()
     
     
 	{
-		while (backgroundThread.isBusy())
-		{
-			auto currentThread = Thread::getCurrentThread();
-			
-			if(currentThread != nullptr)
-				currentThread->wait(10);
-		}
-
 		SimpleReadWriteLock::ScopedMultiWriteLock sl(swapLock);
         
         std::swap(fadeOutConvolverL, convolverL);
@@ -666,8 +759,8 @@ bool ConvolutionEffectBase::reloadInternal()
         
         if(convolverL != nullptr)
         {
-            backgroundThread.addConvolverToBeDeleted(convolverL);
-            backgroundThread.addConvolverToBeDeleted(convolverR);
+            backgroundPool->addConvolverToBeDeleted(convolverL);
+            backgroundPool->addConvolverToBeDeleted(convolverR);
         }
         
         convolverL = s1;
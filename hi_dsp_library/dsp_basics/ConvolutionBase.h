@@ -106,157 +106,194 @@ private:
 	Smoother smoother;
 };
 
-class MultithreadedConvolver : public fftconvolver::TwoStageFFTConvolver,
+class MultithreadedConvolver : public fftconvolver::MultiStageFFTConvolver,
                                public ReferenceCountedObject
 {
 public:
     
     using Ptr = ReferenceCountedObjectPtr<MultithreadedConvolver>;
     
-	class BackgroundThread : public Thread
+	/** A pool of worker threads that calculates the background stages of all convolvers.
+
+		It is shared between all convolution effects, so that the stages of multiple long
+		impulse responses are spread across multiple cores. If a stage hasn't been picked
+		up by a worker when its result is needed, the audio thread will calculate it.
+	*/
+	class BackgroundPool
 	{
 	public:
 
-		BackgroundThread() :
-          Thread("Convolution Background Thread"),
-          queue(512)
-		{}
+		static constexpr int MaxNumWorkers = 4;
 
-        ~BackgroundThread()
-        {
-            soonToBeDeleted.clear();
-            jassert(numRegisteredConvolvers == 0);
-            
-            stopThread(1000);
-            queue.callForEveryElementInQueue({});
-            
-        }
-        
-		void run() override
+		BackgroundPool() = default;
+		~BackgroundPool();
+
+		/** Starts the worker threads if they are not running yet. */
+		void startWorkers();
+
+		/** Adds the stage of the convolver to the job queue. Returns false if the job couldn't be added. */
+		bool addConvolverJob(MultithreadedConvolver::Ptr c, int stageIndex);
+
+		/** Adds the convolver to a list that will be cleared on the next run of a worker thread. */
+		void addConvolverToBeDeleted(MultithreadedConvolver::Ptr c);
+
+		int getNumWorkers() const { return workers.size(); }
+
+		std::atomic<int> numRegisteredConvolvers = { 0 };
+
+	private:
+
+		class Worker;
+
+		struct Job
 		{
-			while (!threadShouldExit())
-			{
-                {
-                    ScopedValueSetter<bool> svs(currentlyRendering, true);
-                    
-                    queue.callForEveryElementInQueue([this](MultithreadedConvolver::Ptr c)
-                    {
-                        if (threadShouldExit())
-                            return false;
-                        
-                        c->doBackgroundProcessing();
-                        c->pending.store(false);
-                        
-                        return true;
-                    });
-                }
-                
-                ReferenceCountedArray<MultithreadedConvolver> copy;
-                
-                if(!soonToBeDeleted.isEmpty())
-                {
-                    SpinLock::ScopedLockType sl(deleteLock);
-                    copy.swapWith(soonToBeDeleted);
-                }
-                
-                copy.clear();
-                
-				wait(500);
-			}
+			MultithreadedConvolver::Ptr convolver;
+			int stageIndex = -1;
 		};
 
-        void addConvolverJob(MultithreadedConvolver::Ptr c)
-        {
-            queue.push(c);
-            notify();
-        }
-        
-        void addConvolverToBeDeleted(MultithreadedConvolver::Ptr c)
-        {
-            SpinLock::ScopedLockType sl(deleteLock);
-            soonToBeDeleted.add(c);
-        }
-        
-		bool isBusy() const { return currentlyRendering; }
-		bool currentlyRendering = false;
-		
-        int numRegisteredConvolvers = 0;
-        
-        hise::LockfreeQueue<MultithreadedConvolver::Ptr> queue;
-        
-        SpinLock deleteLock;
-        
-        ReferenceCountedArray<MultithreadedConvolver> soonToBeDeleted;
-	};
+		void runPendingJobs(Thread& worker);
+		void clearConvolversToBeDeleted();
 
+		moodycamel::ConcurrentQueue<Job> jobs = moodycamel::ConcurrentQueue<Job>(512);
+		WaitableEvent jobEvent;
 
-public:
+		CriticalSection workerLock;
+		OwnedArray<Worker> workers;
+
+		SpinLock deleteLock;
+		ReferenceCountedArray<MultithreadedConvolver> soonToBeDeleted;
+
+		JUCE_DECLARE_NON_COPYABLE(BackgroundPool);
+	};
+
+	/** The maximum number of stages that can be calculated on the background pool. */
+	static constexpr int MaxNumStages = 16;
 
 	MultithreadedConvolver(audiofft::ImplementationType fftType) :
-		TwoStageFFTConvolver(fftType),
-		backgroundThread(nullptr)
-	{};
+		MultiStageFFTConvolver(fftType)
+	{
+		for (auto& s : stageStates)
+			s.store(StageState::Idle);
+	};
 
 	virtual ~MultithreadedConvolver()
 	{
-        jassert(!pending);
-        
-        if(backgroundThread != nullptr)
-            backgroundThread->numRegisteredConvolvers--;
+#if JUCE_DEBUG
+		for (auto& s : stageStates)
+			jassert(s.load() == StageState::Idle);
+#endif
+
+        if(auto p = backgroundPool.load())
+            p->numRegisteredConvolvers--;
 	};
 
-	void startBackgroundProcessing() override
+	void startBackgroundProcessing(size_t stageIndex) override
 	{
-        pending.store(true);
-        
-		if (backgroundThread != nullptr)
+		jassert(isPositiveAndBelow(stageIndex, (size_t)MaxNumStages));
+
+		auto p = backgroundPool.load();
+
+		if (p != nullptr && isPositiveAndBelow(stageIndex, (size_t)MaxNumStages))
 		{
-            backgroundThread->addConvolverJob(this);
+			stageStates[stageIndex].store(StageState::Queued);
+
+			if (p->addConvolverJob(this, (int)stageIndex))
+				return;
+
+			// The queue is full, so it will be calculated on this thread. A stale job from the last
+			// time this stage was queued might have picked it up already, in this case it's calculated
+			// there and waitForBackgroundProcessing() will wait for it.
+			processQueuedStage((int)stageIndex);
+			return;
 		}
-		else
+
+		doBackgroundProcessing(stageIndex);
+	}
+
+	void waitForBackgroundProcessing(size_t stageIndex) override
+	{
+		if (!isPositiveAndBelow(stageIndex, (size_t)MaxNumStages))
+			return;
+
+		// If no worker has picked up the stage yet, the calling thread will calculate it
+		processQueuedStage((int)stageIndex);
+
+		// A worker is calculating the stage right now. Spin for a short time (it's most likely almost
+		// done) and then block until the worker signals the end so that we don't keep a core busy
+		// while the worker thread is preempted.
+		for (int i = 0; stageStates[stageIndex].load() == StageState::Running; i++)
 		{
-			doBackgroundProcessing();
-            pending.store(false);
+			if (i >= NumSpinIterations)
+				stageFinished.wait(1);
 		}
 	}
 
-	void waitForBackgroundProcessing() override
+	/** Calculates the stage if it is queued and not processed by another thread. Returns true if it was processed. 
+	
+		If signalWaitingThread is true, this will wake up the thread that is waiting for the result in waitForBackgroundProcessing().
+	*/
+	bool processQueuedStage(int stageIndex, bool signalWaitingThread=false)
 	{
-        while (pending.load())
-            jassertfalse;
+		int expected = StageState::Queued;
+
+		if (stageStates[stageIndex].compare_exchange_strong(expected, StageState::Running))
+		{
+			doBackgroundProcessing((size_t)stageIndex);
+			stageStates[stageIndex].store(StageState::Idle);
+
+			if (signalWaitingThread)
+				stageFinished.signal();
+
+			return true;
+		}
+
+		return false;
 	}
 
 	static bool prepareImpulseResponse(const AudioSampleBuffer& originalBuffer, AudioSampleBuffer& buffer, bool* abortFlag, Range<int> range, double resampleRatio);
 
 	static double getResampleFactor(double sampleRate, double impulseSampleRate);
 
-	void setUseBackgroundThread(BackgroundThread* newThreadToUse, bool forceUpdate = false)
+	void setUseBackgroundThread(BackgroundPool* newPoolToUse, bool forceUpdate = false)
 	{
-		if (backgroundThread != newThreadToUse || forceUpdate)
+		auto currentPool = backgroundPool.load();
+
+		if (currentPool != newPoolToUse || forceUpdate)
         {
-            if(backgroundThread != nullptr)
-                backgroundThread->numRegisteredConvolvers--;
+            if(currentPool != nullptr)
+                currentPool->numRegisteredConvolvers--;
             
-            backgroundThread = newThreadToUse;
+            backgroundPool.store(newPoolToUse);
             
-            if(backgroundThread != nullptr)
-                backgroundThread->numRegisteredConvolvers++;
-            
-            if (backgroundThread != nullptr && !backgroundThread->isThreadRunning())
-                backgroundThread->startThread(10);
+            if(newPoolToUse != nullptr)
+            {
+                newPoolToUse->numRegisteredConvolvers++;
+                newPoolToUse->startWorkers();
+            }
         }
 	}
 
 	bool isUsingBackgroundThread() const
 	{
-		return backgroundThread != nullptr;
+		return backgroundPool.load() != nullptr;
 	}
 
 private:
 
-    std::atomic<bool> pending = { false };
+	enum StageState
+	{
+		Idle = 0,
+		Queued,
+		Running
+	};
+
+    /** The amount of spin iterations before the waiting thread blocks on the event. */
+    static constexpr int NumSpinIterations = 2000;
+
+    std::atomic<int> stageStates[MaxNumStages];
+    WaitableEvent stageFinished;
     
-    BackgroundThread* backgroundThread = nullptr;
+    std::atomic<BackgroundPool*> backgroundPool = { nullptr };
 };
 
 struct ConvolutionEffectBase : public AsyncUpdater,
@@ -278,7 +315,7 @@ struct ConvolutionEffectBase : public AsyncUpdater,
 
 		SimpleReadWriteLock::ScopedReadLock sl(swapLock);
         
-        auto tToUse = !nonRealtime && useBackgroundThread ? &backgroundThread : nullptr;
+        auto tToUse = !nonRealtime && useBackgroundThread ? &backgroundPool.get() : nullptr;
         
         convolverL->setUseBackgroundThread(tToUse);
 		convolverR->setUseBackgroundThread(tToUse);
@@ -289,7 +326,7 @@ struct ConvolutionEffectBase : public AsyncUpdater,
 
 protected:
 
-    MultithreadedConvolver::BackgroundThread backgroundThread;
+    SharedResourcePointer<MultithreadedConvolver::BackgroundPool> backgroundPool;
     
 	void resetBase();
 
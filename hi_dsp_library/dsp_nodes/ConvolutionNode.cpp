@@ -76,7 +76,7 @@ void convolution::setMultithread(double shouldBeMultithreaded)
 	{
 		SimpleReadWriteLock::ScopedWriteLock sl(swapLock);
         
-        auto tToUse = useBackgroundThread && !nonRealtime ? &backgroundThread : nullptr;
+        auto tToUse = useBackgroundThread && !nonRealtime ? &backgroundPool.get() : nullptr;
         
 		convolverL->setUseBackgroundThread(tToUse);
 		convolverR->setUseBackgroundThread(tToUse);
@@ -0,0 +1,261 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which also must be licenced for commercial applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+
+#include "MultiStageFFTConvolver.h"
+
+#include <algorithm>
+#include <cmath>
+
+
+namespace fftconvolver
+{
+
+MultiStageFFTConvolver::Stage::Stage(audiofft::ImplementationType fftType) :
+  blockSize(0),
+  convolver(fftType),
+  input(),
+  inputFill(0),
+  backgroundInput(),
+  output(),
+  precalculated(),
+  precalculatedPos(0)
+{
+}
+
+
+MultiStageFFTConvolver::MultiStageFFTConvolver(audiofft::ImplementationType fftType) :
+  _fftType(fftType),
+  _headBlockSize(0),
+  _headConvolver(fftType),
+  _stages()
+{
+}
+
+
+MultiStageFFTConvolver::~MultiStageFFTConvolver()
+{
+  reset();
+}
+
+
+std::vector<size_t> MultiStageFFTConvolver::getDefaultBlockSizes(size_t headBlockSize, size_t irLen, size_t maxBlockSize)
+{
+  std::vector<size_t> blockSizes;
+  blockSizes.push_back(NextPowerOf2(jmax(size_t(1), headBlockSize)));
+
+  for (;;)
+  {
+    const size_t lastBlockSize = blockSizes.back();
+    const size_t blockSize = jmin(lastBlockSize * StageRatio, NextPowerOf2(maxBlockSize));
+
+    // Stop if the maximum block size is reached or if the stage would start after the end of the impulse response
+    if (blockSize <= lastBlockSize || 2 * blockSize >= irLen)
+    {
+      break;
+    }
+
+    blockSizes.push_back(blockSize);
+  }
+
+  return blockSizes;
+}
+
+
+void MultiStageFFTConvolver::reset()
+{
+  for (size_t i=0; i<_stages.size(); ++i)
+  {
+    waitForBackgroundProcessing(i);
+  }
+
+  _headBlockSize = 0;
+  _headConvolver.reset();
+  _stages.clear();
+}
+
+
+void MultiStageFFTConvolver::cleanPipeline()
+{
+  for (size_t i=0; i<_stages.size(); ++i)
+  {
+    // Make sure that the background processing doesn't write into the buffers that are cleared here
+    waitForBackgroundProcessing(i);
+
+    Stage& s = *_stages[i];
+    s.convolver.resetInput();
+    s.input.setZero();
+    s.backgroundInput.setZero();
+    s.output.setZero();
+    s.precalculated.setZero();
+    s.inputFill = 0;
+    s.precalculatedPos = 0;
+  }
+
+  _headConvolver.resetInput();
+}
+
+
+bool MultiStageFFTConvolver::init(size_t headBlockSize, const Sample* ir, size_t irLen)
+{
+  return init(getDefaultBlockSizes(headBlockSize, irLen), ir, irLen);
+}
+
+
+bool MultiStageFFTConvolver::init(const std::vector<size_t>& blockSizes, const Sample* ir, size_t irLen)
+{
+  reset();
+
+  if (blockSizes.empty() || blockSizes[0] == 0)
+  {
+    return false;
+  }
+
+  // Ignore zeros at the end of the impulse response because they only waste computation time
+  while (irLen > 0 && ::fabs(ir[irLen-1]) < 0.000001f)
+  {
+    --irLen;
+  }
+
+  if (irLen == 0)
+  {
+    return true;
+  }
+
+  _headBlockSize = NextPowerOf2(blockSizes[0]);
+
+  std::vector<size_t> stageBlockSizes;
+  size_t lastBlockSize = _headBlockSize;
+
+  for (size_t i=1; i<blockSizes.size(); ++i)
+  {
+    // The block sizes must grow so that every stage starts after the previous one
+    const size_t minBlockSize = stageBlockSizes.empty() ? lastBlockSize : 2 * lastBlockSize;
+    const size_t blockSize = jmax(NextPowerOf2(blockSizes[i]), minBlockSize);
+
+    if (2 * blockSize >= irLen)
+    {
+      break;
+    }
+
+    stageBlockSizes.push_back(blockSize);
+    lastBlockSize = blockSize;
+  }
+
+  const size_t headIrLen = stageBlockSizes.empty() ? irLen : 2 * stageBlockSizes[0];
+  _headConvolver.init(_headBlockSize, ir, headIrLen);
+
+  for (size_t i=0; i<stageBlockSizes.size(); ++i)
+  {
+    const size_t blockSize = stageBlockSizes[i];
+    const size_t irBegin = 2 * blockSize;
+    const size_t irEnd = (i+1 < stageBlockSizes.size()) ? 2 * stageBlockSizes[i+1] : irLen;
+
+    std::unique_ptr<Stage> s(new Stage(_fftType));
+    s->blockSize = blockSize;
+    s->convolver.init(blockSize, ir+irBegin, irEnd-irBegin);
+    s->input.resize(blockSize);
+    s->backgroundInput.resize(blockSize);
+    s->output.resize(blockSize);
+    s->precalculated.resize(blockSize);
+    _stages.push_back(std::move(s));
+  }
+
+  return true;
+}
+
+
+void MultiStageFFTConvolver::process(const Sample* input, Sample* output, size_t len)
+{
+  // Head
+  _headConvolver.process(input, output, len);
+
+  if (_stages.empty())
+  {
+    return;
+  }
+
+  // Stages. The block sizes are multiples of the first stage, so a chunk that ends
+  // at the block boundary of the first stage never crosses the boundary of another stage.
+  size_t processed = 0;
+  while (processed < len)
+  {
+    const size_t processing = jmin(len - processed, _stages[0]->blockSize - _stages[0]->inputFill);
+
+    for (size_t i=0; i<_stages.size(); ++i)
+    {
+      Stage& s = *_stages[i];
+
+      // Sum the result of the previous block
+      FloatVectorOperations::add(output+processed, s.precalculated.data()+s.precalculatedPos, (int)processing);
+      s.precalculatedPos += processing;
+
+      // Fill the input buffer
+      ::memcpy(s.input.data()+s.inputFill, input+processed, processing * sizeof(Sample));
+      s.inputFill += processing;
+      assert(s.inputFill <= s.blockSize);
+
+      if (s.inputFill == s.blockSize)
+      {
+        waitForBackgroundProcessing(i);
+        SampleBuffer::Swap(s.precalculated, s.output);
+        s.backgroundInput.copyFrom(s.input);
+        startBackgroundProcessing(i);
+
+        s.inputFill = 0;
+        s.precalculatedPos = 0;
+      }
+    }
+
+    processed += processing;
+  }
+}
+
+
+void MultiStageFFTConvolver::startBackgroundProcessing(size_t stageIndex)
+{
+  doBackgroundProcessing(stageIndex);
+}
+
+
+void MultiStageFFTConvolver::waitForBackgroundProcessing(size_t)
+{
+}
+
+
+void MultiStageFFTConvolver::doBackgroundProcessing(size_t stageIndex)
+{
+  Stage& s = *_stages[stageIndex];
+  s.convolver.process(s.backgroundInput.data(), s.output.data(), s.blockSize);
+}
+
+} // End of namespace fftconvolver
@@ -0,0 +1,181 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which also must be licenced for commercial applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+#ifndef _FFTCONVOLVER_MULTISTAGEFFTCONVOLVER_H
+#define _FFTCONVOLVER_MULTISTAGEFFTCONVOLVER_H
+
+#include "FFTConvolver.h"
+#include "Utilities.h"
+
+#include <memory>
+#include <vector>
+
+
+namespace fftconvolver
+{
+
+/**
+* @class MultiStageFFTConvolver
+* @brief FFT convolver using a non-uniform partition with an arbitrary amount of stages
+*
+* This is a generalisation of the TwoStageFFTConvolver:
+*
+* - The head convolver processes the begin of the impulse response with the smallest
+*   block size directly in the process() call.
+*
+* - Every following stage processes a segment of the impulse response with a bigger block
+*   size. A stage with the block size N covers the impulse response starting at 2 * N, so
+*   its convolution can be calculated during the next N samples (eg. on a background thread)
+*   and will be ready when it's needed.
+*
+* The block sizes should be powers of two that grow with every stage. Small block sizes keep
+* the latency and the work per process() call small, big block sizes are much cheaper for
+* the long tail of the impulse response, so getDefaultBlockSizes() uses the smallest
+* possible head size and multiplies it by 4 for each stage.
+*
+* The stages are independent from each other, so their background processing can be
+* executed in parallel.
+*/
+class MultiStageFFTConvolver
+{
+public:
+
+  /** The block size ratio between two neighbouring stages that is used by getDefaultBlockSizes(). */
+  static constexpr size_t StageRatio = 4;
+
+  /** The default maximum block size for the last stage. */
+  static constexpr size_t DefaultMaxBlockSize = 16384;
+
+  MultiStageFFTConvolver(audiofft::ImplementationType fftType);
+  virtual ~MultiStageFFTConvolver();
+
+  /**
+  * @brief Calculates the block sizes of the stages for the given impulse response length
+  * @param headBlockSize The block size of the head (usually the host buffer size)
+  * @param irLen Length of the impulse response in samples
+  * @param maxBlockSize The maximum block size of the last stage
+  * @return The block sizes starting with the head block size
+  */
+  static std::vector<size_t> getDefaultBlockSizes(size_t headBlockSize, size_t irLen, size_t maxBlockSize=DefaultMaxBlockSize);
+
+  /**
+  * @brief Initializes the convolver with the default block sizes for the impulse response
+  * @param headBlockSize The head block size
+  * @param ir The impulse response
+  * @param irLen Length of the impulse response in samples
+  * @return true: Success - false: Failed
+  */
+  bool init(size_t headBlockSize, const Sample* ir, size_t irLen);
+
+  /**
+  * @brief Initializes the convolver with the given block sizes
+  * @param blockSizes The block sizes of the head and every following stage
+  * @param ir The impulse response
+  * @param irLen Length of the impulse response in samples
+  * @return true: Success - false: Failed
+  */
+  bool init(const std::vector<size_t>& blockSizes, const Sample* ir, size_t irLen);
+
+  /**
+  * @brief Convolves the the given input samples and immediately outputs the result
+  * @param input The input samples
+  * @param output The convolution result
+  * @param len Number of input/output samples
+  */
+  void process(const Sample* input, Sample* output, size_t len);
+
+  /**
+  * @brief Resets the convolver and discards the set impulse response
+  */
+  void reset();
+
+  /** Clears the internal buffers so that it resets the convolution pipeline. */
+  void cleanPipeline();
+
+  /** Returns the number of stages that are processed with startBackgroundProcessing(). */
+  size_t getNumBackgroundStages() const { return _stages.size(); }
+
+  /** Returns the block size of the given background stage. */
+  size_t getBlockSize(size_t stageIndex) const { return _stages[stageIndex]->blockSize; }
+
+protected:
+
+  /**
+  * @brief Method called by the convolver if work for the given stage is available
+  *
+  * The default implementation just calls doBackgroundProcessing(). The result must be
+  * available when waitForBackgroundProcessing() returns for this stage, which will happen
+  * after the next getBlockSize(stageIndex) samples.
+  */
+  virtual void startBackgroundProcessing(size_t stageIndex);
+
+  /**
+  * @brief Called by the convolver if it expects the result of the previous call to startBackgroundProcessing()
+  *
+  * After returning from this method, the background processing of the stage has to be completed.
+  */
+  virtual void waitForBackgroundProcessing(size_t stageIndex);
+
+  /**
+  * @brief Actually performs the background processing work of the given stage
+  */
+  void doBackgroundProcessing(size_t stageIndex);
+
+private:
+
+  struct Stage
+  {
+    Stage(audiofft::ImplementationType fftType);
+
+    size_t blockSize;
+    FFTConvolver convolver;
+    SampleBuffer input;
+    size_t inputFill;
+    SampleBuffer backgroundInput;
+    SampleBuffer output;
+    SampleBuffer precalculated;
+    size_t precalculatedPos;
+  };
+
+  audiofft::ImplementationType _fftType;
+  size_t _headBlockSize;
+  FFTConvolver _headConvolver;
+  std::vector<std::unique_ptr<Stage>> _stages;
+
+  // Prevent uncontrolled usage
+  MultiStageFFTConvolver(const MultiStageFFTConvolver&);
+  MultiStageFFTConvolver& operator=(const MultiStageFFTConvolver&);
+};
+
+} // End of namespace fftconvolver
+
+#endif // Header guard
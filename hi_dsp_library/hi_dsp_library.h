@@ -159,6 +159,7 @@ Set this to 1 if you want to embed the libraries created with this module into y
 #include "fft_convolver/AudioFFT.h"
 #include "fft_convolver/FFTConvolver.h"
 #include "fft_convolver/TwoStageFFTConvolver.h"
+#include "fft_convolver/MultiStageFFTConvolver.h"
 #include "dsp_basics/ConvolutionBase.h"
 
 #include "node_api/helpers/Error.h"
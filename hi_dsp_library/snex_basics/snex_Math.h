@@ -114,6 +114,12 @@ return b1; \
         vOpScalar(vmuls, FloatVectorOperations::multiply);
 		vOpScalar(vadds, FloatVectorOperations::add);
 		vOpScalar(vmovs, FloatVectorOperations::fill);
+
+		static forcedinline block& vsubs(block& b1, float s)
+		{
+			FloatVectorOperations::add(b1.data, -s, b1.size());
+			return b1;
+		}
         
         static forcedinline block& vclip(block& b1, float s1, float s2)
         {
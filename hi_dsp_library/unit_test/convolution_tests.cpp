@@ -0,0 +1,164 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licencing:
+*
+*   http://www.hartinstruments.net/hise/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+namespace hise
+{
+
+namespace tests
+{
+
+using namespace juce;
+
+/** Compares the non-uniform partitioned convolution against a direct convolution. */
+class ConvolutionTests : public UnitTest
+{
+public:
+
+	ConvolutionTests() :
+		UnitTest("Testing MultiStageFFTConvolver", "dsp")
+	{}
+
+	void runTest() override
+	{
+		for (auto irLength : { 1, 37, 1000, 5000, 40000 })
+		{
+			for (auto blockSize : { 64, 256, 512 })
+			{
+				testConvolver(irLength, blockSize, false, false);
+				testConvolver(irLength, blockSize, true, false);
+			}
+
+			testConvolver(irLength, 128, true, true);
+		}
+	}
+
+private:
+
+	void testConvolver(int irLength, int blockSize, bool useVariableBlockSize, bool useBackgroundPool)
+	{
+		String name;
+		name << "IR length: " << String(irLength) << ", block size: " << String(blockSize);
+
+		if (useVariableBlockSize)
+			name << " (variable)";
+
+		if (useBackgroundPool)
+			name << " with background pool";
+
+		beginTest(name);
+
+		Random r(irLength * 1000 + blockSize);
+
+		std::vector<float> ir((size_t)irLength);
+
+		for (auto& s : ir)
+			s = r.nextFloat() * 2.0f - 1.0f;
+
+		// A noise burst at the start and a few single impulses so that every stage is hit
+		const int signalLength = 3 * irLength + 8192;
+		std::vector<float> input((size_t)signalLength, 0.0f);
+
+		for (int i = 0; i < 2048; i++)
+			input[(size_t)i] = r.nextFloat() * 2.0f - 1.0f;
+
+		for (int i = 0; i < 8; i++)
+			input[(size_t)r.nextInt(signalLength)] = 1.0f;
+
+		std::vector<float> expected((size_t)signalLength, 0.0f);
+
+		for (int i = 0; i < signalLength; i++)
+		{
+			if (input[(size_t)i] == 0.0f)
+				continue;
+
+			const int numToAdd = jmin(irLength, signalLength - i);
+
+			for (int j = 0; j < numToAdd; j++)
+				expected[(size_t)(i + j)] += input[(size_t)i] * ir[(size_t)j];
+		}
+
+		std::vector<float> actual((size_t)signalLength, 0.0f);
+
+		MultithreadedConvolver::BackgroundPool pool;
+
+		{
+			MultithreadedConvolver::Ptr c = new MultithreadedConvolver(audiofft::ImplementationType::BestAvailable);
+
+			if (useBackgroundPool)
+				c->setUseBackgroundThread(&pool);
+
+			expect(c->init((size_t)blockSize, ir.data(), ir.size()), "init failed");
+
+			// The first stage starts at twice its block size
+			if (irLength > 2 * (int)MultithreadedConvolver::StageRatio * blockSize)
+				expect(c->getNumBackgroundStages() > 0, "No background stages");
+
+			for (int pos = 0; pos < signalLength;)
+			{
+				auto numThisTime = useVariableBlockSize ? 1 + r.nextInt(blockSize) : blockSize;
+				numThisTime = jmin(numThisTime, signalLength - pos);
+
+				c->process(input.data() + pos, actual.data() + pos, (size_t)numThisTime);
+				pos += numThisTime;
+			}
+
+			c->setUseBackgroundThread(nullptr);
+			c->reset();
+		}
+
+		float peak = 0.0f;
+		float maxError = 0.0f;
+		int errorIndex = -1;
+
+		for (int i = 0; i < signalLength; i++)
+		{
+			auto e = std::abs(expected[(size_t)i] - actual[(size_t)i]);
+
+			peak = jmax(peak, std::abs(expected[(size_t)i]));
+
+			if (e > maxError)
+			{
+				maxError = e;
+				errorIndex = i;
+			}
+		}
+
+		expect(maxError <= peak * 1e-4f, "Error " + String(maxError) + " at sample " + String(errorIndex) + " (peak: " + String(peak) + ")");
+	}
+};
+
+static ConvolutionTests convolutionTests;
+
+}
+
+}
@@ -33,6 +33,7 @@
 #include "hi_lac.h"
 
 #include "hlac/BitCompressors.cpp"
+#include "hlac/BitCompressorsSIMD.cpp"
 #include "hlac/CompressionHelpers.cpp"
 #include "hlac/SampleBuffer.cpp"
 #include "hlac/HlacEncoder.cpp"
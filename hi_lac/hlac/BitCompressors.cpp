@@ -124,8 +124,6 @@ void packArrayOfInt16(int16* d, int numValues, uint8 bitDepth)
 
 void unpackArrayOfInt16(int16* d, int /*numValues*/, uint8 bitDepth)
 {
-	jassert(reinterpret_cast<uint64>(d) % 16 == 0);
-
 #if HI_ENABLE_LEGACY_CPU_SUPPORT || !JUCE_WINDOWS
 	for (int i = 0; i < 8; i++)
 	{
@@ -139,14 +137,24 @@ void unpackArrayOfInt16(int16* d, int /*numValues*/, uint8 bitDepth)
 
 	auto sub_ = _mm_set1_epi16(sub);
 
-	auto d_ = _mm_load_si128((__m128i*)d);
+	auto d_ = _mm_loadu_si128((__m128i*)d);
 	d_ = _mm_sub_epi16(d_, sub_);
-	_mm_store_si128((__m128i*)d, d_);
+	_mm_storeu_si128((__m128i*)d, d_);
 
 #endif
 
 }
 
+/** Decompresses as many values as possible with the vectorised kernels and advances the pointers. */
+void unpackWithSIMD(uint8 bitDepth, int16*& destination, const uint8*& data, int& numValuesToDecompress)
+{
+	const int numUnpacked = BitCompressors::SIMD::unpack(bitDepth, destination, data, numValuesToDecompress);
+
+	destination += numUnpacked;
+	data += (numUnpacked * bitDepth) / 8;
+	numValuesToDecompress -= numUnpacked;
+}
+
 
 int BitCompressors::ZeroBit::getAllowedBitRange() const
 {
@@ -223,6 +231,8 @@ bool BitCompressors::OneBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::OneBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	unpackWithSIMD(1, destination, data, numValuesToDecompress);
+
 	const uint8 masks[8] = { 0b00000001, 0b00000010, 0b00000100, 0b00001000,
 		0b00010000, 0b00100000, 0b01000000, 0b10000000 };
 
@@ -318,6 +328,8 @@ bool BitCompressors::TwoBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::TwoBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	unpackWithSIMD(2, destination, data, numValuesToDecompress);
+
 	const uint8 signMasks[4] =  { 0b00000010, 0b00001000, 0b00100000, 0b10000000 };
 	const uint8 valueMasks[4] = { 0b00000001, 0b00000100, 0b00010000, 0b01000000 };
 
@@ -431,7 +443,7 @@ bool BitCompressors::FourBit::compress(uint8* destination, const int16* data, in
 
 bool BitCompressors::FourBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
-	
+	unpackWithSIMD(4, destination, data, numValuesToDecompress);
 
 	const uint8 signMasks[2] =  { 0b00001000, 0b10000000 };
 	const uint8 valueMasks[2] = { 0b00000111, 0b01110000 };
@@ -543,6 +555,8 @@ bool BitCompressors::SixBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::SixBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	unpackWithSIMD(6, destination, data, numValuesToDecompress);
+
 #if JUCE_IOS
 	while (numValuesToDecompress >= 8)
 	{
@@ -703,6 +717,8 @@ bool BitCompressors::EightBit::compress(uint8* destination, const int16* data, i
 
 bool BitCompressors::EightBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	unpackWithSIMD(8, destination, data, numValuesToDecompress);
+
     while (--numValuesToDecompress >= 0)
 	{
 		const int8 value = *reinterpret_cast<const int8*>(data++);
@@ -790,6 +806,8 @@ bool BitCompressors::TenBit::compress(uint8* destination, const int16* data, int
 
 bool BitCompressors::TenBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	unpackWithSIMD(10, destination, data, numValuesToDecompress);
+
 	while (numValuesToDecompress >= 8)
 	{
 		decompress10Bit(reinterpret_cast<uint16*>(destination), (void*)data);
@@ -848,6 +866,8 @@ bool BitCompressors::TwelveBit::compress(uint8* destination, const int16* data,
 
 bool BitCompressors::TwelveBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	unpackWithSIMD(12, destination, data, numValuesToDecompress);
+
 #if USE_SSE
 
 	const int numInBlockProcessing = numValuesToDecompress - (numValuesToDecompress % 4);
@@ -1002,6 +1022,8 @@ bool BitCompressors::FourteenBit::compress(uint8* destination, const int16* data
 
 bool BitCompressors::FourteenBit::decompress(int16* destination, const uint8* data, int numValuesToDecompress)
 {
+	unpackWithSIMD(14, destination, data, numValuesToDecompress);
+
 	while (numValuesToDecompress >= 8)
 	{
 		decompress14Bit(destination, data);
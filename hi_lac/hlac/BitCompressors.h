@@ -47,6 +47,45 @@ namespace hlac { using namespace juce;
 
 struct BitCompressors
 {
+	/** The instruction set that is used by the decompression routines. */
+	enum class SIMDLevel
+	{
+		Scalar = 0,
+		SSE41,
+		AVX2,
+		numSIMDLevels
+	};
+
+	/** Returns the best instruction set that is available on this CPU. */
+	static SIMDLevel getSupportedSIMDLevel();
+
+	/** Returns the instruction set that is currently used for decompressing. */
+	static SIMDLevel getSIMDLevel();
+
+	/** Overrides the instruction set (it will be limited to the supported level). 
+	
+		This is mainly used by the unit tests to compare the vectorised kernels against
+		the scalar implementation, which is the bit-exact reference.
+	*/
+	static void setSIMDLevel(SIMDLevel newLevel);
+
+	/** The vectorised kernels. 
+	
+		All functions process as many values as they can with the current SIMD level and return
+		the amount of values they have processed, so the scalar implementation can take care of the rest.
+	*/
+	struct SIMD
+	{
+		/** Unpacks whole blocks of the given bit depth and returns the number of decompressed values. */
+		static int unpack(uint8 bitDepth, int16* destination, const uint8* data, int numValues);
+
+		/** Distributes the full values of a diff cycle and returns the number of processed full values. */
+		static int distributeFullSamples(int16* destination, const int16* fullValues, int numFullValues);
+
+		/** Subtracts the error signal of a diff cycle and returns the number of processed error values. */
+		static int addErrorSignal(int16* destination, const int16* errorValues, int numErrorValues);
+	};
+
 	struct Base
 	{
 		virtual ~Base() {};
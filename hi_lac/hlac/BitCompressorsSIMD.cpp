@@ -0,0 +1,621 @@
+/*  ===========================================================================
+ *
+ *   This file is part of HISE.
+ *   Copyright 2016 Christoph Hart
+ *
+ *   HISE is free software: you can redistribute it and/or modify
+ *   it under the terms of the GNU General Public License as published by
+ *   the Free Software Foundation, either version 3 of the License, or
+ *   (at your option) any later version.
+ *
+ *   HISE is distributed in the hope that it will be useful,
+ *   but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *   GNU General Public License for more details.
+ *
+ *   You should have received a copy of the GNU General Public License
+ *   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *   Commercial licenses for using HISE in an closed source project are
+ *   available on request. Please visit the project's website to get more
+ *   information about commercial licensing:
+ *
+ *   http://www.hise.audio/
+ *
+ *   HISE is based on the JUCE library,
+ *   which must be separately licensed for closed source applications:
+ *
+ *   http://www.juce.com
+ *
+ *   ===========================================================================
+ */
+
+
+#if JUCE_INTEL && !HI_ENABLE_LEGACY_CPU_SUPPORT
+#define HLAC_ENABLE_SIMD_KERNELS 1
+#include <immintrin.h>
+#else
+#define HLAC_ENABLE_SIMD_KERNELS 0
+#endif
+
+// The kernels are compiled for the respective instruction set regardless of the global compiler
+// flags and are only called if the CPU supports them.
+#if HLAC_ENABLE_SIMD_KERNELS && (JUCE_GCC || JUCE_CLANG)
+#define HLAC_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define HLAC_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define HLAC_TARGET_SSE41
+#define HLAC_TARGET_AVX2
+#endif
+
+namespace hlac { using namespace juce; 
+
+BitCompressors::SIMDLevel BitCompressors::getSupportedSIMDLevel()
+{
+#if HLAC_ENABLE_SIMD_KERNELS
+	if (SystemStats::hasAVX2())
+		return SIMDLevel::AVX2;
+
+	if (SystemStats::hasSSE41())
+		return SIMDLevel::SSE41;
+#endif
+
+	return SIMDLevel::Scalar;
+}
+
+static std::atomic<int>& getCurrentSIMDLevel()
+{
+	static std::atomic<int> level((int)BitCompressors::getSupportedSIMDLevel());
+	return level;
+}
+
+BitCompressors::SIMDLevel BitCompressors::getSIMDLevel()
+{
+	return (SIMDLevel)getCurrentSIMDLevel().load(std::memory_order_relaxed);
+}
+
+void BitCompressors::setSIMDLevel(SIMDLevel newLevel)
+{
+	auto l = jmin((int)newLevel, (int)getSupportedSIMDLevel());
+	getCurrentSIMDLevel().store(l, std::memory_order_relaxed);
+}
+
+#if HLAC_ENABLE_SIMD_KERNELS
+
+namespace SIMDKernels
+{
+
+/*	The 6, 10, 12 and 14 bit formats store the values as offset binary in a stream of uint16 words
+	(with the most significant bit first). Eight values always occupy bitDepth bytes, so we create
+	a byte shuffle mask that gathers the two words that contain the value into a 32 bit lane, 
+	a shift amount that moves the value to the top of the lane and shift it down again.
+	
+	The kernels load 16 bytes per eight values, so the caller must make sure that they are readable.
+*/
+struct PackedLayout
+{
+	PackedLayout(int bitDepth_):
+	  bitDepth(bitDepth_)
+	{
+		for (int i = 0; i < 8; i++)
+		{
+			const int bitOffset = bitDepth * i;
+			const int wordIndex = bitOffset / 16;
+
+			// Little endian: the lower word goes to the upper half of the lane
+			shuffle[i * 4 + 0] = (int8)(2 * wordIndex + 2);
+			shuffle[i * 4 + 1] = (int8)(2 * wordIndex + 3);
+			shuffle[i * 4 + 2] = (int8)(2 * wordIndex);
+			shuffle[i * 4 + 3] = (int8)(2 * wordIndex + 1);
+
+			shift[i] = bitOffset % 16;
+			multiplier[i] = 1 << shift[i];
+		}
+	}
+
+	const int bitDepth;
+
+	alignas(32) int8 shuffle[32];
+	alignas(32) int32 shift[8];
+	alignas(32) int32 multiplier[8];
+};
+
+HLAC_TARGET_SSE41 static int unpackPackedSSE41(int bitDepth, int16* destination, const uint8* data, int numValues, int numBytes)
+{
+	const PackedLayout l(bitDepth);
+
+	const auto loShuffle = _mm_load_si128((const __m128i*)l.shuffle);
+	const auto hiShuffle = _mm_load_si128((const __m128i*)(l.shuffle + 16));
+	const auto loMul = _mm_load_si128((const __m128i*)l.multiplier);
+	const auto hiMul = _mm_load_si128((const __m128i*)(l.multiplier + 4));
+	const auto shiftDown = _mm_cvtsi32_si128(32 - bitDepth);
+	const auto offset = _mm_set1_epi16((int16)((1 << (bitDepth - 1)) - 1));
+
+	int numDone = 0;
+
+	while (numValues - numDone >= 8 && numBytes >= 16)
+	{
+		const auto x = _mm_loadu_si128((const __m128i*)data);
+
+		auto lo = _mm_mullo_epi32(_mm_shuffle_epi8(x, loShuffle), loMul);
+		auto hi = _mm_mullo_epi32(_mm_shuffle_epi8(x, hiShuffle), hiMul);
+
+		lo = _mm_srl_epi32(lo, shiftDown);
+		hi = _mm_srl_epi32(hi, shiftDown);
+
+		const auto v = _mm_sub_epi16(_mm_packus_epi32(lo, hi), offset);
+		_mm_storeu_si128((__m128i*)destination, v);
+
+		destination += 8;
+		data += bitDepth;
+		numBytes -= bitDepth;
+		numDone += 8;
+	}
+
+	return numDone;
+}
+
+HLAC_TARGET_AVX2 static int unpackPackedAVX2(int bitDepth, int16* destination, const uint8* data, int numValues, int numBytes)
+{
+	const PackedLayout l(bitDepth);
+
+	const auto shuffle = _mm256_load_si256((const __m256i*)l.shuffle);
+	const auto shift = _mm256_load_si256((const __m256i*)l.shift);
+	const auto shiftDown = _mm_cvtsi32_si128(32 - bitDepth);
+	const auto offset = _mm256_set1_epi16((int16)((1 << (bitDepth - 1)) - 1));
+
+	int numDone = 0;
+
+	// Two blocks of eight values per iteration, the second load reaches bitDepth bytes further
+	while (numValues - numDone >= 16 && numBytes >= 16 + bitDepth)
+	{
+		const auto x1 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)data));
+		const auto x2 = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(data + bitDepth)));
+
+		auto v1 = _mm256_sllv_epi32(_mm256_shuffle_epi8(x1, shuffle), shift);
+		auto v2 = _mm256_sllv_epi32(_mm256_shuffle_epi8(x2, shuffle), shift);
+
+		v1 = _mm256_srl_epi32(v1, shiftDown);
+		v2 = _mm256_srl_epi32(v2, shiftDown);
+
+		// packus works per 128 bit lane, so we need to reorder the quad words afterwards
+		auto v = _mm256_permute4x64_epi64(_mm256_packus_epi32(v1, v2), 0xD8);
+		v = _mm256_sub_epi16(v, offset);
+
+		_mm256_storeu_si256((__m256i*)destination, v);
+
+		destination += 16;
+		data += 2 * bitDepth;
+		numBytes -= 2 * bitDepth;
+		numDone += 16;
+	}
+
+	return numDone + unpackPackedSSE41(bitDepth, destination, data, numValues - numDone, numBytes);
+}
+
+HLAC_TARGET_SSE41 static int unpackOneBitSSE41(int16* destination, const uint8* data, int numValues)
+{
+	const auto masks = _mm_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128);
+
+	int numDone = 0;
+
+	while (numValues - numDone >= 8)
+	{
+		const auto x = _mm_and_si128(_mm_set1_epi16(*data++), masks);
+		_mm_storeu_si128((__m128i*)destination, _mm_srli_epi16(_mm_cmpeq_epi16(x, masks), 15));
+
+		destination += 8;
+		numDone += 8;
+	}
+
+	return numDone;
+}
+
+HLAC_TARGET_AVX2 static int unpackOneBitAVX2(int16* destination, const uint8* data, int numValues)
+{
+	const auto masks = _mm256_setr_epi16(1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128);
+
+	int numDone = 0;
+
+	while (numValues - numDone >= 16)
+	{
+		auto x = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_set1_epi16(data[0])), _mm_set1_epi16(data[1]), 1);
+		x = _mm256_and_si256(x, masks);
+		_mm256_storeu_si256((__m256i*)destination, _mm256_srli_epi16(_mm256_cmpeq_epi16(x, masks), 15));
+
+		destination += 16;
+		data += 2;
+		numDone += 16;
+	}
+
+	return numDone + unpackOneBitSSE41(destination, data, numValues - numDone);
+}
+
+/** Broadcasts four bytes so that every byte covers four 16 bit lanes (two registers). */
+HLAC_TARGET_SSE41 static void spreadTwoBitBytes(const uint8* data, __m128i& lo, __m128i& hi)
+{
+	int32 fourBytes;
+	memcpy(&fourBytes, data, 4);
+
+	auto x = _mm_unpacklo_epi8(_mm_cvtsi32_si128(fourBytes), _mm_setzero_si128());
+	x = _mm_unpacklo_epi16(x, x);
+
+	lo = _mm_unpacklo_epi32(x, x);
+	hi = _mm_unpackhi_epi32(x, x);
+}
+
+HLAC_TARGET_SSE41 static __m128i decodeTwoBitSSE41(__m128i x)
+{
+	const auto valueMasks = _mm_setr_epi16(1, 4, 16, 64, 1, 4, 16, 64);
+	const auto signMasks = _mm_setr_epi16(2, 8, 32, 128, 2, 8, 32, 128);
+
+	const auto value = _mm_cmpeq_epi16(_mm_and_si128(x, valueMasks), valueMasks);
+	const auto sign = _mm_cmpeq_epi16(_mm_and_si128(x, signMasks), signMasks);
+
+	// value ? (sign ? -1 : 1) : 0
+	return _mm_and_si128(value, _mm_or_si128(sign, _mm_set1_epi16(1)));
+}
+
+HLAC_TARGET_SSE41 static int unpackTwoBitSSE41(int16* destination, const uint8* data, int numValues)
+{
+	int numDone = 0;
+
+	while (numValues - numDone >= 16)
+	{
+		__m128i lo, hi;
+		spreadTwoBitBytes(data, lo, hi);
+
+		_mm_storeu_si128((__m128i*)destination, decodeTwoBitSSE41(lo));
+		_mm_storeu_si128((__m128i*)(destination + 8), decodeTwoBitSSE41(hi));
+
+		destination += 16;
+		data += 4;
+		numDone += 16;
+	}
+
+	return numDone;
+}
+
+HLAC_TARGET_AVX2 static int unpackTwoBitAVX2(int16* destination, const uint8* data, int numValues)
+{
+	const auto valueMasks = _mm256_setr_epi16(1, 4, 16, 64, 1, 4, 16, 64, 1, 4, 16, 64, 1, 4, 16, 64);
+	const auto signMasks = _mm256_setr_epi16(2, 8, 32, 128, 2, 8, 32, 128, 2, 8, 32, 128, 2, 8, 32, 128);
+	const auto one = _mm256_set1_epi16(1);
+
+	int numDone = 0;
+
+	while (numValues - numDone >= 16)
+	{
+		__m128i lo, hi;
+		spreadTwoBitBytes(data, lo, hi);
+
+		const auto x = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+
+		const auto value = _mm256_cmpeq_epi16(_mm256_and_si256(x, valueMasks), valueMasks);
+		const auto sign = _mm256_cmpeq_epi16(_mm256_and_si256(x, signMasks), signMasks);
+
+		_mm256_storeu_si256((__m256i*)destination, _mm256_and_si256(value, _mm256_or_si256(sign, one)));
+
+		destination += 16;
+		data += 4;
+		numDone += 16;
+	}
+
+	return numDone;
+}
+
+/** Decodes a register of bytes that are duplicated into adjacent 16 bit lanes (even lanes use the low nibble). */
+HLAC_TARGET_SSE41 static __m128i decodeFourBitSSE41(__m128i x)
+{
+	const auto nibbleMask = _mm_set1_epi16(0x0F);
+	const auto valueMask = _mm_set1_epi16(0x07);
+	const auto signMask = _mm_set1_epi16(0x08);
+
+	const auto n = _mm_blend_epi16(_mm_and_si128(x, nibbleMask), _mm_and_si128(_mm_srli_epi16(x, 4), nibbleMask), 0xAA);
+	const auto value = _mm_and_si128(n, valueMask);
+	const auto negate = _mm_cmpeq_epi16(_mm_and_si128(n, signMask), signMask);
+
+	return _mm_sub_epi16(_mm_xor_si128(value, negate), negate);
+}
+
+HLAC_TARGET_SSE41 static int unpackFourBitSSE41(int16* destination, const uint8* data, int numValues)
+{
+	int numDone = 0;
+
+	while (numValues - numDone >= 16)
+	{
+		auto x = _mm_loadl_epi64((const __m128i*)data);
+		x = _mm_unpacklo_epi8(x, x);
+
+		_mm_storeu_si128((__m128i*)destination, decodeFourBitSSE41(_mm_cvtepu8_epi16(x)));
+		_mm_storeu_si128((__m128i*)(destination + 8), decodeFourBitSSE41(_mm_cvtepu8_epi16(_mm_srli_si128(x, 8))));
+
+		destination += 16;
+		data += 8;
+		numDone += 16;
+	}
+
+	return numDone;
+}
+
+HLAC_TARGET_AVX2 static __m256i decodeFourBitAVX2(__m256i x)
+{
+	const auto nibbleMask = _mm256_set1_epi16(0x0F);
+	const auto valueMask = _mm256_set1_epi16(0x07);
+	const auto signMask = _mm256_set1_epi16(0x08);
+
+	const auto n = _mm256_blend_epi16(_mm256_and_si256(x, nibbleMask), _mm256_and_si256(_mm256_srli_epi16(x, 4), nibbleMask), 0xAA);
+	const auto value = _mm256_and_si256(n, valueMask);
+	const auto negate = _mm256_cmpeq_epi16(_mm256_and_si256(n, signMask), signMask);
+
+	return _mm256_sub_epi16(_mm256_xor_si256(value, negate), negate);
+}
+
+HLAC_TARGET_AVX2 static int unpackFourBitAVX2(int16* destination, const uint8* data, int numValues)
+{
+	int numDone = 0;
+
+	while (numValues - numDone >= 32)
+	{
+		const auto x = _mm_loadu_si128((const __m128i*)data);
+
+		const auto lo = _mm256_cvtepu8_epi16(_mm_unpacklo_epi8(x, x));
+		const auto hi = _mm256_cvtepu8_epi16(_mm_unpackhi_epi8(x, x));
+
+		_mm256_storeu_si256((__m256i*)destination, decodeFourBitAVX2(lo));
+		_mm256_storeu_si256((__m256i*)(destination + 16), decodeFourBitAVX2(hi));
+
+		destination += 32;
+		data += 16;
+		numDone += 32;
+	}
+
+	return numDone + unpackFourBitSSE41(destination, data, numValues - numDone);
+}
+
+HLAC_TARGET_SSE41 static int unpackEightBitSSE41(int16* destination, const uint8* data, int numValues)
+{
+	int numDone = 0;
+
+	while (numValues - numDone >= 8)
+	{
+		_mm_storeu_si128((__m128i*)destination, _mm_cvtepi8_epi16(_mm_loadl_epi64((const __m128i*)data)));
+
+		destination += 8;
+		data += 8;
+		numDone += 8;
+	}
+
+	return numDone;
+}
+
+HLAC_TARGET_AVX2 static int unpackEightBitAVX2(int16* destination, const uint8* data, int numValues)
+{
+	int numDone = 0;
+
+	while (numValues - numDone >= 16)
+	{
+		_mm256_storeu_si256((__m256i*)destination, _mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)data)));
+
+		destination += 16;
+		data += 16;
+		numDone += 16;
+	}
+
+	return numDone + unpackEightBitSSE41(destination, data, numValues - numDone);
+}
+
+/*	The scalar code uses integer division which rounds towards zero, so we need to add 
+	(divisor - 1) to negative values before the arithmetic shift to stay bit-exact. 
+*/
+HLAC_TARGET_SSE41 static __m128i divideBy4(__m128i x)
+{
+	return _mm_srai_epi32(_mm_add_epi32(x, _mm_and_si128(_mm_srai_epi32(x, 31), _mm_set1_epi32(3))), 2);
+}
+
+HLAC_TARGET_SSE41 static __m128i divideBy2(__m128i x)
+{
+	return _mm_srai_epi32(_mm_add_epi32(x, _mm_srli_epi32(x, 31)), 1);
+}
+
+HLAC_TARGET_AVX2 static __m256i divideBy4(__m256i x)
+{
+	return _mm256_srai_epi32(_mm256_add_epi32(x, _mm256_and_si256(_mm256_srai_epi32(x, 31), _mm256_set1_epi32(3))), 2);
+}
+
+HLAC_TARGET_AVX2 static __m256i divideBy2(__m256i x)
+{
+	return _mm256_srai_epi32(_mm256_add_epi32(x, _mm256_srli_epi32(x, 31)), 1);
+}
+
+HLAC_TARGET_SSE41 static int distributeFullSamplesSSE41(int16* d, const int16* r, int numFullValues)
+{
+	int i = 0;
+
+	// The last pair is interpolated differently, so we leave it to the scalar code
+	while (i + 4 <= numFullValues - 2)
+	{
+		const auto a = _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i*)(r + i)));
+		const auto b = _mm_cvtepi16_epi32(_mm_loadl_epi64((const __m128i*)(r + i + 1)));
+
+		const auto v1 = a;
+		const auto v2 = divideBy4(_mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(a, 1), a), b));
+		const auto v3 = divideBy2(_mm_add_epi32(a, b));
+		const auto v4 = divideBy4(_mm_add_epi32(_mm_add_epi32(_mm_slli_epi32(b, 1), b), a));
+
+		// All values are within the int16 range so the saturation never kicks in
+		const auto x = _mm_packs_epi32(v1, v3);
+		const auto y = _mm_packs_epi32(v2, v4);
+
+		const auto lo = _mm_unpacklo_epi16(x, y);
+		const auto hi = _mm_unpackhi_epi16(x, y);
+
+		_mm_storeu_si128((__m128i*)d, _mm_unpacklo_epi32(lo, hi));
+		_mm_storeu_si128((__m128i*)(d + 8), _mm_unpackhi_epi32(lo, hi));
+
+		d += 16;
+		i += 4;
+	}
+
+	return i;
+}
+
+HLAC_TARGET_AVX2 static int distributeFullSamplesAVX2(int16* d, const int16* r, int numFullValues)
+{
+	int i = 0;
+
+	while (i + 8 <= numFullValues - 2)
+	{
+		const auto a = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(r + i)));
+		const auto b = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(r + i + 1)));
+
+		const auto v1 = a;
+		const auto v2 = divideBy4(_mm256_add_epi32(_mm256_add_epi32(_mm256_slli_epi32(a, 1), a), b));
+		const auto v3 = divideBy2(_mm256_add_epi32(a, b));
+		const auto v4 = divideBy4(_mm256_add_epi32(_mm256_add_epi32(_mm256_slli_epi32(b, 1), b), a));
+
+		const auto x = _mm256_packs_epi32(v1, v3);
+		const auto y = _mm256_packs_epi32(v2, v4);
+
+		const auto lo = _mm256_unpacklo_epi16(x, y);
+		const auto hi = _mm256_unpackhi_epi16(x, y);
+
+		// Every 128 bit lane contains four quadruples, so we need to interleave the lanes
+		const auto q1 = _mm256_unpacklo_epi32(lo, hi);
+		const auto q2 = _mm256_unpackhi_epi32(lo, hi);
+
+		_mm256_storeu_si256((__m256i*)d, _mm256_permute2x128_si256(q1, q2, 0x20));
+		_mm256_storeu_si256((__m256i*)(d + 16), _mm256_permute2x128_si256(q1, q2, 0x31));
+
+		d += 32;
+		i += 8;
+	}
+
+	return i + distributeFullSamplesSSE41(d, r + i, numFullValues - i);
+}
+
+HLAC_TARGET_SSE41 static int addErrorSignalSSE41(int16* d, const int16* e, int numErrorValues)
+{
+	// Moves three error values into the lanes 1-3 of each quadruple
+	const auto shuffle = _mm_setr_epi8(-1, -1, 0, 1, 2, 3, 4, 5, -1, -1, 6, 7, 8, 9, 10, 11);
+
+	int numDone = 0;
+
+	// Two quadruples per iteration, but the load reads eight error values
+	while (numErrorValues - numDone >= 8)
+	{
+		const auto errors = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)e), shuffle);
+		const auto v = _mm_sub_epi16(_mm_loadu_si128((const __m128i*)d), errors);
+		_mm_storeu_si128((__m128i*)d, v);
+
+		d += 8;
+		e += 6;
+		numDone += 6;
+	}
+
+	return numDone;
+}
+
+HLAC_TARGET_AVX2 static int addErrorSignalAVX2(int16* d, const int16* e, int numErrorValues)
+{
+	const auto shuffle = _mm256_setr_epi8(-1, -1, 0, 1, 2, 3, 4, 5, -1, -1, 6, 7, 8, 9, 10, 11,
+										  -1, -1, 0, 1, 2, 3, 4, 5, -1, -1, 6, 7, 8, 9, 10, 11);
+
+	int numDone = 0;
+
+	while (numErrorValues - numDone >= 14)
+	{
+		auto errors = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)e)), 
+											  _mm_loadu_si128((const __m128i*)(e + 6)), 1);
+
+		errors = _mm256_shuffle_epi8(errors, shuffle);
+
+		const auto v = _mm256_sub_epi16(_mm256_loadu_si256((const __m256i*)d), errors);
+		_mm256_storeu_si256((__m256i*)d, v);
+
+		d += 16;
+		e += 12;
+		numDone += 12;
+	}
+
+	return numDone + addErrorSignalSSE41(d, e, numErrorValues - numDone);
+}
+
+} // namespace SIMDKernels
+
+#endif
+
+int BitCompressors::SIMD::unpack(uint8 bitDepth, int16* destination, const uint8* data, int numValues)
+{
+#if HLAC_ENABLE_SIMD_KERNELS
+	const auto level = getSIMDLevel();
+
+	if (level == SIMDLevel::Scalar)
+		return 0;
+
+	const bool useAVX = level == SIMDLevel::AVX2;
+
+	switch (bitDepth)
+	{
+	case 1:  return useAVX ? SIMDKernels::unpackOneBitAVX2(destination, data, numValues) :
+							 SIMDKernels::unpackOneBitSSE41(destination, data, numValues);
+	case 2:  return useAVX ? SIMDKernels::unpackTwoBitAVX2(destination, data, numValues) :
+							 SIMDKernels::unpackTwoBitSSE41(destination, data, numValues);
+	case 4:  return useAVX ? SIMDKernels::unpackFourBitAVX2(destination, data, numValues) :
+							 SIMDKernels::unpackFourBitSSE41(destination, data, numValues);
+	case 8:  return useAVX ? SIMDKernels::unpackEightBitAVX2(destination, data, numValues) :
+							 SIMDKernels::unpackEightBitSSE41(destination, data, numValues);
+	case 6:
+	case 10:
+	case 12:
+	case 14:
+	{
+		// Only the fully packed blocks are safe to read
+		const int numBytes = (numValues / 8) * bitDepth;
+
+		return useAVX ? SIMDKernels::unpackPackedAVX2(bitDepth, destination, data, numValues, numBytes) :
+						SIMDKernels::unpackPackedSSE41(bitDepth, destination, data, numValues, numBytes);
+	}
+	default: return 0;
+	}
+#else
+	ignoreUnused(bitDepth, destination, data, numValues);
+	return 0;
+#endif
+}
+
+int BitCompressors::SIMD::distributeFullSamples(int16* destination, const int16* fullValues, int numFullValues)
+{
+#if HLAC_ENABLE_SIMD_KERNELS
+	switch (getSIMDLevel())
+	{
+	case SIMDLevel::AVX2:  return SIMDKernels::distributeFullSamplesAVX2(destination, fullValues, numFullValues);
+	case SIMDLevel::SSE41: return SIMDKernels::distributeFullSamplesSSE41(destination, fullValues, numFullValues);
+	default:			   return 0;
+	}
+#else
+	ignoreUnused(destination, fullValues, numFullValues);
+	return 0;
+#endif
+}
+
+int BitCompressors::SIMD::addErrorSignal(int16* destination, const int16* errorValues, int numErrorValues)
+{
+#if HLAC_ENABLE_SIMD_KERNELS
+	switch (getSIMDLevel())
+	{
+	case SIMDLevel::AVX2:  return SIMDKernels::addErrorSignalAVX2(destination, errorValues, numErrorValues);
+	case SIMDLevel::SSE41: return SIMDKernels::addErrorSignalSSE41(destination, errorValues, numErrorValues);
+	default:			   return 0;
+	}
+#else
+	ignoreUnused(destination, errorValues, numErrorValues);
+	return 0;
+#endif
+}
+
+#undef HLAC_TARGET_SSE41
+#undef HLAC_TARGET_AVX2
+#undef HLAC_ENABLE_SIMD_KERNELS
+
+} // namespace hlac
@@ -915,80 +915,12 @@ void CompressionHelpers::Diff::distributeFullSamples(AudioBufferInt16& dst, cons
 	int thisValue = 0;
 	int nextValue = 0;
 
-#if HI_ENABLE_LEGACY_CPU_SUPPORT || !JUCE_WINDOWS
-
-	for (int i = 0; i < numSamples - 2; i++)
-	{
-		thisValue = (int)r[i];
-		nextValue = (int)r[i + 1];
-
-		d[0] = (int16)(thisValue);
-		d[1] = (int16)((3 * thisValue + nextValue) / 4);
-		d[2] = (int16)((thisValue + nextValue) / 2);
-		d[3] = (int16)((thisValue + 3 * nextValue) / 4);
-
-		d += 4;
-	}
-
-#else
-
-	if (SystemStats::hasSSE41())
-	{
-		for (int i = 0; i < numSamples - 9; i += 4)
-		{
-			__m128i a = _mm_loadl_epi64((const __m128i*)(r + i));
-			__m128i b = _mm_loadl_epi64((const __m128i*)(r + i + 1));
-			const __m128i mul3 = _mm_set1_epi32(3);
-
-			a = _mm_cvtepi16_epi32(a);
-			b = _mm_cvtepi16_epi32(b);
-
-			auto v1 = a;
-
-			auto v2 = _mm_mullo_epi32(a, mul3);
-			v2 = _mm_add_epi32(v2, b);
-			v2 = _mm_srai_epi32(v2, 2);
-
-			auto v3 = _mm_add_epi32(a, b);
-			v3 = _mm_srai_epi32(v3, 1);
-
-			auto v4 = _mm_mullo_epi32(b, mul3);
-			v4 = _mm_add_epi32(v4, a);
-			v4 = _mm_srai_epi32(v4, 2);
+	// The scalar loop below is the reference implementation for the SIMD kernels
+	const int numDone = BitCompressors::SIMD::distributeFullSamples(d, r, numSamples);
 
-			const uint8 z = 0x80;
-
-			const __m128i mask1a = _mm_set_epi8(z, z, z, z, z, z, 5, 4, z, z, z, z, z, z, 1, 0);
-			const __m128i mask1b = _mm_set_epi8(z, z, z, z, z, z, 13, 12, z, z, z, z, z, z, 9, 8);
-			const __m128i mask2a = _mm_set_epi8(z, z, z, z, 5, 4, z, z, z, z, z, z, 1, 0, z, z);
-			const __m128i mask2b = _mm_set_epi8(z, z, z, z, 13, 12, z, z, z, z, z, z, 9, 8, z, z);
-			const __m128i mask3a = _mm_set_epi8(z, z, 5, 4, z, z, z, z, z, z, 1, 0, z, z, z, z);
-			const __m128i mask3b = _mm_set_epi8(z, z, 13, 12, z, z, z, z, z, z, 9, 8, z, z, z, z);
-			const __m128i mask4a = _mm_set_epi8(5, 4, z, z, z, z, z, z, 1, 0, z, z, z, z, z, z);
-			const __m128i mask4b = _mm_set_epi8(13, 12, z, z, z, z, z, z, 9, 8, z, z, z, z, z, z);
-
-			const __m128i d1a = _mm_shuffle_epi8(v1, mask1a);
-			const __m128i d1b = _mm_shuffle_epi8(v2, mask2a);
-			const __m128i d1c = _mm_shuffle_epi8(v3, mask3a);
-			const __m128i d1d = _mm_shuffle_epi8(v4, mask4a);
-
-			const __m128i d1 = _mm_or_si128(_mm_or_si128(d1a, d1b), _mm_or_si128(d1c, d1d));
-
-			const __m128i d2a = _mm_shuffle_epi8(v1, mask1b);
-			const __m128i d2b = _mm_shuffle_epi8(v2, mask2b);
-			const __m128i d2c = _mm_shuffle_epi8(v3, mask3b);
-			const __m128i d2d = _mm_shuffle_epi8(v4, mask4b);
-
-			const __m128i d2 = _mm_or_si128(_mm_or_si128(d2a, d2b), _mm_or_si128(d2c, d2d));
-
-			_mm_store_si128((__m128i*)d, d1);
-			_mm_store_si128((__m128i*)(d + 8), d2);
-
-			d += 16;
-		}
-	}
+	d += 4 * numDone;
 
-	for (int i = numSamples - 9; i < numSamples - 2; i++)
+	for (int i = numDone; i < numSamples - 2; i++)
 	{
 		thisValue = (int)r[i];
 		nextValue = (int)r[i + 1];
@@ -1001,8 +933,6 @@ void CompressionHelpers::Diff::distributeFullSamples(AudioBufferInt16& dst, cons
 		d += 4;
 	}
 
-#endif
-
 	thisValue = r[numSamples - 2];
 	nextValue = r[numSamples - 1];
 	
@@ -1023,14 +953,14 @@ void CompressionHelpers::Diff::addErrorSignal(AudioBufferInt16& dst, const uint1
 
 	int16* e = const_cast<int16*>(reinterpret_cast<const int16*>(errorSignalPacked));
 
-	int counter = 0;
+	const int numDone = BitCompressors::SIMD::addErrorSignal(d, e, numSamples);
 
-#if HI_ENABLE_LEGACY_CPU_SUPPORT || !JUCE_WINDOWS
+	d += 4 * (numDone / 3);
+	e += numDone;
+	numSamples -= numDone;
 
 	while (numSamples > 2)
 	{
-		counter += 4;
-
 		d[1] -= e[0];
 		d[2] -= e[1];
 		d[3] -= e[2];
@@ -1043,52 +973,6 @@ void CompressionHelpers::Diff::addErrorSignal(AudioBufferInt16& dst, const uint1
 
 	d[1] -= e[0];
 	d[2] -= e[1];
-
-#else
-
-	while (numSamples > 2)
-	{
-		// SSE 3.0 should be available everywhere by now...
-
-		counter += 16;
-
-		__m128i a1 = _mm_load_si128((__m128i*)d);
-		__m128i a2 = _mm_load_si128((__m128i*)(d+8));
-
-		__m128i b1 = _mm_loadl_epi64((__m128i*)e);
-		__m128i b2 = _mm_loadl_epi64((__m128i*)(e+3));
-		__m128i b3 = _mm_loadl_epi64((__m128i*)(e+6));
-		__m128i b4 = _mm_loadl_epi64((__m128i*)(e+9));
-
-		const uint8 z = 0x80;
-
-		const __m128i mask = _mm_set_epi8 (z, z, z, z, z, z, z, z, 5, 4, 3, 2, 1, 0, z, z);
-		const __m128i mask2 = _mm_set_epi8(5, 4, 3, 2, 1, 0, z, z, z, z, z, z, z, z, z, z);
-
-		__m128i ba = _mm_shuffle_epi8(b1, mask);
-		ba = _mm_or_si128(ba, _mm_shuffle_epi8(b2, mask2));
-
-		__m128i bb = _mm_shuffle_epi8(b3, mask);
-		bb = _mm_or_si128(bb, _mm_shuffle_epi8(b4, mask2));
-
-		a1 = _mm_sub_epi16(a1, ba);
-		a2 = _mm_sub_epi16(a2, bb);
-
-		_mm_store_si128((__m128i*)d, a1);
-		_mm_store_si128((__m128i*)(d+8), a2);
-
-		d += 16;
-		e += 12;
-
-		numSamples -= 12;
-
-	}
-
-	d[1] -= e[0];
-	d[2] -= e[1];
-
-
-#endif
 }
 
 uint64 CompressionHelpers::Misc::NumberOfSetBits(uint64 i)
@@ -1486,60 +1370,103 @@ bool HlacArchiver::extractSampleData(const DecompressData& data)
 
 #define WRITE_FLAG(x) writeFlag(fos, x)
 
-FileInputStream* HlacArchiver::writeTempFile(AudioFormatReader* reader, int bitDepth)
+/** Decodes a HLAC file and writes it as FLAC into a temporary file. 
+
+	The jobs run on a thread pool so that multiple files can be encoded in parallel 
+	while the archiver copies the temporary files in the original order. 
+*/
+struct HlacArchiver::TempFileJob : public ThreadPoolJob
 {
-	FlacAudioFormat flacFormat;
+	TempFileJob(HlacArchiver& parent_, const File& sourceFile_, const File& tmpFile_, int bitDepth_) :
+		ThreadPoolJob("HLAC Archiver"),
+		parent(parent_),
+		sourceFile(sourceFile_),
+		tmpFile(tmpFile_),
+		bitDepth(bitDepth_)
+	{}
 
-	StringPairArray metadata;
+	~TempFileJob()
+	{
+		tmpFile.deleteFile();
+	}
 
-	tmpFile.deleteFile();
-	FileOutputStream* tempOutput = new FileOutputStream(tmpFile);
+	bool shouldCancel() const
+	{
+		return shouldExit() || (parent.thread != nullptr && parent.thread->threadShouldExit());
+	}
 
-	const int bufferSize = 8192 * 32;
+	JobStatus runJob() override
+	{
+		result = writeTempFile();
+		return jobHasFinished;
+	}
 
-	AudioSampleBuffer tempBuffer(reader->numChannels, bufferSize);
+	Result writeTempFile()
+	{
+		hlac::HiseLosslessAudioFormat haf;
 
-	ScopedPointer<AudioFormatWriter> writer = flacFormat.createWriterFor(tempOutput, reader->sampleRate, reader->numChannels, bitDepth, metadata, 9);
+		ScopedPointer<AudioFormatReader> reader = haf.createReaderFor(new FileInputStream(sourceFile), true);
 
-	bool writeResult = true;
+		if (reader == nullptr)
+			return Result::fail("Can't open " + sourceFile.getFullPathName());
 
-	dynamic_cast<HiseLosslessAudioFormatReader*>(reader)->setTargetAudioDataType(AudioDataConverters::float32BE);
+		sampleRate = reader->sampleRate;
+		numChannels = (int)reader->numChannels;
+		lengthInSamples = reader->lengthInSamples;
 
-	for (int offsetInReader = 0; offsetInReader < reader->lengthInSamples; offsetInReader += bufferSize)
-	{
+		FlacAudioFormat flacFormat;
 
-		if (thread->threadShouldExit())
-		{
-			tempOutput->flush();
-			writer = nullptr;
-			tmpFile.deleteFile();
-			return nullptr;
-		}
-			
+		StringPairArray metadata;
 
-		double partProgress = (double)offsetInReader / (double)reader->lengthInSamples;
+		tmpFile.deleteFile();
+		FileOutputStream* tempOutput = new FileOutputStream(tmpFile);
 
-		if (progress != nullptr)
-			*progress = partProgress;
+		const int bufferSize = 8192 * 32;
 
-		const int numToRead = jmin<int>(bufferSize, (int)(reader->lengthInSamples - offsetInReader));
+		AudioSampleBuffer tempBuffer(reader->numChannels, bufferSize);
 
-		reader->read(&tempBuffer, 0, numToRead, offsetInReader, true, true);
+		ScopedPointer<AudioFormatWriter> writer = flacFormat.createWriterFor(tempOutput, reader->sampleRate, reader->numChannels, bitDepth, metadata, 9);
 
-		writeResult = writer->writeFromAudioSampleBuffer(tempBuffer, 0, numToRead);
+		dynamic_cast<HiseLosslessAudioFormatReader*>(reader.get())->setTargetAudioDataType(AudioDataConverters::float32BE);
 
-		if (!writeResult)
+		for (int offsetInReader = 0; offsetInReader < reader->lengthInSamples; offsetInReader += bufferSize)
 		{
-			listener->criticalErrorOccured("Error at writing from temp buffer at position " + String(offsetInReader) + ", chunk-length: " + String(numToRead));
-			return nullptr;
+			if (shouldCancel())
+			{
+				writer = nullptr;
+				tmpFile.deleteFile();
+				return Result::fail("Cancelled");
+			}
+
+			progress.store((double)offsetInReader / (double)reader->lengthInSamples);
+
+			const int numToRead = jmin<int>(bufferSize, (int)(reader->lengthInSamples - offsetInReader));
+
+			reader->read(&tempBuffer, 0, numToRead, offsetInReader, true, true);
+
+			if (!writer->writeFromAudioSampleBuffer(tempBuffer, 0, numToRead))
+				return Result::fail("Error at writing from temp buffer at position " + String(offsetInReader) + ", chunk-length: " + String(numToRead));
 		}
+
+		writer->flush();
+		writer = nullptr;
+
+		return Result::ok();
 	}
 
-	tempOutput->flush();
-	writer = nullptr;
+	HlacArchiver& parent;
 
-	return new FileInputStream(tmpFile);
-}
+	const File sourceFile;
+	const File tmpFile;
+	const int bitDepth;
+
+	Result result = Result::ok();
+	std::atomic<double> progress = { 0.0 };
+
+	double sampleRate = 0.0;
+	int numChannels = 0;
+	int64 lengthInSamples = 0;
+};
 
 #define CHECK_FILE_WRITE_OP if (!ok) { listener->criticalErrorOccured("file write error at " + fos->getFile().getFileName()); return; }
 
@@ -1602,13 +1529,22 @@ void HlacArchiver::compressSampleData(const CompressData& data)
 			WRITE_FLAG(Flag::EndAdditionalFile);
 		}
 
-		hlac::HiseLosslessAudioFormat haf;
+		deltaPerFile = (double)1 / (double)hlacFiles.size();
 
-		StringPairArray metadata;
+		const int numThreads = data.numThreads > 0 ? data.numThreads : SystemStats::getNumCpus();
 
-		tmpFile = targetFile.getSiblingFile("Temp.dat");
+		// Don't encode too far ahead so that the temporary files don't pile up
+		const int numFilesAhead = 2 * numThreads;
 
-		deltaPerFile = (double)1 / (double)hlacFiles.size();
+		OwnedArray<TempFileJob> jobs;
+
+		for (int i = 0; i < hlacFiles.size(); i++)
+			jobs.add(new TempFileJob(*this, hlacFiles[i], targetFile.getSiblingFile("Temp" + String(i) + ".dat"), bitDepth));
+
+		// Declared after the jobs so that it stops all running jobs before they are deleted
+		ThreadPool pool(numThreads);
+
+		int numScheduled = 0;
 
 		for (int i = 0; i < hlacFiles.size(); i++)
 		{
@@ -1617,20 +1553,40 @@ void HlacArchiver::compressSampleData(const CompressData& data)
 
 			*data.totalProgress = ((double)i / (double)hlacFiles.size());
 
-			auto sizeLeftInPart = data.partSize - fos->getPosition();
-
-			FileInputStream* fis = new FileInputStream(hlacFiles[i]);
+			while (numScheduled < jmin(hlacFiles.size(), i + numFilesAhead))
+				pool.addJob(jobs[numScheduled++], false);
 
-			ScopedPointer<AudioFormatReader> reader = haf.createReaderFor(fis, true);
+			auto job = jobs[i];
 
 			const String name = hlacFiles[i].getFileName();
 
-			VERBOSE_LOG("  Writing monolith " + name);
 			STATUS_LOG("Compressing " + name);
 
-			VERBOSE_LOG("    Samplerate: " + String(reader->sampleRate, 1));
-			VERBOSE_LOG("    Channels: " + String(reader->numChannels));
-			VERBOSE_LOG("    Length: " + String(reader->lengthInSamples));
+			while (!pool.waitForJobToFinish(job, 50))
+			{
+				if (thread->threadShouldExit())
+					return;
+
+				if (progress != nullptr)
+					*progress = job->progress.load();
+			}
+
+			if (thread->threadShouldExit())
+				return;
+
+			if (job->result.failed())
+			{
+				listener->criticalErrorOccured(job->result.getErrorMessage());
+				return;
+			}
+
+			auto sizeLeftInPart = data.partSize - fos->getPosition();
+
+			VERBOSE_LOG("  Writing monolith " + name);
+
+			VERBOSE_LOG("    Samplerate: " + String(job->sampleRate, 1));
+			VERBOSE_LOG("    Channels: " + String(job->numChannels));
+			VERBOSE_LOG("    Length: " + String(job->lengthInSamples));
 
 			WRITE_FLAG(Flag::BeginName);
 			ok = fos->writeString(name);
@@ -1642,12 +1598,7 @@ void HlacArchiver::compressSampleData(const CompressData& data)
 			CHECK_FILE_WRITE_OP;
 			WRITE_FLAG(Flag::EndTime);
 
-			
-
-			ScopedPointer<FileInputStream> tmpInput = writeTempFile(reader, bitDepth);
-
-			if (tmpInput == nullptr)
-				return;
+			ScopedPointer<FileInputStream> tmpInput = new FileInputStream(job->tmpFile);
 
 			int64 bytesToWrite = jmin<int64>(tmpInput->getTotalLength(), sizeLeftInPart);
 
@@ -1695,13 +1646,13 @@ void HlacArchiver::compressSampleData(const CompressData& data)
 			jassert(tmpInput->isExhausted());
 			fos->flush();
 			tmpInput = nullptr;
+
+			job->tmpFile.deleteFile();
 		}
 
 		WRITE_FLAG(Flag::EndOfArchive);
 		fos->flush();
 		fos = nullptr;
-
-		tmpFile.deleteFile();
 	}
 #else
 
@@ -396,6 +396,9 @@ struct HlacArchiver
 		int64 partSize = -1;
 		double* progress = nullptr;
 		double* totalProgress = nullptr;
+
+		/** The number of files that are encoded in parallel (-1 uses all CPU cores). */
+		int numThreads = -1;
 	};
 
 	struct DecompressData
@@ -452,7 +455,7 @@ struct HlacArchiver
 
 private:
 
-	FileInputStream* writeTempFile(AudioFormatReader* reader, int bitDepth=16);
+	struct TempFileJob;
 
 	Listener* listener = nullptr;
 
@@ -473,8 +476,6 @@ private:
 	Thread* thread = nullptr;
 	
 	
-	File tmpFile;
-
 	double deltaPerFile = 0.1;
 	double fileProgress = 0.0;
 
@@ -30,6 +30,10 @@
  *   ===========================================================================
  */
 
+#if !JUCE_WINDOWS
+#include <sys/mman.h>
+#endif
+
 namespace hlac { using namespace juce; 
 
 HiseLosslessAudioFormatReader::HiseLosslessAudioFormatReader(InputStream* input_) :
@@ -472,6 +476,51 @@ void HlacMemoryMappedAudioFormatReader::setTargetAudioDataType(AudioDataConverte
 	internalReader.setTargetAudioDataType(dataType);
 }
 
+void HlacMemoryMappedAudioFormatReader::adviseReadAhead(Range<int64> samplesToRead)
+{
+	samplesToRead = samplesToRead.getIntersectionWith({ 0, lengthInSamples });
+
+	if (map == nullptr || samplesToRead.isEmpty())
+		return;
+
+	Range<int64> byteRange;
+
+	if (isMonolith)
+	{
+		byteRange = { dataChunkStart + samplesToRead.getStart() * bytesPerFrame,
+					  dataChunkStart + samplesToRead.getEnd() * bytesPerFrame };
+	}
+	else
+	{
+		auto start = (int64)internalReader.header.getOffsetForReadPosition(samplesToRead.getStart(), true);
+		auto end = samplesToRead.getEnd() >= lengthInSamples ? getFile().getSize() :
+				   (int64)internalReader.header.getOffsetForNextBlock(samplesToRead.getEnd(), true);
+
+		byteRange = { start, end };
+	}
+
+	auto mappedRange = map->getRange();
+	byteRange = byteRange.getIntersectionWith(mappedRange);
+
+	if (byteRange.isEmpty())
+		return;
+
+#if JUCE_WINDOWS
+	// PrefetchVirtualMemory() needs Windows 8, so we rely on the read-ahead of the memory manager here...
+#else
+	// The mapped range starts at a page boundary, so we can align the address relative to the mapped data
+	static const int64 pageSize = (int64)SystemStats::getPageSize();
+
+	auto offset = byteRange.getStart() - mappedRange.getStart();
+	auto alignedOffset = offset - (offset % pageSize);
+
+	auto address = static_cast<uint8*>(map->getData()) + alignedOffset;
+	auto numBytes = (size_t)(byteRange.getEnd() - mappedRange.getStart() - alignedOffset);
+
+	posix_madvise(address, numBytes, POSIX_MADV_WILLNEED);
+#endif
+}
+
 void HlacMemoryMappedAudioFormatReader::copySampleData(int* const* destSamples, int startOffsetInDestBuffer, int numDestChannels, const void* sourceData, int numChannels, int numSamples) noexcept
 {
 	jassert(numDestChannels == numDestChannels);
@@ -549,12 +598,25 @@ bool HlacSubSectionReader::readSamples(int** destSamples, int numDestChannels, i
 	clearSamplesBeyondAvailableLength(destSamples, numDestChannels, startOffsetInDestBuffer,
 		startSampleInFile, numSamples, length);
 
+	ScopedLock sl(internalReader->readLock);
+
 	if(memoryReader != nullptr)
 		return memoryReader->readSamples(destSamples, numDestChannels, startOffsetInDestBuffer, startSampleInFile + start, numSamples);
 	else
 		return normalReader->readSamples(destSamples, numDestChannels, startOffsetInDestBuffer, startSampleInFile + start, numSamples);
 }
 
+void HlacSubSectionReader::adviseReadAhead(int64 readerStartSample, int numSamples)
+{
+	if (memoryReader == nullptr)
+		return;
+
+	auto r = Range<int64>(readerStartSample, readerStartSample + numSamples).getIntersectionWith({ 0, length });
+
+	if (!r.isEmpty())
+		memoryReader->adviseReadAhead(r + start);
+}
+
 void HlacSubSectionReader::readMaxLevels(int64 startSampleInFile, int64 numSamples, Range<float>* results, int numChannelsToRead)
 {
 	startSampleInFile = jmax((int64)0, startSampleInFile);
@@ -566,8 +628,78 @@ void HlacSubSectionReader::readMaxLevels(int64 startSampleInFile, int64 numSampl
 		normalReader->readMaxLevels(startSampleInFile + start, numSamples, results, numChannelsToRead);
 }
 
+HlacSubSectionReader::ScopedThreadReader::ScopedThreadReader(const File& monolithFile) :
+	file(monolithFile),
+	previous(getCurrentThreadReader())
+{
+	getCurrentThreadReader() = this;
+}
+
+HlacSubSectionReader::ScopedThreadReader::~ScopedThreadReader()
+{
+	jassert(getCurrentThreadReader() == this);
+	getCurrentThreadReader() = previous;
+}
+
+HlacSubSectionReader::ScopedThreadReader*& HlacSubSectionReader::getCurrentThreadReader()
+{
+	static thread_local ScopedThreadReader* current = nullptr;
+	return current;
+}
+
+HlacMemoryMappedAudioFormatReader* HlacSubSectionReader::getThreadReader(HlacMemoryMappedAudioFormatReader* sharedReader)
+{
+	if (sharedReader == nullptr)
+		return nullptr;
+
+	for (auto r = getCurrentThreadReader(); r != nullptr; r = r->previous)
+	{
+		if (r->failed || r->file != sharedReader->getFile())
+			continue;
+
+		if (r->reader == nullptr)
+		{
+			HiseLosslessAudioFormat hlaf;
+			ScopedPointer<MemoryMappedAudioFormatReader> mr = hlaf.createMemoryMappedReader(r->file);
+
+			if (dynamic_cast<HlacMemoryMappedAudioFormatReader*>(mr.get()) != nullptr && mr->mapEntireFile())
+			{
+				r->reader = dynamic_cast<HlacMemoryMappedAudioFormatReader*>(mr.release());
+				r->reader->setTargetAudioDataType(sharedReader->usesFloatingPointData ? AudioDataConverters::float32BE : AudioDataConverters::int16BE);
+			}
+			else
+			{
+				// fall back to the shared reader
+				r->failed = true;
+				return nullptr;
+			}
+		}
+
+		return r->reader;
+	}
+
+	return nullptr;
+}
+
 void HlacSubSectionReader::readIntoFixedBuffer(HiseSampleBuffer& buffer, int startSample, int numSamples, int64 readerStartSample)
 {
+	if (auto threadReader = getThreadReader(memoryReader))
+	{
+		if (isMonolith)
+			threadReader->copyFromMonolith(buffer, startSample, buffer.getNumChannels(), start + readerStartSample, numChannels, numSamples);
+		else
+		{
+			threadReader->internalReader.fixedBufferRead(buffer, numChannels, startSample, start + readerStartSample, numSamples);
+
+			if (buffer.getNumChannels() == 1 || numChannels == 1)
+				buffer.setUseOneMap(true);
+		}
+
+		return;
+	}
+
+	ScopedLock sl(internalReader->readLock);
+
 	if (isMonolith)
 	{
 		if (memoryReader != nullptr)
@@ -124,6 +124,10 @@ private:
 	HlacDecoder decoder;
 	HiseLosslessHeader header;
 
+	// The decoder state is shared between all subsection readers of a monolith, so this
+	// lock prevents multiple streaming threads from reading the same file concurrently.
+	CriticalSection readLock;
+
 	bool usesFloatingPointData;
 
 	bool useHeaderOffsetWhenSeeking = true;
@@ -188,6 +192,9 @@ public:
 
 	void setTargetAudioDataType(AudioDataConverters::DataFormat dataType);
 
+	/** Tells the OS that the given range of samples will be read soon so that it can page in the mapped data in the background. */
+	void adviseReadAhead(Range<int64> samplesToRead);
+
 private:
 	
 	friend class HlacSubSectionReader;
@@ -215,8 +222,40 @@ public:
 
 	void readIntoFixedBuffer(HiseSampleBuffer& buffer, int startSample, int numSamples, int64 readerStartSample);
 
+	/** Prefetches the mapped data for the given range of the subsection. This does nothing if the file is not memory mapped. */
+	void adviseReadAhead(int64 readerStartSample, int numSamples);
+
+	/** Lets the current thread decode a memory mapped monolith with its own reader.
+	
+		All subsection readers of a monolith share the decoder of one memory mapped reader, so their reads are 
+		serialised by its read lock. While this object exists, readIntoFixedBuffer() calls on this thread for the 
+		given file use a private reader instead, which maps the same file and doesn't need the lock.
+		The private reader is created with the first read.
+	*/
+	struct ScopedThreadReader
+	{
+		ScopedThreadReader(const File& monolithFile);
+		~ScopedThreadReader();
+
+	private:
+
+		friend class HlacSubSectionReader;
+
+		const File file;
+		ScopedPointer<HlacMemoryMappedAudioFormatReader> reader;
+		ScopedThreadReader* const previous;
+		bool failed = false;
+
+		JUCE_DECLARE_NON_COPYABLE(ScopedThreadReader);
+	};
+
 private:
 
+	static ScopedThreadReader*& getCurrentThreadReader();
+
+	/** Returns the private reader of the current thread for the file of the shared reader or nullptr. */
+	static HlacMemoryMappedAudioFormatReader* getThreadReader(HlacMemoryMappedAudioFormatReader* sharedReader);
+
 	bool isMonolith = false;
 
 	HlacMemoryMappedAudioFormatReader* memoryReader;
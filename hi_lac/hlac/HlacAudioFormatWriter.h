@@ -58,6 +58,9 @@ public:
 
 	void setEnableFullDynamics(bool shouldEnableFullDynamics);
 
+	/** Sets the number of threads that are used to compress the blocks of each file. */
+	void setNumEncodingThreads(int numThreads);
+
 	bool write(const int** samplesToWrite, int numSamples) override;
 
 	double getCompressionRatioForLastFile() { return encoder.getCompressionRatio(); }
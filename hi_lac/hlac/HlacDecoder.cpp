@@ -73,6 +73,7 @@ void HlacDecoder::reset()
 	firstCycleLength = -1;
 	ratio = 0.0f;
 	readOffset = 0;
+	pendingReferencePosition = -1;
 }
 
 
@@ -108,6 +109,15 @@ bool HlacDecoder::decodeBlock(HiseSampleBuffer& destination, bool decodeStereo,
 		jassert(header.getNumSamples() != 0);
 		jassert(header.getNumSamples() <= COMPRESSION_BLOCK_SIZE);
 
+		if (skipCycle(header, input, channelIndex))
+			continue;
+
+		if (pendingReferencePosition != -1 && !header.isDiff() && !header.isTemplate())
+			restorePendingReferenceCycle(input);
+
+		if (header.isDiff() || (header.isTemplate() && header.getBitRate() != 0))
+			pendingReferencePosition = -1;
+
 		if (header.isDiff())
 			decodeDiff(header, decodeStereo, destination, input, channelIndex);
 		else
@@ -150,6 +160,8 @@ void HlacDecoder::decode(HiseSampleBuffer& destination, bool decodeStereo, Input
 	leftFloatIndex = 0;
 	rightFloatIndex = 0;
 
+	mappedInput = dynamic_cast<MemoryInputStream*>(&input);
+
 	int channelIndex = 0;
 	
 
@@ -164,6 +176,8 @@ void HlacDecoder::decode(HiseSampleBuffer& destination, bool decodeStereo, Input
 
 	readOffset += readIndex;
 
+	mappedInput = nullptr;
+
 	if(hlacVersion > 2)
 		destination.flushNormalisationInfo({ 0, numSamples });
 
@@ -184,41 +198,122 @@ void HlacDecoder::decodeDiff(const CycleHeader& header, bool /*decodeStereo*/, H
 {
 	uint16 blockSize = header.getNumSamples();
 
+	LOG("DEC  " + String(readOffset + readIndex + indexInBlock) + "\t\t\tNew diff with bit depth " + String(header.getBitRate(true)) + "/" + String(header.getBitRate(false)) + ": " + String(blockSize));
+
+	decompressDiffIntoCurrentCycle(header, input);
+
+	writeToFloatArray(true, false, destination, channelIndex, blockSize);
+
+	indexInBlock += blockSize;
+}
+
+
+
+
+void HlacDecoder::decompressDiffIntoCurrentCycle(const CycleHeader& header, InputStream& input)
+{
+	uint16 blockSize = header.getNumSamples();
+
 	uint8 fullBitRate = header.getBitRate(true);
 	auto compressorFull = collection.getSuitableCompressorForBitRate(fullBitRate);
 	auto numFullValues = CompressionHelpers::Diff::getNumFullValues(blockSize);
 	auto numFullBytes = compressorFull->getByteAmount(numFullValues);
 
-	input.read(readBuffer.getData(), numFullBytes);
+	auto fullData = readCompressedData(input, numFullBytes);
 
-	compressorFull->decompress(workBuffer.getWritePointer(), (uint8*)readBuffer.getData(), numFullValues);
+	compressorFull->decompress(workBuffer.getWritePointer(), fullData, numFullValues);
 
 	CompressionHelpers::Diff::distributeFullSamples(currentCycle, (const uint16*)workBuffer.getReadPointer(), numFullValues);
 
 	uint8 errorBitRate = header.getBitRate(false);
 
-	LOG("DEC  " + String(readOffset + readIndex + indexInBlock) + "\t\t\tNew diff with bit depth " + String(fullBitRate) + "/" + String(errorBitRate) + ": " + String(blockSize));
-
 	if (errorBitRate > 0)
 	{
 		auto compressorError = collection.getSuitableCompressorForBitRate(errorBitRate);
 		auto numErrorValues = CompressionHelpers::Diff::getNumErrorValues(blockSize);
 		auto numErrorBytes = compressorError->getByteAmount(numErrorValues);
 
-		input.read(readBuffer.getData(), numErrorBytes);
+		auto errorData = readCompressedData(input, numErrorBytes);
 
-		compressorError->decompress(workBuffer.getWritePointer(), (uint8*)readBuffer.getData(), numErrorValues);
+		compressorError->decompress(workBuffer.getWritePointer(), errorData, numErrorValues);
 
 		CompressionHelpers::Diff::addErrorSignal(currentCycle, (const uint16*)workBuffer.getReadPointer(), numErrorValues);
 	}
+}
 
-	writeToFloatArray(true, false, destination, channelIndex, blockSize);
+int HlacDecoder::getCompressedSize(const CycleHeader& header)
+{
+	const auto numSamples = header.getNumSamples();
 
-	indexInBlock += blockSize;
+	if (header.isDiff())
+	{
+		auto numBytes = collection.getSuitableCompressorForBitRate(header.getBitRate(true))->getByteAmount(CompressionHelpers::Diff::getNumFullValues(numSamples));
+
+		auto errorBitRate = header.getBitRate(false);
+
+		if (errorBitRate > 0)
+			numBytes += collection.getSuitableCompressorForBitRate(errorBitRate)->getByteAmount(CompressionHelpers::Diff::getNumErrorValues(numSamples));
+
+		return numBytes;
+	}
+
+	return collection.getSuitableCompressorForBitRate(header.getBitRate())->getByteAmount(numSamples);
 }
 
+bool HlacDecoder::skipCycle(const CycleHeader& header, InputStream& input, int channelIndex)
+{
+	int& skipToUse = channelIndex == 0 ? leftNumToSkip : rightNumToSkip;
+
+	const int numSamples = header.getNumSamples();
+
+	if (skipToUse < numSamples)
+		return false;
+
+	const auto dataPosition = input.getPosition();
+	const auto numBytes = getCompressedSize(header);
+
+	// A skipped template or diff would have been the reference for subsequent delta cycles,
+	// so we remember where it is and only decompress it if a delta actually needs it.
+	const bool isReference = header.isDiff() || (header.isTemplate() && header.getBitRate() != 0);
+
+	if (isReference)
+	{
+		pendingReferencePosition = dataPosition;
+		pendingReferenceHeader = header;
+	}
+
+	if (numBytes > 0)
+		input.setPosition(dataPosition + numBytes);
 
+	LOG("DEC  " + String(readOffset + readIndex + indexInBlock) + "\t\t\tSkipped cycle: " + String(numSamples));
 
+	skipToUse -= numSamples;
+	indexInBlock += (uint16)numSamples;
+
+	return true;
+}
+
+void HlacDecoder::restorePendingReferenceCycle(InputStream& input)
+{
+	jassert(pendingReferencePosition != -1);
+
+	const auto position = input.getPosition();
+	input.setPosition(pendingReferencePosition);
+
+	if (pendingReferenceHeader.isDiff())
+		decompressDiffIntoCurrentCycle(pendingReferenceHeader, input);
+	else
+	{
+		auto numSamples = pendingReferenceHeader.getNumSamples();
+		auto compressor = collection.getSuitableCompressorForBitRate(pendingReferenceHeader.getBitRate());
+		auto data = readCompressedData(input, compressor->getByteAmount(numSamples));
+
+		compressor->decompress(currentCycle.getWritePointer(), data, numSamples);
+	}
+
+	input.setPosition(position);
+	pendingReferencePosition = -1;
+}
 
 void HlacDecoder::decodeCycle(const CycleHeader& header, bool /*decodeStereo*/, HiseSampleBuffer& destination, InputStream& input, int channelIndex)
 {
@@ -234,8 +329,10 @@ void HlacDecoder::decodeCycle(const CycleHeader& header, bool /*decodeStereo*/,
 	auto compressor = collection.getSuitableCompressorForBitRate(br);
 	auto numBytesToRead = compressor->getByteAmount(numSamples);
 
+	const uint8* data = nullptr;
+
 	if (numBytesToRead > 0)
-		input.read(readBuffer.getData(), numBytesToRead);
+		data = readCompressedData(input, numBytesToRead);
 
 	if (header.isTemplate())
 	{
@@ -243,7 +340,7 @@ void HlacDecoder::decodeCycle(const CycleHeader& header, bool /*decodeStereo*/,
 
         if (compressor->getAllowedBitRange() != 0)
 		{
-			compressor->decompress(currentCycle.getWritePointer(), (const uint8*)readBuffer.getData(), numSamples);
+			compressor->decompress(currentCycle.getWritePointer(), data, numSamples);
 
 			writeToFloatArray(true, false, destination, channelIndex, numSamples);
 		}
@@ -256,9 +353,21 @@ void HlacDecoder::decodeCycle(const CycleHeader& header, bool /*decodeStereo*/,
 	{
         LOG("DEC  " + String(readOffset + indexInBlock) + "\t\t\t\tNew Delta with bit depth " + String(compressor->getAllowedBitRange()) + ": " + String(numSamples) + " Index in Block:" + String(indexInBlock));
         
-		if (compressor->getAllowedBitRange() > 0)
+		if (auto dst = compressor->getAllowedBitRange() > 0 ? getDirectWritePointer(destination, channelIndex, numSamples) : nullptr)
+		{
+			// Skip the work buffer and decompress the delta straight into the streaming buffer
+			compressor->decompress(dst, data, numSamples);
+
+			CompressionHelpers::IntVectorOperations::add(dst, currentCycle.getReadPointer(), numSamples);
+
+			if (channelIndex == 0)
+				leftFloatIndex += numSamples;
+			else
+				rightFloatIndex += numSamples;
+		}
+		else if (compressor->getAllowedBitRange() > 0)
 		{
-			compressor->decompress(workBuffer.getWritePointer(), (const uint8*)readBuffer.getData(), numSamples);
+			compressor->decompress(workBuffer.getWritePointer(), data, numSamples);
 
 			CompressionHelpers::IntVectorOperations::add(workBuffer.getWritePointer(), currentCycle.getReadPointer(), numSamples);
 			
@@ -396,8 +505,48 @@ void HlacDecoder::writeToFloatArray(bool shouldCopy, bool useTempBuffer, HiseSam
 	
 }
 
+const uint8* HlacDecoder::readCompressedData(InputStream& input, int numBytes)
+{
+	if (mappedInput != nullptr)
+	{
+		auto position = mappedInput->getPosition();
+
+		if (position + numBytes <= (int64)mappedInput->getDataSize())
+		{
+			mappedInput->setPosition(position + numBytes);
+			return static_cast<const uint8*>(mappedInput->getData()) + position;
+		}
+	}
+
+	input.read(readBuffer.getData(), numBytes);
+	return static_cast<const uint8*>(readBuffer.getData());
+}
+
+int16* HlacDecoder::getDirectWritePointer(HiseSampleBuffer& destination, int channelIndex, int numSamples)
+{
+	if (destination.isFloatingPoint())
+		return nullptr;
+
+	if (channelIndex == 1 && destination.getNumChannels() != 2)
+		return nullptr;
+
+	const int skipToUse = channelIndex == 0 ? leftNumToSkip : rightNumToSkip;
+
+	if (skipToUse != 0)
+		return nullptr;
+
+	const int bufferOffset = channelIndex == 0 ? leftFloatIndex : rightFloatIndex;
+
+	if (bufferOffset + numSamples > destination.getNumSamples())
+		return nullptr;
+
+	return static_cast<int16*>(destination.getWritePointer(channelIndex, bufferOffset));
+}
+
 void HlacDecoder::seekToPosition(InputStream& input, uint32 position, uint32 byteOffset)
 {
+	pendingReferencePosition = -1;
+
 	if (position % COMPRESSION_BLOCK_SIZE == 0)
 	{
 		input.setPosition(byteOffset);
@@ -95,6 +95,21 @@ private:
 
 	void decodeCycle(const CycleHeader& header, bool decodeStereo, HiseSampleBuffer& destination, InputStream& input, int channelIndex);
 
+	void decompressDiffIntoCurrentCycle(const CycleHeader& header, InputStream& input);
+
+	/** Returns the number of compressed bytes that follow the given cycle header. */
+	int getCompressedSize(const CycleHeader& header);
+
+	/** Skips the data of a cycle without decompressing it if all of its samples are before the seek position.
+	*
+	*	The cycle headers work as a seek index within the block, so starting a voice in the middle of a
+	*	block only needs to decompress the cycles that are actually played back.
+	*/
+	bool skipCycle(const CycleHeader& header, InputStream& input, int channelIndex);
+
+	/** Decompresses the last skipped template or diff into the current cycle if a delta cycle refers to it. */
+	void restorePendingReferenceCycle(InputStream& input);
+
 	enum class FloatWriteMode
 	{
 		Copy,
@@ -105,6 +120,15 @@ private:
 
 	void writeToFloatArray(bool shouldCopy, bool useTempBuffer, HiseSampleBuffer& destination, int channelIndex, int numSamples);
 
+	/** Returns a pointer to the compressed data and advances the stream.
+	*
+	*	If the input is a memory mapped stream, this returns a pointer to the mapped data instead of copying it into the read buffer.
+	*/
+	const uint8* readCompressedData(InputStream& input, int numBytes);
+
+	/** Returns a pointer into the destination if the decompressed samples can be written directly into the (fixed point) buffer or nullptr otherwise. */
+	int16* getDirectWritePointer(HiseSampleBuffer& destination, int channelIndex, int numSamples);
+
 	CycleHeader readCycleHeader(InputStream& input);
 
 	BitCompressors::Collection collection;
@@ -128,6 +152,11 @@ private:
 
 	MemoryBlock readBuffer;
 
+	MemoryInputStream* mappedInput = nullptr;
+
+	int64 pendingReferencePosition = -1;
+	CycleHeader pendingReferenceHeader = { 0, 0 };
+
 	float ratio = 0.0f;
 
 	int readOffset = 0;
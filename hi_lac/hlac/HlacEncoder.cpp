@@ -32,6 +32,139 @@
 
 namespace hlac { using namespace juce; 
 
+/** Compresses batches of full blocks on a thread pool.
+
+	Every thread (including the calling thread) uses its own encoder and grabs the next block from the batch
+	until it's exhausted. The encoded blocks are then written in order by the calling thread. 
+*/
+struct HlacEncoder::ParallelEncoder
+{
+	struct Job : public ThreadPoolJob
+	{
+		Job(ParallelEncoder& parent_) :
+			ThreadPoolJob("HLAC Encoder"),
+			parent(parent_)
+		{}
+
+		JobStatus runJob() override
+		{
+			parent.encodePendingBlocks(encoder);
+			return jobHasFinished;
+		}
+
+		ParallelEncoder& parent;
+		HlacEncoder encoder;
+	};
+
+	struct EncodedBlock
+	{
+		MemoryBlock data;
+		uint32 numBytesWritten = 0;
+	};
+
+	ParallelEncoder(int numThreads_) :
+		numThreads(numThreads_),
+		pool(numThreads_ - 1)
+	{
+		for (int i = 0; i < numThreads - 1; i++)
+			helpers.add(new Job(*this));
+
+		blocks.resize(numThreads * NumBlocksPerThread);
+	}
+
+	~ParallelEncoder()
+	{
+		pool.removeAllJobs(true, -1);
+	}
+
+	void encodePendingBlocks(HlacEncoder& e)
+	{
+		for (int i = nextBlock++; i < numBlocksInBatch; i = nextBlock++)
+		{
+			auto& b = blocks[i];
+
+			MemoryOutputStream mos(b.data, false);
+			b.numBytesWritten = e.encodeFullBlock(*source, batchOffset + i * COMPRESSION_BLOCK_SIZE, mos);
+		}
+	}
+
+	void encode(HlacEncoder& parent, AudioSampleBuffer& s, OutputStream& output, uint32* blockOffsetData, int numBlocks)
+	{
+		source = &s;
+
+		callerEncoder.options = parent.options;
+		callerEncoder.currentNormaliseBitShiftAmount = parent.currentNormaliseBitShiftAmount;
+
+		for (auto j : helpers)
+		{
+			j->encoder.options = parent.options;
+			j->encoder.currentNormaliseBitShiftAmount = parent.currentNormaliseBitShiftAmount;
+		}
+
+		const int batchSize = (int)blocks.size();
+
+		for (int batchStart = 0; batchStart < numBlocks; batchStart += batchSize)
+		{
+			numBlocksInBatch = jmin(batchSize, numBlocks - batchStart);
+			batchOffset = (int)parent.blockOffset + batchStart * COMPRESSION_BLOCK_SIZE;
+			nextBlock = 0;
+
+			for (auto j : helpers)
+				pool.addJob(j, false);
+
+			encodePendingBlocks(callerEncoder);
+
+			for (auto j : helpers)
+				pool.waitForJobToFinish(j, -1);
+
+			for (int i = 0; i < numBlocksInBatch; i++)
+			{
+				const auto& b = blocks[i];
+
+				blockOffsetData[parent.blockIndex] = parent.numBytesWritten;
+				++parent.blockIndex;
+
+				output.write(b.data.getData(), b.data.getSize());
+
+				parent.numBytesWritten += b.numBytesWritten;
+				parent.numBytesUncompressed += (uint32)(s.getNumChannels() * COMPRESSION_BLOCK_SIZE * 2);
+			}
+		}
+
+		source = nullptr;
+	}
+
+	static constexpr int NumBlocksPerThread = 8;
+
+	const int numThreads;
+
+	HlacEncoder callerEncoder;
+	OwnedArray<Job> helpers;
+	std::vector<EncodedBlock> blocks;
+
+	AudioSampleBuffer* source = nullptr;
+	int batchOffset = 0;
+	int numBlocksInBatch = 0;
+	std::atomic<int> nextBlock = { 0 };
+
+	ThreadPool pool;
+};
+
+HlacEncoder::HlacEncoder():
+	currentCycle(0),
+	workBuffer(0)
+{
+	reset();
+}
+
+void HlacEncoder::setNumThreads(int newNumThreads)
+{
+	if (newNumThreads <= 1)
+		parallelEncoder = nullptr;
+	else if (parallelEncoder == nullptr || parallelEncoder->numThreads != newNumThreads)
+		parallelEncoder = new ParallelEncoder(newNumThreads);
+}
+
 void HlacEncoder::compress(AudioSampleBuffer& source, OutputStream& output, uint32* blockOffsetData)
 {
 	bool compressStereo = source.getNumChannels() == 2;
@@ -67,31 +200,25 @@ void HlacEncoder::compress(AudioSampleBuffer& source, OutputStream& output, uint
 	blockOffset = 0;
 	int32 numSamplesRemaining = source.getNumSamples();
 
-	while (numSamplesRemaining >= COMPRESSION_BLOCK_SIZE)
+	if (parallelEncoder != nullptr && numSamplesRemaining >= 2 * COMPRESSION_BLOCK_SIZE)
 	{
-		blockOffsetData[blockIndex] = numBytesWritten;
-		++blockIndex;
+		const int numFullBlocks = numSamplesRemaining / COMPRESSION_BLOCK_SIZE;
 
-		uint32 numTodo = jmin<int>(COMPRESSION_BLOCK_SIZE, source.getNumSamples());
+		parallelEncoder->encode(*this, source, output, blockOffsetData, numFullBlocks);
 
-		if (compressStereo)
-		{
-			auto l = CompressionHelpers::getPart(source, 0, blockOffset, numTodo);
-			auto r = CompressionHelpers::getPart(source, 1, blockOffset, numTodo);
+		blockOffset += numFullBlocks * COMPRESSION_BLOCK_SIZE;
+		numSamplesRemaining -= numFullBlocks * COMPRESSION_BLOCK_SIZE;
+	}
 
-			encodeBlock(l, output);
-			encodeBlock(r, output);
-		}
-		else
-		{
-			auto b = CompressionHelpers::getPart(source, blockOffset, numTodo);
-			
-			encodeBlock(b, output);
-		}
+	while (numSamplesRemaining >= COMPRESSION_BLOCK_SIZE)
+	{
+		blockOffsetData[blockIndex] = numBytesWritten;
+		++blockIndex;
 
-		blockOffset += numTodo;
+		encodeFullBlock(source, blockOffset, output);
 
-		numSamplesRemaining -= numTodo;
+		blockOffset += COMPRESSION_BLOCK_SIZE;
+		numSamplesRemaining -= COMPRESSION_BLOCK_SIZE;
 	}
 
 	if (source.getNumSamples() - blockOffset > 0)
@@ -150,6 +277,28 @@ float HlacEncoder::getCompressionRatio() const
 	return (float)(numBytesWritten) / (float)(numBytesUncompressed);
 }
 
+uint32 HlacEncoder::encodeFullBlock(AudioSampleBuffer& source, int offset, OutputStream& output)
+{
+	const auto numBytesBefore = numBytesWritten;
+
+	if (source.getNumChannels() == 2)
+	{
+		auto l = CompressionHelpers::getPart(source, 0, offset, COMPRESSION_BLOCK_SIZE);
+		auto r = CompressionHelpers::getPart(source, 1, offset, COMPRESSION_BLOCK_SIZE);
+
+		encodeBlock(l, output);
+		encodeBlock(r, output);
+	}
+	else
+	{
+		auto b = CompressionHelpers::getPart(source, offset, COMPRESSION_BLOCK_SIZE);
+
+		encodeBlock(b, output);
+	}
+
+	return numBytesWritten - numBytesBefore;
+}
+
 bool HlacEncoder::encodeBlock(AudioSampleBuffer& block, OutputStream& output)
 {
 	auto block16 = CompressionHelpers::AudioBufferInt16(block, 0, options.normalisationMode, options.normalisationThreshold);
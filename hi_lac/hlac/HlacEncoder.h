@@ -40,12 +40,7 @@ class HlacEncoder
 {
 public:
 
-	HlacEncoder():
-		currentCycle(0),
-		workBuffer(0)
-	{
-		reset();
-	};
+	HlacEncoder();
 
 	~HlacEncoder();
 
@@ -137,12 +132,25 @@ public:
 		options = newOptions;
 	}
 
+	/** Sets the number of threads that are used to compress the blocks. 
+	
+		If this is bigger than one, the blocks of a buffer will be compressed in parallel by a 
+		set of helper encoders and written in their original order, so the encoded data is the 
+		same as with a single thread. 
+	*/
+	void setNumThreads(int newNumThreads);
+
 	float getCompressionRatio() const;
 
 	uint32 getNumBlocksWritten() const { return blockIndex; }
 
 private:
 
+	struct ParallelEncoder;
+
+	/** Compresses the (mono or stereo) block at the given position and returns the number of bytes it added. */
+	uint32 encodeFullBlock(AudioSampleBuffer& source, int offset, OutputStream& output);
+
 	bool encodeBlock(AudioSampleBuffer& block, OutputStream& output);
 
 	bool encodeBlock(CompressionHelpers::AudioBufferInt16& block, OutputStream& output);
@@ -207,6 +215,8 @@ private:
 	uint64 readIndex = 0;
 
 	double decompressionSpeed = 0.0;
+
+	ScopedPointer<ParallelEncoder> parallelEncoder;
 };
 
 } // namespace hlac
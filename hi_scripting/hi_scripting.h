@@ -89,6 +89,14 @@ compile / debug cycle and don't need all nodes in scriptnode you might want to t
 #define HISE_CREATE_DSP_NETWORKS_FOR_HARDCODED_NODES 0
 #endif
 
+/** If this is set to 1, the callbacks of a script will be compiled to bytecode for a register based VM
+ *  after the optimisation passes were applied. Every expression that the VM doesn't support will be executed
+ *  by the syntax tree, so this should behave exactly like the default interpreter.
+ */
+#ifndef HISE_USE_SCRIPT_BYTECODE
+#define HISE_USE_SCRIPT_BYTECODE 0
+#endif
+
 #define MAX_SCRIPT_HEIGHT 700
 
 #include "AppConfig.h"
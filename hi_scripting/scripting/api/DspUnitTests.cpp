@@ -1940,6 +1940,989 @@ private:
 
 static CustomContainerTest unorderedStackTest;
 
+class StreamingTelemetryTest : public UnitTest
+{
+public:
+
+	StreamingTelemetryTest() :
+		UnitTest("Testing streaming telemetry")
+	{}
+
+	void runTest() override
+	{
+		testConcurrentReadAndWrite();
+	}
+
+private:
+
+	using Record = StreamingTelemetry::Record;
+
+	/** Writes records where every field is derived from the same counter, so a torn record can be detected. */
+	struct Writer : public Thread
+	{
+		Writer(StreamingTelemetry& t_, int writerIndex_, int numToWrite_) :
+			Thread("Telemetry Writer " + String(writerIndex_)),
+			t(t_),
+			writerIndex(writerIndex_),
+			numToWrite(numToWrite_)
+		{}
+
+		static Record createRecord(int writerIndex, int counter)
+		{
+			Record r;
+			r.voiceId = (uint32)writerIndex;
+			r.positionInFile = counter;
+			r.numSamples = counter * 2;
+			r.soundHash = (int64)counter * 3;
+			r.monolithOffset = (int64)counter * 5;
+			r.requestTime = (double)counter;
+			r.completionTime = (double)counter + 0.5;
+			return r;
+		}
+
+		static bool isConsistent(const Record& r)
+		{
+			const auto c = r.positionInFile;
+
+			return r.numSamples == c * 2 &&
+				   r.soundHash == (int64)c * 3 &&
+				   r.monolithOffset == (int64)c * 5 &&
+				   r.requestTime == (double)c &&
+				   r.completionTime == (double)c + 0.5;
+		}
+
+		void run() override
+		{
+			for (int i = 0; i < numToWrite; i++)
+				t.addRecord(createRecord(writerIndex, i));
+		}
+
+		StreamingTelemetry& t;
+		const int writerIndex;
+		const int numToWrite;
+	};
+
+	void testConcurrentReadAndWrite()
+	{
+		beginTest("Testing concurrent addRecord() and copyRecords()");
+
+		StreamingTelemetry t;
+		t.setEnabled(true);
+
+		static constexpr int NumWriters = 3;
+		static constexpr int NumPerWriter = StreamingTelemetry::NumRecords * 16;
+
+		OwnedArray<Writer> writers;
+
+		for (int i = 0; i < NumWriters; i++)
+			writers.add(new Writer(t, i, NumPerWriter));
+
+		for (auto w : writers)
+			w->startThread();
+
+		int numTornRecords = 0;
+		int numCopies = 0;
+
+		auto isRunning = [&writers]()
+		{
+			for (auto w : writers)
+			{
+				if (w->isThreadRunning())
+					return true;
+			}
+
+			return false;
+		};
+
+		while (isRunning() || numCopies == 0)
+		{
+			Array<Record> records;
+			t.copyRecords(records);
+
+			expect(records.size() <= StreamingTelemetry::NumRecords, "Too many records");
+
+			for (const auto& r : records)
+			{
+				if (!Writer::isConsistent(r))
+					numTornRecords++;
+			}
+
+			numCopies++;
+		}
+
+		for (auto w : writers)
+			w->waitForThreadToExit(-1);
+
+		expectEquals(numTornRecords, 0, "Torn records after " + String(numCopies) + " copies");
+
+		// Without concurrent writes, the ring buffer must contain the last records of each writer in order
+		Array<Record> records;
+		t.copyRecords(records);
+
+		expectEquals(records.size(), (int)StreamingTelemetry::NumRecords, "Number of records after writing");
+
+		int lastCounter[NumWriters] = { -1, -1, -1 };
+
+		for (const auto& r : records)
+		{
+			expect(Writer::isConsistent(r), "Torn record after writing");
+
+			auto& last = lastCounter[r.voiceId];
+			expect(r.positionInFile > last, "Wrong order for writer " + String(r.voiceId));
+			last = r.positionInFile;
+		}
+	}
+};
+
+static StreamingTelemetryTest streamingTelemetryTest;
+
+
+class ParallelVoiceRenderingTest : public UnitTest
+{
+public:
+
+	ParallelVoiceRenderingTest() :
+		UnitTest("Parallel voice rendering")
+	{}
+
+	void runTest() override
+	{
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		testSineSynth(256);
+		testSineSynth(77);
+	}
+
+private:
+
+	void testSineSynth(int blockSize)
+	{
+		beginTest("Testing parallel SineSynth rendering with block size " + String(blockSize));
+
+		auto expected = render(0, blockSize);
+		auto actual = render(3, blockSize);
+
+		expectEquals(actual.getNumSamples(), expected.getNumSamples());
+
+		for (int c = 0; c < 2; c++)
+		{
+			auto size = sizeof(float) * (size_t)expected.getNumSamples();
+			auto equal = memcmp(expected.getReadPointer(c), actual.getReadPointer(c), size) == 0;
+
+			expect(equal, "Channel " + String(c) + " is not bit-identical");
+		}
+
+		expect(expected.getMagnitude(0, expected.getNumSamples()) > 0.0f, "Silent output");
+	}
+
+	AudioSampleBuffer render(int numThreads, int blockSize)
+	{
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+
+		bp->setNumAudioRenderingThreads(numThreads);
+
+		ScopedPointer<SineSynth> sine = new SineSynth(bp, "TestProcessor", NUM_POLYPHONIC_VOICES);
+
+		sine->addProcessorsWhenEmpty();
+		sine->setAttribute(ModulatorSynth::Parameters::Gain, 0.1f, dontSendNotification);
+
+		bp->getMainSynthChain()->getHandler()->add(sine.release(), nullptr);
+
+		MidiBuffer midi;
+
+		// Release the notes at different times so that voices are reset while the others are rendered
+		for (int i = 0; i < 24; i++)
+		{
+			midi.addEvent(MidiMessage::noteOn(1, 40 + i, 0.3f + 0.02f * (float)i), i * 13);
+			midi.addEvent(MidiMessage::noteOff(1, 40 + i), 8000 + i * 1100);
+		}
+
+		AudioSampleBuffer output(2, 44100);
+		output.clear();
+
+		bp->prepareToPlay(44100.0, blockSize);
+
+		expect(numThreads == 0 || bp->getAudioRenderingThreadPool() != nullptr, "No rendering pool");
+
+		for (int offset = 0; offset < output.getNumSamples(); offset += blockSize)
+		{
+			auto numThisTime = jmin(blockSize, output.getNumSamples() - offset);
+
+			float* d[2] = { output.getWritePointer(0, offset), output.getWritePointer(1, offset) };
+
+			AudioSampleBuffer subAudio(d, 2, numThisTime);
+			MidiBuffer subMidi;
+			subMidi.addEvents(midi, offset, numThisTime, -offset);
+
+			bp->processBlock(subAudio, subMidi);
+		}
+
+		return output;
+	}
+};
+
+static ParallelVoiceRenderingTest parallelVoiceRenderingTest;
+
+class SoundLookupIndexTest : public UnitTest
+{
+public:
+
+	SoundLookupIndexTest() :
+		UnitTest("Sound lookup index")
+	{}
+
+	void runTest() override
+	{
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		beginTest("Testing the sound lookup before and after a samplemap switch");
+
+		auto folder = File::createTempFile("SoundLookupIndexTest");
+		folder.createDirectory();
+
+		auto fileA = writeTestFile(folder.getChildFile("A.wav"));
+		auto fileB = writeTestFile(folder.getChildFile("B.wav"));
+
+		{
+			ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+			ScopedPointer<ModulatorSampler> sampler = new ModulatorSampler(bp, "TestProcessor", 8);
+
+			auto s = sampler.get();
+
+			bp->getMainSynthChain()->getHandler()->add(sampler.release(), nullptr);
+			bp->prepareToPlay(44100.0, 512);
+
+			s->getSampleMap()->loadUnsavedValueTree(createSampleMap(fileA, 60, 64));
+
+			expect(s->rebuildSoundLookupIndexIfOutdated(), "The index for the first samplemap wasn't built");
+			expectEquals(collect(s, 62), 1, "Wrong sound count for the first samplemap");
+			expectEquals(collect(s, 71), 0, "Wrong sound count for the first samplemap");
+
+			WeakReference<ModulatorSamplerSound> oldSound = dynamic_cast<ModulatorSamplerSound*>(s->getSound(0));
+
+			s->getSampleMap()->loadUnsavedValueTree(createSampleMap(fileB, 70, 72));
+
+			expect(oldSound.get() == nullptr, "The index keeps the sound of the old samplemap alive");
+
+			// The index wasn't rebuilt yet, so it must not return the deleted sound
+			expectEquals(collect(s, 62), 0, "Outdated index was used");
+			expectEquals(collect(s, 71), 1, "Outdated index was used");
+
+			expect(s->rebuildSoundLookupIndexIfOutdated(), "The index for the second samplemap wasn't built");
+			expectEquals(collect(s, 62), 0, "Wrong sound count for the second samplemap");
+			expectEquals(collect(s, 71), 1, "Wrong sound count for the second samplemap");
+		}
+
+		folder.deleteRecursively();
+	}
+
+private:
+
+	static int collect(ModulatorSampler* s, int noteNumber)
+	{
+		HiseEvent e(HiseEvent::Type::NoteOn, (uint8)noteNumber, 100);
+		return s->collectSoundsToBeStarted(e);
+	}
+
+	static File writeTestFile(const File& f)
+	{
+		AudioSampleBuffer b(2, 4410);
+
+		for (int i = 0; i < b.getNumSamples(); i++)
+		{
+			auto v = 0.5f * std::sin((float)i * 0.05f);
+			b.setSample(0, i, v);
+			b.setSample(1, i, v);
+		}
+
+		WavAudioFormat wav;
+		std::unique_ptr<AudioFormatWriter> w(wav.createWriterFor(new FileOutputStream(f), 44100.0, 2, 16, {}, 0));
+
+		if (w != nullptr)
+			w->writeFromAudioSampleBuffer(b, 0, b.getNumSamples());
+
+		return f;
+	}
+
+	static ValueTree createSampleMap(const File& f, int loKey, int hiKey)
+	{
+		ValueTree v("samplemap");
+		v.setProperty("ID", "SoundLookupIndexTest", nullptr);
+		v.setProperty("SaveMode", 0, nullptr);
+		v.setProperty("RRGroupAmount", 1, nullptr);
+		v.setProperty("MicPositions", ";", nullptr);
+
+		ValueTree sample("sample");
+		sample.setProperty(SampleIds::FileName, f.getFullPathName(), nullptr);
+		sample.setProperty(SampleIds::Root, loKey, nullptr);
+		sample.setProperty(SampleIds::LoKey, loKey, nullptr);
+		sample.setProperty(SampleIds::HiKey, hiKey, nullptr);
+		sample.setProperty(SampleIds::LoVel, 0, nullptr);
+		sample.setProperty(SampleIds::HiVel, 127, nullptr);
+		sample.setProperty(SampleIds::RRGroup, 1, nullptr);
+
+		v.addChild(sample, -1, nullptr);
+
+		return v;
+	}
+};
+
+static SoundLookupIndexTest soundLookupIndexTest;
+
+class BinarySampleMapTest : public UnitTest
+{
+public:
+
+	BinarySampleMapTest() :
+		UnitTest("Binary samplemap")
+	{}
+
+	void runTest() override
+	{
+		testRoundTrip();
+		testFile();
+		testInvalidData();
+	}
+
+private:
+
+	void testRoundTrip()
+	{
+		beginTest("Testing ValueTree -> .hsm -> ValueTree");
+
+		auto original = createSampleMap();
+
+		expectRoundTrip(original);
+
+		// The samplemap pool loads the XML files, so all properties are strings
+		auto fromXml = ValueTree::fromXml(*original.createXml());
+		expectRoundTrip(fromXml);
+
+		expectRoundTrip(ValueTree("samplemap"));
+	}
+
+	void testFile()
+	{
+		beginTest("Testing the binary samplemap file");
+
+		auto folder = File::createTempFile("BinarySampleMapTest");
+		folder.createDirectory();
+
+		auto xmlFile = folder.getChildFile("Map.xml");
+		auto binaryFile = xmlFile.withFileExtension(BinarySampleMap::getFileExtension());
+
+		auto original = createSampleMap();
+
+		xmlFile.replaceWithText(original.createXml()->createDocument(""));
+		expect(BinarySampleMap::getUpToDateBinaryFile(xmlFile) == File(), "Missing binary file was found");
+
+		expect(BinarySampleMap::writeToFile(original, binaryFile).wasOk(), "Can't write the binary file");
+		expect(BinarySampleMap::getUpToDateBinaryFile(xmlFile) == binaryFile, "Binary file wasn't found");
+
+		{
+			BinarySampleMap bm(binaryFile);
+			expect(bm.isValid(), "Mapped file is invalid");
+			expectEquals(bm.getNumSamples(), original.getNumChildren());
+			expectEquivalent(original, bm.createValueTree());
+		}
+
+		xmlFile.setLastModificationTime(binaryFile.getLastModificationTime() + RelativeTime::seconds(10));
+		expect(BinarySampleMap::getUpToDateBinaryFile(xmlFile) == File(), "Outdated binary file was used");
+
+		folder.deleteRecursively();
+	}
+
+	void testInvalidData()
+	{
+		beginTest("Testing invalid data");
+
+		MemoryOutputStream mos;
+		expect(BinarySampleMap::write(createSampleMap(), mos).wasOk());
+
+		{
+			BinarySampleMap truncated(mos.getData(), mos.getDataSize() - 1);
+			expect(!truncated.isValid(), "Truncated data was accepted");
+			expectEquals(truncated.getNumSamples(), 0);
+		}
+
+		{
+			MemoryBlock mb(mos.getData(), mos.getDataSize());
+			mb[0] = 0;
+
+			BinarySampleMap wrongMagic(mb.getData(), mb.getSize());
+			expect(!wrongMagic.isValid(), "Data with wrong magic number was accepted");
+		}
+
+		auto unsupported = createSampleMap();
+		unsupported.getChild(0).setProperty("Array", Array<var>({ 1, 2 }), nullptr);
+
+		MemoryOutputStream mos2;
+		expect(BinarySampleMap::write(unsupported, mos2).failed(), "Array property was written");
+	}
+
+	void expectRoundTrip(const ValueTree& original)
+	{
+		MemoryOutputStream mos;
+		auto r = BinarySampleMap::write(original, mos);
+
+		expect(r.wasOk(), r.getErrorMessage());
+
+		BinarySampleMap bm(mos.getData(), mos.getDataSize());
+
+		expect(bm.isValid(), "Written data is invalid");
+		expectEquals(bm.getNumSamples(), original.getNumChildren());
+
+		expectEquivalent(original, bm.createValueTree());
+
+		for (int i = 0; i < bm.getNumSamples(); i++)
+			expectEquivalent(original.getChild(i), bm.createSampleTree(i));
+	}
+
+	// The order of the properties is not preserved, so we compare them by name
+	void expectEquivalent(const ValueTree& expected, const ValueTree& actual)
+	{
+		expectEquals(actual.getType().toString(), expected.getType().toString());
+		expectEquals(actual.getNumProperties(), expected.getNumProperties(), "Property count mismatch in " + expected.getType().toString());
+
+		for (int i = 0; i < expected.getNumProperties(); i++)
+		{
+			auto id = expected.getPropertyName(i);
+
+			expect(actual.hasProperty(id), "Missing property " + id.toString());
+			expectEquals(actual[id].toString(), expected[id].toString(), "Value mismatch for " + id.toString());
+		}
+
+		expectEquals(actual.getNumChildren(), expected.getNumChildren(), "Child count mismatch");
+
+		for (int i = 0; i < jmin(actual.getNumChildren(), expected.getNumChildren()); i++)
+			expectEquivalent(expected.getChild(i), actual.getChild(i));
+	}
+
+	static ValueTree createSampleMap()
+	{
+		ValueTree v("samplemap");
+		v.setProperty("ID", "BinaryTest", nullptr);
+		v.setProperty("SaveMode", 0, nullptr);
+		v.setProperty("RRGroupAmount", 2, nullptr);
+		v.setProperty("MicPositions", "Close;Far;", nullptr);
+		v.setProperty("CrossfadeGamma", 1.5, nullptr);
+
+		for (int i = 0; i < 20; i++)
+		{
+			ValueTree s("sample");
+
+			s.setProperty(SampleIds::ID, i, nullptr);
+			s.setProperty(SampleIds::Root, 40 + i, nullptr);
+			s.setProperty(SampleIds::LoKey, 40 + i, nullptr);
+			s.setProperty(SampleIds::HiKey, 41 + i, nullptr);
+			s.setProperty(SampleIds::LoVel, 0, nullptr);
+			s.setProperty(SampleIds::HiVel, 127, nullptr);
+			s.setProperty(SampleIds::RRGroup, 1 + i % 2, nullptr);
+			s.setProperty(SampleIds::Volume, -3.25 * (double)i, nullptr);
+			s.setProperty(SampleIds::Normalized, i % 3 == 0, nullptr);
+			s.setProperty(SampleIds::Pitch, "0.50", nullptr);
+			s.setProperty("MonolithOffset", (int64)1 << 40, nullptr);
+			s.setProperty("CustomProperty", "Some text " + String(i), nullptr);
+
+			if (i % 4 == 0)
+			{
+				// a single mic sample with the file name as property
+				s.setProperty(SampleIds::FileName, "{PROJECT_FOLDER}Sample" + String(i) + ".wav", nullptr);
+			}
+			else
+			{
+				for (auto m : { "Close", "Far" })
+				{
+					ValueTree f("file");
+					f.setProperty(SampleIds::FileName, "{PROJECT_FOLDER}Sample" + String(i) + "_" + m + ".wav", nullptr);
+					s.addChild(f, -1, nullptr);
+				}
+			}
+
+			v.addChild(s, -1, nullptr);
+		}
+
+		return v;
+	}
+};
+
+static BinarySampleMapTest binarySampleMapTest;
+
+class ScriptBytecodeTest : public UnitTest
+{
+public:
+
+	ScriptBytecodeTest() :
+		UnitTest("Script bytecode")
+	{}
+
+	void runTest() override
+	{
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		beginTest("Testing operators");
+
+		expectSameResult("reg r1 = 3; const var c1 = 7; var g = 2.5;",
+			R"(local a = 5; local b = 2; local s = "12"; local u;
+			   local out = [];
+			   out.push(a + b, a - b, a * b, a / b, a % b, -a);
+			   out.push(a + g, c1 / g, r1 * c1, s + a, a + s, s * 2);
+			   out.push(a == b, a != b, a < b, a >= c1, s == 12, s === 12, s !== "12");
+			   out.push(a & 3, a | 8, a ^ b, a << 3, -a >> 1, u == undefined);
+			   out.push(a > 2 && b > 2, a > 2 || b > 2, !a, a > 4 ? "yes" : "no");
+			   out.push(a++, a, ++a, b--, --b);
+			   a += 3; b *= 4; r1 -= 1; g /= 2;
+			   out.push(a, b, r1, g);
+			   r1 = r1 + (r1 = 10);
+			   out.push(r1);
+			   return out;)");
+
+		beginTest("Testing short circuit evaluation");
+
+		expectSameResult("reg counter = 0; inline function inc(){ counter++; return true; };",
+			R"(local out = [];
+			   local a = false && inc();
+			   local b = true || inc();
+			   local c = true && inc();
+			   local d = false || inc();
+			   out.push(a, b, c, d, counter);
+			   out.push(counter > 2 ? inc() : false, counter);
+			   return out;)");
+
+		beginTest("Testing loops");
+
+		expectSameResult("reg total = 0; const var list = [1, 2, 3, 4, 5, 6];",
+			R"(local out = [];
+			   local sum = 0;
+			   local i = 0; local x = 0; local y = 0; local j = 0; local e = 0;
+			   for (i = 0; i < 10; i++)
+			   {
+				   if (i == 2) continue;
+				   if (i == 8) break;
+				   sum += i;
+			   }
+			   out.push(sum);
+			   local n = 0;
+			   while (n < 100) { n += 7; if (n % 5 == 0) break; }
+			   out.push(n);
+			   local k = 0;
+			   local d = 0;
+			   do { k++; if (k % 2 == 0) continue; d += k; } while (k < 9);
+			   out.push(k, d);
+			   local nested = 0;
+			   for (x = 0; x < 4; x++) { for (y = 0; y < 4; y++) { if (y > x) break; nested += y; } }
+			   out.push(nested);
+			   for (e in list) { if (e == 5) break; total += e; }
+			   out.push(total);
+			   for (j = 0; j < 100; j++) { if (j * j > 50) return [out, j]; }
+			   return out;)");
+
+		beginTest("Testing API calls");
+
+		expectSameResult("reg x = 4; const var notes = [60, 64, 67];",
+			R"(local out = [];
+			   local v = 1.7;
+			   out.push(Math.round(v * x), Math.max(x, v), Math.pow(2, x), Math.range(v * 10, 0, x));
+			   out.push(Engine.getMidiNoteName(notes[1]), Engine.getFrequencyForMidiNoteNumber(x + 65));
+			   out.push(Math.max(x++, x), Math.min(x, x--), x);
+			   out.push(Math.abs(Math.min(-x, v)));
+			   return out;)");
+
+		beginTest("Testing errors");
+
+		expectSameResult("reg x = 4;", R"(local u; x = 8; u.callSomething(); return x;)");
+	}
+
+private:
+
+	void expectSameResult(const String& onInit, const String& onNoteOn)
+	{
+		auto expected = runScript(onInit, onNoteOn, false);
+		auto actual = runScript(onInit, onNoteOn, true);
+
+		expect(expected.isNotEmpty(), "No result");
+		expectEquals(actual, expected, "Bytecode result mismatch");
+	}
+
+	/** Runs the onNoteOn callback a few times and returns the results as JSON. */
+	String runScript(const String& onInit, const String& onNoteOn, bool useBytecode)
+	{
+		struct ScopedBytecodeSetter
+		{
+			ScopedBytecodeSetter(bool shouldUseBytecode):
+			  previous(HiseJavascriptEngine::useScriptBytecode.exchange(shouldUseBytecode))
+			{}
+
+			~ScopedBytecodeSetter() { HiseJavascriptEngine::useScriptBytecode.store(previous); }
+
+			const bool previous;
+		} sbs(useBytecode);
+
+		String code;
+		code << "function onInit(){" << onInit << "}";
+		code << "function onNoteOn(){" << onNoteOn << "}";
+		code << "function onNoteOff(){}function onController(){}function onTimer(){}function onControl(number, value){}";
+
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+
+		auto jp = new JavascriptMidiProcessor(bp, "scripter");
+		auto mpc = dynamic_cast<MidiProcessorChain*>(bp->getMainSynthChain()->getChildProcessor(ModulatorSynth::MidiProcessor));
+		jp->setOwnerSynth(bp->getMainSynthChain());
+		jp->parseSnippetsFromString(code, true);
+		mpc->getHandler()->add(jp, nullptr);
+
+		auto engine = jp->getScriptEngine();
+
+		expect(engine->isCallbackCompiledToBytecode(JavascriptMidiProcessor::onNoteOn) == useBytecode, "The bytecode wasn't created");
+
+		Array<var> results;
+
+		for (int i = 0; i < 3; i++)
+		{
+			auto r = Result::ok();
+			auto v = engine->executeCallback(JavascriptMidiProcessor::onNoteOn, &r);
+
+			if (r.failed())
+			{
+				results.add("Error: " + r.getErrorMessage());
+				break;
+			}
+
+			results.add(v);
+		}
+
+		bp = nullptr;
+
+		return JSON::toString(var(results), true);
+	}
+};
+
+static ScriptBytecodeTest scriptBytecodeTest;
+
+class ScriptInlineCacheTest : public UnitTest
+{
+public:
+
+	ScriptInlineCacheTest() :
+		UnitTest("Script inline caches")
+	{}
+
+	void runTest() override
+	{
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		beginTest("Testing property reads with different shapes");
+
+		expectResult("",
+			R"(local out = [];
+			   local o = 0;
+			   local shapes = [{a: 1, b: 2}, {b: 20, a: 10}, {x: 5, y: 6, a: 100, b: 200}, {a: 1000}];
+			   for (o in shapes) out.push(o.a, o["a"]);
+			   return out;)",
+			"[1, 1, 10, 10, 100, 100, 1000, 1000]");
+
+		beginTest("Testing reassigned objects and added properties");
+
+		expectResult("",
+			R"(local out = [];
+			   local i = 0;
+			   local obj = {a: 1, b: 2};
+			   for (i = 0; i < 3; i++)
+			   {
+				   out.push(obj.b);
+				   obj = {b: i + 10, a: 0, c: 1};
+			   }
+			   local grow = {a: 1};
+			   for (i = 0; i < 3; i++)
+			   {
+				   out.push(isDefined(grow.c));
+				   grow.c = i;
+			   }
+			   out.push(grow.a, grow.c);
+			   return out;)",
+			"[2, 10, 11, false, true, true, 1, 2]");
+
+		beginTest("Testing writes with a stale slot");
+
+		expectResult("",
+			R"(local out = [];
+			   local o = 0;
+			   local shapes = [{a: 1, b: 0}, {b: 0, a: 10}, {x: 5, a: 100}, {a: 1000}];
+			   for (o in shapes) o.b = o.a * 2;
+			   for (o in shapes) out.push(o.a, o.b);
+			   out.push(shapes[2].x);
+			   return out;)",
+			"[1, 2, 10, 20, 100, 200, 1000, 2000, 5]");
+
+		beginTest("Testing method calls with different shapes");
+
+		expectResult(R"(const var fns = [{f: function(x){ return x + 1; }, g: 0}, {g: 0, f: function(x){ return x * 2; }}];
+						const var list = Engine.createMidiList();
+						list.setValue(3, 7);
+						const var containers = [Engine.createUnorderedStack(), list];)",
+			R"(local out = [];
+			   local o = 0;
+			   for (o in fns) out.push(o.f(5));
+			   for (o in containers) out.push(o.isEmpty());
+			   out.push(list.getValue(3));
+			   return out;)",
+			"[6, 10, true, false, 7]");
+	}
+
+private:
+
+	/** Runs the onNoteOn callback a few times so that the caches are filled with the shape of the last call. */
+	void expectResult(const String& onInit, const String& onNoteOn, const String& expectedJSON)
+	{
+		String code;
+		code << "function onInit(){" << onInit << "}";
+		code << "function onNoteOn(){" << onNoteOn << "}";
+		code << "function onNoteOff(){}function onController(){}function onTimer(){}function onControl(number, value){}";
+
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+
+		auto jp = new JavascriptMidiProcessor(bp, "scripter");
+		auto mpc = dynamic_cast<MidiProcessorChain*>(bp->getMainSynthChain()->getChildProcessor(ModulatorSynth::MidiProcessor));
+		jp->setOwnerSynth(bp->getMainSynthChain());
+		jp->parseSnippetsFromString(code, true);
+		mpc->getHandler()->add(jp, nullptr);
+
+		expect(jp->getLastErrorMessage().wasOk(), jp->getLastErrorMessage().getErrorMessage());
+
+		auto engine = jp->getScriptEngine();
+		auto expected = JSON::toString(JSON::parse(expectedJSON), true);
+
+		for (int i = 0; i < 3; i++)
+		{
+			auto r = Result::ok();
+			auto v = engine->executeCallback(JavascriptMidiProcessor::onNoteOn, &r);
+
+			expect(r.wasOk(), r.getErrorMessage());
+			expectEquals(JSON::toString(v, true), expected, "Result mismatch in run " + String(i + 1));
+		}
+
+		bp = nullptr;
+	}
+};
+
+static ScriptInlineCacheTest scriptInlineCacheTest;
+
+#if HISE_INCLUDE_SNEX
+class JitFusionTest : public UnitTest
+{
+public:
+
+	JitFusionTest() :
+		UnitTest("JIT fusion of scriptnode networks")
+	{}
+
+	void runTest() override
+	{
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		beginTest("Testing fused network against interpreted nodes");
+
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+
+		{
+			ScopedPointer<JavascriptMasterEffect> fx = new JavascriptMasterEffect(bp, "fx");
+
+			auto network = fx->getOrCreate("dsp");
+			var root(network->getRootNode());
+
+			auto mul = dynamic_cast<scriptnode::NodeBase*>(network->createAndAdd("math.mul", "mul", root).getObject());
+			network->createAndAdd("math.add", "add", root);
+			network->createAndAdd("math.tanh", "tanh", root);
+
+			expect(mul != nullptr, "Can't create node");
+
+			if (mul == nullptr)
+				return;
+
+			mul->getParameterFromIndex(0)->setValueSync(3.0);
+
+			network->setNumChannels(2);
+			network->prepareToPlay(44100.0, 512.0);
+
+			auto interpreted = render(*network);
+
+			expect(network->setUseJitFusion(true), "Can't fuse the network");
+			expect(network->isJitFused(), "The network isn't fused");
+
+			expectSameSignal(render(*network), interpreted, "Fused network mismatch");
+
+			beginTest("Testing fallback after a network change");
+
+			mul->getParameterFromIndex(0)->setValueSync(0.5);
+
+			expect(!network->isJitFused(), "The fused node wasn't discarded");
+
+			auto changed = render(*network);
+
+			expect(changed.getSample(0, 100) != interpreted.getSample(0, 100), "The parameter change wasn't applied");
+
+			expect(network->setUseJitFusion(true), "Can't fuse the network again");
+			expectSameSignal(render(*network), changed, "Fused network mismatch after change");
+
+#if SNEX_MIR_BACKEND
+			beginTest("Testing cold & warm compilation of the fused network");
+
+			// Only use the memory cache so that a file from a previous run doesn't warm up the first compilation
+			auto prevDirectory = snex::mir::MirCodeCache::getCacheDirectory();
+			snex::mir::MirCodeCache::setCacheDirectory(File());
+			snex::mir::MirCodeCache::clear(false);
+
+			auto compileTime = [&]()
+			{
+				network->setUseJitFusion(false);
+
+				auto start = Time::getMillisecondCounterHiRes();
+				expect(network->setUseJitFusion(true), "Can't fuse the network");
+				return Time::getMillisecondCounterHiRes() - start;
+			};
+
+			auto coldTime = compileTime();
+			auto warmTime = compileTime();
+
+			expectSameSignal(render(*network), changed, "Fused network mismatch with cached code");
+
+			logMessage("Cold network compilation: " + String(coldTime, 2) + "ms, warm network compilation: " + String(warmTime, 2) + "ms");
+
+			snex::mir::MirCodeCache::setCacheDirectory(prevDirectory);
+#endif
+
+			fx = nullptr;
+		}
+
+		bp = nullptr;
+	}
+
+private:
+
+	/** Processes a sine sweep in a few blocks and returns the output. */
+	AudioSampleBuffer render(scriptnode::DspNetwork& network)
+	{
+		AudioSampleBuffer output(2, 2048);
+
+		for (int c = 0; c < 2; c++)
+		{
+			for (int i = 0; i < output.getNumSamples(); i++)
+				output.setSample(c, i, 0.8f * std::sin((float)i * (0.01f + 0.005f * (float)c)));
+		}
+
+		network.reset();
+
+		HiseEventBuffer events;
+
+		for (int offset = 0; offset < output.getNumSamples(); offset += 512)
+		{
+			AudioSampleBuffer block(output.getArrayOfWritePointers(), 2, offset, 512);
+			network.process(block, &events);
+		}
+
+		return output;
+	}
+
+	void expectSameSignal(const AudioSampleBuffer& actual, const AudioSampleBuffer& expected, const String& message)
+	{
+		auto maxDelta = 0.0f;
+
+		for (int c = 0; c < expected.getNumChannels(); c++)
+		{
+			for (int i = 0; i < expected.getNumSamples(); i++)
+				maxDelta = jmax(maxDelta, std::abs(actual.getSample(c, i) - expected.getSample(c, i)));
+		}
+
+		expect(maxDelta < 1e-5f, message + ": " + String(maxDelta));
+	}
+};
+
+static JitFusionTest jitFusionTest;
+#endif
+
+class DrawActionRepaintTest : public UnitTest
+{
+public:
+
+	DrawActionRepaintTest() :
+		UnitTest("Partial repaints of draw actions")
+	{}
+
+	struct Listener : public DrawActions::Handler::Listener
+	{
+		void newPaintActionsAvailable(uint64_t) override
+		{
+			numNotifications++;
+			dirtyArea = handler->getDirtyArea();
+		}
+
+		DrawActions::Handler* handler = nullptr;
+		int numNotifications = 0;
+		Rectangle<int> dirtyArea;
+	};
+
+	void runTest() override
+	{
+		ScopedValueSetter<bool> s(MainController::unitTestMode, true);
+
+		ScopedPointer<BackendProcessor> bp = new BackendProcessor(nullptr, nullptr);
+
+		{
+			ScopedPointer<JavascriptMasterEffect> fx = new JavascriptMasterEffect(bp, "fx");
+			ReferenceCountedObjectPtr<ScriptingObjects::GraphicsObject> g = new ScriptingObjects::GraphicsObject(fx, nullptr);
+
+			auto& handler = g->getDrawHandler();
+
+			Listener l;
+			l.handler = &handler;
+			handler.addDrawActionListener(&l);
+
+			auto paint = [&](bool rotate, float x)
+			{
+				handler.beginDrawing();
+
+				if (rotate)
+					g->rotate(0.5, Array<var>({ 50.0f, 50.0f }));
+
+				g->fillRect(Array<var>({ x, 10.0f, 20.0f, 20.0f }));
+				handler.flush(0);
+				handler.handleUpdateNowIfNeeded();
+			};
+
+			beginTest("Testing partial repaint without transform");
+
+			paint(false, 10.0f);
+			expectEquals(l.numNotifications, 1, "first flush");
+			expect(l.dirtyArea.isEmpty(), "first flush must repaint everything");
+
+			paint(false, 10.0f);
+			expectEquals(l.numNotifications, 1, "identical flush must not notify");
+
+			paint(false, 40.0f);
+			expectEquals(l.numNotifications, 2, "moved rectangle");
+			expect(!l.dirtyArea.isEmpty(), "moved rectangle must repaint partially");
+
+			beginTest("Testing full repaint with transform");
+
+			paint(true, 10.0f);
+			expectEquals(l.numNotifications, 3, "added transform");
+
+			paint(true, 10.0f);
+			expectEquals(l.numNotifications, 3, "identical flush with transform must not notify");
+
+			paint(true, 40.0f);
+			expectEquals(l.numNotifications, 4, "moved rectangle with transform");
+			expect(l.dirtyArea.isEmpty(), "a transform must repaint everything");
+
+			handler.removeDrawActionListener(&l);
+		}
+
+		bp = nullptr;
+	}
+};
+
+static DrawActionRepaintTest drawActionRepaintTest;
+
 
 
 #endif
@@ -34,6 +34,11 @@ namespace hise { using namespace juce;
 
 struct ScriptedPostDrawActions
 {
+	template <size_t N> static void addId(DrawActions::ContentHash& h, const char (&id)[N])
+	{
+		h.addBytes(id, N);
+	}
+
 	struct guassianBlur : public DrawActions::PostActionBase
 	{
 		guassianBlur(int b) : blurAmount(b) {};
@@ -44,6 +49,13 @@ struct ScriptedPostDrawActions
 			r.gaussianBlur(blurAmount);
 		}
 
+		bool addToContentHash(DrawActions::ContentHash& h) const override
+		{
+			addId(h, "gaussianBlur");
+			h.add(blurAmount);
+			return true;
+		}
+
 		int blurAmount;
 	};
 
@@ -57,6 +69,13 @@ struct ScriptedPostDrawActions
 			r.boxBlur(blurAmount);
 		}
 
+		bool addToContentHash(DrawActions::ContentHash& h) const override
+		{
+			addId(h, "boxBlur");
+			h.add(blurAmount);
+			return true;
+		}
+
 		int blurAmount;
 	};
 
@@ -70,6 +89,12 @@ struct ScriptedPostDrawActions
 			r.desaturate();
 		}
 
+		bool addToContentHash(DrawActions::ContentHash& h) const override
+		{
+			addId(h, "desaturate");
+			return true;
+		}
+
 		int blurAmount;
 	};
 
@@ -119,6 +144,15 @@ struct ScriptedPostDrawActions
 
 		}
 
+		bool addToContentHash(DrawActions::ContentHash& hash) const override
+		{
+			addId(hash, "applyHSL");
+			hash.add(h);
+			hash.add(s);
+			hash.add(l);
+			return true;
+		}
+
 		float h, s, l;
 	};
 
@@ -136,6 +170,14 @@ struct ScriptedPostDrawActions
 			r.applyGradientMap(ColourGradient(c1, {}, c2, {}, false));
 		}
 
+		bool addToContentHash(DrawActions::ContentHash& h) const override
+		{
+			addId(h, "applyGradientMap");
+			h.add(c1.getARGB());
+			h.add(c2.getARGB());
+			return true;
+		}
+
 		Colour c1, c2;
 	};
 
@@ -152,6 +194,13 @@ struct ScriptedPostDrawActions
 			r.applyGamma(gamma);
 		}
 
+		bool addToContentHash(DrawActions::ContentHash& h) const override
+		{
+			addId(h, "applyGamma");
+			h.add(gamma);
+			return true;
+		}
+
 		float gamma;
 	};
 
@@ -168,6 +217,13 @@ struct ScriptedPostDrawActions
 			r.applySharpness(delta);
 		}
 
+		bool addToContentHash(DrawActions::ContentHash& h) const override
+		{
+			addId(h, "applySharpness");
+			h.add(delta);
+			return true;
+		}
+
 		int delta;
 	};
 
@@ -186,6 +242,15 @@ struct ScriptedPostDrawActions
 			r.applyVignette(amount, radius, falloff);
 		}
 
+		bool addToContentHash(DrawActions::ContentHash& h) const override
+		{
+			addId(h, "applyVignette");
+			h.add(amount);
+			h.add(radius);
+			h.add(falloff);
+			return true;
+		}
+
 		float amount, radius, falloff;
 	};
 
@@ -199,6 +264,12 @@ struct ScriptedPostDrawActions
 		{
 			r.applySepia();
 		}
+
+		bool addToContentHash(DrawActions::ContentHash& h) const override
+		{
+			addId(h, "applySepia");
+			return true;
+		}
 	};
 
 	struct applyMask : public DrawActions::PostActionBase
@@ -220,30 +291,22 @@ struct ScriptedPostDrawActions
 
 namespace ScriptedDrawActions
 {
-	struct fillAll : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(fillAll);
-
-		fillAll(Colour c_) : c(c_) {};
-		void perform(Graphics& g) { g.fillAll(c); };
-		Colour c;
-	};
-
-	struct setColour : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(setColour);
-
-		setColour(Colour c_) : c(c_) {};
-		void perform(Graphics& g) { g.setColour(c); };
-		Colour c;
-	};
-
 	struct addTransform : public DrawActions::ActionBase
 	{
 		SET_ACTION_ID(addTransform);
 
 		addTransform(AffineTransform a_) : a(a_) {};
 		void perform(Graphics& g) override { g.addTransform(a); };
+
+		bool addToContentHash(DrawActions::ContentHash& h) const override
+		{
+			h.add(a.mat00); h.add(a.mat01); h.add(a.mat02);
+			h.add(a.mat10); h.add(a.mat11); h.add(a.mat12);
+			return true;
+		}
+
+		bool transformsCoordinates() const override { return true; }
+
 		AffineTransform a;
 	};
 
@@ -296,44 +359,6 @@ namespace ScriptedDrawActions
 		uint32 numRepaints = 0;
 	};
 
-	struct fillRect : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(fillRect);
-
-		fillRect(Rectangle<float> area_) : area(area_) {};
-		void perform(Graphics& g) { g.fillRect(area); };
-		Rectangle<float> area;
-	};
-
-	struct fillEllipse : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(fillEllipse);
-
-		fillEllipse(Rectangle<float> area_) : area(area_) {};
-		void perform(Graphics& g) { g.fillEllipse(area); };
-		Rectangle<float> area;
-	};
-
-	struct drawRect : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(drawRect);
-
-		drawRect(Rectangle<float> area_, float borderSize_) : area(area_), borderSize(borderSize_) {};
-		void perform(Graphics& g) { g.drawRect(area, borderSize); };
-		Rectangle<float> area;
-		float borderSize;
-	};
-
-	struct drawEllipse : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(drawEllipse);
-
-		drawEllipse(Rectangle<float> area_, float borderSize_) : area(area_), borderSize(borderSize_) {};
-		void perform(Graphics& g) { g.drawEllipse(area, borderSize); };
-		Rectangle<float> area;
-		float borderSize;
-	};
-
 	struct fillRoundedRect : public DrawActions::ActionBase
 	{
 		SET_ACTION_ID(fillRoundedRect);
@@ -356,6 +381,18 @@ namespace ScriptedDrawActions
 				g.fillPath(p);
 			}
 		};
+
+		bool addToContentHash(DrawActions::ContentHash& h) const override
+		{
+			h.add(area);
+			h.add(cornerSize);
+			h.add(allRounded);
+			h.add(rounded);
+			return true;
+		}
+
+		Rectangle<float> getDrawBounds() const override { return area; }
+
 		Rectangle<float> area;
 		float cornerSize;
 
@@ -385,6 +422,19 @@ namespace ScriptedDrawActions
 				g.strokePath(p, PathStrokeType(borderSize));
 			}
 		};
+
+		bool addToContentHash(DrawActions::ContentHash& h) const override
+		{
+			h.add(area);
+			h.add(cornerSize);
+			h.add(borderSize);
+			h.add(allRounded);
+			h.add(rounded);
+			return true;
+		}
+
+		Rectangle<float> getDrawBounds() const override { return area.expanded(borderSize * 0.5f); }
+
 		Rectangle<float> area;
 		float cornerSize, borderSize;
 
@@ -450,52 +500,21 @@ namespace ScriptedDrawActions
 		int yOffset;
 	};
 
-	struct drawHorizontalLine : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(drawHorizontalLine);
-
-		drawHorizontalLine(int y_, float x1_, float x2_) :
-			y(y_), x1(x1_), x2(x2_) {};
-		void perform(Graphics& g) { g.drawHorizontalLine(y, x1, x2); };
-		int y; float x1; float x2;
-	};
-
-	struct drawVerticalLine : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(drawVerticalLine);
-
-		drawVerticalLine(int x_, float y1_, float y2_) :
-			x(x_), y1(y1_), y2(y2_) {};
-		void perform(Graphics& g) { g.drawVerticalLine(x, y1, y2); };
-		int x; float y1; float y2;
-	};
-
-	struct setOpacity : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(setOpacity);
-
-		setOpacity(float alpha_) :
-			alpha(alpha_) {};
-		void perform(Graphics& g) { g.setOpacity(alpha); };
-		float alpha;
-	};
-
-	struct drawLine : public DrawActions::ActionBase
-	{
-		SET_ACTION_ID(drawLine);
-
-		drawLine(float x1_, float x2_, float y1_, float y2_, float lineThickness_) :
-			x1(x1_), x2(x2_), y1(y1_), y2(y2_), lineThickness(lineThickness_) {};
-		void perform(Graphics& g) { g.drawLine(x1, x2, y1, y2, lineThickness); };
-		float x1, x2, y1, y2, lineThickness;
-	};
-
 	struct setFont : public DrawActions::ActionBase
 	{
 		SET_ACTION_ID(setFont);
 
 		setFont(Font f_) : f(f_) {};
 		void perform(Graphics& g) { g.setFont(f); };
+
+		bool addToContentHash(DrawActions::ContentHash& h) const override
+		{
+			h.add(f.toString().hashCode64());
+			h.add(f.getExtraKerningFactor());
+			h.add(f.getHorizontalScale());
+			return true;
+		}
+
 		Font f;
 	};
 
@@ -514,6 +533,17 @@ namespace ScriptedDrawActions
 
 		drawText(const String& text_, Rectangle<float> area_, Justification j_ = Justification::centred) : text(text_), area(area_), j(j_) {};
 		void perform(Graphics& g) override { g.drawText(text, area, j); };
+
+		bool addToContentHash(DrawActions::ContentHash& h) const override
+		{
+			h.add(text.hashCode64());
+			h.add(area);
+			h.add(j.getFlags());
+			return true;
+		}
+
+		Rectangle<float> getDrawBounds() const override { return area; }
+
 		String text;
 		Rectangle<float> area;
 		Justification j;
@@ -5165,6 +5165,7 @@ struct ScriptingApi::Synth::Wrapper
 	API_VOID_METHOD_WRAPPER_1(Synth, setClockSpeed);
 	API_VOID_METHOD_WRAPPER_1(Synth, setShouldKillRetriggeredNote);
 	API_VOID_METHOD_WRAPPER_2(Synth, setUseUniformVoiceHandler);
+	API_VOID_METHOD_WRAPPER_2(Synth, setUseParallelChildRendering);
 	API_METHOD_WRAPPER_0(Synth, createBuilder);
 	
 };
@@ -5217,6 +5218,7 @@ ScriptingApi::Synth::Synth(ProcessorWithScriptingContent *p, Message* messageObj
 	ADD_API_METHOD_2(sendControllerToChildSynths);
 	ADD_API_METHOD_4(setModulatorAttribute);
 	ADD_API_METHOD_2(setUseUniformVoiceHandler);
+	ADD_API_METHOD_2(setUseParallelChildRendering);
 	ADD_API_METHOD_3(addModulator);
 	ADD_API_METHOD_3(addEffect);
 	ADD_API_METHOD_1(getMidiPlayer);
@@ -6453,6 +6455,22 @@ void ScriptingApi::Synth::setUseUniformVoiceHandler(String containerId, bool sho
 	reportScriptError("Can't find Container with ID " + containerId);
 }
 
+void ScriptingApi::Synth::setUseParallelChildRendering(String containerId, bool shouldRenderInParallel)
+{
+	Processor::Iterator<ModulatorSynthChain> iter(getScriptProcessor()->getMainController_()->getMainSynthChain());
+
+	while (auto s = iter.getNextProcessor())
+	{
+		if (s->getId() == containerId)
+		{
+			s->setUseParallelChildRendering(shouldRenderInParallel);
+			return;
+		}
+	}
+
+	reportScriptError("Can't find Container with ID " + containerId);
+}
+
 // ====================================================================================================== Console functions
 
 struct ScriptingApi::Console::Wrapper
@@ -1271,6 +1271,9 @@ public:
 		/** Use a uniform voice index for the given container. */
 		void setUseUniformVoiceHandler(String containerId, bool shouldUseUniformVoiceHandling);
 
+		/** Renders the independent child sound generators of the given container in parallel. */
+		void setUseParallelChildRendering(String containerId, bool shouldRenderInParallel);
+
 		// ============================================================================================================
 
 		void handleNoteCounter(const HiseEvent& e) noexcept
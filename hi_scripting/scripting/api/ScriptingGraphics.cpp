@@ -1846,18 +1846,18 @@ void ScriptingObjects::GraphicsObject::applyMask(var path, var area, bool invert
 void ScriptingObjects::GraphicsObject::fillAll(var colour)
 {
 	Colour c = ScriptingApi::Content::Helpers::getCleanedObjectColour(colour);
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::fillAll(c));
+	drawActionHandler.addPrimitive({ DrawActions::PrimitiveList::Type::FillAll, c });
 }
 
 void ScriptingObjects::GraphicsObject::fillRect(var area)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::fillRect(getRectangleFromVar(area)));
+	drawActionHandler.addPrimitive({ DrawActions::PrimitiveList::Type::FillRect, getRectangleFromVar(area) });
 }
 
 void ScriptingObjects::GraphicsObject::drawRect(var area, float borderSize)
 {
 	auto bs = (float)borderSize;
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawRect(getRectangleFromVar(area), SANITIZED(bs)));
+	drawActionHandler.addPrimitive({ DrawActions::PrimitiveList::Type::DrawRect, getRectangleFromVar(area), SANITIZED(bs) });
 }
 
 void ScriptingObjects::GraphicsObject::fillRoundedRectangle(var area, var cornerData)
@@ -1923,29 +1923,29 @@ void ScriptingObjects::GraphicsObject::drawRoundedRectangle(var area, var corner
 
 void ScriptingObjects::GraphicsObject::drawHorizontalLine(int y, float x1, float x2)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawHorizontalLine(y, SANITIZED(x1), SANITIZED(x2)));
+	drawActionHandler.addPrimitive({ DrawActions::PrimitiveList::Type::DrawHorizontalLine, (float)y, SANITIZED(x1), SANITIZED(x2) });
 }
 
 void ScriptingObjects::GraphicsObject::drawVerticalLine(int x, float y1, float y2)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawVerticalLine(x, SANITIZED(y1), SANITIZED(y2)));
+	drawActionHandler.addPrimitive({ DrawActions::PrimitiveList::Type::DrawVerticalLine, (float)x, SANITIZED(y1), SANITIZED(y2) });
 }
 
 void ScriptingObjects::GraphicsObject::setOpacity(float alphaValue)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::setOpacity(alphaValue));
+	drawActionHandler.addPrimitive({ DrawActions::PrimitiveList::Type::SetOpacity, alphaValue, 0.0f, 0.0f });
 }
 
 void ScriptingObjects::GraphicsObject::drawLine(float x1, float x2, float y1, float y2, float lineThickness)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawLine(
-		SANITIZED(x1), SANITIZED(y1), SANITIZED(x2), SANITIZED(y2), SANITIZED(lineThickness)));
+	drawActionHandler.addPrimitive({ DrawActions::PrimitiveList::Type::DrawLine,
+		SANITIZED(x1), SANITIZED(y1), SANITIZED(x2), SANITIZED(y2), SANITIZED(lineThickness) });
 }
 
 void ScriptingObjects::GraphicsObject::setColour(var colour)
 {
 	auto c = ScriptingApi::Content::Helpers::getCleanedObjectColour(colour);
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::setColour(c));
+	drawActionHandler.addPrimitive({ DrawActions::PrimitiveList::Type::SetColour, c });
 }
 
 void ScriptingObjects::GraphicsObject::setFont(String fontName, float fontSize)
@@ -2119,14 +2119,14 @@ void ScriptingObjects::GraphicsObject::setGradientFill(var gradientData)
 
 void ScriptingObjects::GraphicsObject::drawEllipse(var area, float lineThickness)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::drawEllipse(getRectangleFromVar(area), lineThickness));
+	drawActionHandler.addPrimitive({ DrawActions::PrimitiveList::Type::DrawEllipse, getRectangleFromVar(area), lineThickness });
 }
 
 
 
 void ScriptingObjects::GraphicsObject::fillEllipse(var area)
 {
-	drawActionHandler.addDrawAction(new ScriptedDrawActions::fillEllipse(getRectangleFromVar(area)));
+	drawActionHandler.addPrimitive({ DrawActions::PrimitiveList::Type::FillEllipse, getRectangleFromVar(area) });
 }
 
 void ScriptingObjects::GraphicsObject::drawImage(String imageName, var area, int /*xOffset*/, int yOffset)
@@ -2158,10 +2158,10 @@ void ScriptingObjects::GraphicsObject::drawImage(String imageName, var area, int
 	}
 	else
 	{
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::setColour(Colours::grey));
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::fillRect(getRectangleFromVar(area)));
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::setColour(Colours::black));
-		drawActionHandler.addDrawAction(new ScriptedDrawActions::drawRect(getRectangleFromVar(area), 1.0f));
+		drawActionHandler.addPrimitive({ DrawActions::PrimitiveList::Type::SetColour, Colours::grey });
+		drawActionHandler.addPrimitive({ DrawActions::PrimitiveList::Type::FillRect, getRectangleFromVar(area) });
+		drawActionHandler.addPrimitive({ DrawActions::PrimitiveList::Type::SetColour, Colours::black });
+		drawActionHandler.addPrimitive({ DrawActions::PrimitiveList::Type::DrawRect, getRectangleFromVar(area), 1.0f });
 		drawActionHandler.addDrawAction(new ScriptedDrawActions::setFont(GLOBAL_BOLD_FONT()));
 		drawActionHandler.addDrawAction(new ScriptedDrawActions::drawText("XXX", getRectangleFromVar(area), Justification::centred));
 
@@ -352,6 +352,11 @@ public:
 		loc.throwError("Illegal operation in audio thread: " + getOperationName(operationType));
 	}
 
+	void setLocation(const CodeLocation& newLocation)
+	{
+		loc = newLocation;
+	}
+
 private:
 
 	AudioThreadGuard::ScopedHandlerSetter setter;
@@ -361,6 +366,8 @@ private:
 struct HiseJavascriptEngine::RootObject::ScriptAudioThreadGuard
 {
 	ScriptAudioThreadGuard(const CodeLocation& /*location*/) {};
+
+	void setLocation(const CodeLocation& /*newLocation*/) {};
 };
 #endif
 
@@ -968,6 +975,14 @@ void HiseJavascriptEngine::setCallbackParameter(int callbackIndex, int parameter
 	root->hiseSpecialData.callbackNEW[callbackIndex]->setParameterValue(parameterIndex, newValue);
 }
 
+bool HiseJavascriptEngine::isCallbackCompiledToBytecode(int callbackIndex) const
+{
+	if (auto c = root->hiseSpecialData.callbackNEW[callbackIndex].get())
+		return c->bytecode != nullptr;
+
+	return false;
+}
+
 DebugInformationBase::Ptr HiseJavascriptEngine::getDebugInformation(int index)
 {
 	return root->hiseSpecialData.getDebugInformation(index);
@@ -238,6 +238,15 @@ public:
 
 	void setCallbackParameter(int callbackIndex, int parameterIndex, const var& newValue);
 
+	/** Returns true if the callback runs on the bytecode VM. */
+	bool isCallbackCompiledToBytecode(int callbackIndex) const;
+
+	/** If this is true, the callbacks of every script that is compiled afterwards will run on the bytecode VM.
+	
+		The default value is HISE_USE_SCRIPT_BYTECODE. It's atomic because scripts might be compiled
+		on other threads while it's changed.
+	*/
+	static std::atomic<bool> useScriptBytecode;
 
 	String getHoverString(const String& token);
 
@@ -588,6 +597,10 @@ public:
 		struct TokenIterator;
 		struct ExpressionTreeBuilder;
 
+		// Bytecode VM
+
+		struct BytecodeProgram;
+
 		//==============================================================================
 		static var get(Args a, int index) noexcept{ return index < a.numArguments ? a.arguments[index] : var(); }
 		static bool isInt(Args a, int index) noexcept{ return get(a, index).isInt() || get(a, index).isInt64(); }
@@ -660,6 +673,9 @@ public:
 
 			void cleanLocalProperties();
 
+			/** Compiles the statements to bytecode if HiseJavascriptEngine::useScriptBytecode is enabled. */
+			void compileBytecode();
+
 			Identifier parameters[4];
 			var parameterValues[4];
 
@@ -669,6 +685,8 @@ public:
 
 			ScopedPointer<BlockStatement> statements;
 
+			ScopedPointer<BytecodeProgram> bytecode;
+
 			private:
 
 			double lastExecutionTime;
@@ -472,6 +472,14 @@ public:
     *   The JavascriptEngine uses this to resolve the function call into a function pointer at compile time.
     *   When the script is executed, this information will be used for blazing fast access to the methods.*/
 	bool getIndexAndNumArgsForFunction(const Identifier &id, int &index, int &numArgs) const;
+
+	/** Checks whether the function at the given index has the ID. 
+	*
+	*	This can be used to verify a cached result of getIndexAndNumArgsForFunction() without searching all slots. */
+	bool isFunctionAtIndex(const Identifier& id, int index, int numArgs) const noexcept
+	{
+		return isPositiveAndBelow(index, NumSlots) && isPositiveAndBelow(numArgs, NumMaxArguments) && ids[numArgs][index] == id;
+	}
     
     /** Calls the function with the index and the argument data.
     *
@@ -149,6 +149,8 @@ HiseJavascriptEngine::ExternalFileData::ExternalFileData(Type t_, const File& f_
 HiseJavascriptEngine::ExternalFileData::ExternalFileData(): f(File()), r(Result::fail("uninitialised"))
 {}
 
+std::atomic<bool> HiseJavascriptEngine::useScriptBytecode { HISE_USE_SCRIPT_BYTECODE };
+
 HiseJavascriptEngine::HiseJavascriptEngine(JavascriptProcessor *p, MainController* mc) : maximumExecutionTime(15.0), root(new RootObject()), unneededScope(new DynamicObject())
 {
     
@@ -342,9 +344,10 @@ var HiseJavascriptEngine::RootObject::FunctionCall::getResult(const Scope& s) co
 
 			if (ConstScriptingObject* c = dynamic_cast<ConstScriptingObject*>(thisObject.getObject()))
 			{
-				auto numExpectedArgs = arguments.size();
-
-				c->getIndexAndNumArgsForFunction(dot->child, functionIndex, numArgs);
+				// functionIndex and numArgs are the result of the last call so if the object at this
+				// call site has the same class, the search can be skipped
+				if (!c->isFunctionAtIndex(dot->child, functionIndex, numArgs))
+					c->getIndexAndNumArgsForFunction(dot->child, functionIndex, numArgs);
                 
 #if ENABLE_SCRIPTING_SAFE_CHECKS
                 types = c->getForcedParameterTypes(functionIndex, numArgs);
@@ -388,7 +391,14 @@ var HiseJavascriptEngine::RootObject::FunctionCall::getResult(const Scope& s) co
 
 			if (DynamicObject* dynObj = thisObject.getDynamicObject())
 			{
-				var property = dynObj->getProperty(dot->child);
+				var property;
+
+				auto cachedProperty = InlinePropertyCache::isPlainObject(dynObj) ? propertyCache.getPropertyPointer(dynObj, dot->child) : nullptr;
+
+				if (cachedProperty != nullptr)
+					property = *cachedProperty;
+				else
+					property = dynObj->getProperty(dot->child);
 
 				if (auto obj = dynamic_cast<InlineFunction::Object*>(property.getObject()))
 				{
@@ -399,6 +409,10 @@ var HiseJavascriptEngine::RootObject::FunctionCall::getResult(const Scope& s) co
 
 					return obj->performDynamically(s, parameters, arguments.size());
 				}
+
+				// findFunctionCall() would return the same property
+				if (cachedProperty != nullptr)
+					return invokeFunction(s, property, thisObject);
 			}
 			if (thisObject.isArray())
 			{
@@ -1261,6 +1275,7 @@ var HiseJavascriptEngine::executeCallback(int callbackIndex, Result *result)
 
 void HiseJavascriptEngine::RootObject::Callback::setStatements(BlockStatement *s) noexcept
 {
+	bytecode = nullptr;
 	statements = s;
 	isCallbackDefined = s->statements.size() != 0;
 }
@@ -1378,19 +1393,33 @@ var HiseJavascriptEngine::RootObject::Callback::perform(RootObject *root)
 
     LocalScopeCreator::ScopedSetter svs(root, this);
 
-	statements->perform(s, &returnValue);
+	if (bytecode != nullptr)
+		bytecode->run(s, &returnValue);
+	else
+		statements->perform(s, &returnValue);
 
 	root->removeFromCallStack(callbackName);
 
 	const double post = Time::getMillisecondCounterHiRes();
 	lastExecutionTime = post - pre;
 #else
-	statements->perform(s, &returnValue);
+	if (bytecode != nullptr)
+		bytecode->run(s, &returnValue);
+	else
+		statements->perform(s, &returnValue);
 #endif
 
 	return returnValue;
 }
 
+void HiseJavascriptEngine::RootObject::Callback::compileBytecode()
+{
+	if (HiseJavascriptEngine::useScriptBytecode.load())
+		bytecode = BytecodeProgram::compile(*this);
+	else
+		bytecode = nullptr;
+}
+
 AttributedString DynamicObjectDebugInformation::getDescription() const
 {
 	return AttributedString();
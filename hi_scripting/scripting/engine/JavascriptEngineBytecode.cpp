@@ -0,0 +1,747 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+/** A compiled version of a callback that runs on a register based VM.
+
+	The compiler walks the (already optimised) syntax tree of a callback and creates a flat list of
+	instructions. Variable slots (reg variables, const variables, callback parameters and locals as
+	well as literals) are resolved to direct pointers at compile time so reading them doesn't require
+	a virtual call or a copy. Every node that is not supported by the VM is executed through its
+	original AST implementation, so the semantics are exactly the same as in the tree walker.
+*/
+struct HiseJavascriptEngine::RootObject::BytecodeProgram
+{
+	/** The maximum number of temporary registers. If a callback needs more, it is not compiled. */
+	static constexpr int MaxNumRegisters = 64;
+
+	enum class OpCode : uint8
+	{
+		Move,				// r[dst] = a
+		ToBool,				// r[dst] = (bool)a
+		Evaluate,			// r[dst] = expression->getResult()
+		CallApi,			// r[dst] = apiCall->callWithArguments(arguments[firstArgument...])
+		Perform,			// statement->perform() with break / continue / return handling
+		Binary,				// r[dst] = operator->evaluate(a, b)
+		TypeEquals,			// r[dst] = areTypeEqual(a, b)
+		TypeNotEquals,		// r[dst] = !areTypeEqual(a, b)
+		Store,				// *pointer = a
+		Assign,				// expression->assign(a)
+		Jump,				// goto target
+		JumpIfTrue,			// if(a) goto target
+		JumpIfFalse,		// if(!a) goto target
+		CheckTimeout,		// s.checkTimeOut()
+		StatementStart,		// audio thread guard location & breakpoints
+		Return,				// *returnValue = a; return returnWasHit
+		ReturnCode,			// return target
+		End
+	};
+
+	/** An operand is either a temporary register or a resolved pointer to a variable slot. */
+	struct Operand
+	{
+		const var* pointer = nullptr;
+		int index = -1;
+	};
+
+	struct Instruction
+	{
+		OpCode op;
+		int dst = -1;
+		Operand a, b;
+		int target = -1;
+		int continueTarget = -1;
+		int firstArgument = -1;
+		Statement* statement = nullptr;
+		var* pointer = nullptr;
+	};
+
+	static BytecodeProgram* compile(Callback& c)
+	{
+		if (c.statements == nullptr || !c.statements->scopedBlockStatements.isEmpty())
+			return nullptr;
+
+		ScopedPointer<BytecodeProgram> p = new BytecodeProgram();
+
+		Compiler compiler(*p, c);
+
+		try
+		{
+			if (!compiler.compileStatement(c.statements))
+				return nullptr;
+		}
+		catch (String&)
+		{
+			return nullptr;
+		}
+
+		compiler.emit(OpCode::End);
+
+		p->numRegisters = compiler.numMaxRegisters;
+		return p.release();
+	}
+
+	Statement::ResultCode run(const Scope& s, var* returnValue) const
+	{
+		// Only construct the registers that are used by this program
+		struct Registers
+		{
+			Registers(int numToUse_) :
+				numToUse(numToUse_)
+			{
+				for (int i = 0; i < numToUse; i++)
+					new (data + i) var();
+			}
+
+			~Registers()
+			{
+				for (int i = 0; i < numToUse; i++)
+					data[i].~var();
+			}
+
+			var& operator[](int index) { return data[index]; }
+
+			const int numToUse;
+
+			union
+			{
+				var data[MaxNumRegisters];
+			};
+		} r(numRegisters);
+
+#if ENABLE_SCRIPTING_BREAKPOINTS
+		ScriptAudioThreadGuard guard(instructions.getReference(0).statement != nullptr ?
+									 instructions.getReference(0).statement->location :
+									 CodeLocation("", ""));
+#endif
+
+		auto get = [&r](const Operand& o) -> const var& { return o.pointer != nullptr ? *o.pointer : r[o.index]; };
+
+		auto data = instructions.begin();
+		int pc = 0;
+
+		for (;;)
+		{
+			const auto& i = data[pc++];
+
+			switch (i.op)
+			{
+			case OpCode::Move:			r[i.dst] = get(i.a); break;
+			case OpCode::ToBool:		r[i.dst] = (bool)get(i.a); break;
+			case OpCode::Evaluate:		r[i.dst] = static_cast<Expression*>(i.statement)->getResult(s); break;
+			case OpCode::CallApi:
+			{
+				auto ac = static_cast<ApiCall*>(i.statement);
+
+				var args[5];
+
+				for (int a = 0; a < ac->expectedNumArguments; a++)
+					args[a] = get(arguments.getReference(i.firstArgument + a));
+
+				r[i.dst] = ac->callWithArguments(args);
+				break;
+			}
+			case OpCode::Perform:
+			{
+				if (auto rc = i.statement->perform(s, returnValue))
+				{
+					if (rc == Statement::breakWasHit && i.target != -1)
+						pc = i.target;
+					else if (rc == Statement::continueWasHit && i.continueTarget != -1)
+						pc = i.continueTarget;
+					else
+						return rc;
+				}
+
+				break;
+			}
+			case OpCode::Binary:		r[i.dst] = static_cast<BinaryOperator*>(i.statement)->evaluate(get(i.a), get(i.b)); break;
+			case OpCode::TypeEquals:	r[i.dst] = areTypeEqual(get(i.a), get(i.b)); break;
+			case OpCode::TypeNotEquals:	r[i.dst] = !areTypeEqual(get(i.a), get(i.b)); break;
+			case OpCode::Store:			*i.pointer = get(i.a); break;
+			case OpCode::Assign:		static_cast<Expression*>(i.statement)->assign(s, get(i.a)); break;
+			case OpCode::Jump:			pc = i.target; break;
+			case OpCode::JumpIfTrue:	if (get(i.a)) pc = i.target; break;
+			case OpCode::JumpIfFalse:	if (!get(i.a)) pc = i.target; break;
+			case OpCode::CheckTimeout:	s.checkTimeOut(i.statement->location); break;
+			case OpCode::StatementStart:
+			{
+#if ENABLE_SCRIPTING_BREAKPOINTS
+				guard.setLocation(i.statement->location);
+
+				if (i.statement->breakpointReference.index != -1)
+					BlockStatement::throwBreakpoint(s, i.statement);
+#endif
+				break;
+			}
+			case OpCode::Return:
+			{
+				if (returnValue != nullptr)
+					*returnValue = get(i.a);
+
+				return Statement::returnWasHit;
+			}
+			case OpCode::ReturnCode:	return (Statement::ResultCode)i.target;
+			case OpCode::End:			return Statement::ok;
+			}
+		}
+	}
+
+private:
+
+	struct Compiler
+	{
+		Compiler(BytecodeProgram& p_, Callback& c_) :
+			p(p_),
+			c(c_)
+		{}
+
+		int emit(OpCode op)
+		{
+			Instruction i;
+			i.op = op;
+			p.instructions.add(i);
+			return p.instructions.size() - 1;
+		}
+
+		Instruction& get(int index) { return p.instructions.getReference(index); }
+
+		int getNextIndex() const { return p.instructions.size(); }
+
+		int allocateRegister()
+		{
+			auto index = numUsedRegisters++;
+			numMaxRegisters = jmax(numMaxRegisters, numUsedRegisters);
+
+			if (numUsedRegisters > MaxNumRegisters)
+				throw String("too many registers");
+
+			return index;
+		}
+
+		/** Returns a pointer to the variable slot if the expression can be read without evaluation. */
+		const var* getReadPointer(Expression* e)
+		{
+			if (auto lv = dynamic_cast<LiteralValue*>(e))
+				return &lv->value;
+
+			if (auto ac = dynamic_cast<ApiConstant*>(e))
+				return &ac->value;
+
+			if (auto rn = dynamic_cast<RegisterName*>(e))
+				return rn->data;
+
+			if (auto cp = dynamic_cast<CallbackParameterReference*>(e))
+				return cp->data;
+
+			if (auto cl = dynamic_cast<CallbackLocalReference*>(e))
+			{
+				if (cl->parentCallback == &c)
+					return c.localProperties.getVarPointer(cl->name);
+			}
+
+			if (auto cr = dynamic_cast<ConstReference*>(e))
+			{
+				if (cr->ns != nullptr)
+					return cr->ns->constObjects.getVarPointerAt(cr->index);
+			}
+
+			return nullptr;
+		}
+
+		/** Returns a pointer to the variable slot if assigning to it doesn't need any checks. */
+		var* getWritePointer(Expression* e)
+		{
+			if (auto rn = dynamic_cast<RegisterName*>(e))
+			{
+#if ENABLE_SCRIPTING_SAFE_CHECKS
+				if (rn->type)
+					return nullptr;
+#endif
+				return rn->data;
+			}
+
+			if (auto cl = dynamic_cast<CallbackLocalReference*>(e))
+			{
+				if (cl->parentCallback == &c)
+					return c.localProperties.getVarPointer(cl->name);
+			}
+
+			return nullptr;
+		}
+
+		void emitStore(Expression* target, const Operand& value)
+		{
+			if (auto ptr = getWritePointer(target))
+			{
+				auto i = emit(OpCode::Store);
+				get(i).pointer = ptr;
+				get(i).a = value;
+			}
+			else
+			{
+				auto i = emit(OpCode::Assign);
+				get(i).statement = target;
+				get(i).a = value;
+			}
+		}
+
+		/** Makes sure that the value lives in a temporary register. */
+		Operand toRegister(const Operand& o)
+		{
+			if (o.pointer == nullptr)
+				return o;
+
+			Operand r;
+			r.index = allocateRegister();
+
+			auto i = emit(OpCode::Move);
+			get(i).dst = r.index;
+			get(i).a = o;
+			return r;
+		}
+
+		/** The tree walker reads the left operand before it evaluates the right one, so if the
+			right side might change the variable, the value needs to be copied first.
+		*/
+		Operand compileLeftOperand(Expression* lhs, Expression* rhs)
+		{
+			auto a = compileExpression(lhs);
+
+			if (a.pointer != nullptr && getReadPointer(rhs) == nullptr)
+				return toRegister(a);
+
+			return a;
+		}
+
+		Operand compileExpression(Expression* e)
+		{
+			Operand result;
+
+			if (auto ptr = getReadPointer(e))
+			{
+				result.pointer = ptr;
+				return result;
+			}
+
+			if (auto bo = dynamic_cast<BinaryOperator*>(e))
+			{
+				auto a = compileLeftOperand(bo->lhs, bo->rhs);
+				auto b = compileExpression(bo->rhs);
+
+				result.index = allocateRegister();
+
+				auto i = emit(OpCode::Binary);
+				get(i).dst = result.index;
+				get(i).a = a;
+				get(i).b = b;
+				get(i).statement = bo;
+				return result;
+			}
+
+			auto isAnd = dynamic_cast<LogicalAndOp*>(e) != nullptr;
+
+			if (isAnd || dynamic_cast<LogicalOrOp*>(e) != nullptr)
+			{
+				auto bo = dynamic_cast<BinaryOperatorBase*>(e);
+
+				result.index = allocateRegister();
+
+				auto a = compileExpression(bo->lhs);
+				auto i1 = emit(OpCode::ToBool);
+				get(i1).dst = result.index;
+				get(i1).a = a;
+
+				Operand r;
+				r.index = result.index;
+
+				auto jump = emit(isAnd ? OpCode::JumpIfFalse : OpCode::JumpIfTrue);
+				get(jump).a = r;
+
+				auto b = compileExpression(bo->rhs);
+				auto i2 = emit(OpCode::ToBool);
+				get(i2).dst = result.index;
+				get(i2).a = b;
+
+				get(jump).target = getNextIndex();
+				return result;
+			}
+
+			auto isTypeEquals = dynamic_cast<TypeEqualsOp*>(e) != nullptr;
+
+			if (isTypeEquals || dynamic_cast<TypeNotEqualsOp*>(e) != nullptr)
+			{
+				auto bo = dynamic_cast<BinaryOperatorBase*>(e);
+
+				auto a = compileLeftOperand(bo->lhs, bo->rhs);
+				auto b = compileExpression(bo->rhs);
+
+				result.index = allocateRegister();
+
+				auto i = emit(isTypeEquals ? OpCode::TypeEquals : OpCode::TypeNotEquals);
+				get(i).dst = result.index;
+				get(i).a = a;
+				get(i).b = b;
+				return result;
+			}
+
+			if (auto co = dynamic_cast<ConditionalOp*>(e))
+			{
+				result.index = allocateRegister();
+
+				auto cond = compileExpression(co->condition);
+				auto jumpToFalse = emit(OpCode::JumpIfFalse);
+				get(jumpToFalse).a = cond;
+
+				auto t = compileExpression(co->trueBranch);
+				auto i1 = emit(OpCode::Move);
+				get(i1).dst = result.index;
+				get(i1).a = t;
+
+				auto jumpToEnd = emit(OpCode::Jump);
+
+				get(jumpToFalse).target = getNextIndex();
+
+				auto f = compileExpression(co->falseBranch);
+				auto i2 = emit(OpCode::Move);
+				get(i2).dst = result.index;
+				get(i2).a = f;
+
+				get(jumpToEnd).target = getNextIndex();
+				return result;
+			}
+
+			if (auto pa = dynamic_cast<PostAssignment*>(e))
+			{
+				auto oldValue = toRegister(compileExpression(pa->target));
+				auto newValue = compileExpression(pa->newValue);
+				emitStore(pa->target, newValue);
+				return oldValue;
+			}
+
+			if (auto sa = dynamic_cast<SelfAssignment*>(e))
+			{
+				auto value = compileExpression(sa->newValue);
+				emitStore(sa->target, value);
+				return value;
+			}
+
+			if (auto a = dynamic_cast<Assignment*>(e))
+			{
+				// The value must be copied because the source might be changed by the assignment
+				auto value = toRegister(compileExpression(a->newValue));
+				emitStore(a->target, value);
+				return value;
+			}
+
+			if (auto ac = dynamic_cast<ApiCall*>(e))
+			{
+				if (canCallDirectly(ac))
+				{
+					auto firstArgument = p.arguments.size();
+
+					for (int a = 0; a < ac->expectedNumArguments; a++)
+						p.arguments.add({});
+
+					for (int a = 0; a < ac->expectedNumArguments; a++)
+					{
+						auto arg = compileExpression(ac->argumentList[a]);
+
+						// Copy the value if one of the next arguments might change the variable
+						for (int next = a + 1; next < ac->expectedNumArguments; next++)
+						{
+							if (getReadPointer(ac->argumentList[next]) == nullptr)
+							{
+								arg = toRegister(arg);
+								break;
+							}
+						}
+
+						p.arguments.getReference(firstArgument + a) = arg;
+					}
+
+					result.index = allocateRegister();
+
+					auto i = emit(OpCode::CallApi);
+					get(i).dst = result.index;
+					get(i).statement = ac;
+					get(i).firstArgument = firstArgument;
+					return result;
+				}
+			}
+
+			result.index = allocateRegister();
+
+			auto i = emit(OpCode::Evaluate);
+			get(i).dst = result.index;
+			get(i).statement = e;
+			return result;
+		}
+
+		/** API calls that are allowed to do illegal things on the audio thread evaluate their arguments
+			with a suspended audio thread guard, so they need to be executed by the syntax tree.
+		*/
+		static bool canCallDirectly(ApiCall* ac)
+		{
+			if (ac->apiClass == nullptr || !isPositiveAndBelow(ac->expectedNumArguments, 6))
+				return false;
+
+			for (int a = 0; a < ac->expectedNumArguments; a++)
+			{
+				if (ac->argumentList[a] == nullptr)
+					return false;
+			}
+
+#if JUCE_ENABLE_AUDIO_GUARD
+			if (ac->apiClass->allowIllegalCallsOnAudioThread(ac->functionIndex))
+				return false;
+#endif
+
+			return true;
+		}
+
+		void emitPerform(Statement* st)
+		{
+			auto i = emit(OpCode::Perform);
+			get(i).statement = st;
+
+			if (!loops.isEmpty())
+			{
+				breakJumps.add(i);
+				continueJumps.add(i);
+			}
+		}
+
+		bool compileStatement(Statement* st)
+		{
+			if (st == nullptr)
+				return true;
+
+			// Temporary registers only live within a statement
+			ScopedValueSetter<int> svs(numUsedRegisters, numUsedRegisters);
+
+			if (auto bs = dynamic_cast<BlockStatement*>(st))
+			{
+				if (!bs->scopedBlockStatements.isEmpty())
+				{
+					emitPerform(st);
+					return true;
+				}
+
+				for (auto s : bs->statements)
+				{
+#if ENABLE_SCRIPTING_BREAKPOINTS
+					auto i = emit(OpCode::StatementStart);
+					get(i).statement = s;
+#endif
+
+					if (!compileStatement(s))
+						return false;
+				}
+
+				return true;
+			}
+
+			if (auto is = dynamic_cast<IfStatement*>(st))
+			{
+				auto cond = compileExpression(is->condition);
+				auto jumpToFalse = emit(OpCode::JumpIfFalse);
+				get(jumpToFalse).a = cond;
+
+				if (!compileStatement(is->trueBranch))
+					return false;
+
+				auto jumpToEnd = emit(OpCode::Jump);
+
+				get(jumpToFalse).target = getNextIndex();
+
+				if (!compileStatement(is->falseBranch))
+					return false;
+
+				get(jumpToEnd).target = getNextIndex();
+				return true;
+			}
+
+			if (auto ls = dynamic_cast<LoopStatement*>(st))
+			{
+				if (ls->isIterator)
+				{
+					emitPerform(st);
+					return true;
+				}
+
+				if (!compileStatement(ls->initialiser))
+					return false;
+
+				auto start = getNextIndex();
+				auto jumpToEnd = -1;
+
+				if (!ls->isDoLoop)
+				{
+					auto cond = compileExpression(ls->condition);
+					jumpToEnd = emit(OpCode::JumpIfFalse);
+					get(jumpToEnd).a = cond;
+				}
+
+				get(emit(OpCode::CheckTimeout)).statement = ls;
+
+				auto numBreaks = breakJumps.size();
+				auto numContinues = continueJumps.size();
+
+				loops.add(ls);
+				auto ok = compileStatement(ls->body);
+				loops.removeLast();
+
+				if (!ok)
+					return false;
+
+				// end of the loop body
+				if (!compileStatement(ls->iterator))
+					return false;
+
+				if (ls->isDoLoop)
+				{
+					auto cond = compileExpression(ls->condition);
+					jumpToEnd = emit(OpCode::JumpIfFalse);
+					get(jumpToEnd).a = cond;
+				}
+
+				get(emit(OpCode::Jump)).target = start;
+
+				// A continue statement in a do loop skips the condition check
+				auto continueTarget = getNextIndex();
+
+				if (!compileStatement(ls->iterator))
+					return false;
+
+				get(emit(OpCode::Jump)).target = start;
+
+				auto end = getNextIndex();
+				get(jumpToEnd).target = end;
+
+				for (int i = numBreaks; i < breakJumps.size(); i++)
+					get(breakJumps[i]).target = end;
+
+				for (int i = numContinues; i < continueJumps.size(); i++)
+				{
+					auto& ins = get(continueJumps[i]);
+
+					if (ins.op == OpCode::Perform)
+						ins.continueTarget = continueTarget;
+					else
+						ins.target = continueTarget;
+				}
+
+				breakJumps.removeRange(numBreaks, breakJumps.size() - numBreaks);
+				continueJumps.removeRange(numContinues, continueJumps.size() - numContinues);
+
+				return true;
+			}
+
+			if (auto rs = dynamic_cast<ReturnStatement*>(st))
+			{
+				auto value = compileExpression(rs->returnValue);
+				get(emit(OpCode::Return)).a = value;
+				return true;
+			}
+
+			auto isBreak = dynamic_cast<BreakStatement*>(st) != nullptr;
+
+			if (isBreak || dynamic_cast<ContinueStatement*>(st) != nullptr)
+			{
+				if (loops.isEmpty())
+				{
+					get(emit(OpCode::ReturnCode)).target = isBreak ? Statement::breakWasHit : Statement::continueWasHit;
+				}
+				else
+				{
+					auto i = emit(OpCode::Jump);
+
+					if (isBreak)
+						breakJumps.add(i);
+					else
+						continueJumps.add(i);
+				}
+
+				return true;
+			}
+
+			if (auto cls = dynamic_cast<CallbackLocalStatement*>(st))
+			{
+				auto ptr = cls->parentCallback == &c ? c.localProperties.getVarPointer(cls->name) : nullptr;
+
+				if (ptr == nullptr)
+				{
+					emitPerform(st);
+					return true;
+				}
+
+				auto value = compileExpression(cls->initialiser);
+				auto i = emit(OpCode::Store);
+				get(i).pointer = ptr;
+				get(i).a = value;
+				return true;
+			}
+
+			if (auto e = dynamic_cast<Expression*>(st))
+			{
+				// Only plain expressions use the default perform() implementation
+				if (dynamic_cast<VarStatement*>(st) == nullptr &&
+					dynamic_cast<LocalVarStatement*>(st) == nullptr)
+				{
+					compileExpression(e);
+					return true;
+				}
+			}
+
+			emitPerform(st);
+			return true;
+		}
+
+		BytecodeProgram& p;
+		Callback& c;
+
+		Array<LoopStatement*> loops;
+		Array<int> breakJumps;
+		Array<int> continueJumps;
+
+		int numUsedRegisters = 0;
+		int numMaxRegisters = 0;
+	};
+
+	Array<Instruction> instructions;
+	Array<Operand> arguments;
+	int numRegisters = 0;
+};
+
+} // namespace hise
@@ -151,13 +151,18 @@ struct HiseJavascriptEngine::RootObject::ApiCall : public Expression
 
 		var results[5];
 		for (int i = 0; i < expectedNumArguments; i++)
-		{
 			results[i] = argumentList[i]->getResult(s);
 
+		return callWithArguments(results);
+	}
+
+	/** Calls the API method with the already evaluated arguments. */
+	var callWithArguments(var* results) const
+	{
 #if ENABLE_SCRIPTING_SAFE_CHECKS
+		for (int i = 0; i < expectedNumArguments; i++)
 			HiseJavascriptEngine::checkValidParameter(i, results[i], argumentList[i]->location, types[i]);
 #endif
-		}
 
 		CHECK_CONDITION_WITH_LOCATION(apiClass != nullptr, "API class does not exist");
 
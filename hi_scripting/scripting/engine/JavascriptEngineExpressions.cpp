@@ -124,6 +124,43 @@ struct HiseJavascriptEngine::RootObject::ConstReference : public Expression
 
 
 
+/** A per call site cache for property lookups in a DynamicObject.
+
+	Objects that are created from the same literal (or by the same code) store their properties
+	in the same order, so the slot of the last lookup is a good guess for the next object that
+	passes this call site. The guess is verified by comparing the identifier in that slot, which
+	is a pointer comparison, so a miss just falls back to the linear search.
+*/
+struct InlinePropertyCache
+{
+	var* getPropertyPointer(DynamicObject* o, const Identifier& id) const noexcept
+	{
+		auto& properties = o->getProperties();
+		auto index = cachedIndex.load(std::memory_order_relaxed);
+
+		if (isPositiveAndBelow(index, properties.size()) && properties.getName(index) == id)
+			return properties.getVarPointerAt(index);
+
+		index = properties.indexOf(id);
+
+		if (index == -1)
+			return nullptr;
+
+		cachedIndex.store(index, std::memory_order_relaxed);
+		return properties.getVarPointerAt(index);
+	}
+
+	/** Only plain objects can skip the virtual getProperty() / setProperty() calls. */
+	static bool isPlainObject(const DynamicObject* o) noexcept
+	{
+		return typeid(*o) == typeid(DynamicObject);
+	}
+
+private:
+
+	mutable std::atomic<int> cachedIndex = { -1 };
+};
+
 struct HiseJavascriptEngine::RootObject::ArraySubscript : public Expression
 {
 	ArraySubscript(const CodeLocation& l) noexcept : Expression(l) {}
@@ -165,6 +202,12 @@ struct HiseJavascriptEngine::RootObject::ArraySubscript : public Expression
             }
             else
             {
+                if (InlinePropertyCache::isPlainObject(obj))
+                {
+                    if (auto v = propertyCache.getPropertyPointer(const_cast<DynamicObject*>(obj), cachedId))
+                        return *v;
+                }
+
                 return obj->getProperty(cachedId);
             }
         }
@@ -221,6 +264,15 @@ struct HiseJavascriptEngine::RootObject::ArraySubscript : public Expression
             }
             else
             {
+                if (InlinePropertyCache::isPlainObject(obj))
+                {
+                    if (auto v = propertyCache.getPropertyPointer(obj, cachedId))
+                    {
+                        *v = newValue;
+                        return;
+                    }
+                }
+
                 return obj->setProperty(cachedId, newValue);
             }
         }
@@ -243,6 +295,7 @@ struct HiseJavascriptEngine::RootObject::ArraySubscript : public Expression
 	ExpPtr object, index;
     
     mutable Identifier cachedId;
+    InlinePropertyCache propertyCache;
 };
 
 #define DECLARE_ID(x) const juce::Identifier x(#x);
@@ -272,7 +325,7 @@ struct HiseJavascriptEngine::RootObject::DotOperator : public Expression
 
 		if (DynamicObject* o = p.getDynamicObject())
 		{
-			if (const var* v = getPropertyPointer(o, child))
+			if (const var* v = propertyCache.getPropertyPointer(o, child))
 				return *v;
 
 			return o->getProperty(child);
@@ -309,6 +362,15 @@ struct HiseJavascriptEngine::RootObject::DotOperator : public Expression
         
 		if (DynamicObject* o = v.getDynamicObject())
 		{
+			if (InlinePropertyCache::isPlainObject(o))
+			{
+				if (auto existing = propertyCache.getPropertyPointer(o, child))
+				{
+					*existing = newValue;
+					return;
+				}
+			}
+
 			WARN_IF_AUDIO_THREAD(!o->hasProperty(child), ScriptAudioThreadGuard::ObjectResizing);
 
 			o->setProperty(child, newValue);
@@ -365,6 +427,8 @@ struct HiseJavascriptEngine::RootObject::DotOperator : public Expression
 	
 	ExpPtr parent;
 	Identifier child;
+
+	InlinePropertyCache propertyCache;
 };
 
 
@@ -469,6 +533,8 @@ struct HiseJavascriptEngine::RootObject::FunctionCall : public Expression
 	mutable int numArgs = -1;
 	mutable int functionIndex = -1;
 
+	InlinePropertyCache propertyCache;
+
 #if ENABLE_SCRIPTING_SAFE_CHECKS
     mutable VarTypeChecker::ParameterTypes types;
 #endif
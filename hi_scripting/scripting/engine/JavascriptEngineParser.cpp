@@ -2760,6 +2760,10 @@ void HiseJavascriptEngine::RootObject::execute(const String& code, bool allowCon
 	auto after = Time::getMillisecondCounter();
 	
 	auto optimisationTimeMs = after - before;
+
+	// The bytecode must be created after the optimisation passes changed the syntax tree
+	for (auto c : hiseSpecialData.callbackNEW)
+		c->compileBytecode();
 	
 	if (!results.isEmpty())
 	{
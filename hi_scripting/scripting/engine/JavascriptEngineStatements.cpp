@@ -518,21 +518,7 @@ struct HiseJavascriptEngine::RootObject::BlockStatement : public Statement
 			ScriptAudioThreadGuard guard(statements[i]->location);
 
 			if (statements.getUnchecked(i)->breakpointReference.index != -1)
-			{
-				Statement* st = statements.getUnchecked(i);
-				const auto& loc = st->location;
-				int col, line;
-
-				loc.fillColumnAndLines(col, line);
-				Breakpoint bp = Breakpoint(st->breakpointReference.localScopeId, loc.externalFile, line, col, loc.getCharIndex(), st->breakpointReference.index);
-
-				const bool hasRootScope = s.root.get() == s.scope.get();
-
-				if(!hasRootScope)
-					bp.localScope = s.scope.get();
-
-				throw bp;
-			}
+				throwBreakpoint(s, statements.getUnchecked(i));
 #endif
 			if (ResultCode r = statements.getUnchecked(i)->perform(s, returnedValue))
 				return r;
@@ -541,6 +527,24 @@ struct HiseJavascriptEngine::RootObject::BlockStatement : public Statement
 		return ok;
 	}
 
+#if ENABLE_SCRIPTING_BREAKPOINTS
+	static void throwBreakpoint(const Scope& s, Statement* st)
+	{
+		const auto& loc = st->location;
+		int col, line;
+
+		loc.fillColumnAndLines(col, line);
+		Breakpoint bp = Breakpoint(st->breakpointReference.localScopeId, loc.externalFile, line, col, loc.getCharIndex(), st->breakpointReference.index);
+
+		const bool hasRootScope = s.root.get() == s.scope.get();
+
+		if(!hasRootScope)
+			bp.localScope = s.scope.get();
+
+		throw bp;
+	}
+#endif
+
 	ResultCode perform(const Scope& s, var* returnedValue) const override
 	{
 		if(scopedBlockStatements.isEmpty())
@@ -49,6 +49,7 @@ struct DspNetwork::Wrapper
 	API_METHOD_WRAPPER_3(DspNetwork, createAndAdd);
 	API_METHOD_WRAPPER_2(DspNetwork, createFromJSON);
 	API_METHOD_WRAPPER_0(DspNetwork, undo);
+	API_METHOD_WRAPPER_1(DspNetwork, setUseJitFusion);
 	//API_VOID_METHOD_WRAPPER_0(DspNetwork, disconnectAll);
 	//API_VOID_METHOD_WRAPPER_3(DspNetwork, injectAfter);
 };
@@ -65,6 +66,9 @@ DspNetwork::DspNetwork(hise::ProcessorWithScriptingContent* p, ValueTree data_,
 #endif
 	parentHolder(dynamic_cast<Holder*>(p)),
 	projectNodeHolder(*this)
+#if HISE_INCLUDE_SNEX
+	, jitFusionHolder(*this)
+#endif
 {
 	jassert(data.getType() == PropertyIds::Network);
 
@@ -181,6 +185,7 @@ DspNetwork::DspNetwork(hise::ProcessorWithScriptingContent* p, ValueTree data_,
 	ADD_API_METHOD_2(clear);
 	ADD_API_METHOD_2(createFromJSON);
 	ADD_API_METHOD_0(undo);
+	ADD_API_METHOD_1(setUseJitFusion);
 	//ADD_API_METHOD_0(disconnectAll);
 	//ADD_API_METHOD_3(injectAfter);
 
@@ -499,6 +504,10 @@ void DspNetwork::reset()
 	
 	if (projectNodeHolder.isActive())
 		projectNodeHolder.n.reset();
+#if HISE_INCLUDE_SNEX
+	else if (jitFusionHolder.isActive())
+		jitFusionHolder.jitNode->reset();
+#endif
 	else if (auto rn = getRootNode())
 		rn->reset();
 }
@@ -507,6 +516,10 @@ void DspNetwork::handleHiseEvent(HiseEvent& e)
 {
 	if (projectNodeHolder.isActive())
 		projectNodeHolder.n.handleHiseEvent(e);
+#if HISE_INCLUDE_SNEX
+	else if (jitFusionHolder.isActive())
+		jitFusionHolder.jitNode->handleHiseEvent(e);
+#endif
 	else
 		getRootNode()->handleHiseEvent(e);
 }
@@ -532,6 +545,11 @@ void DspNetwork::process(ProcessDataDyn& data)
 		return;
 	}
 
+#if HISE_INCLUDE_SNEX
+	if (jitFusionHolder.isActive() && jitFusionHolder.process(data))
+		return;
+#endif
+
 	if (auto s = SimpleReadWriteLock::ScopedTryReadLock(getConnectionLock()))
 	{
 		if (exceptionHandler.isOk())
@@ -599,6 +617,11 @@ void DspNetwork::prepareToPlay(double sampleRate, double blockSize)
 
 				if (projectNodeHolder.isActive())
 					projectNodeHolder.prepare(currentSpecs);
+
+#if HISE_INCLUDE_SNEX
+				if (jitFusionHolder.isActive())
+					jitFusionHolder.prepare(currentSpecs);
+#endif
 			}
             
             initialised = true;
@@ -1254,6 +1277,48 @@ void DspNetwork::setUseFrozenNode(bool shouldBeEnabled)
 	reset();
 }
 
+bool DspNetwork::setUseJitFusion(bool shouldBeEnabled)
+{
+#if HISE_INCLUDE_SNEX
+	if (jitFusionHolder.isActive() == shouldBeEnabled)
+		return shouldBeEnabled;
+
+	if (shouldBeEnabled)
+	{
+		auto r = Result::ok();
+
+		if (isFrozen())
+			r = Result::fail("The network is already frozen");
+		else
+			r = jitFusionHolder.compile();
+
+		if (r.wasOk() && currentSpecs && currentSpecs.numChannels != jitFusionHolder.numChannels)
+			r = Result::fail("Channel mismatch");
+
+		if (!r.wasOk())
+		{
+			debugError(dynamic_cast<Processor*>(getScriptProcessor()), "Can't fuse " + getId() + ": " + r.getErrorMessage());
+			return false;
+		}
+	}
+
+	jitFusionHolder.setEnabled(shouldBeEnabled);
+	return jitFusionHolder.isActive();
+#else
+	ignoreUnused(shouldBeEnabled);
+	return false;
+#endif
+}
+
+bool DspNetwork::isJitFused() const
+{
+#if HISE_INCLUDE_SNEX
+	return jitFusionHolder.isActive();
+#else
+	return false;
+#endif
+}
+
 bool DspNetwork::hashMatches()
 {
 	return projectNodeHolder.hashMatches;
@@ -1268,6 +1333,10 @@ hise::ScriptParameterHandler* DspNetwork::getCurrentParameterHandler()
 {
 	if (projectNodeHolder.isActive())
 		return &projectNodeHolder;
+#if HISE_INCLUDE_SNEX
+	else if (jitFusionHolder.isActive())
+		return &jitFusionHolder;
+#endif
 	else
 		return &networkParameterHandler;
 }
@@ -1358,13 +1427,7 @@ ScriptParameterHandler* DspNetwork::Holder::getCurrentNetworkParameterHandler(
 	if (auto n = getActiveOrDebuggedNetwork())
 	{
 		if (n->isForwardingControlsToParameters())
-		{
-			if(n->projectNodeHolder.isActive())
-				return const_cast<ScriptParameterHandler*>(static_cast<const ScriptParameterHandler*>(&n->projectNodeHolder));
-			else
-				return const_cast<ScriptParameterHandler*>(static_cast<const ScriptParameterHandler*>(&n->networkParameterHandler));
-					
-		}
+			return n->getCurrentParameterHandler();
 	}
 
 	return const_cast<ScriptParameterHandler*>(contentHandler);
@@ -2378,6 +2441,204 @@ void DspNetwork::ProjectNodeHolder::init(dll::StaticLibraryHostFactory* staticLi
 	}
 }
 
+#if HISE_INCLUDE_SNEX
+DspNetwork::JitFusionHolder::JitFusionHolder(DspNetwork& parent):
+	AnyListener(valuetree::AsyncMode::Synchronously),
+	network(parent)
+{
+	memset(parameterValues, 0, sizeof(parameterValues));
+
+	for (auto o : snex::jit::OptimizationIds::Helpers::getDefaultIds())
+		memory.addOptimization(o);
+
+	setPropertyCondition(BIND_MEMBER_FUNCTION_2(JitFusionHolder::isDspProperty));
+	setRootValueTree(network.data);
+
+	rootParameterListener.setCallback(network.data, { PropertyIds::Value }, valuetree::AsyncMode::Synchronously,
+		BIND_MEMBER_FUNCTION_2(JitFusionHolder::rootParameterChanged));
+}
+
+Identifier DspNetwork::JitFusionHolder::getParameterId(int index) const
+{ return network.networkParameterHandler.getParameterId(index); }
+
+int DspNetwork::JitFusionHolder::getNumParameters() const
+{ return jmin(network.networkParameterHandler.getNumParameters(), (int)OpaqueNode::NumMaxParameters); }
+
+void DspNetwork::JitFusionHolder::setParameter(int index, float newValue)
+{
+	if (!isPositiveAndBelow(index, getNumParameters()))
+		return;
+
+	parameterValues[index] = newValue;
+
+	if (auto sl = SimpleReadWriteLock::ScopedTryReadLock(network.getConnectionLock()))
+	{
+		if (jitNode != nullptr && isPositiveAndBelow(index, parameters.size()))
+			parameters.getReference(index).callback.call((double)newValue);
+	}
+}
+
+float DspNetwork::JitFusionHolder::getParameter(int index) const
+{
+	if (isPositiveAndBelow(index, OpaqueNode::NumMaxParameters))
+		return parameterValues[index];
+
+	return 0.0f;
+}
+
+Result DspNetwork::JitFusionHolder::compile()
+{
+	using namespace snex::jit;
+
+	compiledNode = nullptr;
+
+	auto rootTree = network.getRootNode()->getValueTree();
+
+	if (network.isPolyphonic())
+		return Result::fail("Polyphonic networks are not supported");
+
+	if (cppgen::ValueTreeIterator::hasChildNodeWithProperty(rootTree, PropertyIds::IsPublicMod))
+		return Result::fail("Networks with a modulation output are not supported");
+
+	cppgen::ValueTreeBuilder b(rootTree, cppgen::ValueTreeBuilder::Format::JitCompiledInstance);
+	auto br = b.createCppCode();
+
+	if (!br.r.wasOk())
+		return br.r;
+
+	numChannels = cppgen::ValueTreeBuilder::getRootChannelAmount(rootTree);
+	compiler = new Compiler(memory);
+
+	JitCompiledNode::Ptr newNode = new JitCompiledNode(*compiler, br.code, rootTree[PropertyIds::ID].toString(), numChannels);
+
+	if (!newNode->r.wasOk())
+		return newNode->r;
+
+	auto usesExternalData = false;
+
+	snex::ExternalData::forEachType([&](snex::ExternalData::DataType dt)
+	{
+		usesExternalData |= newNode->getNumRequiredDataObjects(dt) > 0;
+	});
+
+	if (usesExternalData)
+		return Result::fail("Networks with complex data objects are not supported");
+
+	if (newNode->getParameterList().size() != getNumParameters())
+		return Result::fail("Parameter mismatch");
+
+	compiledNode = newNode;
+	return Result::ok();
+}
+
+void DspNetwork::JitFusionHolder::setEnabled(bool shouldBeEnabled)
+{
+	auto newNode = shouldBeEnabled ? compiledNode : nullptr;
+
+	if (newNode == jitNode)
+		return;
+
+	ParameterDataList newParameters;
+
+	if (newNode != nullptr)
+	{
+		if (network.currentSpecs)
+			newNode->prepare(network.currentSpecs);
+
+		newParameters = newNode->getParameterList();
+
+		for (int i = 0; i < newParameters.size(); i++)
+		{
+			parameterValues[i] = network.networkParameterHandler.getParameter(i);
+			newParameters.getReference(i).callback.call((double)parameterValues[i]);
+		}
+	}
+
+	{
+		SimpleReadWriteLock::ScopedWriteLock sl(network.getConnectionLock());
+		std::swap(jitNode, newNode);
+		std::swap(parameters, newParameters);
+	}
+
+	if (jitNode == nullptr)
+	{
+		for (int i = 0; i < getNumParameters(); i++)
+			network.networkParameterHandler.setParameter(i, parameterValues[i]);
+
+		network.reset();
+	}
+}
+
+void DspNetwork::JitFusionHolder::prepare(PrepareSpecs ps)
+{
+	// the fused node will be discarded if the channel amount changes
+	if (ps.numChannels != numChannels)
+	{
+		setEnabled(false);
+		return;
+	}
+
+	jitNode->prepare(ps);
+}
+
+bool DspNetwork::JitFusionHolder::process(ProcessDataDyn& data)
+{
+	if (data.getNumChannels() != numChannels)
+		return false;
+
+	if (auto sl = SimpleReadWriteLock::ScopedTryReadLock(network.getConnectionLock()))
+	{
+		if (jitNode != nullptr)
+		{
+			NodeProfiler np(network.getRootNode(), data.getNumSamples());
+			jitNode->process(data);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool DspNetwork::JitFusionHolder::isDspProperty(const ValueTree& v, const Identifier& id) const
+{
+	static const Array<Identifier> uiIds = { PropertyIds::NodeColour, PropertyIds::Folded, PropertyIds::ShowParameters, 
+											 PropertyIds::IsVertical, PropertyIds::Comment, PropertyIds::Frozen,
+											 PropertyIds::ShowClones, PropertyIds::DisplayedClones };
+
+	if (uiIds.contains(id))
+		return false;
+
+	// Root parameters are forwarded to the fused node by the rootParameterListener
+	if (id == PropertyIds::Value && isRootParameter(v))
+		return false;
+
+	return true;
+}
+
+bool DspNetwork::JitFusionHolder::isRootParameter(const ValueTree& v) const
+{
+	auto rn = network.getRootNode();
+
+	return rn != nullptr && v.getType() == PropertyIds::Parameter &&
+		   v.getParent().getParent() == rn->getValueTree();
+}
+
+void DspNetwork::JitFusionHolder::rootParameterChanged(ValueTree v, Identifier id)
+{
+	if (isActive() && isRootParameter(v))
+		setParameter(v.getParent().indexOf(v), (float)v[id]);
+}
+
+void DspNetwork::JitFusionHolder::anythingChanged(CallbackType cb)
+{
+	if (cb == CallbackType::Nothing || compiledNode == nullptr)
+		return;
+
+	setEnabled(false);
+	compiledNode = nullptr;
+}
+#endif
+
 int HostHelpers::getNumMaxDataObjects(const ValueTree& v, snex::ExternalData::DataType t)
 {
 	auto id = Identifier(snex::ExternalData::getDataTypeName(t, false));
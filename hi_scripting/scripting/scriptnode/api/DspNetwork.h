@@ -543,6 +543,9 @@ public:
 	/** Sets the parameters of this node according to the JSON data. */
 	bool setParameterDataFromJSON(var jsonData);
 
+	/** Compiles the entire network into a single SNEX function and uses it for processing. Any change to the network will revert to the interpreted nodes. */
+	bool setUseJitFusion(bool shouldBeEnabled);
+
 	Array<Parameter*> getListOfProbedParameters();
 
 	String getId() const { return data[PropertyIds::ID].toString(); }
@@ -695,6 +698,8 @@ public:
 
 	bool isFrozen() const { return projectNodeHolder.isActive(); }
 
+	bool isJitFused() const;
+
 	bool hashMatches();
 
 	void setExternalData(const snex::ExternalData & d, int index);
@@ -872,6 +877,65 @@ private:
 		bool loaded = false;
 		bool forwardToNode = false;
 	} projectNodeHolder;
+
+#if HISE_INCLUDE_SNEX
+
+	/** Compiles the root node into a single JIT object using the
+	    code generator of the ValueTreeBuilder. 
+		
+		As soon as the network is changed, the fused node will be discarded
+		and the processing falls back to the interpreted nodes.
+	*/
+	struct JitFusionHolder : public hise::ScriptParameterHandler,
+							 private valuetree::AnyListener
+	{
+		JitFusionHolder(DspNetwork& parent);
+
+		Identifier getParameterId(int index) const override;
+
+		int getParameterIndexForIdentifier(const Identifier& id) const override
+		{
+			return network.networkParameterHandler.getParameterIndexForIdentifier(id);
+		}
+
+		int getNumParameters() const override;
+
+		void setParameter(int index, float newValue) override;
+
+		float getParameter(int index) const override;
+
+		bool isActive() const { return jitNode != nullptr; }
+
+		Result compile();
+
+		void setEnabled(bool shouldBeEnabled);
+
+		void prepare(PrepareSpecs ps);
+
+		bool process(ProcessDataDyn& data);
+
+		DspNetwork& network;
+		snex::jit::GlobalScope memory;
+		snex::jit::Compiler::Ptr compiler;
+		snex::jit::JitCompiledNode::Ptr compiledNode;
+		snex::jit::JitCompiledNode::Ptr jitNode;
+		float parameterValues[OpaqueNode::NumMaxParameters];
+		ParameterDataList parameters;
+		int numChannels = 0;
+
+	private:
+
+		bool isDspProperty(const ValueTree& v, const Identifier& id) const;
+
+		bool isRootParameter(const ValueTree& v) const;
+
+		void rootParameterChanged(ValueTree v, Identifier id);
+
+		void anythingChanged(CallbackType cb) override;
+
+		valuetree::RecursivePropertyListener rootParameterListener;
+	} jitFusionHolder;
+#endif
     
 	JUCE_DECLARE_WEAK_REFERENCEABLE(DspNetwork);
 };
@@ -1676,18 +1676,41 @@ RealNodeProfiler::RealNodeProfiler(NodeBase* n, int numSamples_) :
 	numSamples(numSamples_),
 	node(n)
 {
-	if (enabled)
+#if HISE_ENABLE_DSP_BENCHMARK
+	if (auto b = DspBenchmark::getCurrent())
+	{
+		auto network = static_cast<ControlledObject*>(n->getRootNetwork());
+
+		if (network->getMainController() == b->getMainController())
+			benchmark = b;
+	}
+#endif
+
+	if (enabled || benchmark != nullptr)
 		start = Time::getMillisecondCounterHiRes();
 }
 
 RealNodeProfiler::~RealNodeProfiler()
 {
-	if (enabled)
+	if (enabled || benchmark != nullptr)
 	{
 		auto delta = Time::getMillisecondCounterHiRes() - start;
-		profileFlag = profileFlag * 0.9 + 0.1 * delta;
 
-		node->processProfileInfo(profileFlag, numSamples);
+		if (benchmark != nullptr)
+		{
+			auto n = node;
+
+			benchmark->addMeasurement(DspBenchmark::Category::Node, node, 0, delta, [n]()
+			{
+				return n->getRootNetwork()->getId() + "." + n->getId();
+			});
+		}
+
+		if (enabled)
+		{
+			profileFlag = profileFlag * 0.9 + 0.1 * delta;
+			node->processProfileInfo(profileFlag, numSamples);
+		}
 	}
 }
 
@@ -539,6 +539,7 @@ struct RealNodeProfiler
 
 	NodeBase* node;
 	bool enabled;
+	DspBenchmark* benchmark = nullptr;
 	double& profileFlag;
 	double start;
 	const int numSamples;
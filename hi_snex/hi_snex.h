@@ -62,16 +62,6 @@ END_JUCE_MODULE_DECLARATION
 
 
 
-/** Config: SNEX_ENABLE_SIMD
-
-Enables SIMD processing for consecutive float spans (not functional yet). 
-*/
-#ifndef SNEX_ENABLE_SIMD
-#define SNEX_ENABLE_SIMD 0
-#endif
-
-
-
 #include "../JUCE/modules/juce_gui_extra/juce_gui_extra.h"
 
 
@@ -105,6 +95,20 @@ Set to 0 to disable SNEX compilation (default on iOS).
 #define SNEX_MIR_BACKEND 1
 #endif
 
+/** Config: SNEX_ENABLE_SIMD
+
+Enables SIMD processing for consecutive float spans. 
+
+With the MIR backend, this adds the AutoVectorisation pass to the default optimisations, which lowers 
+range-based loops over float spans & dyns with a simple body (`s *= 0.5f;`) to the block operations 
+of the Math class. Loops that read the value through a reference are left untouched. 
+
+The float4 register type of the asmjit backend is not functional yet, so it defaults to 0 there.
+*/
+#ifndef SNEX_ENABLE_SIMD
+#define SNEX_ENABLE_SIMD SNEX_MIR_BACKEND
+#endif
+
 /** The SNEX compiler is only available on x64 builds so this preprocessor will allow compiling HISE on ARM withouth the JIT compiler. */
 #ifndef HISE_INCLUDE_SNEX_X64_CODEGEN
 #if JUCE_ARM
@@ -203,7 +207,9 @@ namespace snex
 
 				static StringArray getDefaultIds()
 				{
-#if SNEX_MIR_BACKEND
+#if SNEX_MIR_BACKEND && SNEX_ENABLE_SIMD
+					return { BinaryOpOptimisation, ConstantFolding, DeadCodeElimination, AutoVectorisation };
+#elif SNEX_MIR_BACKEND
 					return { BinaryOpOptimisation, ConstantFolding, DeadCodeElimination };
 #else
 					return { BinaryOpOptimisation, ConstantFolding, DeadCodeElimination, Inlining, LoopOptimisation, AsmOptimisation, NoSafeChecks };
@@ -123,26 +123,32 @@ public:
 				return nullptr;
 			}
 
-			executePass(PostSymbolOptimization, newScope->pimpl, sTree);
-
-			executePass(FunctionTemplateParsing, newScope->pimpl, sTree);
-			executePass(FunctionParsing, newScope->pimpl, sTree);
+			executeCompilationPasses(sTree);
+		}
+		catch (ParserHelpers::Error& e)
+		{
+			handleError(e);
+		}
 
-			// Optimize now
+		return newScope.release();
+	}
 
-			executePass(FunctionCompilation, newScope->pimpl, sTree);
+	/** Runs the remaining passes on the syntax tree of the last parseOnly call. */
+	AsmJitFunctionCollection* finishCompilation()
+	{
+		jassert(newScope != nullptr);
+		jassert(!parseOnly);
 
-			if (lastResult.wasOk())
-				lastResult = newScope->pimpl->getRootData()->callRootConstructors();
+		try
+		{
+			if (auto sTree = dynamic_cast<SyntaxTree*>(syntaxTree.get()))
+				executeCompilationPasses(sTree);
+			else
+				lastResult = Result::fail("No parsed syntax tree");
 		}
 		catch (ParserHelpers::Error& e)
 		{
-			syntaxTree = nullptr;
-
-			auto m = e.toString(useCodeSnippetInErrorMessage() ? ParserHelpers::Error::Format::CodeExample : ParserHelpers::Error::Format::LineNumbers);
-
-			logMessage(BaseCompiler::Error, m);
-			lastResult = Result::fail(m);
+			handleError(e);
 		}
 
 		return newScope.release();
@@ -159,6 +165,31 @@ public:
 
 	Result getLastResult() { return lastResult; }
 
+	void executeCompilationPasses(SyntaxTree* sTree)
+	{
+		executePass(PostSymbolOptimization, newScope->pimpl, sTree);
+
+		executePass(FunctionTemplateParsing, newScope->pimpl, sTree);
+		executePass(FunctionParsing, newScope->pimpl, sTree);
+
+		// Optimize now
+
+		executePass(FunctionCompilation, newScope->pimpl, sTree);
+
+		if (lastResult.wasOk())
+			lastResult = newScope->pimpl->getRootData()->callRootConstructors();
+	}
+
+	void handleError(ParserHelpers::Error& e)
+	{
+		syntaxTree = nullptr;
+
+		auto m = e.toString(useCodeSnippetInErrorMessage() ? ParserHelpers::Error::Format::CodeExample : ParserHelpers::Error::Format::LineNumbers);
+
+		logMessage(BaseCompiler::Error, m);
+		lastResult = Result::fail(m);
+	}
+
 	ScopedPointer<AsmJitFunctionCollection> newScope;
 
 	AsmJitX86Compiler* asmCompiler;
@@ -63,7 +63,9 @@ bool SpanType::isSimdType(const TypeInfo& t)
 
 bool SpanType::isSimd() const
 {
-#if SNEX_ENABLE_SIMD
+	// The MIR backend has no vector registers, it vectorises
+	// loops by lowering them to block operations instead
+#if SNEX_ENABLE_SIMD && SNEX_ASMJIT_BACKEND
 	if (getElementType() == Types::ID::Float && getNumElements() == 4)
 	{
 		jassert(hasAlias());
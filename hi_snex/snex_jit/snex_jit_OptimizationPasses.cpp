@@ -1554,6 +1554,10 @@ bool LoopVectoriser::processStatementInternal(BaseCompiler* compiler, BaseScope*
 
 bool LoopVectoriser::convertToSimd(BaseCompiler* c, Operations::Loop* l)
 {
+#if SNEX_MIR_BACKEND
+	// MIR has no vector registers so we use the vectorised block operations instead
+	return convertToVectorOp(c, l);
+#else
 	auto t = l->getTarget();
 
 	if (t->getTypeInfo().isDynamic())
@@ -1627,6 +1631,78 @@ bool LoopVectoriser::convertToSimd(BaseCompiler* c, Operations::Loop* l)
 	}
 
 	return false;
+#endif
+}
+
+bool LoopVectoriser::convertToVectorOp(BaseCompiler* c, Operations::Loop* l)
+{
+	using namespace Operations;
+
+	auto t = l->getTarget();
+
+	if (t->getTypeInfo().isDynamic())
+		t->tryToResolveType(c);
+
+	auto at = t->getTypeInfo().getTypedIfComplexType<ArrayTypeBase>();
+
+	if (at == nullptr || at->getElementType().getType() != Types::ID::Float)
+		return false;
+
+	if (dynamic_cast<SpanType*>(at) == nullptr && dynamic_cast<DynType*>(at) == nullptr)
+		return false;
+
+	// A copy of the element won't write back to the target
+	if (!l->iterator.typeInfo.isRef())
+		return false;
+
+	auto lb = l->getLoopBlock();
+
+	if (lb == nullptr || lb->getNumChildStatements() != 1)
+		return false;
+
+	auto a = as<Assignment>(lb->getChildStatement(0));
+
+	if (a == nullptr || a->overloadedAssignOperator.isResolved())
+		return false;
+
+	auto op = a->assignmentType;
+
+	if (op != JitTokens::assign_ && op != JitTokens::times && op != JitTokens::plus && op != JitTokens::minus)
+		return false;
+
+	auto target = as<VariableReference>(a->getSubExpr(1));
+
+	if (target == nullptr || !(target->id == l->iterator))
+		return false;
+
+	auto value = a->getSubExpr(0);
+
+	if (auto vr = as<VariableReference>(value))
+	{
+		// The vector op would read the value only once
+		if (vr->id == l->iterator)
+			return false;
+
+		// A reference might point into the span that is written by the loop
+		if (vr->id.typeInfo.isRef() || vr->getTypeInfo().isRef())
+			return false;
+	}
+	else if (as<Immediate>(value) == nullptr)
+		return false;
+
+	value->tryToResolveType(c);
+
+	// Anything else would be rounded differently than the scalar loop
+	if (value->getTypeInfo().getType() != Types::ID::Float)
+		return false;
+
+	Ptr vop = new VectorOp(l->location, t->clone(l->location), op, value->clone(l->location));
+
+	c->logMessage(BaseCompiler::VerboseProcessMessage, "Vectorised loop over " + t->getTypeInfo().toString());
+
+	replaceExpression(l, vop);
+	l->parent = nullptr;
+	return true;
 }
 
 juce::Result LoopVectoriser::changeIteratorTargetToSimd(Operations::Loop* l)
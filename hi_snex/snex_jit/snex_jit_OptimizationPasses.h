@@ -306,6 +306,12 @@ private:
 
 	bool convertToSimd(BaseCompiler* c, Operations::Loop* l);
 
+	/** Replaces a range-based loop over a float span / dyn with a vector operation
+	    if the body is a single assignment to the iterator with a loop invariant
+		float value (eg. `for(auto& s: data) s *= gain;` becomes `data *= gain;`). 
+	*/
+	bool convertToVectorOp(BaseCompiler* c, Operations::Loop* l);
+
 	Result changeIteratorTargetToSimd(Operations::Loop* l);
 
 	static bool isUnSimdableOperation(Ptr s);
@@ -291,6 +291,7 @@ MathFunctions::MathFunctions(bool addInlinedFunctions, ComplexType::Ptr blockTyp
 
 	HNODE_JIT_ADD_C_FUNCTION_2(void*, (ScalarFunc)hmath::vmuls, void*, float, "vmuls");
 	HNODE_JIT_ADD_C_FUNCTION_2(void*, (ScalarFunc)hmath::vadds, void*, float, "vadds");
+	HNODE_JIT_ADD_C_FUNCTION_2(void*, (ScalarFunc)hmath::vsubs, void*, float, "vsubs");
 	HNODE_JIT_ADD_C_FUNCTION_2(void*, (ScalarFunc)hmath::vmovs, void*, float, "vmovs");
 
 	HNODE_JIT_ADD_C_FUNCTION_2(void*, (VectorFunc)hmath::vmul, void*, void*, "vmul");
@@ -130,6 +130,11 @@ ValueTree MirBuilder::getGlobalData()
     return currentState->dataManager.getGlobalData();
 }
 
+bool MirBuilder::hasAbsoluteAddresses() const
+{
+	return currentState->hasAbsoluteAddresses;
+}
+
 String MirBuilder::getMirText() const
 {
 	auto text = currentState->toString(true);
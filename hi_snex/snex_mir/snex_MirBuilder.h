@@ -58,6 +58,9 @@ struct MirBuilder
     void setDataLayout(const Array<ValueTree>& data);
     
     ValueTree getGlobalData();
+
+	/** Returns true if the MIR text contains memory addresses of this process. */
+	bool hasAbsoluteAddresses() const;
     
 private:
 
@@ -329,6 +329,9 @@ struct InstructionParsers
 		auto v = state[InstructionPropertyIds::Value];
 		auto id = Types::Helpers::getTypeFromStringValue(v);
 		auto type = TypeConverters::TypeInfo2MirType(TypeInfo(id, false, false));
+
+		if (id == Types::ID::Pointer)
+			state.hasAbsoluteAddresses = true;
 		rm.registerCurrentTextOperand(v, type, RegisterType::Value);
 
 		return Result::ok();
@@ -730,6 +733,21 @@ struct InstructionParsers
 		return Result::ok();
 	}
 
+	/** The init values of a pointer member are embedded as address into the quad words. */
+	static void checkInitValuesForAddresses(State& state)
+	{
+		if (!state.currentTree.hasProperty(InstructionPropertyIds::InitValues))
+			return;
+
+		InitValueParser p(state[InstructionPropertyIds::InitValues]);
+
+		p.forEach([&](uint32, Types::ID type, const VariableStorage&)
+		{
+			if (type == Types::ID::Pointer)
+				state.hasAbsoluteAddresses = true;
+		});
+	}
+
 	static Result ComplexTypeDefinition(State* state_)
 	{
 		auto& state = *state_;
@@ -788,6 +806,8 @@ struct InstructionParsers
 
                     state.dataManager.addGlobalData(s.id.toString(), state[InstructionPropertyIds::Type]);
                     
+                    checkInitValuesForAddresses(state);
+
                     MemoryBlock mb;
                     mb.fromBase64Encoding(state[InstructionPropertyIds::InitValuesB64]);
 
@@ -867,6 +887,8 @@ struct InstructionParsers
                     {
                         // static type copy with initialization values
 
+                        checkInitValuesForAddresses(state);
+
                         MemoryBlock mb;
                         mb.fromBase64Encoding(state[InstructionPropertyIds::InitValuesB64]);
 
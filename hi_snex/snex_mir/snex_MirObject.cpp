@@ -302,6 +302,8 @@ snex::jit::FunctionCollectionBase* MirCompiler::compileMirCode(const ValueTree&
 	{
         auto code = b.getMirText();
 		auto ok = compileMirCode(code);
+
+		isCacheable = !b.hasAbsoluteAddresses();
         
         getFunctionClass()->globalData = b.getGlobalData();
         
@@ -311,6 +313,31 @@ snex::jit::FunctionCollectionBase* MirCompiler::compileMirCode(const ValueTree&
 	return nullptr;
 }
 
+snex::jit::FunctionCollectionBase* MirCompiler::compileMirCode(const MirCodeCache::Entry& cachedCode)
+{
+	if (auto fc = compileMirCode(cachedCode.code))
+	{
+		getFunctionClass()->globalData = cachedCode.globalData.createCopy();
+		return fc;
+	}
+
+	return nullptr;
+}
+
+MirCodeCache::Entry MirCompiler::createCacheEntry(const String& keyData)
+{
+	MirCodeCache::Entry e;
+
+	if (r.wasOk() && isCacheable && getFunctionClass() != nullptr)
+	{
+		e.keyData = keyData;
+		e.code = assembly;
+		e.globalData = getFunctionClass()->globalData.createCopy();
+	}
+
+	return e;
+}
+
 snex::mir::MirFunctionCollection* MirCompiler::getFunctionClass()
 {
 	return dynamic_cast<MirFunctionCollection*>(currentFunctionClass.get());
@@ -497,6 +524,246 @@ MirCompiler::~MirCompiler()
 	
 }
 
+struct MirCodeCache::Data
+{
+	static constexpr int MaxNumMemoryEntries = 512;
+
+	CriticalSection lock;
+	HashMap<String, Entry> entries;
+	File directory;
+};
+
+MirCodeCache::Data& MirCodeCache::getData()
+{
+	static Data d;
+	return d;
+}
+
+File MirCodeCache::getCacheFile(const File& directory, const String& keyData)
+{
+	if (directory == File())
+		return {};
+
+	return directory.getChildFile(String::toHexString(keyData.hashCode64())).withFileExtension("mirc");
+}
+
+String MirCodeCache::createKey(const String& preprocessedCode, jit::GlobalScope& memory, jit::NamespaceHandler& handler)
+{
+	String k;
+
+	k << "Version: " << String(Version) << "\n";
+
+#if JUCE_ARM
+	k << "CPU: ARM" << (SystemStats::hasNeon() ? " NEON" : "") << "\n";
+#else
+	k << "CPU: x64" << (SystemStats::hasSSE41() ? " SSE41" : "")
+					<< (SystemStats::hasAVX() ? " AVX" : "")
+					<< (SystemStats::hasAVX2() ? " AVX2" : "") << "\n";
+#endif
+
+	k << "Optimizations: " << memory.getOptimizationPassList().joinIntoString(", ") << "\n";
+	k << "Polyphonic: " << String((int)memory.getPolyHandler()->isEnabled()) << "\n";
+
+	// External types change the memory layout of the generated code
+	for (auto t : handler.getComplexTypeList())
+	{
+		k << "Type: " << t->toString();
+
+		if (t->isFinalised())
+			k << " " << String((int)t->getRequiredByteSize());
+
+		k << "\n";
+	}
+
+	k << preprocessedCode;
+
+	return k;
+}
+
+MirCodeCache::Entry MirCodeCache::get(const String& keyData)
+{
+	auto& d = getData();
+	auto hash = String::toHexString(keyData.hashCode64());
+
+	File f;
+
+	{
+		ScopedLock sl(d.lock);
+
+		f = getCacheFile(d.directory, keyData);
+
+		if (d.entries.contains(hash))
+		{
+			auto e = d.entries[hash];
+
+			// The hash is not collision proof, so we compare the full key
+			if (e.keyData != keyData)
+				return {};
+
+			if (f.existsAsFile())
+				f.setLastModificationTime(Time::getCurrentTime());
+
+			return e;
+		}
+	}
+
+	if (f.existsAsFile())
+	{
+		FileInputStream fis(f);
+		GZIPDecompressorInputStream zis(fis);
+
+		auto v = ValueTree::readFromStream(zis);
+
+		if (v.isValid() && v["KeyData"].toString() == keyData)
+		{
+			Entry e;
+			e.keyData = keyData;
+			e.code = v["Code"].toString();
+			e.globalData = v.getChild(0).createCopy();
+
+			f.setLastModificationTime(Time::getCurrentTime());
+
+			ScopedLock sl(d.lock);
+
+			if (d.entries.size() < Data::MaxNumMemoryEntries)
+				d.entries.set(hash, e);
+
+			return e;
+		}
+	}
+
+	return {};
+}
+
+void MirCodeCache::store(const String& keyData, Entry e)
+{
+	if (!e.isValid())
+		return;
+
+	auto& d = getData();
+	auto hash = String::toHexString(keyData.hashCode64());
+
+	e.keyData = keyData;
+
+	File f;
+
+	{
+		ScopedLock sl(d.lock);
+
+		if (d.entries.size() >= Data::MaxNumMemoryEntries)
+			d.entries.clear();
+
+		d.entries.set(hash, e);
+		f = getCacheFile(d.directory, keyData);
+	}
+
+	if (f != File())
+	{
+		ValueTree v("MirCode");
+		v.setProperty("KeyData", keyData, nullptr);
+		v.setProperty("Code", e.code, nullptr);
+		v.addChild(e.globalData.isValid() ? e.globalData.createCopy() : ValueTree("GlobalData"), -1, nullptr);
+
+		MemoryOutputStream mos;
+
+		{
+			GZIPCompressorOutputStream zos(mos, 9);
+			v.writeToStream(zos);
+		}
+
+		f.getParentDirectory().createDirectory();
+		f.replaceWithData(mos.getData(), mos.getDataSize());
+
+		trimCacheDirectory(f.getParentDirectory());
+	}
+}
+
+void MirCodeCache::trimCacheDirectory(const File& directory)
+{
+	auto files = directory.findChildFiles(File::findFiles, false, "*.mirc");
+
+	int64 totalSize = 0;
+
+	for (const auto& f : files)
+		totalSize += f.getSize();
+
+	if (totalSize <= MaxDiskSize)
+		return;
+
+	struct LastUsedSorter
+	{
+		static int compareElements(const File& f1, const File& f2)
+		{
+			auto t1 = f1.getLastModificationTime();
+			auto t2 = f2.getLastModificationTime();
+
+			if (t1 < t2)
+				return -1;
+			if (t1 > t2)
+				return 1;
+
+			return 0;
+		}
+	} sorter;
+
+	files.sort(sorter);
+
+	for (const auto& f : files)
+	{
+		if (totalSize <= MaxDiskSize)
+			break;
+
+		auto size = f.getSize();
+
+		if (f.deleteFile())
+			totalSize -= size;
+	}
+}
+
+void MirCodeCache::remove(const String& keyData)
+{
+	auto& d = getData();
+
+	File f;
+
+	{
+		ScopedLock sl(d.lock);
+		d.entries.remove(String::toHexString(keyData.hashCode64()));
+		f = getCacheFile(d.directory, keyData);
+	}
+
+	if (f.existsAsFile())
+		f.deleteFile();
+}
+
+void MirCodeCache::setCacheDirectory(const File& newDirectory)
+{
+	auto& d = getData();
+	ScopedLock sl(d.lock);
+	d.directory = newDirectory;
+}
+
+File MirCodeCache::getCacheDirectory()
+{
+	auto& d = getData();
+	ScopedLock sl(d.lock);
+	return d.directory;
+}
+
+void MirCodeCache::clear(bool deleteCacheFiles)
+{
+	auto& d = getData();
+	ScopedLock sl(d.lock);
+
+	d.entries.clear();
+
+	if (deleteCacheFiles && d.directory.isDirectory())
+	{
+		for (auto f : d.directory.findChildFiles(File::findFiles, false, "*.mirc"))
+			f.deleteFile();
+	}
+}
+
 
 }
 }
@@ -47,12 +47,80 @@ using jit::StaticFunctionPointer;
 
 struct MirFunctionCollection;
 
+/** A content-addressed cache for the MIR code of compiled SNEX snippets.
+
+	The key is built from the preprocessed code, the optimisations & polyphony of the
+	GlobalScope, the complex types that were registered before the compilation and the
+	CPU. If there is an entry for the key, the Compiler only runs the parser passes (the 
+	type information is still needed by the caller) and skips the optimisation passes, the
+	syntax tree creation and the MirBuilder. MIR itself still has to load the cached text
+	and generate the machine code (it can't serialise machine code).
+
+	Code that embeds a memory address of the current process into the MIR text (eg. a
+	pointer immediate) is not cached because the address is invalid in any other process.
+
+	The entries are kept in memory and - if a cache directory is set - written to a file
+	per key so that reopening a project in the next session can reuse them. The files are
+	touched on every cache hit and the least recently used files are deleted when the
+	directory exceeds MaxDiskSize.
+*/
+struct MirCodeCache
+{
+	struct Entry
+	{
+		bool isValid() const { return code.isNotEmpty(); }
+
+		String keyData;
+		String code;
+		ValueTree globalData;
+	};
+
+	/** Creates the key data for the given code. Call this before the compilation. */
+	static String createKey(const String& preprocessedCode, jit::GlobalScope& memory, jit::NamespaceHandler& handler);
+
+	/** Returns the entry for the key or an invalid entry if there is no match. */
+	static Entry get(const String& keyData);
+
+	static void store(const String& keyData, Entry e);
+
+	static void remove(const String& keyData);
+
+	/** Sets the directory for the persistent cache files. Pass in File() to only use the memory cache. */
+	static void setCacheDirectory(const File& newDirectory);
+
+	static File getCacheDirectory();
+
+	static void clear(bool deleteCacheFiles);
+
+	/** Bump this whenever the MirBuilder output changes so that old cache files are ignored. */
+	static constexpr int Version = 2;
+
+	/** The maximum size of all cache files in the cache directory. */
+	static constexpr int64 MaxDiskSize = 64 * 1024 * 1024;
+
+private:
+
+	struct Data;
+
+	static Data& getData();
+
+	static File getCacheFile(const File& directory, const String& keyData);
+
+	/** Deletes the least recently used cache files until the directory fits into MaxDiskSize. */
+	static void trimCacheDirectory(const File& directory);
+};
+
 struct MirCompiler
 {
 	MirCompiler(jit::GlobalScope& m);
 
 	jit::FunctionCollectionBase* compileMirCode(const String& code);
 	jit::FunctionCollectionBase* compileMirCode(const ValueTree& ast);
+	jit::FunctionCollectionBase* compileMirCode(const MirCodeCache::Entry& cachedCode);
+
+	/** Creates a cache entry from the last successful compilation. Returns an invalid
+		entry if the MIR text contains memory addresses of this process. */
+	MirCodeCache::Entry createCacheEntry(const String& keyData);
 
     void setDataLayout(const Array<ValueTree>& dataTree);
     
@@ -78,6 +146,7 @@ struct MirCompiler
 
     Array<ValueTree> dataLayout;
     String assembly;
+	bool isCacheable = false;
     
 	static Array<StaticFunctionPointer> currentFunctions;
 	static void* currentConsole;
@@ -157,6 +157,8 @@ void TextLine::addImmOperand(const VariableStorage& value)
 {
 	if (value.getType() == Types::ID::Pointer)
 	{
+		state->hasAbsoluteAddresses = true;
+
 		auto x = String(reinterpret_cast<int64>(value.getDataPointer()));
 
 		operands.add(x);
@@ -455,6 +455,10 @@ struct State
 	
 	Array<TextLine> lines;
 
+	/** Set when the MIR text contains a memory address of this process (a pointer immediate or
+		a pointer in the init values). The text can't be reused by another process then. */
+	bool hasAbsoluteAddresses = false;
+
 	String operator[](const Identifier& id) const;
 
 	void dump() const;
@@ -203,27 +203,71 @@ JitObject Compiler::compileJitObject(const juce::String& code)
 		compiler->lastResult = Result::fail(e);
 		return {};
 	}
-	
+#if SNEX_MIR_BACKEND
+	auto cacheKey = mir::MirCodeCache::createKey(preprocessedCode, memory, compiler->namespaceHandler);
+	auto cachedCode = mir::MirCodeCache::get(cacheKey);
 
-	
+	// If the code is cached we only need the type information from the parser
+	compiler->parseOnly = cachedCode.isValid();
+#endif
 
 	JitObject snexObject(compiler->compileAndGetScope(preprocessedCode));
 
 	cr = compiler->getLastResult();
 
+#if SNEX_MIR_BACKEND
+	auto resetParseOnlyScope = [this]()
+	{
+		if (compiler->parseOnly)
+		{
+			// the scope is not released in parse only mode, so
+			// get rid of it like the compiled scope above
+			compiler->newScope = nullptr;
+			compiler->parseOnly = false;
+		}
+	};
+#endif
+
 #if SNEX_MIR_BACKEND
 
 	if (cr.wasOk())
 	{
-		auto layout = compiler->namespaceHandler.createDataLayouts();
-		
-		mir::MirCompiler mc(memory);
+		ScopedPointer<mir::MirCompiler> mc = new mir::MirCompiler(memory);
 
-		mc.setDataLayout(layout);
+		JitObject mirObject;
 
-		JitObject mirObject(mc.compileMirCode(getAST()));
+		if (cachedCode.isValid())
+		{
+			mirObject = JitObject(mc->compileMirCode(cachedCode));
+			cr = mc->getLastError();
 
-		cr = mc.getLastError();
+			if (!cr.wasOk())
+			{
+				mir::MirCodeCache::remove(cacheKey);
+
+				// The cached code can't be linked, so we run the remaining passes on
+				// the parsed syntax tree and compile it like a cache miss
+				compiler->parseOnly = false;
+				snexObject = JitObject(compiler->finishCompilation());
+				cr = compiler->getLastResult();
+				cachedCode = {};
+				mc = new mir::MirCompiler(memory);
+			}
+		}
+
+		if (!cachedCode.isValid() && cr.wasOk())
+		{
+			auto layout = compiler->namespaceHandler.createDataLayouts();
+
+			mc->setDataLayout(layout);
+
+			mirObject = JitObject(mc->compileMirCode(getAST()));
+
+			cr = mc->getLastError();
+
+			if (cr.wasOk())
+				mir::MirCodeCache::store(cacheKey, mc->createCacheEntry(cacheKey));
+		}
 
 #if SNEX_INCLUDE_NMD_ASSEMBLY
 
@@ -238,13 +282,15 @@ JitObject Compiler::compileJitObject(const juce::String& code)
 			assembly << f.createAssembly() << "\n";
 		}
 #else
-		assembly = mc.getAssembly();
+		assembly = mc->getAssembly();
 #endif
 
+		resetParseOnlyScope();
 		return mirObject;
 	}
 	else
 	{
+		resetParseOnlyScope();
 		return {};
 	}
 
@@ -570,6 +570,9 @@ public:
 		{
 			auto v = ValueTree::fromXml(*xml);
 			cppgen::ValueTreeBuilder b(v, cppgen::ValueTreeBuilder::Format::TestCaseFile);
+			auto br = b.createCppCode();
+
+			expect(br.code.contains("BEGIN_TEST_DATA"), "missing test case header");
 		}
 	}
 
@@ -745,6 +748,8 @@ public:
 		testSpan<int>();
 		testSpan<float>();
 		testSpan<double>();
+		testLoopVectorisation();
+		testCodeCache();
 		testStructs();
 		testUsingAliases();
 		testProcessData();
@@ -988,6 +993,204 @@ private:
 		}
 	}
 
+	void testLoopVectorisation()
+	{
+		beginTest("Testing loop vectorisation");
+
+		juce::String code;
+
+		ADD_CODE_LINE("span<float, 64> data;");
+		ADD_CODE_LINE("float test(block in, float gain){");
+		ADD_CODE_LINE("    for(auto& s: data) s = 0.3f;");
+		ADD_CODE_LINE("    for(auto& s: data) s *= gain;");
+		ADD_CODE_LINE("    for(auto& s: in) s *= gain;");
+		ADD_CODE_LINE("    for(auto& s: in) s += 0.125f;");
+		ADD_CODE_LINE("    for(auto& s: in) s -= gain;");
+		ADD_CODE_LINE("    return data[17];}");
+		ADD_CODE_LINE("span<float, 8> aliased;");
+		ADD_CODE_LINE("float testAlias(float gain){");
+		ADD_CODE_LINE("    for(auto& s: aliased) s = gain;");
+		ADD_CODE_LINE("    auto& g = aliased[0];");
+		ADD_CODE_LINE("    for(auto& s: aliased) s *= g;");
+		ADD_CODE_LINE("    return aliased[7];}");
+
+		struct Counter : public DebugHandler
+		{
+			void logMessage(int, const juce::String& s) override
+			{
+				if (s.startsWith("Vectorised loop"))
+					numVectorisedLoops++;
+			}
+
+			int numVectorisedLoops = 0;
+		};
+
+		auto runWith = [&](bool vectorise, heap<float>& buffer, float& aliasResult)
+		{
+			GlobalScope m;
+			Counter counter;
+
+			for (auto o : optimizations)
+			{
+				if (o != OptimizationIds::AutoVectorisation)
+					m.addOptimization(o);
+			}
+
+			if (vectorise)
+				m.addOptimization(OptimizationIds::AutoVectorisation);
+
+			Compiler c(m);
+			c.setDebugHandler(&counter);
+
+#if SNEX_MIR_BACKEND
+			mir::MirCompiler::setLibraryFunctions(c.getFunctionMap());
+#endif
+
+			auto obj = c.compileJitObject(code);
+
+			expect(c.getCompileResult().wasOk(), c.getCompileResult().getErrorMessage());
+
+#if SNEX_MIR_BACKEND
+			// The loop that reads through the reference must not be vectorised
+			expectEquals(counter.numVectorisedLoops, vectorise ? 6 : 0, "vectorised loop count");
+#endif
+
+			aliasResult = obj["testAlias"].call<float>(0.5f);
+
+			Random r(9281);
+
+			for (auto& s : buffer)
+				s = r.nextFloat() * 2.0f - 1.0f;
+
+			block bl;
+			bl.referTo(buffer);
+
+			return obj["test"].call<float>(&bl, 0.37f);
+		};
+
+		heap<float> scalarBuffer, vectorBuffer;
+		scalarBuffer.setSize(131);
+		vectorBuffer.setSize(131);
+
+		float scalarAlias, vectorAlias;
+
+		auto scalarResult = runWith(false, scalarBuffer, scalarAlias);
+		auto vectorResult = runWith(true, vectorBuffer, vectorAlias);
+
+		expectEquals(vectorAlias, scalarAlias, "aliased result mismatch");
+		expectEquals(vectorAlias, 0.5f * 0.25f, "aliased result");
+		expectEquals(vectorResult, 0.3f * 0.37f, "span result");
+		expectEquals(vectorResult, scalarResult, "span result mismatch");
+		expect(memcmp(scalarBuffer.begin(), vectorBuffer.begin(), sizeof(float) * 131) == 0, "block result mismatch");
+	}
+
+	void testCodeCache()
+	{
+#if SNEX_MIR_BACKEND
+		beginTest("Testing MIR code cache");
+
+		juce::String code;
+
+		ADD_CODE_LINE("struct Osc {");
+		ADD_CODE_LINE("    span<float, 128> table;");
+		ADD_CODE_LINE("    double uptime = 0.0;");
+		ADD_CODE_LINE("    void prepare(){ for(int i = 0; i < 128; i++) table[i] = Math.sin((float)i * 0.05f); }");
+		ADD_CODE_LINE("    float tick(double delta){ uptime += delta; return table[(int)uptime % 128]; }");
+		ADD_CODE_LINE("};");
+		ADD_CODE_LINE("Osc osc;");
+		ADD_CODE_LINE("float test(float input){");
+		ADD_CODE_LINE("    osc.prepare();");
+		ADD_CODE_LINE("    float sum = 0.0f;");
+		ADD_CODE_LINE("    for(int i = 0; i < 1000; i++) sum += osc.tick((double)input);");
+		ADD_CODE_LINE("    return sum;}");
+
+		auto compileAndRun = [&](double& milliseconds)
+		{
+			GlobalScope m;
+
+			for (auto o : optimizations)
+				m.addOptimization(o);
+
+			Compiler c(m);
+			mir::MirCompiler::setLibraryFunctions(c.getFunctionMap());
+
+			auto start = Time::getMillisecondCounterHiRes();
+			auto obj = c.compileJitObject(code);
+			milliseconds = Time::getMillisecondCounterHiRes() - start;
+
+			expect(c.getCompileResult().wasOk(), c.getCompileResult().getErrorMessage());
+
+			return obj["test"].call<float>(1.5f);
+		};
+
+		juce::String key;
+
+		{
+			GlobalScope m;
+
+			for (auto o : optimizations)
+				m.addOptimization(o);
+
+			Compiler c(m);
+
+			Preprocessor p(code);
+			p.addDefinitionsFromScope(m.getPreprocessorDefinitions());
+
+			key = mir::MirCodeCache::createKey(p.process(), m, c.getNamespaceHandler());
+		}
+
+		auto tempDirectory = File::createTempFile("mir_cache");
+		auto prevDirectory = mir::MirCodeCache::getCacheDirectory();
+
+		mir::MirCodeCache::setCacheDirectory(tempDirectory);
+		mir::MirCodeCache::clear(false);
+
+		double coldTime, warmTime, fileTime;
+
+		auto coldResult = compileAndRun(coldTime);
+
+		auto entry = mir::MirCodeCache::get(key);
+
+		expect(entry.isValid(), "code wasn't cached");
+
+		// Addresses of this process would crash the code in the next session
+		expect(!entry.code.contains("p0x"), "cached code contains a pointer immediate");
+
+		// Every compileAndRun call uses a new GlobalScope & Compiler, so this reuses the entry
+		// in another instance.
+		auto warmResult = compileAndRun(warmTime);
+
+		expectEquals(warmResult, coldResult, "cached code result mismatch");
+
+		// Drop the memory cache so that the entry is read from the file like in the next session
+		mir::MirCodeCache::clear(false);
+
+		auto fileResult = compileAndRun(fileTime);
+
+		expectEquals(fileResult, coldResult, "cache file result mismatch");
+
+		logMessage("Cold compilation: " + juce::String(coldTime, 2) + "ms, warm compilation: " + juce::String(warmTime, 2) + "ms, from file: " + juce::String(fileTime, 2) + "ms");
+
+		mir::MirCodeCache::clear(true);
+		mir::MirCodeCache::setCacheDirectory(prevDirectory);
+		tempDirectory.deleteRecursively();
+
+		{
+			// Replace the entry with code that can't be linked: the compiler must fall back
+			// to a full compilation and store the correct code again
+			mir::MirCodeCache::Entry broken;
+			broken.code = "# no module";
+			mir::MirCodeCache::store(key, broken);
+		}
+
+		double fallbackTime;
+		auto fallbackResult = compileAndRun(fallbackTime);
+
+		expectEquals(fallbackResult, coldResult, "fallback result mismatch");
+		expect(mir::MirCodeCache::get(key).code != "# no module", "broken cache entry wasn't replaced");
+#endif
+	}
+
 	void testInlinedMathPerformance()
 	{
 		beginTest("Testing inline math performance");
@@ -2,10 +2,12 @@
 #include "hi_streaming.h"
 
 
+#include "hi_streaming/StreamingTelemetry.cpp"
 #include "hi_streaming/SampleThreadPool.cpp"
 #include "hi_streaming/MonolithAudioFormat.cpp"
 #include "hi_streaming/StreamingSampler.cpp"
 #include "hi_streaming/StreamingSamplerSound.cpp"
+#include "hi_streaming/AdaptivePreloadSizer.cpp"
 #include "hi_streaming/StreamingSamplerVoice.cpp"
 
 #include "timestretch//time_stretcher.cpp"
@@ -93,16 +93,58 @@ Set this to true in order to use cubic interpolation for the sample playback.
 #define HISE_SAMPLER_CUBIC_INTERPOLATION 0
 #endif
 
+/** Config: HISE_NUM_STREAMING_THREADS
+
+The number of background threads that refill the streaming buffers of the sampler voices. 
+The default is zero, which loads the streaming buffers on the sample loading thread.
+*/
+#ifndef HISE_NUM_STREAMING_THREADS
+#define HISE_NUM_STREAMING_THREADS 0
+#endif
+
+/** Config: HISE_ENABLE_STREAMING_TELEMETRY
+
+If enabled, the sampler voices will record their streaming activity so you can create a latency report or dump
+the streaming activity after a buffer underrun. This is enabled in HISE by default, in a compiled plugin it will only
+be enabled if you use the adaptive preload sizing.
+*/
+#ifndef HISE_ENABLE_STREAMING_TELEMETRY
+#if USE_BACKEND
+#define HISE_ENABLE_STREAMING_TELEMETRY 1
+#else
+#define HISE_ENABLE_STREAMING_TELEMETRY 0
+#endif
+#endif
+
+/** Config: HISE_ENABLE_ADAPTIVE_PRELOAD
+
+If enabled, the samplers will adapt the preload size of each sound based on the measured streaming latency
+and how often the sound is played. You can also change this at runtime with AdaptivePreloadSizer::setEnabled().
+*/
+#ifndef HISE_ENABLE_ADAPTIVE_PRELOAD
+#define HISE_ENABLE_ADAPTIVE_PRELOAD 0
+#endif
+
+/** Config: HISE_ADAPTIVE_PRELOAD_BUDGET_MB
+
+The maximum amount of memory in megabytes that the preload buffers of all samplers can use in the adaptive preload mode.
+*/
+#ifndef HISE_ADAPTIVE_PRELOAD_BUDGET_MB
+#define HISE_ADAPTIVE_PRELOAD_BUDGET_MB 1024
+#endif
+
 
 #include "hi_streaming/lockfree_fifo/readerwriterqueue.h"
 #include "hi_streaming/lockfree_fifo/concurrentqueue.h"
 
 #include "timestretch/time_stretcher.h"
 
+#include "hi_streaming/StreamingTelemetry.h"
 #include "hi_streaming/SampleThreadPool.h"
 #include "hi_streaming/MonolithAudioFormat.h"
 #include "hi_streaming/StreamingSampler.h"
 #include "hi_streaming/StreamingSamplerSound.h"
+#include "hi_streaming/AdaptivePreloadSizer.h"
 #include "hi_streaming/StreamingSamplerVoice.h"
 
 
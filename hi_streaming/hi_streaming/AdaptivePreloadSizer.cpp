@@ -0,0 +1,245 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+
+namespace hise { using namespace juce;
+
+AdaptivePreloadSizer::AdaptivePreloadSizer(StreamingTelemetry& telemetry_) :
+	telemetry(telemetry_)
+{
+	if (isEnabled())
+		telemetry.setEnabled(true);
+}
+
+void AdaptivePreloadSizer::setEnabled(bool shouldBeEnabled)
+{
+	// The refill latency is measured with the telemetry records
+	if (shouldBeEnabled)
+		telemetry.setEnabled(true);
+
+	if (enabled.exchange(shouldBeEnabled) != shouldBeEnabled)
+		listeners.call([shouldBeEnabled](Listener& l) { l.adaptivePreloadStateChanged(shouldBeEnabled); });
+}
+
+void AdaptivePreloadSizer::setPreloadRange(double newMinFactor, double newMaxFactor)
+{
+	ScopedLock sl(statisticsLock);
+
+	minFactor = jlimit(0.0, 1.0, newMinFactor);
+	maxFactor = jmax(1.0, newMaxFactor);
+}
+
+void AdaptivePreloadSizer::updateLatencyStatistics()
+{
+	Array<StreamingTelemetry::Record> records;
+	telemetry.copyRecords(records);
+
+	std::map<int64, Array<double>> latencies;
+	Array<double> allLatencies;
+
+	for (const auto& r : records)
+	{
+		if (r.type != StreamingTelemetry::EventType::Refill || r.requestTime <= 0.0)
+			continue;
+
+		const auto l = jmax(0.0, r.completionTime - r.requestTime);
+		latencies[r.soundHash].add(l);
+		allLatencies.add(l);
+	}
+
+	// We're using the 95th percentile so that a single hiccup doesn't blow up the preload buffer
+	auto getPercentile = [](Array<double>& values)
+	{
+		values.sort();
+		return values[jmin(values.size() - 1, (int)(values.size() * 0.95))];
+	};
+
+	ScopedLock sl(statisticsLock);
+
+	if (!allLatencies.isEmpty())
+		globalLatency = getPercentile(allLatencies);
+
+	for (auto& l : latencies)
+	{
+		if (l.second.size() >= NumMinRecordsPerSound)
+			latencyPerSound[l.first] = getPercentile(l.second);
+	}
+}
+
+double AdaptivePreloadSizer::getRefillLatency(int64 soundHash) const
+{
+	ScopedLock sl(statisticsLock);
+
+	auto it = latencyPerSound.find(soundHash);
+
+	if (it != latencyPerSound.end())
+		return it->second;
+
+	return globalLatency;
+}
+
+int64 AdaptivePreloadSizer::getNumBytesForPreloadSize(StreamingSamplerSound* s, int numSamples)
+{
+	const int64 numChannels = s->isStereo() ? 2 : 1;
+	const int64 bytesPerSample = s->isMonolithic() ? sizeof(int16) : sizeof(float);
+
+	return (int64)numSamples * numChannels * bytesPerSample;
+}
+
+int AdaptivePreloadSizer::getRequiredPreloadSize(StreamingSamplerSound* s) const
+{
+	// The preload buffer must last until the first streaming buffer is filled with the max pitch
+	const auto latencySeconds = getRefillLatency(s->getHashCode()) * 0.001;
+	return roundToInt(latencySeconds * s->getSampleRate() * (double)MAX_SAMPLER_PITCH);
+}
+
+bool AdaptivePreloadSizer::calculatePreloadSizes(Array<Entry>& entries, int64 availableBytes)
+{
+	struct SizeInfo
+	{
+		Entry* entry;
+		double score;
+		int minSize;
+		int targetSize;
+	};
+
+	std::vector<SizeInfo> infos;
+	infos.reserve(entries.size());
+
+	auto roundUp = [](int numSamples)
+	{
+		return ((numSamples + Granularity - 1) / Granularity) * Granularity;
+	};
+
+	double maxScore = 0.0;
+
+	{
+		ScopedLock sl(statisticsLock);
+
+		for (auto& e : entries)
+		{
+			e.newPreloadSize = e.sound->getPreloadSize();
+
+			// Sounds that are deactivated or loaded entirely are not changed
+			if (e.basePreloadSize <= 0 || e.sound->isEntireSampleLoaded())
+				continue;
+
+			// The score is a moving average of the note starts per update
+			auto& score = playScores[e.sound->getHashCode()];
+			score = score * 0.75 + (double)e.sound->getAndResetNumNoteStarts();
+			maxScore = jmax(maxScore, score);
+
+			const auto lowerLimit = roundUp(jmax(Granularity, roundToInt(e.basePreloadSize * minFactor)));
+			const auto upperLimit = roundUp(jmax(lowerLimit, roundToInt(e.basePreloadSize * maxFactor)));
+			const auto required = jlimit(lowerLimit, upperLimit, roundUp(getRequiredPreloadSize(e.sound)));
+
+			infos.push_back({ &e, score, required, upperLimit });
+		}
+	}
+
+	int64 numMinBytes = 0;
+
+	for (const auto& i : infos)
+		numMinBytes += getNumBytesForPreloadSize(i.entry->sound, i.minSize);
+
+	auto budgetIsMet = numMinBytes <= availableBytes;
+
+	// Shrink the minimum sizes so that they fit into the budget
+	if (!budgetIsMet)
+	{
+		const auto ratio = availableBytes > 0 ? (double)availableBytes / (double)numMinBytes : 0.0;
+
+		numMinBytes = 0;
+
+		for (auto& i : infos)
+		{
+			i.minSize = jmax(Granularity, (roundToInt(i.minSize * ratio) / Granularity) * Granularity);
+			numMinBytes += getNumBytesForPreloadSize(i.entry->sound, i.minSize);
+		}
+
+		budgetIsMet = numMinBytes <= availableBytes;
+	}
+
+	// Every sound gets the size that covers the latency, the rest goes to the sounds that are played the most
+	for (auto& i : infos)
+	{
+		if (maxScore > 0.0)
+		{
+			const auto heat = i.score / maxScore;
+			i.targetSize = jmax(i.minSize, roundUp(roundToInt(i.minSize + (i.targetSize - i.minSize) * heat)));
+		}
+		else
+			i.targetSize = i.minSize;
+	}
+
+	availableBytes -= numMinBytes;
+
+	std::sort(infos.begin(), infos.end(), [](const SizeInfo& a, const SizeInfo& b) { return a.score > b.score; });
+
+	for (auto& i : infos)
+	{
+		auto newSize = i.minSize;
+
+		if (availableBytes > 0 && i.targetSize > i.minSize)
+		{
+			const int64 bytesPerSample = getNumBytesForPreloadSize(i.entry->sound, 1);
+			const int64 maxExtra = (int64)(i.targetSize - i.minSize);
+			const auto numExtra = (int)std::min(maxExtra, availableBytes / bytesPerSample);
+
+			newSize += (numExtra / Granularity) * Granularity;
+			availableBytes -= getNumBytesForPreloadSize(i.entry->sound, newSize - i.minSize);
+		}
+
+		// Only reload the sound if the size changes significantly (or if it can't cover the latency)
+		const auto currentSize = i.entry->newPreloadSize;
+		const auto isTooSmall = currentSize < i.minSize;
+
+		if (!isTooSmall && std::abs(newSize - currentSize) <= currentSize / 4)
+		{
+			// Keeping a bigger buffer must not exceed the budget
+			const auto delta = getNumBytesForPreloadSize(i.entry->sound, currentSize) - getNumBytesForPreloadSize(i.entry->sound, newSize);
+
+			if (delta <= 0 || delta <= availableBytes)
+			{
+				availableBytes -= delta;
+				continue;
+			}
+		}
+
+		i.entry->newPreloadSize = newSize;
+	}
+
+	return budgetIsMet;
+}
+
+} // namespace hise
@@ -0,0 +1,147 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+
+#ifndef ADAPTIVEPRELOADSIZER_H_INCLUDED
+#define ADAPTIVEPRELOADSIZER_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+class StreamingSamplerSound;
+
+/** Calculates individual preload sizes for sounds based on the measured refill latency and how often they are played.
+
+	Instead of using the same preload size for every sound, this class looks at the refill records of the
+	StreamingTelemetry to find out how long it takes to load the next streaming buffer for a file (or monolith
+	chunk) and counts the note starts of each sound. Sounds that are played often will get a bigger preload
+	buffer, rarely played sounds will be shrinked to the size that is required to cover the refill latency.
+
+	The sum of all preload buffers is kept below the memory budget. It doesn't change the sounds itself, so
+	the owner of the sounds has to apply the new sizes in a safe context (with all voices killed).
+*/
+class AdaptivePreloadSizer
+{
+public:
+
+	/** A sound that should be resized. */
+	struct Entry
+	{
+		StreamingSamplerSound* sound = nullptr;
+
+		/** The preload size that would be used without the adaptive mode. */
+		int basePreloadSize = 0;
+
+		/** The result of calculatePreloadSizes(). If this is the same as the current preload size, you don't need to do anything. */
+		int newPreloadSize = 0;
+	};
+
+	/** A listener that is notified when the adaptive preload sizing is enabled or disabled. */
+	struct Listener
+	{
+		virtual ~Listener() {};
+
+		virtual void adaptivePreloadStateChanged(bool isEnabled) = 0;
+	};
+
+	AdaptivePreloadSizer(StreamingTelemetry& telemetry_);
+
+	/** Enables the adaptive preload sizing. This also enables the recording of the telemetry. 
+	
+		Call this from the message thread so that the listeners can start and stop their timers.
+	*/
+	void setEnabled(bool shouldBeEnabled);
+
+	void addListener(Listener* l) { listeners.add(l); }
+
+	void removeListener(Listener* l) { listeners.remove(l); }
+
+	bool isEnabled() const noexcept { return enabled.load(); }
+
+	/** Sets the maximum amount of memory that all preload buffers might use. */
+	void setMemoryBudget(int64 numBytes) noexcept { memoryBudget.store(numBytes > 0 ? numBytes : 0); }
+
+	int64 getMemoryBudget() const noexcept { return memoryBudget.load(); }
+
+	/** Sets the range of the preload size relative to the base preload size. */
+	void setPreloadRange(double minFactor, double maxFactor);
+
+	/** Reads the refill records of the telemetry and updates the latency for each sound. */
+	void updateLatencyStatistics();
+
+	/** Returns the refill latency in milliseconds for the given sound (or the global latency if there are not enough records for this sound). */
+	double getRefillLatency(int64 soundHash) const;
+
+	/** Calculates the new preload sizes for the given sounds.
+
+		The available bytes are the part of the memory budget that can be used by these sounds. This also
+		consumes the note start counters of the sounds, so make sure you only call it from one thread.
+
+		If the sizes that are required to cover the refill latency don't fit into the available bytes, they
+		will be scaled down to fit into the budget (but not below the granularity) and this returns false.
+	*/
+	bool calculatePreloadSizes(Array<Entry>& entries, int64 availableBytes);
+
+	/** Returns the amount of bytes that are used by the preload buffer of the given size. */
+	static int64 getNumBytesForPreloadSize(StreamingSamplerSound* s, int numSamples);
+
+private:
+
+	int getRequiredPreloadSize(StreamingSamplerSound* s) const;
+
+	/** The number of refill records for a sound until its own latency is used. */
+	static constexpr int NumMinRecordsPerSound = 8;
+
+	/** The sizes are rounded to this granularity to avoid reloading for small changes. */
+	static constexpr int Granularity = 1024;
+
+	StreamingTelemetry& telemetry;
+
+	std::atomic<bool> enabled = { (bool)HISE_ENABLE_ADAPTIVE_PRELOAD };
+	std::atomic<int64> memoryBudget = { (int64)HISE_ADAPTIVE_PRELOAD_BUDGET_MB * 1024 * 1024 };
+
+	double minFactor = 0.25;
+	double maxFactor = 4.0;
+
+	CriticalSection statisticsLock;
+
+	double globalLatency = 0.0;
+	std::map<int64, double> latencyPerSound;
+	std::map<int64, double> playScores;
+
+	ListenerList<Listener> listeners;
+
+	JUCE_DECLARE_NON_COPYABLE(AdaptivePreloadSizer);
+};
+
+} // namespace hise
+#endif  // ADAPTIVEPRELOADSIZER_H_INCLUDED
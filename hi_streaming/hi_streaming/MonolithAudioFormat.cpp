@@ -213,10 +213,12 @@ HlacMonolithInfo::HlacMonolithInfo(const Array<File>& monolithicFiles_)
 {
 	id = monolithicFiles_.getFirst().getFileNameWithoutExtension().replaceCharacter('_', '/');
 	monolithicFiles.reserve(monolithicFiles_.size());
+	storageDeviceIds.reserve(monolithicFiles_.size());
 
 	for (int i = 0; i < monolithicFiles_.size(); i++)
 	{
 		monolithicFiles.push_back(monolithicFiles_[i]);
+		storageDeviceIds.push_back(SampleThreadPool::getStorageDeviceId(monolithicFiles_[i]));
 
 #if USE_FALLBACK_READERS_FOR_MONOLITH
 		ScopedPointer<FileInputStream> fallbackStream = new FileInputStream(monolithicFiles_[i]);
@@ -386,6 +388,19 @@ juce::AudioFormatReader* HlacMonolithInfo::createUserInterfaceReader(int sampleI
 	return nullptr;
 }
 
+juce::int64 HlacMonolithInfo::getStorageDeviceId(int sampleIndex, int channelIndex) const
+{
+	if (isPositiveAndBelow(sampleIndex, sampleInfo.size()))
+	{
+		auto fileIndex = getFileIndex(channelIndex, sampleIndex);
+
+		if (isPositiveAndBelow(fileIndex, storageDeviceIds.size()))
+			return storageDeviceIds[fileIndex];
+	}
+
+	return -1;
+}
+
 juce::AudioFormatReader* HlacMonolithInfo::createMonolithicReader(int sampleIndex, int channelIndex)
 {
 	if (isPositiveAndBelow(sampleIndex, sampleInfo.size()))
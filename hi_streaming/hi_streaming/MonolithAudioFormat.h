@@ -147,6 +147,12 @@ public:
 	/** Use this for UI rendering stuff to avoid multithreading issues. */
 	AudioFormatReader* createUserInterfaceReader(int sampleIndex, int channelIndex);
 
+	/** Returns the ID of the storage device that contains the monolith for the given sample and channel. */
+	int64 getStorageDeviceId(int sampleIndex, int channelIndex) const;
+
+	/** Returns the monolith file that contains the given sample and channel. */
+	File getMonolithFile(int sampleIndex, int channelIndex) const { return getFile(channelIndex, sampleIndex); }
+
 	using Ptr = ReferenceCountedObjectPtr<HlacMonolithInfo>;
 
 private:
@@ -174,6 +180,7 @@ private:
 	std::vector<SampleInfo> sampleInfo;
 
 	std::vector<File> monolithicFiles;
+	std::vector<int64> storageDeviceIds;
 
 	int numChannels = 0;
 	int numSplitFiles = 0;
@@ -30,52 +30,418 @@
 *   ===========================================================================
 */
 
+#if !JUCE_WINDOWS
+#include <sys/stat.h>
+#endif
+
 namespace hise { using namespace juce;
 
 
 struct SampleThreadPool::Pimpl
 {
+	/** Measures the ratio between the busy and idle time of a thread. */
+	struct UsageMeasurement
+	{
+		void start()
+		{
+#if ENABLE_CPU_MEASUREMENT
+			lastEndTime = endTime;
+			startTime = Time::getHighResolutionTicks();
+#endif
+		}
+
+		void stop()
+		{
+#if ENABLE_CPU_MEASUREMENT
+			endTime = Time::getHighResolutionTicks();
+
+			const int64 idleTime = startTime - lastEndTime;
+			const int64 busyTime = endTime - startTime;
+
+			usage.store((double)busyTime / (double)(idleTime + busyTime));
+#endif
+		}
+
+		int64 startTime = 0, endTime = 0, lastEndTime = 0;
+		std::atomic<double> usage = { 0.0 };
+	};
+
+	/** The maximum number of threads that can add jobs to the same queue at the same time. */
+	static constexpr int NumProducerTokens = 8;
+
+	/** A multi producer queue that uses preallocated producer tokens.
+
+		Jobs are added from the audio thread and the audio rendering threads, so adding a job must
+		not allocate. The implicit producers of the moodycamel queue are created lazily for each thread,
+		so instead a thread claims one of the tokens that are created with the queue and releases it 
+		after the job was added. Jobs from the same thread keep their order as long as no other thread 
+		is adding a job at the same time.
+	*/
+	struct JobQueue
+	{
+		JobQueue(size_t capacity) :
+			queue(capacity, NumProducerTokens, 0)
+		{
+			for (auto& t : tokens)
+				t = new moodycamel::ProducerToken(queue);
+		}
+
+		/** Adds the job without allocating. Returns false if the queue is full. */
+		bool push(const WeakReference<Job>& j)
+		{
+			for (;;)
+			{
+				for (int i = 0; i < NumProducerTokens; i++)
+				{
+					bool expected = false;
+
+					if (tokenInUse[i].compare_exchange_strong(expected, true, std::memory_order_acquire))
+					{
+						auto ok = queue.try_enqueue(*tokens[i], j);
+						tokenInUse[i].store(false, std::memory_order_release);
+						return ok;
+					}
+				}
+
+				// more threads than tokens are adding a job right now...
+				Thread::yield();
+			}
+		}
+
+		bool pop(WeakReference<Job>& j)
+		{
+			return queue.try_dequeue(j);
+		}
+
+		moodycamel::ConcurrentQueue<WeakReference<Job>> queue;
+		ScopedPointer<moodycamel::ProducerToken> tokens[NumProducerTokens];
+		std::atomic<bool> tokenInUse[NumProducerTokens] = {};
+	};
+
+	/** A queue that holds all streaming jobs that read from the same storage device. 
+	
+		Jobs can be added from any thread, but only the streaming thread that has acquired the
+		queue may fetch and execute jobs, so the files of one device are never read in parallel.
+	*/
+	struct DeviceQueue
+	{
+		static constexpr int64 UnusedDevice = std::numeric_limits<int64>::min();
+
+		/** The time in milliseconds before a job that needs to run again is executed again. */
+		static constexpr double RetryDelayMs = 1.0;
+
+		static constexpr size_t Capacity = 512;
+
+		struct PendingJob
+		{
+			// the heap will put the job with the earliest deadline at the front
+			bool operator<(const PendingJob& other) const noexcept { return deadline > other.deadline; }
+
+			WeakReference<Job> job;
+			double deadline;
+			double retryTime = 0.0;
+		};
+
+		DeviceQueue():
+			incomingJobs(Capacity)
+		{
+			pendingJobs.reserve(Capacity);
+			delayedJobs.reserve(64);
+		}
+
+		bool tryToAcquire() noexcept
+		{
+			bool expected = false;
+			return busy.compare_exchange_strong(expected, true);
+		}
+
+		void release() noexcept
+		{
+			busy.store(false);
+		}
+
+		void fetchIncomingJobs()
+		{
+			WeakReference<Job> next;
+
+			while (incomingJobs.pop(next))
+			{
+				if (auto j = next.get())
+					addPendingJob(next, j->getDeadline());
+			}
+		}
+
+		void addPendingJob(const WeakReference<Job>& j, double deadline)
+		{
+			pendingJobs.push_back({ j, deadline });
+			std::push_heap(pendingJobs.begin(), pendingJobs.end());
+		}
+
+		/** Moves the delayed jobs whose retry time has passed back into the pending jobs. */
+		void fetchDelayedJobs(double now)
+		{
+			for (int i = 0; i < (int)delayedJobs.size();)
+			{
+				if (delayedJobs[i].retryTime <= now)
+				{
+					addPendingJob(delayedJobs[i].job, delayedJobs[i].deadline);
+					delayedJobs[i] = delayedJobs.back();
+					delayedJobs.pop_back();
+				}
+				else
+					i++;
+			}
+		}
+
+		bool hasDelayedJobs() const noexcept { return !delayedJobs.empty(); }
+
+		/** Executes the job with the earliest deadline. Returns false if there was no job. */
+		bool runMostUrgentJob(Thread* currentThread)
+		{
+			const auto now = Time::getMillisecondCounterHiRes();
+
+			fetchIncomingJobs();
+			fetchDelayedJobs(now);
+
+			if (pendingJobs.empty())
+				return false;
+
+			std::pop_heap(pendingJobs.begin(), pendingJobs.end());
+			auto next = pendingJobs.back();
+			pendingJobs.pop_back();
+
+			if (auto j = next.job.get())
+			{
+				// A job that needs to run again waits for another streaming thread (eg. the Unmapper
+				// waits for the loader of its voice), so it must not be executed right away or 
+				// this thread would spin until the other thread is done.
+				if (Pimpl::executeJob(j, currentThread) == Job::jobNeedsRunningAgain)
+				{
+					next.retryTime = now + RetryDelayMs;
+					delayedJobs.push_back(next);
+				}
+			}
+
+			return true;
+		}
+
+		void clear()
+		{
+			fetchIncomingJobs();
+
+			for (auto& p : pendingJobs)
+			{
+				if (auto j = p.job.get())
+				{
+					j->queued.store(false);
+					j->signalJobShouldExit();
+				}
+			}
+
+			for (auto& p : delayedJobs)
+			{
+				if (auto j = p.job.get())
+				{
+					j->queued.store(false);
+					j->signalJobShouldExit();
+				}
+			}
+
+			pendingJobs.clear();
+			delayedJobs.clear();
+		}
+
+		std::atomic<int64> deviceId = { UnusedDevice };
+		std::atomic<bool> busy = { false };
+		JobQueue incomingJobs;
+		std::vector<PendingJob> pendingJobs;
+		std::vector<PendingJob> delayedJobs;
+	};
+
+	/** A thread that executes the streaming jobs of all device queues. */
+	struct StreamingThread : public Thread
+	{
+		StreamingThread(Pimpl& parent_, int index_) :
+			Thread("Sample Streaming Thread " + String(index_ + 1), HISE_DEFAULT_STACK_SIZE),
+			parent(parent_),
+			index(index_)
+		{}
+
+		~StreamingThread()
+		{
+			stopThread(1000);
+		}
+
+		void run() override
+		{
+			int queueOffset = index;
+
+			while (!threadShouldExit())
+			{
+				bool hasDelayedJobs = false;
+				const bool executedJob = runNextJob(queueOffset, hasDelayedJobs);
+
+				// rotate the start index so that no device queue gets starved
+				queueOffset = (queueOffset + 1) % NumMaxStorageDevices;
+
+				if (!executedJob)
+					parent.streamingEvent.wait(hasDelayedJobs ? roundToInt(DeviceQueue::RetryDelayMs) : 500);
+			}
+		}
+
+		bool runNextJob(int queueOffset, bool& hasDelayedJobs)
+		{
+			// Jobs on the sample loading thread might change the sounds, so we
+			// must not execute any streaming jobs while they are running.
+			ScopedReadLock sl(parent.jobLock);
+
+			for (int i = 0; i < NumMaxStorageDevices; i++)
+			{
+				auto& q = parent.deviceQueues[(queueOffset + i) % NumMaxStorageDevices];
+
+				if (q.deviceId.load() == DeviceQueue::UnusedDevice || !q.tryToAcquire())
+					continue;
+
+				measurement.start();
+				const bool executedJob = q.runMostUrgentJob(this);
+				hasDelayedJobs |= q.hasDelayedJobs();
+				q.release();
+
+				if (executedJob)
+				{
+					measurement.stop();
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		Pimpl& parent;
+		const int index;
+		UsageMeasurement measurement;
+	};
+
 	Pimpl() :
 		jobQueue(8192),
-		currentlyExecutedJob(nullptr),
-		diskUsage(0.0)
+		currentlyExecutedJob(nullptr)
 	{};
 
 	~Pimpl()
 	{
+		streamingThreads.clear();
+
 		if (auto currentJob = currentlyExecutedJob.load())
 		{
 			currentJob->signalJobShouldExit();
 		}
 	}
 
+	static Job::JobStatus executeJob(Job* j, Thread* currentThread)
+	{
+		j->currentThread.store(currentThread);
+		j->running.store(true);
+
+		auto status = j->runJob();
+
+		j->running.store(false);
+
+		if (status == Job::jobHasFinished)
+			j->queued.store(false);
+
+		return status;
+	}
+
+	DeviceQueue& getQueueForDevice(int64 deviceId)
+	{
+		// The queues are assigned in order, so a linear search with a lock free
+		// insertion is enough to make sure that every device gets only one queue.
+		for (auto& q : deviceQueues)
+		{
+			auto expected = DeviceQueue::UnusedDevice;
+
+			if (q.deviceId.compare_exchange_strong(expected, deviceId) || expected == deviceId)
+				return q;
+		}
+
+		// More devices than queues, so some devices have to share their queue...
+		return deviceQueues[(uint64)deviceId % (uint64)NumMaxStorageDevices];
+	}
+
 	CriticalSection clearLock;
+	ReadWriteLock jobLock;
 
-	std::atomic<double> diskUsage;
-	int64 startTime, endTime;
-	moodycamel::ReaderWriterQueue<WeakReference<Job>> jobQueue;
+	UsageMeasurement measurement;
+	// The child synths of a container might be rendered on multiple threads, so this needs to support multiple producers
+	JobQueue jobQueue;
 	std::atomic<Job*> currentlyExecutedJob;
+
+	DeviceQueue deviceQueues[NumMaxStorageDevices];
+	WaitableEvent streamingEvent;
+	StreamingTelemetry telemetry;
+	OwnedArray<StreamingThread> streamingThreads;
+
 	static const String errorMessage;
 };
 
-SampleThreadPool::SampleThreadPool() :
+SampleThreadPool::SampleThreadPool(int numStreamingThreads) :
 	Thread("Sample Loading Thread", HISE_DEFAULT_STACK_SIZE),
 	pimpl(new Pimpl())
 {
-
 	startThread(9);
-	
+
+	for (int i = 0; i < numStreamingThreads; i++)
+	{
+		pimpl->streamingThreads.add(new Pimpl::StreamingThread(*pimpl, i));
+		pimpl->streamingThreads.getLast()->startThread(9);
+	}
 }
 
 SampleThreadPool::~SampleThreadPool()
 {
 	stopThread(1000);
+	pimpl->streamingThreads.clear();
 	pimpl = nullptr;
 }
 
+int64 SampleThreadPool::getStorageDeviceId(const File& f)
+{
+#if JUCE_WINDOWS
+	return (int64)(uint32)f.getVolumeSerialNumber();
+#else
+	auto fileToCheck = f;
+
+	// use the closest existing parent directory if the file doesn't exist (yet)
+	while (!fileToCheck.exists() && fileToCheck != fileToCheck.getParentDirectory())
+		fileToCheck = fileToCheck.getParentDirectory();
+
+	struct stat info;
+
+	if (stat(fileToCheck.getFullPathName().toRawUTF8(), &info) == 0)
+		return (int64)info.st_dev;
+
+	return 0;
+#endif
+}
+
+int SampleThreadPool::getNumStreamingThreads() const noexcept
+{
+	return pimpl->streamingThreads.size();
+}
+
+StreamingTelemetry& SampleThreadPool::getTelemetry() noexcept
+{
+	return pimpl->telemetry;
+}
+
 double SampleThreadPool::getDiskUsage() const noexcept
 {
-	return pimpl->diskUsage.load();
+	auto usage = pimpl->measurement.usage.load();
+
+	for (auto t : pimpl->streamingThreads)
+		usage = jmax(usage, t->measurement.usage.load());
+
+	return usage;
 }
 
 void SampleThreadPool::clearPendingTasks()
@@ -84,11 +450,21 @@ void SampleThreadPool::clearPendingTasks()
 		
 	WeakReference<Job> next;
 
-	while (pimpl->jobQueue.try_dequeue(next))
+	while (pimpl->jobQueue.pop(next))
 	{
 		next->queued.store(false);
 		next->signalJobShouldExit();
 	}
+
+	for (auto& q : pimpl->deviceQueues)
+	{
+		// wait until the streaming thread that currently processes this queue is done
+		while (!q.tryToAcquire())
+			Thread::yield();
+
+		q.clear();
+		q.release();
+	}
 }
 
 void SampleThreadPool::addJob(Job* jobToAdd, bool unused)
@@ -102,9 +478,32 @@ void SampleThreadPool::addJob(Job* jobToAdd, bool unused)
 	}
 #endif
 
+	auto deviceId = jobToAdd->getStorageDeviceId();
+
+	if (deviceId != -1 && !pimpl->streamingThreads.isEmpty())
+	{
+		jobToAdd->queued.store(true);
+
+		if (!pimpl->getQueueForDevice(deviceId).incomingJobs.push(jobToAdd))
+		{
+			// the voice will add the job again with its next request
+			jobToAdd->queued.store(false);
+			jassertfalse;
+			return;
+		}
+
+		pimpl->streamingEvent.signal();
+		return;
+	}
 
 	jobToAdd->queued.store(true);
-	pimpl->jobQueue.enqueue(jobToAdd);
+
+	if (!pimpl->jobQueue.push(jobToAdd))
+	{
+		jobToAdd->queued.store(false);
+		jassertfalse;
+		return;
+	}
 
 	notify();
 }
@@ -113,56 +512,30 @@ void SampleThreadPool::run()
 {
 	while (!threadShouldExit())
 	{
+		pimpl->telemetry.writePendingDump();
+
 		WeakReference<Job> next;
 
-		if (pimpl->jobQueue.try_dequeue(next))
+		if (pimpl->jobQueue.pop(next))
 		{
 			ScopedLock sl(pimpl->clearLock);
+			ScopedWriteLock swl(pimpl->jobLock);
 
 			Job* j = next.get();
 
-#if ENABLE_CPU_MEASUREMENT
-
-			const int64 lastEndTime = pimpl->endTime;
-			pimpl->startTime = Time::getHighResolutionTicks();
-#endif
+			pimpl->measurement.start();
 
 			if (j != nullptr)
 			{
 				pimpl->currentlyExecutedJob.store(j);
 
-				j->currentThread.store(this);
-
-				j->running.store(true);
-				
-				Job::JobStatus status = j->runJob();
-
-				j->running.store(false);
-
-				if (status == Job::jobHasFinished)
-				{
+				if (Pimpl::executeJob(j, this) == Job::jobNeedsRunningAgain && !pimpl->jobQueue.push(next))
 					j->queued.store(false);
-				}
-				else if (status == Job::jobNeedsRunningAgain)
-				{
-					pimpl->jobQueue.enqueue(next);
-				}
 
 				pimpl->currentlyExecutedJob.store(nullptr);
 			}
-			else
-			{
-				pimpl->jobQueue.pop();
-			}
-
-#if ENABLE_CPU_MEASUREMENT
-			pimpl->endTime = Time::getHighResolutionTicks();
-
-			const int64 idleTime = pimpl->startTime - lastEndTime;
-			const int64 busyTime = pimpl->endTime - pimpl->startTime;
 
-			pimpl->diskUsage.store((double)busyTime / (double)(idleTime + busyTime));
-#endif
+			pimpl->measurement.stop();
 		}
 
 #if 0 // Set this to true to enable defective threading (for debugging purposes)
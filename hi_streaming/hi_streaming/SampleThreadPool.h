@@ -35,14 +35,30 @@
 
 namespace hise { using namespace juce;
 
+/** The background thread pool that handles the sample loading and streaming.
+
+	It consists of the sample loading thread (which is the Thread object itself and executes
+	all jobs in the order they were added), and a configurable amount of streaming threads that
+	refill the voice buffers.
+
+	Streaming jobs are sorted into one queue per storage device so that files on different drives
+	can be read in parallel, and each queue is processed by only one streaming thread at a time, with the
+	job that has the earliest deadline (= the voice that runs out of samples first) being executed first.
+*/
 class SampleThreadPool : public Thread
 {
 public:
 
-	SampleThreadPool();
+	/** Creates a pool with the given amount of streaming threads. 
+	
+		If you pass in zero, the streaming jobs will be executed on the sample loading thread. 
+	*/
+	SampleThreadPool(int numStreamingThreads=HISE_NUM_STREAMING_THREADS);
 
 	~SampleThreadPool();
 	
+	/** The maximum number of storage devices that get their own queue. */
+	static constexpr int NumMaxStorageDevices = 8;
 
 	class Job
 	{
@@ -65,6 +81,14 @@ public:
 
 		virtual JobStatus runJob() = 0;
 
+		/** Override this and return the ID of the storage device that this job is reading from 
+		    in order to execute it on one of the streaming threads. 
+			
+			The default returns -1, which means that the job will be executed on the sample loading thread.
+			You can use SampleThreadPool::getStorageDeviceId() to obtain the ID for a file.
+		*/
+		virtual int64 getStorageDeviceId() const { return -1; }
+
 		bool shouldExit() const noexcept{ return shouldStop.load(); }
 
 		void signalJobShouldExit() { shouldStop.store(true); }
@@ -73,6 +97,15 @@ public:
 
 		bool isQueued() const noexcept{ return queued.load(); };
 
+		/** Sets the time (in milliseconds, see Time::getMillisecondCounterHiRes()) until this job needs to be finished. 
+		
+			Streaming jobs for the same storage device are executed in the order of their deadline.
+		*/
+		void setDeadline(double newDeadlineMs) noexcept { deadline.store(newDeadlineMs); }
+
+		/** Returns the deadline of the job. */
+		double getDeadline() const noexcept { return deadline.load(); }
+
 	protected:
 
 		void resetJob();
@@ -89,10 +122,20 @@ public:
 		std::atomic<bool> running;
 		std::atomic<bool> shouldStop;
 		std::atomic<Thread*> currentThread;
+		std::atomic<double> deadline = { std::numeric_limits<double>::max() };
 
 		const String name;
 	};
 
+	/** Returns an ID for the physical storage device that contains the given file. */
+	static int64 getStorageDeviceId(const File& f);
+
+	/** Returns the number of streaming threads. */
+	int getNumStreamingThreads() const noexcept;
+
+	/** Returns the recorder for the streaming activity of all voices that use this pool. */
+	StreamingTelemetry& getTelemetry() noexcept;
+
 	double getDiskUsage() const noexcept;
 
 	void clearPendingTasks();
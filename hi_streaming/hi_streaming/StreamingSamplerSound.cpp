@@ -435,7 +435,7 @@ double StreamingSamplerSound::getSampleRate() noexcept
 
 String StreamingSamplerSound::getFileName(bool getFullPath /*= false*/) const { return fileReader.getFileName(getFullPath); }
 
-int64 StreamingSamplerSound::getHashCode() { return fileReader.getHashCode(); }
+int64 StreamingSamplerSound::getHashCode() const { return fileReader.getHashCode(); }
 
 
 void StreamingSamplerSound::checkFileReference()
@@ -1038,11 +1038,13 @@ void StreamingSamplerSound::FileReader::setFile(const String &fileName)
 		fileFormatSupportsMemoryReading = fileExtension.contains("wav") || fileExtension.contains("aif");// || fileExtension.contains("hlac");
 
 		hashCode = loadedFile.hashCode64();
+		storageDeviceId = SampleThreadPool::getStorageDeviceId(loadedFile);
 	}
 	else
 	{
 		faultyFileName = fileName;
 		loadedFile = File();
+		storageDeviceId = -1;
 	}
 }
 
@@ -1251,8 +1253,15 @@ void StreamingSamplerSound::FileReader::readFromDisk(hlac::HiseSampleBuffer &buf
 
 		if (buffer.isFloatingPoint())
 			normalReader->read(buffer.getFloatBufferForFileReader(), startSample, numSamples, readerPosition, true, true);
-		else
-			dynamic_cast<hlac::HlacSubSectionReader*>(normalReader.get())->readIntoFixedBuffer(buffer, startSample, numSamples, readerPosition);
+		else if (auto hlacReader = dynamic_cast<hlac::HlacSubSectionReader*>(normalReader.get()))
+		{
+			// The decoder writes directly into the buffer, so we just need to make sure that
+			// the mapped pages for the next refill are paged in when we get there.
+			hlacReader->readIntoFixedBuffer(buffer, startSample, numSamples, readerPosition);
+
+			const auto nextPosition = isReversed() ? (readerPosition - numSamples) : (readerPosition + numSamples);
+			hlacReader->adviseReadAhead(nextPosition, numSamples);
+		}
 	}
 	else
 	{
@@ -1355,6 +1364,7 @@ void StreamingSamplerSound::FileReader::setMonolithicInfo(HlacMonolithInfo::Ptr
 	monolithicName = info->getFileName(channelIndex, sampleIndex);
 
 	hashCode = monolithicName.hashCode64();
+	storageDeviceId = info->getStorageDeviceId(sampleIndex, channelIndex);
 }
 
 } // namespace hise
@@ -185,6 +185,9 @@ public:
 	*/
 	void setPreloadSize(int newPreloadSizeInSamples, bool forceReload = false);
 
+	/** Returns the preload size in samples (without the sample start modulation). */
+	int getPreloadSize() const noexcept { return preloadSize; }
+
 	/** Returns the size of the preload buffer in bytes. You can use this method to check how much memory the sound uses. It also includes the memory used for the crossfade buffer. */
 	size_t getActualPreloadSize() const;
 
@@ -200,6 +203,12 @@ public:
 	/** decreases the voice counter. The file handle will be kept open until no voice is played. */
 	void decreaseVoiceCount() const;;
 
+	/** Counts the note starts of this sound. This is used by the AdaptivePreloadSizer to find the sounds that are played the most. */
+	void notifyNoteStart() const noexcept { numNoteStarts.fetch_add(1); }
+
+	/** Returns the number of note starts since the last call and resets the counter. */
+	uint32 getAndResetNumNoteStarts() const noexcept { return numNoteStarts.exchange(0); }
+
 	void closeFileHandle();
 	void openFileHandle();
 	bool isOpened();
@@ -215,15 +224,25 @@ public:
 
 	AudioFormatReader* createReaderForAnalysis();
 
+	/** Returns the ID of the storage device that contains the sample data. */
+	int64 getStorageDeviceId() const { return fileReader.getStorageDeviceId(); }
+
 	int64 getMonolithOffset() const { return fileReader.getMonolithOffset(); }
 	int64 getMonolithLength() const { return fileReader.getMonolithLength(); }
 	double getMonolithSampleRate() const { return fileReader.getMonolithSampleRate(); }
 
+	/** Returns the monolith file that contains the sample data or File() if the sample isn't monolithic. 
+	
+		Reading samples from the same monolith file is serialised unless the thread uses a 
+		hlac::HlacSubSectionReader::ScopedThreadReader for this file.
+	*/
+	File getMonolithFile() const { return fileReader.getMonolithFile(); }
+
 	// ==============================================================================================================================================
 
 	String getFileName(bool getFullPath = false) const;
 
-	int64 getHashCode();
+	int64 getHashCode() const;
 
 
 	void refreshFileInformation();
@@ -310,7 +329,8 @@ private:
 
 		String getFileName(bool getFullPath);
 		void checkFileReference();
-		int64 getHashCode() { return hashCode; };
+		int64 getHashCode() const { return hashCode; };
+		int64 getStorageDeviceId() const noexcept { return storageDeviceId; }
 
 		/** Refreshes the information about the file (if it is missing, if it supports memory-mapping). */
 		void refreshFileInformation();
@@ -376,6 +396,14 @@ private:
 			return 0.0;
 		}
 
+		File getMonolithFile() const
+		{
+			if (monolithicInfo != nullptr)
+				return monolithicInfo->getMonolithFile(monolithicIndex, monolithicChannelIndex);
+
+			return {};
+		}
+
 		// ==============================================================================================================================================
 
 		void wakeSound();
@@ -420,6 +448,8 @@ private:
 
 		int64 hashCode;
 
+		int64 storageDeviceId = -1;
+
 		StreamingSamplerSound *sound;
 
 		ScopedPointer<MemoryMappedAudioFormatReader> memoryReader;
@@ -491,6 +521,8 @@ private:
 	int preloadSize;
 	int internalPreloadSize;
 
+	mutable std::atomic<uint32> numNoteStarts = { 0 };
+
 	bool entireSampleLoaded;
 
 	int sampleStart;
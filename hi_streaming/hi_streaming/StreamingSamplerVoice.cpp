@@ -36,10 +36,13 @@ namespace hise { using namespace juce;
 
 
     
+static std::atomic<uint32> numCreatedLoaders = { 0 };
+
 SampleLoader::SampleLoader(SampleThreadPool *pool_) :
 	SampleThreadPoolJob("SampleLoader"),
 	backgroundPool(pool_),
 	writeBufferIsBeingFilled(false),
+	loaderId(++numCreatedLoaders),
 	sound(0),
 	readIndex(0),
 	readIndexDouble(0.0),
@@ -120,6 +123,34 @@ void SampleLoader::startNote(StreamingSamplerSound const *s, int startTime)
 
 	entireSampleIsLoaded = s->isEntireSampleLoaded();
 
+	if (isPrestretching())
+	{
+		bool notBeingFilled = false;
+
+		// The refill job of the last note might still be using the stretcher (or wait for the disk),
+		// so instead of waiting for it, the reset is deferred to the next run of the job.
+		if (writeBufferIsBeingFilled.compare_exchange_strong(notBeingFilled, true))
+		{
+			stretchResetPending = false;
+			resetStretcher(startTime);
+			cancelled = false;
+
+			// The first chunk can be calculated from the preload buffer so the voice
+			// doesn't have to wait for the streaming thread.
+			fillStretchBuffer(PrestretchChunkSize, false);
+
+			writeBufferIsBeingFilled = false;
+		}
+		else
+		{
+			pendingStretchStart = startTime;
+			stretchResetPending = true;
+		}
+
+		requestNewData();
+		return;
+	}
+
 	if (!entireSampleIsLoaded)
 	{
 		// The other buffer will be filled on the next free thread pool slot
@@ -187,6 +218,7 @@ void SampleLoader::setStreamingBufferDataType(bool shouldBeFloat)
 		b2 = hlac::HiseSampleBuffer(shouldBeFloat, 2, 0);
 
 		refreshBufferSizes();
+		resizeStretchBuffers();
 	}
 }
 
@@ -337,6 +369,20 @@ bool SampleLoader::advanceReadIndex(double uptime)
 		}
 		else
 		{
+			auto& telemetry = backgroundPool->getTelemetry();
+
+			if (telemetry.isEnabled())
+			{
+				// If the job is still queued, the write buffer doesn't contain the samples we need
+				const bool refillFinished = !isQueued() && !writeBufferIsBeingFilled;
+				auto r = createTelemetryRecord(refillFinished ? StreamingTelemetry::EventType::Swap :
+																StreamingTelemetry::EventType::Underrun);
+
+				const auto now = Time::getMillisecondCounterHiRes();
+				r.headroom = refillFinished ? (now - lastCompletionTime.load()) : (lastRequestTime - now);
+				telemetry.addRecord(r);
+			}
+
 			lastSwapPosition = (double)positionInSampleFile;
 			positionInSampleFile += getNumSamplesForStreamingBuffers();
 			readIndexDouble = uptime - lastSwapPosition;
@@ -357,6 +403,35 @@ int SampleLoader::getNumSamplesForStreamingBuffers() const
 	return b1.getNumSamples();
 }
 
+double SampleLoader::calculateDeadline() const
+{
+	const auto now = Time::getMillisecondCounterHiRes();
+
+	if (playbackRate <= 0.0)
+		return now;
+
+	if (isPrestretching())
+	{
+		if (stretchResetPending)
+			return now;
+
+		return now + 1000.0 * (double)getNumStretchedSamplesAvailable() / playbackRate;
+	}
+
+	// The write buffer must be filled before the voice reaches the end of the read buffer
+	const auto numSamplesLeft = jmax(0.0, (double)readBuffer.get()->getNumSamples() - readIndexDouble);
+
+	return now + 1000.0 * numSamplesLeft / playbackRate;
+}
+
+int64 SampleLoader::getStorageDeviceId() const
+{
+	if (auto s = sound.get())
+		return s->getStorageDeviceId();
+
+	return -1;
+}
+
 bool SampleLoader::requestNewData()
 {
 	cancelled = false;
@@ -367,6 +442,9 @@ bool SampleLoader::requestNewData()
 		return true;
 	}
 
+	setDeadline(calculateDeadline());
+	lastRequestTime = Time::getMillisecondCounterHiRes();
+
 #if KILL_VOICES_WHEN_STREAMING_IS_BLOCKED
 	if (this->isQueued())
 	{
@@ -397,13 +475,14 @@ SampleThreadPoolJob::JobStatus SampleLoader::runJob()
 
 	const double readStart = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks());
 
-	if (writeBufferIsBeingFilled)
+	bool notBeingFilled = false;
+
+	// A poor man's mutex but gets the job done.
+	if (!writeBufferIsBeingFilled.compare_exchange_strong(notBeingFilled, true))
 	{
 		return SampleThreadPoolJob::jobNeedsRunningAgain;
 	}
 
-	writeBufferIsBeingFilled = true; // A poor man's mutex but gets the job done.
-
 	const StreamingSamplerSound *localSound = sound.get();
 
 	if (!voiceCounterWasIncreased && localSound != nullptr)
@@ -412,12 +491,42 @@ SampleThreadPoolJob::JobStatus SampleLoader::runJob()
 		voiceCounterWasIncreased = true;
 	}
 
-	fillInactiveBuffer();
+	auto& telemetry = backgroundPool->getTelemetry();
+	auto r = createTelemetryRecord(StreamingTelemetry::EventType::Refill);
+
+	if (telemetry.isEnabled())
+		r.startTime = Time::getMillisecondCounterHiRes();
+
+	if (isPrestretching())
+	{
+		if (stretchResetPending)
+		{
+			resetStretcher(pendingStretchStart);
+			stretchResetPending = false;
+		}
+
+		fillStretchBuffer(stretchFifo.getNumSamples(), true);
+	}
+	else
+		fillInactiveBuffer();
 
 	writeBufferIsBeingFilled = false;
 
 	const double readStop = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks());
 	const double readTime = (readStop - readStart);
+
+	if (telemetry.isEnabled())
+	{
+		auto wb = writeBuffer.get();
+
+		r.completionTime = Time::getMillisecondCounterHiRes();
+		r.decodeTime = readTime * 1000.0;
+		r.numBytesRead = (int64)r.numSamples * wb->getNumChannels() * (wb->isFloatingPoint() ? sizeof(float) : sizeof(int16));
+		r.hasEnoughSamples = localSound != nullptr && localSound->hasEnoughSamplesForBlock(r.positionInFile + r.numSamples);
+
+		lastCompletionTime.store(r.completionTime);
+		telemetry.addRecord(r);
+	}
 	const double timeSinceLastCall = readStop - lastCallToRequestData;
 	const float diskUsageThisTime = jmax<float>(diskUsage.get(), (float)(readTime / timeSinceLastCall));
 	diskUsage = diskUsageThisTime;
@@ -426,6 +535,37 @@ SampleThreadPoolJob::JobStatus SampleLoader::runJob()
 	return SampleThreadPoolJob::JobStatus::jobHasFinished;
 }
 
+StreamingTelemetry::Record SampleLoader::createTelemetryRecord(StreamingTelemetry::EventType type) const
+{
+	StreamingTelemetry::Record r;
+
+	r.type = type;
+	r.voiceId = loaderId;
+	r.positionInFile = positionInSampleFile;
+	r.numSamples = getNumSamplesForStreamingBuffers();
+	r.requestTime = lastRequestTime;
+
+	if (auto s = sound.get())
+	{
+		r.soundHash = s->getHashCode();
+		r.monolithOffset = s->getMonolithOffset();
+	}
+
+	return r;
+}
+
+void SampleLoader::reportSampleEnd()
+{
+	auto& telemetry = backgroundPool->getTelemetry();
+
+	if (telemetry.isEnabled())
+	{
+		auto r = createTelemetryRecord(StreamingTelemetry::EventType::SampleEnd);
+		r.hasEnoughSamples = false;
+		telemetry.addRecord(r);
+	}
+}
+
 size_t SampleLoader::getActualStreamingBufferSize() const
 {
 	return b1.getNumSamples() * 2 * 2;
@@ -497,10 +637,283 @@ void SampleLoader::refreshBufferSizes()
 		readBuffer = &b1;
 		writeBuffer = &b2;
 
+		resizeStretchBuffers();
+
+		reset();
+	}
+}
+
+void SampleLoader::setPrestretcher(time_stretcher* stretcherToUse)
+{
+	ScopedLock sl(getLock());
+
+	if (prestretcher != stretcherToUse)
+	{
+		ScopedJobBlocker sjb(*this);
+
+		prestretcher = stretcherToUse;
+		resizeStretchBuffers();
 		reset();
 	}
 }
 
+void SampleLoader::setPrestretchParameters(double newRatio, double newPitchFactor, double newTonality) noexcept
+{
+	prestretchRatio.store(newRatio);
+	prestretchPitchFactor.store(newPitchFactor);
+	prestretchTonality.store(newTonality);
+}
+
+void SampleLoader::resizeStretchBuffers()
+{
+	if (!isPrestretching())
+	{
+		stretchFifo.setSize(0, 0);
+		stretchInput.setSize(0, 0);
+		stretchOutput.setSize(0, 0);
+		stretchSource = hlac::HiseSampleBuffer(b1.isFloatingPoint(), 2, 0);
+		return;
+	}
+
+	// The FIFO holds two streaming buffers worth of output (it must be a power of two for the wrap mask)
+	const auto fifoSize = nextPowerOfTwo(jmax(PrestretchChunkSize * 4, 2 * getNumSamplesForStreamingBuffers()));
+	const auto maxInputSize = PrestretchChunkSize * MAX_SAMPLER_PITCH + 1;
+
+	stretchFifo.setSize(2, fifoSize);
+	stretchFifo.clear();
+	stretchOutput.setSize(2, PrestretchChunkSize);
+	stretchInput.setSize(2, maxInputSize);
+
+	stretchSource = hlac::HiseSampleBuffer(b1.isFloatingPoint(), 2, 0);
+	StreamingHelpers::increaseBufferIfNeeded(stretchSource, maxInputSize);
+
+	stretchReadPosition = 0;
+	stretchWritePosition = 0;
+}
+
+int SampleLoader::getNumStretchedSamplesAvailable() const noexcept
+{
+	return (int)(stretchWritePosition.load() - stretchReadPosition.load());
+}
+
+bool SampleLoader::isInsidePreloadBuffer(const StreamingSamplerSound* s, int startInSample, int numSamples) const
+{
+	auto endInSample = startInSample + numSamples;
+
+	if (s->isLoopEnabled() && endInSample > (s->getLoopEnd() - s->getSampleStart()))
+		return false;
+
+	return endInSample <= s->getPreloadBuffer().getNumSamples();
+}
+
+void SampleLoader::convertStretchSource(const hlac::HiseSampleBuffer& source, int offsetInSource, int offsetInInput, int numSamples)
+{
+	float* dst[2] = { stretchInput.getWritePointer(0, offsetInInput), stretchInput.getWritePointer(1, offsetInInput) };
+	const auto numChannels = source.getNumChannels();
+
+	if (source.isFloatingPoint())
+	{
+		for (int i = 0; i < numChannels; i++)
+			FloatVectorOperations::copy(dst[i], static_cast<const float*>(source.getReadPointer(i, offsetInSource)), numSamples);
+	}
+	else
+	{
+		source.convertToFloatWithNormalisation(dst, numChannels, offsetInSource, numSamples);
+	}
+}
+
+bool SampleLoader::readStretchSource(const StreamingSamplerSound* s, int numSamples)
+{
+	jassert(numSamples <= stretchInput.getNumSamples());
+
+	const auto pos = stretchSourcePosition.fetch_add(numSamples);
+
+	if (isInsidePreloadBuffer(s, pos, numSamples))
+	{
+		convertStretchSource(s->getPreloadBuffer(), pos, 0, numSamples);
+		return true;
+	}
+
+	const int numToRead = s->isLoopEnabled() ? numSamples : jlimit(0, numSamples, s->getSampleLength() - pos);
+
+	if (numToRead > 0 && s->hasEnoughSamplesForBlock(pos + numToRead))
+	{
+		s->fillSampleBuffer(stretchSource, numToRead, pos);
+		convertStretchSource(stretchSource, 0, 0, numToRead);
+	}
+	else if (numToRead > 0)
+	{
+		stretchInput.clear(0, numToRead);
+	}
+
+	if (numToRead < numSamples)
+	{
+		stretchInput.clear(numToRead, numSamples - numToRead);
+		return false;
+	}
+
+	return true;
+}
+
+void SampleLoader::fillStretchBuffer(int maxNumSamplesToWrite, bool allowDiskRead)
+{
+	const StreamingSamplerSound *localSound = sound.get();
+
+	if (localSound == nullptr || prestretcher == nullptr)
+		return;
+
+	const auto capacity = stretchFifo.getNumSamples();
+	const auto mask = (int64)capacity - 1;
+	const auto numChannels = localSound->isStereo() ? 2 : 1;
+	int numWritten = 0;
+
+	// a new note has started, so stop and let the next run of the job reset the stretcher
+	while (!cancelled && !stretchResetPending && !stretchedSampleEnded && numWritten < maxNumSamplesToWrite)
+	{
+		if (capacity - getNumStretchedSamplesAvailable() < PrestretchChunkSize)
+			break;
+
+		const auto ratio = jlimit(0.0, (double)MAX_SAMPLER_PITCH, prestretchRatio.load());
+
+		stretchSourceRemainder += PrestretchChunkSize * ratio;
+		const auto numInput = jmin(stretchInput.getNumSamples(), (int)stretchSourceRemainder);
+
+		if (!allowDiskRead && !isInsidePreloadBuffer(localSound, stretchSourcePosition.load(), numInput))
+		{
+			stretchSourceRemainder -= PrestretchChunkSize * ratio;
+			break;
+		}
+
+		stretchSourceRemainder -= numInput;
+
+		if (!readStretchSource(localSound, numInput))
+			stretchedSampleEnded = true;
+
+		float* inp[2] = { stretchInput.getWritePointer(0), stretchInput.getWritePointer(1) };
+		float* out[2] = { stretchOutput.getWritePointer(0), stretchOutput.getWritePointer(1) };
+
+		prestretcher->setTransposeFactor(prestretchPitchFactor.load(), prestretchTonality.load());
+		prestretcher->process(inp, numInput, out, PrestretchChunkSize);
+
+		if (numChannels == 1)
+			FloatVectorOperations::copy(out[1], out[0], PrestretchChunkSize);
+
+		const auto writePos = stretchWritePosition.load();
+		const auto start = (int)(writePos & mask);
+		const auto numBeforeWrap = jmin(PrestretchChunkSize, capacity - start);
+
+		for (int i = 0; i < 2; i++)
+		{
+			stretchFifo.copyFrom(i, start, out[i], numBeforeWrap);
+
+			if (numBeforeWrap < PrestretchChunkSize)
+				stretchFifo.copyFrom(i, 0, out[i] + numBeforeWrap, PrestretchChunkSize - numBeforeWrap);
+		}
+
+		stretchWritePosition.store(writePos + PrestretchChunkSize);
+		numWritten += PrestretchChunkSize;
+	}
+
+	positionInSampleFile = stretchSourcePosition.load();
+}
+
+void SampleLoader::resetStretcher(int startTime)
+{
+	const StreamingSamplerSound *localSound = sound.get();
+
+	if (localSound == nullptr || prestretcher == nullptr)
+		return;
+
+	prestretcher->configure(localSound->isStereo() ? 2 : 1, const_cast<StreamingSamplerSound*>(localSound)->getSampleRate());
+	prestretcher->setResampleBuffer(1.0, nullptr, 0);
+	prestretcher->reset();
+
+	stretchReadPosition = 0;
+	stretchWritePosition = 0;
+	stretchedSampleEnded = false;
+	stretchSourcePosition = startTime;
+	stretchSourceRemainder = 0.0;
+}
+
+bool SampleLoader::readStretchedSamples(float** output, int numSamples)
+{
+	if (stretchResetPending)
+	{
+		// the streaming thread hasn't started the new note yet
+		for (int i = 0; i < 2; i++)
+			FloatVectorOperations::clear(output[i], numSamples);
+
+		return true;
+	}
+
+	const auto capacity = stretchFifo.getNumSamples();
+	const auto mask = (int64)capacity - 1;
+	const auto readPos = stretchReadPosition.load();
+	const auto numAvailable = getNumStretchedSamplesAvailable();
+	const auto numToRead = jmin(numAvailable, numSamples);
+
+	if (numToRead > 0)
+	{
+		const auto start = (int)(readPos & mask);
+		const auto numBeforeWrap = jmin(numToRead, capacity - start);
+
+		for (int i = 0; i < 2; i++)
+		{
+			FloatVectorOperations::copy(output[i], stretchFifo.getReadPointer(i, start), numBeforeWrap);
+
+			if (numBeforeWrap < numToRead)
+				FloatVectorOperations::copy(output[i] + numBeforeWrap, stretchFifo.getReadPointer(i, 0), numToRead - numBeforeWrap);
+		}
+
+		stretchReadPosition.store(readPos + numToRead);
+	}
+
+	if (numToRead < numSamples)
+	{
+		for (int i = 0; i < 2; i++)
+			FloatVectorOperations::clear(output[i] + numToRead, numSamples - numToRead);
+
+		if (stretchedSampleEnded)
+			return false;
+
+		auto& telemetry = backgroundPool->getTelemetry();
+
+		if (telemetry.isEnabled())
+		{
+			auto r = createTelemetryRecord(StreamingTelemetry::EventType::Underrun);
+			r.hasEnoughSamples = false;
+			telemetry.addRecord(r);
+		}
+	}
+
+	if (!stretchedSampleEnded && !writeBufferIsBeingFilled && !isQueued() &&
+		(numAvailable - numToRead) < capacity / 2)
+	{
+		requestNewData();
+	}
+
+	return true;
+}
+
+SampleLoader::ScopedJobBlocker::ScopedJobBlocker(SampleLoader& l) :
+	loader(l),
+	wasCancelled(l.cancelled.exchange(true))
+{
+	bool notBeingFilled = false;
+
+	while (!loader.writeBufferIsBeingFilled.compare_exchange_weak(notBeingFilled, true))
+	{
+		notBeingFilled = false;
+		Thread::sleep(1);
+	}
+}
+
+SampleLoader::ScopedJobBlocker::~ScopedJobBlocker()
+{
+	loader.cancelled = wasCancelled;
+	loader.writeBufferIsBeingFilled = false;
+}
+
 bool SampleLoader::swapBuffers()
 {
 	auto localReadBuffer = readBuffer.get();
@@ -541,10 +954,21 @@ void StreamingSamplerVoice::startNote(int /*midiNoteNumber*/,
 {
 	StreamingSamplerSound *sound = dynamic_cast<StreamingSamplerSound*>(s);
 
-	stretcher.configure(sound->isStereo() ? 2 : 1, sound->getSampleRate());
+	// In background mode the loader configures the stretcher when the refill job isn't using it
+	if (!loader.isPrestretching())
+		stretcher.configure(sound->isStereo() ? 2 : 1, sound->getSampleRate());
 
 	if (sound != nullptr && sound->getSampleLength() > 0)
 	{
+		sound->notifyNoteStart();
+
+		if (loader.isPrestretching())
+		{
+			// The loader will calculate the first chunk in startNote(), so the parameters must be set before that.
+			loader.setPrestretchParameters(stretchRatio, uptimeDelta * (sound->getSampleRate() / getSampleRate()), timestretchTonality);
+		}
+
+		loader.setPlaybackRate(uptimeDelta * sound->getSampleRate());
 		loader.startNote(sound, sampleStartModValue);
 
 		jassert(sound != nullptr);
@@ -564,7 +988,7 @@ void StreamingSamplerVoice::startNote(int /*midiNoteNumber*/,
 
 		isActive = true;
 
-		if (stretcher.isEnabled())
+		if (stretcher.isEnabled() && !loader.isPrestretching())
 		{
 			stretcher.configure(sound->isStereo() ? 2 : 1, sound->getSampleRate());
 			stretcher.setResampleBuffer(1.0, nullptr, 0);
@@ -848,7 +1272,11 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 
 	if (sound != nullptr)
 	{
-		
+		if (loader.isPrestretching())
+		{
+			renderPrestretchedBlock(outputBuffer, startSample, numSamples);
+			return;
+		}
 
 		float* outL = outputBuffer.getWritePointer(0, startSample);
 		float* outR = outputBuffer.getWritePointer(1, startSample);
@@ -947,6 +1375,9 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
                 FloatVectorOperations::copy(out[1], out[0], numOutput);
 		}
 
+		if (numSamples > 0)
+			loader.setPlaybackRate(pitchCounter / (double)numSamples * getSampleRate());
+
 		if (!loader.advanceReadIndex(voiceUptime))
 		{
 #if LOG_SAMPLE_RENDERING
@@ -966,7 +1397,11 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 		logger->checkSampleData(nullptr, DebugLogger::Location::SampleVoiceBufferFillPost, false, outputBuffer.getReadPointer(1, startFixed), numSamplesFixed);
 #endif
 
-		if (!enoughSamples) resetVoice();
+		if (!enoughSamples)
+		{
+			loader.reportSampleEnd();
+			resetVoice();
+		}
 	}
 	else
 	{
@@ -974,6 +1409,29 @@ void StreamingSamplerVoice::renderNextBlock(AudioSampleBuffer &outputBuffer, int
 	}
 };
 
+void StreamingSamplerVoice::renderPrestretchedBlock(AudioSampleBuffer& outputBuffer, int startSample, int numSamples)
+{
+	auto thisUptimeDelta = uptimeDelta;
+
+	if (pitchData != nullptr)
+		thisUptimeDelta *= pitchData[0];
+
+	// The stretcher runs on the streaming thread, so these values will be picked up with the next refill.
+	loader.setPrestretchParameters(stretchRatio, thisUptimeDelta, timestretchTonality);
+	loader.setPlaybackRate(getSampleRate());
+
+	float* out[2] = { outputBuffer.getWritePointer(0, startSample), outputBuffer.getWritePointer(1, startSample) };
+
+	pitchCounter = numSamples * stretchRatio;
+	voiceUptime += pitchCounter;
+
+	if (!loader.readStretchedSamples(out, numSamples))
+	{
+		loader.reportSampleEnd();
+		resetVoice();
+	}
+}
+
 void StreamingSamplerVoice::setPitchFactor(int midiNote, int rootNote, StreamingSamplerSound *sound, double globalPitchFactor)
 {
 	if (midiNote == rootNote)
@@ -1064,11 +1522,9 @@ SampleThreadPool::Job::JobStatus SampleLoader::Unmapper::runJob()
 {
 	jassert(sound != nullptr);
 
+	// With multiple streaming threads, the loader might already be reading the next sound
 	if (loader->isRunning())
-	{
-		jassertfalse;
 		return SampleThreadPoolJob::jobNeedsRunningAgain;
-	}
 
 	if (sound != nullptr)
 	{
@@ -1081,4 +1537,12 @@ SampleThreadPool::Job::JobStatus SampleLoader::Unmapper::runJob()
 	return SampleThreadPoolJob::jobHasFinished;
 }
 
+int64 SampleLoader::Unmapper::getStorageDeviceId() const
+{
+	if (sound != nullptr)
+		return sound->getStorageDeviceId();
+
+	return -1;
+}
+
 } // namespace hise
@@ -69,6 +69,15 @@ public:
 	*/
 	JobStatus runJob() override;
 
+	/** Returns the storage device of the currently loaded sound so that the refill is executed on a streaming thread. */
+	int64 getStorageDeviceId() const override;
+
+	/** Sets the amount of samples per second that the voice consumes from the streaming buffers. 
+	
+		This is used to calculate the deadline of the next refill operation.
+	*/
+	void setPlaybackRate(double sourceSamplesPerSecond) noexcept { playbackRate = sourceSamplesPerSecond; }
+
 	size_t getActualStreamingBufferSize() const;
 
 	void setStreamingBufferDataType(bool shouldBeFloat);
@@ -103,6 +112,8 @@ public:
 
 		JobStatus runJob() override;
 
+		int64 getStorageDeviceId() const override;
+
 	private:
 
 		StreamingSamplerSound::Ptr sound;
@@ -112,6 +123,9 @@ public:
 	/** Resets the loader (unloads the sound). */
 	void reset();
 
+	/** Adds a telemetry record that the voice was stopped because the sound has no more samples. */
+	void reportSampleEnd();
+
 	void clearLoader();
 
 	/** Calculates and returns the disk usage.
@@ -136,6 +150,41 @@ public:
 		nonRealtime = shouldBeNonRealtime;
 	}
 
+	/** Enables the background timestretching with the given stretcher (or disables it if nullptr).
+	
+		If this is enabled, the refill job will read the source samples and run the stretcher
+		on the streaming thread. It writes the output into a FIFO that the voice consumes with
+		readStretchedSamples(), so the voice doesn't need to touch the streaming buffers at all.
+	*/
+	void setPrestretcher(time_stretcher* stretcherToUse);
+
+	bool isPrestretching() const noexcept { return prestretcher != nullptr; }
+
+	/** Sets the values that the next refill will use for the stretcher. This is lock free and can be called from the audio thread. */
+	void setPrestretchParameters(double newRatio, double newPitchFactor, double newTonality) noexcept;
+
+	/** Copies the next block of stretched samples into the output and returns false if the end of the sample was reached. */
+	bool readStretchedSamples(float** output, int numSamples);
+
+	/** Cancels a running refill job, waits until it's finished and keeps new jobs from running until it goes out of scope.
+	
+		Use this whenever the stretcher or the stretch buffers are reallocated while the refill job might be using them.
+		The job might be waiting for a disk read, so this must not be used on the audio thread (startNote() defers
+		the reset of the stretcher to the refill job instead).
+	*/
+	struct ScopedJobBlocker
+	{
+		ScopedJobBlocker(SampleLoader& l);
+		~ScopedJobBlocker();
+
+	private:
+
+		SampleLoader& loader;
+		const bool wasCancelled;
+
+		JUCE_DECLARE_NON_COPYABLE(ScopedJobBlocker);
+	};
+
 private:
 
 	bool nonRealtime = false;
@@ -146,12 +195,26 @@ private:
 
 	int getNumSamplesForStreamingBuffers() const;
 
+	double calculateDeadline() const;
+
+	StreamingTelemetry::Record createTelemetryRecord(StreamingTelemetry::EventType type) const;
+
 	bool requestNewData();
 
 	bool swapBuffers();
 
 	void fillInactiveBuffer();
 	void refreshBufferSizes();
+
+	void fillStretchBuffer(int maxNumSamplesToWrite, bool allowDiskRead);
+	bool isInsidePreloadBuffer(const StreamingSamplerSound* s, int startInSample, int numSamples) const;
+	bool readStretchSource(const StreamingSamplerSound* s, int numSamples);
+	void convertStretchSource(const hlac::HiseSampleBuffer& source, int offsetInSource, int offsetInInput, int numSamples);
+	int getNumStretchedSamplesAvailable() const noexcept;
+	void resizeStretchBuffers();
+
+	/** Prepares the stretcher for a new note. Only call this while holding writeBufferIsBeingFilled. */
+	void resetStretcher(int startTime);
 	// ============================================================================================ member variables
 
 	Unmapper unmapper;
@@ -163,7 +226,7 @@ private:
 	CriticalSection lock;
 
 	/** A mutex for the buffer that is being used for loading. */
-	bool writeBufferIsBeingFilled;
+	std::atomic<bool> writeBufferIsBeingFilled;
 
 	// variables for handling of the internal buffers
 
@@ -171,6 +234,14 @@ private:
 
 	double lastSwapPosition = 0.0;
 
+	double playbackRate = 0.0;
+
+	// variables for the streaming telemetry
+
+	const uint32 loaderId;
+	double lastRequestTime = 0.0;
+	std::atomic<double> lastCompletionTime = { 0.0 };
+
 	Atomic<StreamingSamplerSound const *> sound;
 
 	int readIndex;
@@ -204,7 +275,31 @@ private:
 
 	hlac::HiseSampleBuffer b1, b2;
 
-	bool cancelled = false;
+	std::atomic<bool> cancelled = { false };
+
+	// variables for the background timestretching
+
+	static constexpr int PrestretchChunkSize = 512;
+
+	time_stretcher* prestretcher = nullptr;
+
+	std::atomic<double> prestretchRatio = { 1.0 };
+	std::atomic<double> prestretchPitchFactor = { 1.0 };
+	std::atomic<double> prestretchTonality = { 0.0 };
+
+	std::atomic<int64> stretchReadPosition = { 0 };
+	std::atomic<int64> stretchWritePosition = { 0 };
+	std::atomic<bool> stretchedSampleEnded = { false };
+
+	std::atomic<int> stretchSourcePosition = { 0 };
+
+	/** Set by startNote() if the refill job was busy. The job will reset the stretcher before the next fill. */
+	std::atomic<bool> stretchResetPending = { false };
+	std::atomic<int> pendingStretchStart = { 0 };
+	double stretchSourceRemainder = 0.0;
+
+	hlac::HiseSampleBuffer stretchSource;
+	AudioSampleBuffer stretchInput, stretchOutput, stretchFifo;
 };
 
 
@@ -302,7 +397,18 @@ public:
 
 	void setEnableTimestretch(bool shouldBeEnabled, const Identifier& engineId={})
 	{
-		stretcher.setEnabled(shouldBeEnabled, engineId);
+		{
+			SampleLoader::ScopedJobBlocker sjb(loader);
+			stretcher.setEnabled(shouldBeEnabled, engineId);
+		}
+
+		loader.setPrestretcher(stretcher.isEnabled() && backgroundStretch ? &stretcher : nullptr);
+	}
+
+	/** Moves the timestretching to the streaming thread. Call this before setEnableTimestretch(). */
+	void setUseBackgroundTimestretch(bool shouldUseBackgroundThread)
+	{
+		backgroundStretch = shouldUseBackgroundThread;
 	}
 
 	void setTimestretchRatio(double newRatio)
@@ -322,9 +428,12 @@ public:
 
 private:
 
+	void renderPrestretchedBlock(AudioSampleBuffer& outputBuffer, int startSample, int numSamples);
+
 	double timestretchTonality = 0.0;
 
 	bool skipLatency = false;
+	bool backgroundStretch = false;
 
 	double pitchCounter = 0.0;
 
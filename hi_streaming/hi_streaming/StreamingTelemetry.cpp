@@ -0,0 +1,346 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+namespace hise { using namespace juce;
+
+StreamingTelemetry::StreamingTelemetry() :
+	slots(new Slot[NumRecords])
+{
+}
+
+void StreamingTelemetry::addRecord(const Record& r) noexcept
+{
+	if (!isEnabled())
+		return;
+
+	auto& s = slots[writeIndex.fetch_add(1) % NumRecords];
+
+	// An odd sequence number marks the slot as being written. If another thread that wrapped
+	// around the buffer is writing this slot right now, the record is dropped.
+	auto sequence = s.sequence.load(std::memory_order_relaxed);
+
+	if ((sequence & 1) == 0 && s.sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_acquire))
+	{
+		std::atomic_thread_fence(std::memory_order_release);
+
+		s.record = r;
+
+		s.sequence.store(sequence + 2, std::memory_order_release);
+	}
+
+	if (r.type == EventType::Underrun)
+	{
+		numUnderruns.fetch_add(1);
+		dumpPending.store(true);
+	}
+}
+
+void StreamingTelemetry::copyRecords(Array<Record>& target) const
+{
+	const auto end = writeIndex.load();
+	const auto start = end > (uint32)NumRecords ? end - (uint32)NumRecords : 0u;
+
+	target.ensureStorageAllocated((int)(end - start));
+
+	for (auto i = start; i < end; i++)
+	{
+		auto& s = slots[i % NumRecords];
+
+		auto before = s.sequence.load(std::memory_order_acquire);
+
+		if (before == 0 || (before & 1) != 0)
+			continue;
+
+		auto copy = s.record;
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		// skip records that were overwritten while copying
+		if (s.sequence.load(std::memory_order_relaxed) == before)
+			target.add(copy);
+	}
+}
+
+void StreamingTelemetry::clear() noexcept
+{
+	for (int i = 0; i < NumRecords; i++)
+		slots[i].sequence.store(0);
+
+	writeIndex.store(0);
+	numUnderruns.store(0);
+	dumpPending.store(false);
+}
+
+bool StreamingTelemetry::dumpToFile(const File& targetFile) const
+{
+	Array<Record> records;
+	copyRecords(records);
+
+	String csv;
+	String nl = "\n";
+
+	csv << "Event,Voice,SoundHash,MonolithOffset,Position,NumSamples,BytesRead,RequestTime,StartTime,CompletionTime,DecodeTime,Headroom,EnoughSamples" << nl;
+
+	for (const auto& r : records)
+	{
+		csv << getEventName(r.type) << ",";
+		csv << String(r.voiceId) << ",";
+		csv << String::toHexString(r.soundHash) << ",";
+		csv << String(r.monolithOffset) << ",";
+		csv << String(r.positionInFile) << ",";
+		csv << String(r.numSamples) << ",";
+		csv << String(r.numBytesRead) << ",";
+		csv << String(r.requestTime, 3) << ",";
+		csv << String(r.startTime, 3) << ",";
+		csv << String(r.completionTime, 3) << ",";
+		csv << String(r.decodeTime, 3) << ",";
+		csv << String(r.headroom, 3) << ",";
+		csv << (r.hasEnoughSamples ? "1" : "0") << nl;
+	}
+
+	return targetFile.replaceWithText(csv);
+}
+
+void StreamingTelemetry::setPostMortemDirectory(const File& newDirectory)
+{
+	ScopedLock sl(directoryLock);
+	postMortemDirectory = newDirectory;
+}
+
+File StreamingTelemetry::getPostMortemDirectory() const
+{
+	ScopedLock sl(directoryLock);
+	return postMortemDirectory;
+}
+
+void StreamingTelemetry::writePendingDump()
+{
+	if (!dumpPending.load())
+		return;
+
+	const auto now = Time::getMillisecondCounterHiRes();
+
+	// Don't flood the disk if the streaming is constantly choking
+	if (now - lastDumpTime < 5000.0)
+		return;
+
+	dumpPending.store(false);
+
+	File directory;
+
+	{
+		ScopedLock sl(directoryLock);
+		directory = postMortemDirectory;
+	}
+
+	if (directory == File())
+		return;
+
+	lastDumpTime = now;
+
+	directory.createDirectory();
+
+	auto f = directory.getNonexistentChildFile("StreamingUnderrun_" + Time::getCurrentTime().formatted("%Y-%m-%d_%H-%M-%S"), ".csv", false);
+
+	dumpToFile(f);
+}
+
+String StreamingTelemetry::getEventName(EventType t)
+{
+	switch (t)
+	{
+	case EventType::Refill:	   return "Refill";
+	case EventType::Swap:	   return "Swap";
+	case EventType::Underrun:  return "Underrun";
+	case EventType::SampleEnd: return "SampleEnd";
+	default:				   return {};
+	}
+}
+
+struct TelemetryHistogram
+{
+	TelemetryHistogram(const String& name_, const String& unit_, Array<double> limits_) :
+		name(name_),
+		unit(unit_),
+		limits(limits_)
+	{
+		counts.insertMultiple(0, 0, limits.size() + 1);
+	}
+
+	void add(double v)
+	{
+		values.add(v);
+
+		int bucket = 0;
+
+		while (bucket < limits.size() && v >= limits[bucket])
+			bucket++;
+
+		counts.set(bucket, counts[bucket] + 1);
+	}
+
+	double getPercentile(double p) const
+	{
+		if (values.isEmpty())
+			return 0.0;
+
+		auto index = jlimit(0, values.size() - 1, roundToInt(p * (double)(values.size() - 1)));
+		return values[index];
+	}
+
+	void write(String& report)
+	{
+		String nl = "\n";
+
+		report << name << " (" << String(values.size()) << " events)" << nl;
+
+		if (values.isEmpty())
+		{
+			report << "  no data" << nl << nl;
+			return;
+		}
+
+		values.sort();
+
+		report << "  median: " << String(getPercentile(0.5), 3) << unit;
+		report << ", 90%: " << String(getPercentile(0.9), 3) << unit;
+		report << ", 99%: " << String(getPercentile(0.99), 3) << unit;
+		report << ", max: " << String(values.getLast(), 3) << unit << nl;
+
+		int maxCount = 1;
+
+		for (auto c : counts)
+			maxCount = jmax(maxCount, c);
+
+		for (int i = 0; i < counts.size(); i++)
+		{
+			String rangeName;
+
+			if (i == 0)
+				rangeName << "< " << String(limits[0]) << unit;
+			else if (i == limits.size())
+				rangeName << ">= " << String(limits.getLast()) << unit;
+			else
+				rangeName << String(limits[i - 1]) << " - " << String(limits[i]) << unit;
+
+			auto numChars = roundToInt(40.0 * (double)counts[i] / (double)maxCount);
+
+			report << "  " << rangeName.paddedRight(' ', 16) << String(counts[i]).paddedLeft(' ', 8) << " " << String::repeatedString("#", numChars) << nl;
+		}
+
+		report << nl;
+	}
+
+	String name;
+	String unit;
+	Array<double> limits;
+	Array<int> counts;
+	Array<double> values;
+};
+
+String StreamingTelemetry::createHistogramReport() const
+{
+	Array<Record> records;
+	copyRecords(records);
+
+	TelemetryHistogram latency("Refill latency (request to completion)", "ms", { 0.5, 1.0, 2.0, 4.0, 8.0, 16.0, 32.0 });
+	TelemetryHistogram waiting("Queue time (request to start)", "ms", { 0.1, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0 });
+	TelemetryHistogram decoding("Read & decode time", "ms", { 0.1, 0.25, 0.5, 1.0, 2.0, 4.0, 8.0 });
+	TelemetryHistogram headroom("Buffer headroom at swap", "ms", { 0.0, 1.0, 2.0, 5.0, 10.0, 20.0, 50.0 });
+
+	int64 numBytes = 0;
+	double totalDecodeTime = 0.0;
+	int numSampleEnds = 0;
+	int numUnderrunsInBuffer = 0;
+
+	std::map<int64, int> underrunsPerSound;
+
+	for (const auto& r : records)
+	{
+		switch (r.type)
+		{
+		case EventType::Refill:
+			latency.add(r.completionTime - r.requestTime);
+			waiting.add(r.startTime - r.requestTime);
+			decoding.add(r.decodeTime);
+			numBytes += r.numBytesRead;
+			totalDecodeTime += r.decodeTime;
+			break;
+		case EventType::Swap:
+			headroom.add(r.headroom);
+			break;
+		case EventType::Underrun:
+			headroom.add(r.headroom);
+			underrunsPerSound[r.soundHash]++;
+			numUnderrunsInBuffer++;
+			break;
+		case EventType::SampleEnd:
+			numSampleEnds++;
+			break;
+		default:
+			break;
+		}
+	}
+
+	String report;
+	String nl = "\n";
+
+	report << "Streaming Telemetry Report" << nl;
+	report << "==========================" << nl << nl;
+	report << "Records: " << String(records.size()) << nl;
+	report << "Underruns: " << String(numUnderrunsInBuffer) << " (total: " << String(getNumUnderruns()) << ")" << nl;
+	report << "Voices stopped at sample end: " << String(numSampleEnds) << nl;
+	report << "Bytes read: " << String(numBytes) << nl;
+
+	if (totalDecodeTime > 0.0)
+		report << "Throughput: " << String((double)numBytes / 1024.0 / 1024.0 / (totalDecodeTime * 0.001), 2) << " MB/s" << nl;
+
+	report << nl;
+
+	latency.write(report);
+	waiting.write(report);
+	decoding.write(report);
+	headroom.write(report);
+
+	if (!underrunsPerSound.empty())
+	{
+		report << "Underruns per sound:" << nl;
+
+		for (const auto& u : underrunsPerSound)
+			report << "  " << String::toHexString(u.first) << ": " << String(u.second) << nl;
+	}
+
+	return report;
+}
+
+} // namespace hise
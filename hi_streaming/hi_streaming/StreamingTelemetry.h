@@ -0,0 +1,140 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#ifndef STREAMINGTELEMETRY_H_INCLUDED
+#define STREAMINGTELEMETRY_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** A lock free recorder for the streaming activity of the sampler voices.
+
+	Every SampleLoader writes a record for each refill operation and buffer swap into a ring buffer.
+	If a voice runs out of streamed samples, the content of the ring buffer can be dumped into a file
+	so you can find out which sound (and which monolith chunk) caused the problem, and the histogram
+	report gives you an overview of the refill latency & buffer headroom so you can choose the preload
+	and buffer sizes based on actual measurements.
+*/
+class StreamingTelemetry
+{
+public:
+
+	enum class EventType : uint8
+	{
+		Refill = 0, ///< a streaming buffer was filled on the background thread
+		Swap, ///< the voice swapped its streaming buffers in time
+		Underrun, ///< the voice needed the next buffer before it was filled
+		SampleEnd, ///< the voice was stopped because the sound has no more samples
+		numEventTypes
+	};
+
+	/** A single event of a SampleLoader. All time values are in milliseconds. */
+	struct Record
+	{
+		EventType type = EventType::Refill;
+		uint32 voiceId = 0;
+		int64 soundHash = 0;
+		int64 monolithOffset = 0;
+		int positionInFile = 0;
+		int numSamples = 0;
+		int64 numBytesRead = 0;
+		double requestTime = 0.0;
+		double startTime = 0.0;
+		double completionTime = 0.0;
+		double decodeTime = 0.0;
+		double headroom = 0.0;
+		bool hasEnoughSamples = true;
+	};
+
+	static constexpr int NumRecords = 8192;
+
+	StreamingTelemetry();
+
+	/** Enables or disables the recording. */
+	void setEnabled(bool shouldBeEnabled) noexcept { enabled.store(shouldBeEnabled); }
+
+	bool isEnabled() const noexcept { return enabled.load(); }
+
+	/** Adds a record to the ring buffer. This is wait free and can be called from any thread. */
+	void addRecord(const Record& r) noexcept;
+
+	/** Copies all valid records in the order they were added. */
+	void copyRecords(Array<Record>& target) const;
+
+	/** Clears the ring buffer. */
+	void clear() noexcept;
+
+	/** Returns the number of underruns since the last call to clear(). */
+	int getNumUnderruns() const noexcept { return numUnderruns.load(); }
+
+	/** Writes the content of the ring buffer as CSV file. */
+	bool dumpToFile(const File& targetFile) const;
+
+	/** Sets a directory where the ring buffer will be dumped after an underrun. Pass in File() to deactivate the automatic dump. */
+	void setPostMortemDirectory(const File& newDirectory);
+
+	/** Returns the directory for the automatic dump or File() if it's deactivated. */
+	File getPostMortemDirectory() const;
+
+	/** Writes the ring buffer to the post mortem directory if an underrun occured. This is called periodically by the sample loading thread. */
+	void writePendingDump();
+
+	/** Creates a text report with histograms of the refill latency, decode time and buffer headroom. */
+	String createHistogramReport() const;
+
+	static String getEventName(EventType t);
+
+private:
+
+	struct Slot
+	{
+		std::atomic<uint32> sequence = { 0 };
+		Record record;
+	};
+
+	std::atomic<bool> enabled = { (bool)HISE_ENABLE_STREAMING_TELEMETRY };
+	std::atomic<uint32> writeIndex = { 0 };
+	std::atomic<int> numUnderruns = { 0 };
+	std::atomic<bool> dumpPending = { false };
+
+	double lastDumpTime = 0.0;
+
+	CriticalSection directoryLock;
+	File postMortemDirectory;
+
+	std::unique_ptr<Slot[]> slots;
+
+	JUCE_DECLARE_NON_COPYABLE(StreamingTelemetry);
+};
+
+} // namespace hise
+#endif  // STREAMINGTELEMETRY_H_INCLUDED
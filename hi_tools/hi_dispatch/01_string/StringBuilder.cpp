@@ -123,6 +123,7 @@ StringBuilder& StringBuilder::operator<<(EventType eventType)
 	case EventType::Remove:			s << "rem_source"; break;
 	case EventType::SlotChange:		s << "slotchange"; break;
 	case EventType::AllListener:	s << "listen_all"; break;
+	case EventType::Repaint:		s << "repaint"; break;
 	case EventType::numEventTypes: break;
 
 	default: jassertfalse;
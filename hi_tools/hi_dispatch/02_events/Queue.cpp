@@ -168,6 +168,7 @@ inline bool Queue::ensureAllocated(size_t numBytesRequired)
                 reallocEvent.numBytes = static_cast<uint16>(b.length());
                 numUsed += reallocEvent.write(data.get() + numUsed, b.get());
                 numElements++;
+                numPerLane[(int)Lane::Structure]++;
             }
             
             return true;
@@ -190,6 +191,9 @@ bool Queue::push(Queueable* s, EventType t, const void* values, size_t numValues
     e.eventType = t;
     e.numBytes = static_cast<uint16>(numValues);
     e.source = s;
+
+    if(coalescing && isCoalescable(t))
+        return pushCoalesced(e, values);
     
     if(!ensureAllocated(e.getTotalByteSize()))
         return false;
@@ -200,37 +204,227 @@ bool Queue::push(Queueable* s, EventType t, const void* values, size_t numValues
 
 	numUsed += numWritten;
     numElements++;
+    numPerLane[(int)getLane(t)]++;
     return true;
 }
 
-bool Queue::flush(const FlushFunction& f, FlushType flushType)
+bool Queue::isCoalescable(EventType t) noexcept
 {
-    ScopedValueSetter<bool> svs(flushPending, true);
+    return t == EventType::SlotChange ||
+           t == EventType::Repaint ||
+           t == EventType::SingleListenerSubset;
+}
 
-    if(isEmpty())
-        return true;
+uint8 Queue::getCoalesceSlotIndex(EventType t, const DataType* values, size_t numBytes) noexcept
+{
+    // The data of a subset event is the bitmask of the changed slots, so it's not keyed by the first byte
+    if(t == EventType::SingleListenerSubset || numBytes == 0)
+        return 0;
 
-	auto state = getState();
+    return *values;
+}
+
+bool Queue::pushCoalesced(const QueuedEvent& e, const void* values)
+{
+    auto isSubset = e.eventType == EventType::SingleListenerSubset;
+    auto slotIndex = getCoalesceSlotIndex(e.eventType, static_cast<const DataType*>(values), e.numBytes);
+
+    DataType mergedBitmask[UINT8_MAX];
+
+    if(indexDirty || (numIndexEntries + 1) * 2 > indexSize)
+        rebuildIndex(jmax<size_t>(64, indexSize * (indexDirty ? 1 : 2)));
+
+    auto entry = findIndexEntry(e.source, e.eventType, slotIndex);
+    auto isNewEntry = entry->generation != indexGeneration;
+
+    if(!isNewEntry)
+    {
+        auto pos = data.get() + entry->offset;
+        auto existing = QueuedEvent::fromData(pos);
+
+        // if the source was invalidated, the event will be skipped and we need to append a new one
+        if(existing.source == e.source)
+        {
+            jassert(existing.eventType == e.eventType);
+
+            auto existingValues = QueuedEvent::getValuePointer(pos);
+            auto newValues = static_cast<const DataType*>(values);
+
+            if(isSubset)
+            {
+                // Combine the changed slots of both events
+                if(existing.numBytes >= e.numBytes)
+                {
+                    for(int i = 0; i < (int)e.numBytes; i++)
+                        existingValues[i] |= newValues[i];
+
+                    return true;
+                }
+
+                memcpy(mergedBitmask, newValues, e.numBytes * sizeof(DataType));
+
+                for(int i = 0; i < (int)existing.numBytes; i++)
+                    mergedBitmask[i] |= existingValues[i];
+
+                values = mergedBitmask;
+            }
+            else if(existing.numBytes == e.numBytes)
+            {
+                memcpy(existingValues, values, e.numBytes * sizeof(DataType));
+                return true;
+            }
+
+            // The size doesn't match, so we need to skip the old event and append the new one
+            *reinterpret_cast<Queueable**>(pos) = nullptr;
+        }
+    }
+
+    if(!ensureAllocated(e.getTotalByteSize()))
+        return false;
+
+    entry->source = e.source;
+    entry->eventType = e.eventType;
+    entry->slotIndex = slotIndex;
+    entry->offset = static_cast<uint32>(numUsed);
+    entry->generation = indexGeneration;
+
+    if(isNewEntry)
+        numIndexEntries++;
+
+    numUsed += e.write(data.get() + numUsed, values);
+    numElements++;
+    numPerLane[(int)getLane(e.eventType)]++;
+    return true;
+}
+
+Queue::IndexEntry* Queue::findIndexEntry(Queueable* s, EventType t, uint8 slotIndex) noexcept
+{
+    jassert(isPowerOfTwo(indexSize));
+
+    auto h = (reinterpret_cast<uint64>(s) >> 4) ^ ((uint64)t << 8) ^ (uint64)slotIndex;
+    h *= 0x9E3779B97F4A7C15ull;
+
+    const auto mask = indexSize - 1;
+    auto i = static_cast<size_t>(h >> 32) & mask;
+
+    // the index is never more than half full, so this will always find a free slot
+    while(true)
+    {
+        auto& entry = index[i];
+
+        if(entry.generation != indexGeneration)
+            return &entry;
+
+        if(entry.source == s && entry.eventType == t && entry.slotIndex == slotIndex)
+            return &entry;
+
+        i = (i + 1) & mask;
+    }
+}
+
+void Queue::rebuildIndex(size_t newIndexSize)
+{
+    if(newIndexSize != indexSize)
+    {
+        index.calloc(newIndexSize);
+        indexSize = newIndexSize;
+    }
+
+    clearIndex();
+    indexDirty = false;
 
-	if(state != State::Running)
-        return true;
-    
+    Iterator iter(*this);
+    QueuedEvent e;
+
+    while(iter.next(e))
+    {
+        // only the events that can be merged are indexed
+        if(e.source == nullptr || !isCoalescable(e.eventType))
+            continue;
+
+        auto pos = iter.getPositionOfCurrentQueuable();
+        auto slotIndex = getCoalesceSlotIndex(e.eventType, QueuedEvent::getValuePointer(pos), e.numBytes);
+        auto entry = findIndexEntry(e.source, e.eventType, slotIndex);
+
+        // if there are duplicates from before, the index will point to the latest one
+        if(entry->generation != indexGeneration)
+            numIndexEntries++;
+
+        entry->source = e.source;
+        entry->eventType = e.eventType;
+        entry->slotIndex = slotIndex;
+        entry->offset = static_cast<uint32>(pos - data.get());
+        entry->generation = indexGeneration;
+    }
+}
+
+void Queue::clearIndex() noexcept
+{
+    numIndexEntries = 0;
+
+    // bumping the generation invalidates all entries in O(1)
+    if(++indexGeneration == 0)
+    {
+        index.clear(indexSize);
+        indexGeneration = 1;
+    }
+}
+
+void Queue::setUseCoalescing(bool shouldCoalesce)
+{
+    if(coalescing != shouldCoalesce)
+    {
+        jassert(!flushPending);
+        coalescing = shouldCoalesce;
+        indexDirty = true;
+    }
+}
+
+Queue::Lane Queue::getLane(EventType t) noexcept
+{
+    switch(t)
+    {
+    case EventType::SlotChange:
+    case EventType::ListenerAnySlot:
+    case EventType::ListenerWithoutData:
+    case EventType::SingleListenerSingleSlot:
+    case EventType::SingleListenerSubset:
+    case EventType::AllListener:
+        return Lane::Value;
+    case EventType::Repaint:
+        return Lane::Repaint;
+    default:
+        return Lane::Structure;
+    }
+}
+
+void Queue::clear()
+{
+    numUsed = 0;
+    numElements = 0;
+
+    for(auto& n: numPerLane)
+        n = 0;
+
+    clearIndex();
+}
+
+Queue::FlushResult Queue::flushLane(const FlushFunction& f, FlushType flushType, Lane lane, int& numDangling)
+{
     Iterator iter(*this);
 
 #if ENABLE_DISPATCH_QUEUE_RESUME
-    if(resumeData != nullptr)
+    if(resumeData != nullptr && resumeData->lane == lane)
         iter.seekTo(resumeData->offset);
 #endif
-    
-    int numDangling = 0;
-    
+
     QueuedEvent e;
     while(iter.next(e))
     {
-        state = getState();
+        auto state = getState();
 
         if(state == State::Shutdown)
-            return false;
+            return FlushResult::Shutdown;
 
         if(state == State::Paused)
         {
@@ -238,9 +432,10 @@ bool Queue::flush(const FlushFunction& f, FlushType flushType)
             resumeData = new ResumeData();
             resumeData->f = f;
             resumeData->flushType = flushType;
+            resumeData->lane = lane;
             resumeData->offset = iter.getPositionOfCurrentQueuable() - data.get();
 #endif
-            return true;
+            return FlushResult::Paused;
         }
         
         if(e.source == nullptr)
@@ -249,29 +444,77 @@ bool Queue::flush(const FlushFunction& f, FlushType flushType)
             continue;
         }
 
+        // Lane::numLanes flushes all events in the order they were pushed
+        if(lane != Lane::numLanes && getLane(e.eventType) != lane)
+            continue;
+
         jassert(!pushCheckFunction || pushCheckFunction(e.source));
 
         // (eg. a change event can skip slot value changes
         auto ok = f(createFlushArgument(e, iter.getPositionOfCurrentQueuable()));
         
         if(!ok)
-        {
-            if(flushType == FlushType::Flush)
-            {
-                numUsed = 0;
-                numElements = 0;
-            }
-            return false;
-        }
+            return FlushResult::Aborted;
     }
     
     jassert(iter.getNextPosition() == data.get() + numUsed);
+    return FlushResult::Finished;
+}
+
+bool Queue::flush(const FlushFunction& f, FlushType flushType)
+{
+    ScopedValueSetter<bool> svs(flushPending, true);
+
+    if(isEmpty())
+        return true;
+
+	auto state = getState();
+
+	if(state != State::Running)
+        return true;
     
-    if(flushType == FlushType::Flush)
+    int numDangling = 0;
+    auto result = FlushResult::Finished;
+
+    if(coalescing)
     {
-        numUsed = 0;
-        numElements = 0;
+        auto firstLane = 0;
+
+#if ENABLE_DISPATCH_QUEUE_RESUME
+        if(resumeData != nullptr && resumeData->lane != Lane::numLanes)
+            firstLane = (int)resumeData->lane;
+#endif
+
+        for(int i = firstLane; i < (int)Lane::numLanes; i++)
+        {
+            // every pass counts all dangling elements
+            int numDanglingInLane = 0;
+
+            if(numPerLane[i] != 0)
+                result = flushLane(f, flushType, (Lane)i, numDanglingInLane);
+
+            numDangling = jmax(numDangling, numDanglingInLane);
+
+            if(result != FlushResult::Finished)
+                break;
+        }
     }
+    else
+    {
+        result = flushLane(f, flushType, Lane::numLanes, numDangling);
+    }
+
+    if(result == FlushResult::Shutdown)
+        return false;
+
+    if(result == FlushResult::Paused)
+        return true;
+
+    if(flushType == FlushType::Flush)
+        clear();
+
+    if(result == FlushResult::Aborted)
+        return false;
     
     if(numDangling != 0 && attachedLogger)
     {
@@ -390,6 +633,11 @@ void Queue::clearPositionInternal(uint8* start, uint8* end)
     jassert(isPositiveAndBelow(start - data.get(), numUsed));
     jassert(isPositiveAndBelow(end - data.get(), numUsed+1));
     
+    numPerLane[(int)getLane(QueuedEvent::fromData(start).eventType)]--;
+
+    // the offsets in the index are invalid now
+    indexDirty = coalescing;
+
     auto src = end;
     auto dst = start;
     auto object_size = end - start;
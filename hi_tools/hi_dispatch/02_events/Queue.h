@@ -56,6 +56,15 @@ public:
 		numFlushTypes
 	};
 
+	/** The lanes of a coalescing queue. All events of a lane are flushed before the next lane. */
+	enum class Lane
+	{
+		Structure, // Add, Remove, SourcePtr & logging events
+		Value,	   // slot changes & listener events
+		Repaint,   // EventType::Repaint
+		numLanes
+	};
+
 	static constexpr size_t MaxQueueSize = 1024 * 1024 * 4; // 4MB should be enough TODO: add dynamic upper limit with warning
 
 	HashedCharPtr getDispatchId() const override { return HashedCharPtr("queue"); }
@@ -123,11 +132,10 @@ public:
 		template <typename T> T& getTypedObject() const
 		{
 			static_assert(std::is_base_of<Queueable, T>(), "not a base of Queueable");
-			auto t = dynamic_cast<T*>(source);
 
-			// should never be nullptr!
-			jassert(t != nullptr);
-			return *t;
+			// the queue must only contain objects of type T if you use this method!
+			jassert(dynamic_cast<T*>(source) != nullptr);
+			return *static_cast<T*>(source);
 		}
 
 		Queueable* source = nullptr;
@@ -145,6 +153,8 @@ public:
 	// - the number of bytes that the data has
 	using FlushFunction = std::function<bool(const FlushArgument&)>;
 
+	template <typename T> using TypedFlushFunction = std::function<bool(T&, const FlushArgument&)>;
+
 	/** Creates a queue and allocates the given amount of bytes. */
 	Queue(RootObject& root, size_t initAllocatedSize);
 
@@ -170,6 +180,35 @@ public:
 	/** flushes the queue with the given function. If the function returns FALSE, it will abort the iteration and clean the remaining queue. */
 	bool flush(const FlushFunction& f, FlushType flushType);
 
+	/** flushes the queue and passes the source as T&. All sources in this queue must be of type T. */
+	template <typename T> bool flushTyped(const TypedFlushFunction<T>& f, FlushType flushType)
+	{
+		return flush([&f](const FlushArgument& a)
+		{
+			return f(a.getTypedObject<T>(), a);
+		}, flushType);
+	}
+
+	/** Enables the coalescing mode.
+	 *
+	 *	If this is enabled, pushing a SlotChange or Repaint event will overwrite the data of a pending event 
+	 *	with the same source, event type and slot index (the first data byte) instead of appending it, so the 
+	 *	flush only sees the latest value. SingleListenerSubset events of the same source are merged by combining 
+	 *	their bitmasks. All other events are appended so that their order is preserved. The events are then 
+	 *	flushed lane by lane (see Lane).
+	 *
+	 *	This is disabled by default and must be enabled explicitly for each queue.
+	 */
+	void setUseCoalescing(bool shouldCoalesce);
+
+	bool isCoalescing() const noexcept { return coalescing; }
+
+	/** Returns the lane that the given event type will be flushed in. */
+	static Lane getLane(EventType t) noexcept;
+
+	/** Returns true if events of this type are merged with pending events in the coalescing mode. */
+	static bool isCoalescable(EventType t) noexcept;
+
 	/** Attaches a logger to the queue. non-owned, lifetime of logger > queue. */
 	void setLogger(Logger* l);
 
@@ -188,7 +227,7 @@ public:
 	void setOverrideDanglingBehaviour(DanglingBehaviour forcedBehaviour) noexcept { queueBehaviour = forcedBehaviour; }
 
 	/** Clears the queue (just moves the pointer to the start, O(1) operation. */
-	void clear() { numUsed = 0; numElements = 0; }
+	void clear();
 
 	void addPushCheck(const std::function<bool(Queueable*)>& pc) { pushCheckFunction = pc; }
 
@@ -209,8 +248,42 @@ public:
 
 private:
 
+	enum class FlushResult
+	{
+		Finished,
+		Aborted,
+		Paused,
+		Shutdown
+	};
+
+	// The position of the latest event for a (source, event type, slot) key
+	struct IndexEntry
+	{
+		Queueable* source = nullptr;
+		uint32 offset = 0;
+		uint32 generation = 0;
+		EventType eventType = EventType::Nothing;
+		uint8 slotIndex = 0;
+	};
+
+	FlushResult flushLane(const FlushFunction& f, FlushType flushType, Lane lane, int& numDangling);
+
+	bool pushCoalesced(const QueuedEvent& e, const void* values);
+	IndexEntry* findIndexEntry(Queueable* s, EventType t, uint8 slotIndex) noexcept;
+	static uint8 getCoalesceSlotIndex(EventType t, const DataType* values, size_t numBytes) noexcept;
+	void rebuildIndex(size_t newIndexSize);
+	void clearIndex() noexcept;
+
 	bool flushPending = false;
 
+	bool coalescing = false;
+	bool indexDirty = false;
+	HeapBlock<IndexEntry> index;
+	size_t indexSize = 0;
+	size_t numIndexEntries = 0;
+	uint32 indexGeneration = 1;
+	int numPerLane[(int)Lane::numLanes] = { 0, 0, 0 };
+
 	std::atomic<State> explicitState = { State::Running };
 
 	std::function<bool(Queueable*)> pushCheckFunction;
@@ -220,6 +293,7 @@ private:
 	struct ResumeData
 	{
 		size_t offset = 0;
+		Lane lane = Lane::numLanes;
 		FlushType flushType = FlushType::Flush;
 		FlushFunction f;
 	};
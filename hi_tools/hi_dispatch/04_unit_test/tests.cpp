@@ -202,6 +202,156 @@ void LoggerTest::testQueue()
 #endif
 }
 
+void LoggerTest::testCoalescingQueue()
+{
+#if ENABLE_QUEUE_AND_LOGGER
+	BEGIN_TEST("Testing coalescing queue");
+
+	RootObject root(nullptr);
+
+	Queue queue(root, 0);
+	queue.setUseCoalescing(true);
+
+	MyTestQueuable s1(root);
+	MyTestQueuable s2(root);
+
+	uint8 buffer[2];
+
+	for(uint8 i = 0; i < 100; i++)
+	{
+		buffer[0] = i % 4; // slot index
+		buffer[1] = i;
+		queue.push(&s1, EventType::SlotChange, buffer, 2);
+		queue.push(&s2, EventType::Repaint, buffer, 2);
+	}
+
+	queue.push(&s2, EventType::Add, nullptr, 0);
+
+	expectEquals((int)queue.size(), 9, "not coalesced");
+
+	Array<EventType> order;
+	int sum = 0;
+
+	queue.flushTyped<MyTestQueuable>([&](MyTestQueuable& s, const Queue::FlushArgument& f)
+	{
+		order.add(f.eventType);
+
+		if(&s == &s1)
+			sum += f.data[1];
+
+		return true;
+	}, Queue::FlushType::Flush);
+
+	expect(order.getFirst() == EventType::Add, "structure lane not flushed first");
+	expect(order.getLast() == EventType::Repaint, "repaint lane not flushed last");
+	expectEquals(sum, 96 + 97 + 98 + 99, "not the latest value");
+	expect(queue.isEmpty(), "not cleared");
+
+	// Structure events must never be merged or the order would change
+	queue.push(&s1, EventType::Add, nullptr, 0);
+	queue.push(&s1, EventType::Remove, nullptr, 0);
+	queue.push(&s1, EventType::Add, nullptr, 0);
+
+	expectEquals((int)queue.size(), 3, "structure events were coalesced");
+
+	order.clear();
+
+	queue.flush([&](const Queue::FlushArgument& f)
+	{
+		order.add(f.eventType);
+		return true;
+	}, Queue::FlushType::Flush);
+
+	expect(order == Array<EventType>({ EventType::Add, EventType::Remove, EventType::Add }), "wrong structure event order");
+
+	// Subset events combine the bitmasks of the changed slots
+	uint8 mask1[2] = { 0x01, 0x00 };
+	uint8 mask2[2] = { 0x04, 0x80 };
+	uint8 mask3[1] = { 0x02 };
+
+	queue.push(&s1, EventType::SingleListenerSubset, mask1, 2);
+	queue.push(&s1, EventType::SingleListenerSubset, mask2, 2);
+	queue.push(&s1, EventType::SingleListenerSubset, mask3, 1);
+
+	expectEquals((int)queue.size(), 1, "subset events not coalesced");
+
+	queue.flush([&](const Queue::FlushArgument& f)
+	{
+		expectEquals((int)f.numBytes, 2, "wrong bitmask size");
+		expectEquals((int)f.data[0], 0x07, "bitmasks not merged");
+		expectEquals((int)f.data[1], 0x80, "bitmasks not merged");
+		return true;
+	}, Queue::FlushType::Flush);
+
+	// The index is rebuilt from the pending events and must use the same key for subset events
+	queue.push(&s1, EventType::SingleListenerSubset, mask2, 2);
+	queue.push(&s1, EventType::Add, nullptr, 0);
+	queue.setUseCoalescing(false);
+	queue.setUseCoalescing(true);
+	queue.push(&s1, EventType::SingleListenerSubset, mask1, 2);
+
+	expectEquals((int)queue.size(), 2, "subset events not coalesced after rebuilding the index");
+
+	queue.flush([&](const Queue::FlushArgument& f)
+	{
+		if(f.eventType == EventType::SingleListenerSubset)
+			expectEquals((int)f.data[0], 0x05, "bitmasks not merged after rebuilding the index");
+
+		return true;
+	}, Queue::FlushType::Flush);
+
+	// Now measure the push / flush throughput with & without coalescing
+	OwnedArray<MyTestQueuable> sources;
+
+	for(int i = 0; i < 256; i++)
+		sources.add(new MyTestQueuable(root));
+
+	int numFlushed = 0;
+
+	Queue::FlushFunction f = [&numFlushed](const Queue::FlushArgument&)
+	{
+		numFlushed++;
+		return true;
+	};
+
+	for(auto shouldCoalesce: { false, true })
+	{
+		Queue benchmarkQueue(root, 0);
+		benchmarkQueue.setUseCoalescing(shouldCoalesce);
+
+		constexpr int NumIterations = 20;
+		constexpr int NumEventsPerIteration = 32768;
+
+		auto start = Time::getHighResolutionTicks();
+
+		for(int i = 0; i < NumIterations; i++)
+		{
+			for(int j = 0; j < NumEventsPerIteration; j++)
+			{
+				buffer[0] = (uint8)(j % 8);
+				buffer[1] = (uint8)j;
+				benchmarkQueue.push(sources[j % sources.size()], EventType::SlotChange, buffer, 2);
+			}
+
+			benchmarkQueue.flush(f, Queue::FlushType::Flush);
+		}
+
+		auto seconds = Time::highResolutionTicksToSeconds(Time::getHighResolutionTicks() - start);
+		auto numEvents = (double)NumIterations * NumEventsPerIteration;
+
+		String m;
+		m << (shouldCoalesce ? "coalescing" : "regular") << " queue: ";
+		m << String(numEvents / seconds / 1000000.0, 2) << " M events/s, ";
+		m << numFlushed << " flush calls";
+		logMessage(m);
+
+		numFlushed = 0;
+
+		expect(benchmarkQueue.isEmpty());
+	}
+#endif
+}
+
 void LoggerTest::testQueueResume()
 {
 #if ENABLE_DISPATCH_QUEUE_RESUME
@@ -429,6 +579,7 @@ void LoggerTest::runTest()
 {
 	TRACE_DISPATCH("logger test");
 	testQueue();
+	testCoalescingQueue();
 	testLogger();
     testQueueResume();
 	testSourceManager();
@@ -72,6 +72,7 @@ struct LoggerTest: public UnitTest,
 
 	void testLogger();
 	void testQueue();
+	void testCoalescingQueue();
 	void testQueueResume();
 	void testSourceManager();
 
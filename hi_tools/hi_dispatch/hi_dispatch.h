@@ -85,6 +85,7 @@ enum class EventType: uint8 // change to HeaderType
 	SingleListenerSingleSlot,
 	SingleListenerSubset,
 	AllListener,
+	Repaint,
 	numEventTypes
 };
 
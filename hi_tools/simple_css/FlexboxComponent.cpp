@@ -72,10 +72,11 @@ void FlexboxComponent::Helpers::writeSelectorsToProperties(Component& c, const S
 
 	static const Identifier iid("id");
 
-	writeClassSelectors(c, classSelectors, false);
-
+	// set the ID first so that the cache is invalidated after both properties have changed
 	if(id.isNotEmpty())
 		c.getProperties().set(iid, id);
+
+	writeClassSelectors(c, classSelectors, false);
 }
 
 Selector FlexboxComponent::Helpers::getTypeSelectorFromComponentClass(Component* c)
@@ -203,6 +204,9 @@ void FlexboxComponent::SimpleTextDisplay::setText(const String& text)
 	{
 		currentText = text;
 
+		if(auto p = findParentComponentOfClass<FlexboxComponent>())
+			p->invalidateLayout();
+
 		if(auto r = findParentComponentOfClass<CSSRootComponent>())
 		{
 			dynamic_cast<Component*>(r)->resized();
@@ -303,6 +307,26 @@ void FlexboxComponent::resized()
 		return;
 	}
 
+	if(fullRebuild && createLayoutKey() == lastLayoutKey)
+	{
+		// nothing that affects the layout has changed since the last
+		// pass so the child bounds are still valid, but nested containers
+		// that were flagged by rebuildLayout() still need to update themselves.
+		fullRebuild = false;
+
+		callRecursive<FlexboxContainer>(this, [this](FlexboxContainer* fc)
+		{
+			auto c = dynamic_cast<Component*>(fc);
+
+			if(c != this && fc->fullRebuild && c->isVisible() && !c->getLocalBounds().isEmpty())
+				c->resized();
+
+			return false;
+		});
+
+		return;
+	}
+
 	auto data = createPositionData();
 
 	std::vector<std::pair<Component*, Rectangle<int>>> prevPositions;
@@ -336,9 +360,76 @@ void FlexboxComponent::resized()
 			p.first->resized();
 	}
 
+	// the children might have updated their layout generation
+	lastLayoutKey = createLayoutKey();
+	layoutGeneration++;
+
 	fullRebuild = false;
 }
 
+void FlexboxComponent::invalidateLayout()
+{
+	Component* c = this;
+
+	while(c != nullptr)
+	{
+		if(auto fc = dynamic_cast<FlexboxComponent*>(c))
+			fc->lastLayoutKey = {};
+
+		c = c->getParentComponent();
+	}
+}
+
+FlexboxComponent::LayoutKey FlexboxComponent::createLayoutKey() const
+{
+	LayoutKey key;
+
+	key.bounds = getLocalBounds();
+	key.styleSheet = ss.get();
+	key.styleVersion = parentToUse != nullptr ? parentToUse->css.getStyleVersion() : 0;
+
+	auto addToHash = [&key](uint64 v)
+	{
+		key.childHash = key.childHash * 31 + v;
+	};
+
+	for(int i = 0; i < getNumChildComponents(); i++)
+	{
+		auto c = getChildComponent(i);
+
+		addToHash(reinterpret_cast<uint64>(c));
+		addToHash(isVisibleOrPlaceHolder(c) ? 1 : 0);
+
+		auto cs = childSheets.find(c);
+
+		if(cs != childSheets.end())
+			addToHash(reinterpret_cast<uint64>(cs->second.get()));
+
+		// the size of these components depends on their content
+		// so they will always be laid out again
+		if(dynamic_cast<SimpleMarkdownDisplay*>(c) != nullptr)
+			return {};
+
+		if(auto b = dynamic_cast<Button*>(c))
+			addToHash((uint64)b->getButtonText().hashCode64());
+
+		if(auto st = dynamic_cast<SimpleTextDisplay*>(c))
+			addToHash((uint64)st->currentText.hashCode64());
+
+		if(auto fc = dynamic_cast<FlexboxComponent*>(c))
+		{
+			if(fc->isInvisibleWrapper())
+				return {};
+
+			addToHash(reinterpret_cast<uint64>(fc->ss.get()));
+			addToHash(fc->layoutGeneration);
+		}
+	}
+
+	key.valid = true;
+	return key;
+}
+
 void FlexboxComponent::rebuildRootLayout()
 {
 	rebuildLayout();
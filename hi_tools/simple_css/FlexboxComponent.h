@@ -152,6 +152,10 @@ struct FlexboxComponent: public Component,
     /** Call this to ensure that the layout is changed properly. */
 	void rebuildLayout() override;
 
+	/** Call this when the content of a child changes its size (eg. the text of a label) so that this
+	 *  component and its parents will not skip the next layout pass. */
+	void invalidateLayout();
+
     /** Adds a invisible component as child that will act as spacer. */
 	void addSpacer();
 
@@ -269,6 +273,31 @@ private:
 
 	PositionData createPositionData();
 
+	/** Contains everything that goes into createPositionData() so that a forced relayout of an unchanged
+	 *  subtree can be skipped. */
+	struct LayoutKey
+	{
+		bool operator==(const LayoutKey& other) const
+		{
+			return valid && other.valid &&
+				   bounds == other.bounds &&
+				   styleSheet == other.styleSheet &&
+				   styleVersion == other.styleVersion &&
+				   childHash == other.childHash;
+		}
+
+		bool valid = false;
+		Rectangle<int> bounds;
+		StyleSheet* styleSheet = nullptr;
+		uint32 styleVersion = 0;
+		uint64 childHash = 0;
+	};
+
+	LayoutKey createLayoutKey() const;
+
+	LayoutKey lastLayoutKey;
+	uint32 layoutGeneration = 0;
+
 	bool applyMargin = true;
 
 	OwnedArray<Component> spacers;
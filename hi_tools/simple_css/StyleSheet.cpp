@@ -424,35 +424,58 @@ StyleSheet::Ptr StyleSheet::Collection::operator[](const Selector& s) const
 
 String StyleSheet::Collection::getDebugLogForComponent(Component* c) const
 {
-	for(auto& cm: cachedMaps)
+	auto it = cachedMaps.find(c);
+
+	if(it != cachedMaps.end() && it->second.first.getComponent() == c)
 	{
-		if(cm.first.getComponent() == c)
-		{
-			if(auto obj = cm.second->varProperties.get())
-			{
-				String s;
-				s << "Current variable values:\n";
-				s << JSON::toString(var(obj));
-				s << "\n==============================\n\n";
+		const auto& cm = it->second;
 
-				s << cm.debugLog;
-				return s;
-			}
+		if(cm.second == nullptr)
+			return {};
 
-			return cm.debugLog;
+		if(auto obj = cm.second->varProperties.get())
+		{
+			String s;
+			s << "Current variable values:\n";
+			s << JSON::toString(var(obj));
+			s << "\n==============================\n\n";
+
+			s << cm.debugLog;
+			return s;
 		}
-			
+
+		return cm.debugLog;
 	}
             
 	return {};
 }
 
+void StyleSheet::Collection::addToCache(Component* c, StyleSheet::Ptr ss, const String& debugLog, bool isShared)
+{
+	auto& entry = cachedMaps[c];
+
+	// carry over the variable values from the style sheet that was invalidated by a parent
+	if(entry.dirty && entry.second != nullptr && ss != nullptr && !isShared && ss != entry.second)
+		ss->copyVarProperties(entry.second);
+
+	entry.first = c;
+	entry.second = ss;
+	entry.debugLog = debugLog;
+	entry.isShared = isShared;
+	entry.dirty = false;
+}
+
 StyleSheet::Ptr StyleSheet::Collection::getForComponent(Component* c)
 {
-	for(const auto& existing: cachedMaps)
+	auto existing = cachedMaps.find(c);
+
+	if(existing != cachedMaps.end())
 	{
-		if(existing.first.getComponent() == c)
-			return existing.second;
+		// the component was deleted and the address was reused
+		if(existing->second.first.getComponent() != c)
+			cachedMaps.erase(existing);
+		else if(!existing->second.dirty)
+			return existing->second.second;
 	}
 
 	using Match = std::pair<ComplexSelector::Score, StyleSheet::Ptr>;
@@ -543,10 +566,14 @@ StyleSheet::Ptr StyleSheet::Collection::getForComponent(Component* c)
 	auto customCode = elementStyle.isNotEmpty() || inlineStyle.isNotEmpty() || parentStyle != nullptr || all != nullptr;
 
 	if(matches.isEmpty() && !customCode)
+	{
+		addToCache(c, nullptr, {}, true);
 		return nullptr;
+	}
 	
 	if(matches.size() == 1 && !customCode && !useIsolatedCollections)
 	{
+		addToCache(c, matches.getFirst().second, {}, true);
 		return matches.getFirst().second;
 	}
 
@@ -708,7 +735,7 @@ StyleSheet::Ptr StyleSheet::Collection::getForComponent(Component* c)
 
 	ptr->setCustomFonts(customFonts);
 
-	cachedMaps.add({ c, ptr, styleSheetLog });
+	addToCache(c, ptr, styleSheetLog, false);
 
 	jassert(animator != nullptr);
 	ptr->animator = animator;
@@ -892,6 +919,8 @@ void StyleSheet::Collection::setPropertyVariable(const Identifier& id, const var
 	{
 		p->setPropertyVariable(id, newValue);
 	});
+
+	styleVersion++;
 }
 
 MarkdownLayout::StyleData StyleSheet::Collection::getMarkdownStyleData(Component* c)
@@ -966,21 +995,46 @@ bool StyleSheet::Collection::clearCache(Component* c)
 	{
 		cachedMaps.clear();
 		cachedMapForAllStates.clear();
+		styleVersion++;
 		return true;
 	}
 	else
 	{
-		for(int i = 0; i < cachedMaps.size(); i++)
-		{
-			if(cachedMaps[i].first.getComponent() == c)
-			{
+		auto it = cachedMaps.find(c);
+		auto found = it != cachedMaps.end();
 
-				cachedMaps.remove(i);
-				return true;
-			}
+		if(found)
+			cachedMaps.erase(it);
+
+		markDirty(c);
+		return found;
+	}
+}
+
+void StyleSheet::Collection::markDirty(Component* c)
+{
+	for(auto it = cachedMaps.begin(); it != cachedMaps.end();)
+	{
+		auto ec = it->second.first.getComponent();
+
+		if(ec == nullptr)
+		{
+			it = cachedMaps.erase(it);
+			continue;
 		}
 
-		return false;
+		if(ec == c || c->isParentOf(ec))
+			it->second.dirty = true;
+
+		++it;
+	}
+
+	for(int i = 0; i < cachedMapForAllStates.size(); i++)
+	{
+		auto ec = cachedMapForAllStates.getReference(i).first.first.getComponent();
+
+		if(ec != nullptr && (ec == c || c->isParentOf(ec)))
+			cachedMapForAllStates.remove(i--);
 	}
 }
 
@@ -1032,11 +1086,13 @@ void StyleSheet::Collection::addCollectionForComponent(Component* c, const Colle
 		if(childCollections[i].first == c)
 		{
 			childCollections[i].second = other.list;
+			markDirty(c);
 			return;
 		}
 	}
 
 	childCollections.add({ c, other.list });
+	markDirty(c);
 }
 
 Result StyleSheet::Collection::performAtRules(DataProvider* d)
@@ -1089,6 +1145,7 @@ Result StyleSheet::Collection::performAtRules(DataProvider* d)
 		}
 	}
 
+	styleVersion++;
 	return Result::ok();
 }
 
@@ -1115,8 +1172,8 @@ void StyleSheet::Collection::forEach(const std::function<void(Ptr)>& f)
 
 	for(const auto& e: cachedMaps)
 	{
-		if(e.first != nullptr)
-			f(e.second);
+		if(e.second.first != nullptr && e.second.second != nullptr && !e.second.isShared)
+			f(e.second.second);
 	}
 
 	for(const auto& e: cachedMapForAllStates)
@@ -76,8 +76,16 @@ struct StyleSheet: public ReferenceCountedObject
 
 		MarkdownLayout::StyleData getMarkdownStyleData(Component* c);
 
+		/** Clears the cached style sheets. If a component is supplied, only the style sheets of this component
+		 *  and its children will be recalculated (the children inherit properties from the parent style sheet and
+		 *  might match descendant selectors). */
 		bool clearCache(Component* c = nullptr);
 
+		/** Returns a counter that is bumped whenever existing style sheets might change their values (variables,
+		 *  at-rules, a full cache reset). Invalidating the cache for a single component will not change this value
+		 *  because the component will receive a new style sheet object. */
+		uint32 getStyleVersion() const { return styleVersion; }
+
 		void setCreateStackTrace(bool shouldCreateStackTrace)
 		{
 			createStackTrace = shouldCreateStackTrace;
@@ -155,10 +163,24 @@ struct StyleSheet: public ReferenceCountedObject
             Component::SafePointer<Component> first;
             StyleSheet::Ptr second;
             String debugLog;
+
+			/** true if second is a style sheet from the list that is shared with other components. */
+			bool isShared = false;
+
+			/** set by clearCache() for child components so that the next lookup recalculates the style sheet
+			 *  and carries over the variable values. */
+			bool dirty = false;
         };
-        
+
+		void addToCache(Component* c, StyleSheet::Ptr ss, const String& debugLog, bool isShared);
+
+		/** Marks the cached style sheets of the component and all its children as dirty. */
+		void markDirty(Component* c);
+
 		Array<std::pair<std::pair<Component::SafePointer<Component>, Selector>, StyleSheet::Ptr>> cachedMapForAllStates;
-		Array<CachedStyleSheet> cachedMaps;
+		std::map<Component*, CachedStyleSheet> cachedMaps;
+
+		uint32 styleVersion = 0;
 
 		Animator* animator = nullptr;
 
@@ -170,6 +170,13 @@ public:
 		print("");
 		print("run_unit_tests");
 		print("Runs the unit tests. In order for this to work, HISE must be built with the CI configuration");
+		print("");
+		print("benchmark -p:PATH -m:MIDI_FILE [-b:BLOCKSIZE] [-s:SAMPLERATE] [-o:OUTPUT_FILE]");
+		print("Loads the given file (either .xml file or .hip file), renders the MIDI file faster than realtime");
+		print("and writes the timing percentiles of every module, voice and scriptnode node as JSON.");
+		print("-b:BLOCKSIZE  - the fixed block size (default: 512)");
+		print("-s:SAMPLERATE - the sample rate (default: 44100)");
+		print("-o:PATH       - the JSON output file. If omitted, the JSON will be printed to the console");
 
 		exit(0);
 	}
@@ -331,6 +338,73 @@ public:
 		return 0;
 	}
 
+	static int runBenchmark(const String& commandLine)
+	{
+		auto args = getCommandLineArgs(commandLine);
+
+		DspBenchmark::Options options;
+
+		auto blockSize = getArgument(args, "-b:");
+		auto sampleRate = getArgument(args, "-s:");
+
+		if (blockSize.isNotEmpty())
+			options.blockSize = blockSize.getIntValue();
+
+		if (sampleRate.isNotEmpty())
+			options.sampleRate = sampleRate.getDoubleValue();
+
+		if (options.blockSize <= 0 || options.blockSize > HISE_MAX_PROCESSING_BLOCKSIZE || options.blockSize % HISE_EVENT_RASTER != 0)
+			throwErrorAndQuit("Invalid block size: " + String(options.blockSize));
+
+		if (options.sampleRate <= 0.0)
+			throwErrorAndQuit("Invalid sample rate: " + String(options.sampleRate));
+
+		auto midiArgument = getArgument(args, "-m:");
+
+		if (midiArgument.isEmpty())
+			throwErrorAndQuit("You need to supply a MIDI file with the -m: argument");
+
+		auto midiFile = File::getCurrentWorkingDirectory().getChildFile(midiArgument);
+		auto outputArgument = getArgument(args, "-o:");
+
+		return loadPresetFile(commandLine, [options, midiFile, outputArgument](BackendProcessor* bp)
+		{
+			DspBenchmark benchmark(bp, options);
+
+			auto ok = benchmark.loadMidiFile(midiFile);
+
+			if (ok.failed())
+				return ok;
+
+			std::cout << "Rendering " << midiFile.getFileName() << "...";
+
+			auto result = benchmark.renderAndWait();
+
+			if (!result.isObject())
+				return Result::fail("The benchmark was cancelled");
+
+			std::cout << "DONE" << std::endl << std::endl;
+
+			auto json = JSON::toString(result);
+
+			if (outputArgument.isNotEmpty())
+			{
+				auto outputFile = File::getCurrentWorkingDirectory().getChildFile(outputArgument);
+
+				if (!outputFile.replaceWithText(json))
+					return Result::fail("Can't write to " + outputFile.getFullPathName());
+
+				std::cout << "Wrote benchmark results to " << outputFile.getFullPathName() << std::endl;
+			}
+			else
+			{
+				std::cout << json << std::endl;
+			}
+
+			return Result::ok();
+		});
+	}
+
 	static void compileNetworks(const String& commandLine)
 	{
 		auto args = getCommandLineArgs(commandLine);
@@ -733,6 +807,16 @@ public:
 			quit();
 			return;
 		}
+		else if (commandLine.startsWith("benchmark"))
+		{
+			auto ok = CommandLineActions::runBenchmark(commandLine);
+
+			if (ok != 0)
+				exit(ok);
+
+			quit();
+			return;
+		}
 		else
 		{
 			mainWindow = new MainWindow(commandLine);
@@ -66,7 +66,16 @@ void BitCompressors::UnitTests::runTest()
 	testAutomaticCompression(14);
 	testAutomaticCompression(15);
 
-
+	testSIMDKernels(compressor = new OneBit());
+	testSIMDKernels(compressor = new TwoBit());
+	testSIMDKernels(compressor = new FourBit());
+	testSIMDKernels(compressor = new SixBit());
+	testSIMDKernels(compressor = new EightBit());
+	testSIMDKernels(compressor = new TenBit());
+	testSIMDKernels(compressor = new TwelveBit());
+	testSIMDKernels(compressor = new FourteenBit());
+
+	testSIMDDiffKernels();
 }
 
 void BitCompressors::UnitTests::testAutomaticCompression(uint8 maxBitSize)
@@ -259,6 +268,110 @@ void BitCompressors::UnitTests::testCompressor(Base* compressor)
 	free(decompressedData);
 }
 
+void BitCompressors::UnitTests::testSIMDKernels(Base* compressor)
+{
+	const int bitRange = compressor->getAllowedBitRange();
+	const auto supportedLevel = getSupportedSIMDLevel();
+	const auto previousLevel = getSIMDLevel();
+
+	beginTest("Testing SIMD kernels with bit rate " + String(bitRange));
+
+	logMessage("Supported SIMD level: " + String((int)supportedLevel));
+
+	Random r;
+
+	for (int i = 0; i < 16; i++)
+	{
+		// Use odd sizes so that the scalar code has to process the remainder
+		const int numToCompress = r.nextInt(Range<int>(1, 4100));
+
+		HeapBlock<int16> uncompressedData(numToCompress);
+		HeapBlock<uint8> compressedData(compressor->getByteAmount(numToCompress) + 16, true);
+
+		fillDataWithAllowedBitRange(uncompressedData, numToCompress, bitRange);
+		compressor->compress(compressedData, uncompressedData, numToCompress);
+
+		// Add an offset to the destination so that the kernels can't rely on aligned memory
+		const int offset = r.nextInt(8);
+
+		HeapBlock<int16> reference(numToCompress + offset, true);
+
+		setSIMDLevel(SIMDLevel::Scalar);
+		compressor->decompress(reference + offset, compressedData, numToCompress);
+
+		for (int l = 1; l <= (int)supportedLevel; l++)
+		{
+			HeapBlock<int16> decompressed(numToCompress + offset, true);
+
+			setSIMDLevel((SIMDLevel)l);
+			compressor->decompress(decompressed + offset, compressedData, numToCompress);
+
+			for (int s = 0; s < numToCompress; s++)
+			{
+				if (decompressed[s + offset] != reference[s + offset])
+				{
+					expectEquals<int16>(decompressed[s + offset], reference[s + offset], "SIMD level " + String(l) + ": Sample mismatch at position " + String(s));
+					break;
+				}
+			}
+		}
+	}
+
+	setSIMDLevel(previousLevel);
+}
+
+void BitCompressors::UnitTests::testSIMDDiffKernels()
+{
+	const auto supportedLevel = getSupportedSIMDLevel();
+	const auto previousLevel = getSIMDLevel();
+
+	beginTest("Testing SIMD kernels for diff cycles");
+
+	Random r;
+
+	for (int bufferSize = 16; bufferSize <= 4096; bufferSize *= 2)
+	{
+		const int numFullValues = CompressionHelpers::Diff::getNumFullValues(bufferSize);
+		const int numErrorValues = CompressionHelpers::Diff::getNumErrorValues(bufferSize);
+
+		CompressionHelpers::AudioBufferInt16 fullValues(numFullValues);
+		CompressionHelpers::AudioBufferInt16 errorValues(numErrorValues);
+
+		// Use the full range so that the rounding of negative values is checked too
+		for (int i = 0; i < numFullValues; i++)
+			fullValues.getWritePointer()[i] = (int16)r.nextInt(Range<int>(-32768, 32768));
+
+		for (int i = 0; i < numErrorValues; i++)
+			errorValues.getWritePointer()[i] = (int16)r.nextInt(Range<int>(-32768, 32768));
+
+		CompressionHelpers::AudioBufferInt16 reference(bufferSize);
+
+		setSIMDLevel(SIMDLevel::Scalar);
+		CompressionHelpers::Diff::distributeFullSamples(reference, (const uint16*)fullValues.getReadPointer(), numFullValues);
+		CompressionHelpers::Diff::addErrorSignal(reference, (const uint16*)errorValues.getReadPointer(), numErrorValues);
+
+		for (int l = 1; l <= (int)supportedLevel; l++)
+		{
+			CompressionHelpers::AudioBufferInt16 b(bufferSize);
+
+			setSIMDLevel((SIMDLevel)l);
+			CompressionHelpers::Diff::distributeFullSamples(b, (const uint16*)fullValues.getReadPointer(), numFullValues);
+			CompressionHelpers::Diff::addErrorSignal(b, (const uint16*)errorValues.getReadPointer(), numErrorValues);
+
+			for (int i = 0; i < bufferSize; i++)
+			{
+				if (b.getReadPointer()[i] != reference.getReadPointer()[i])
+				{
+					expectEquals<int16>(b.getReadPointer()[i], reference.getReadPointer()[i], "SIMD level " + String(l) + ", buffer size " + String(bufferSize) + ": Sample mismatch at position " + String(i));
+					break;
+				}
+			}
+		}
+	}
+
+	setSIMDLevel(previousLevel);
+}
+
 #endif
 
 CodecTest::CodecTest() :
@@ -276,6 +389,12 @@ void CodecTest::runTest()
 {
 	testHiseSampleBufferClearing();
 
+	testMultithreadedEncoding(1);
+	testMultithreadedEncoding(2);
+
+	testDecodingWithOffset(1);
+	testDecodingWithOffset(2);
+
 	return;
 
 	testIntegerBuffers();
@@ -520,6 +639,127 @@ void CodecTest::testCodec(SignalType type, Option option, bool /*testStereo*/)
 
 }
 
+void CodecTest::testMultithreadedEncoding(int numChannels)
+{
+	beginTest("Testing multithreaded encoding with " + String(numChannels) + " channels");
+
+	Random r;
+
+	const int numSamples = r.nextInt(Range<int>(200000, 250000));
+	const int maxNumBlocks = numSamples / COMPRESSION_BLOCK_SIZE + 2;
+
+	auto signal = createTestSignal(numSamples, numChannels, SignalType::DecayingSineWithHarmonic, 0.8f);
+
+	MemoryOutputStream singleOutput, multiOutput;
+
+	HeapBlock<uint32> singleOffsets, multiOffsets;
+	singleOffsets.calloc(maxNumBlocks);
+	multiOffsets.calloc(maxNumBlocks);
+
+	HlacEncoder singleEncoder, multiEncoder;
+
+	singleEncoder.setOptions(options[(int)Option::Diff]);
+	multiEncoder.setOptions(options[(int)Option::Diff]);
+	multiEncoder.setNumThreads(4);
+
+	singleEncoder.compress(signal, singleOutput, singleOffsets);
+	multiEncoder.compress(signal, multiOutput, multiOffsets);
+
+	expectEquals<int>((int)multiEncoder.getNumBlocksWritten(), (int)singleEncoder.getNumBlocksWritten(), "Block amount mismatch");
+	expectEquals<int>((int)multiOutput.getDataSize(), (int)singleOutput.getDataSize(), "Size mismatch");
+
+	for (int i = 0; i < (int)singleEncoder.getNumBlocksWritten(); i++)
+	{
+		if (multiOffsets[i] != singleOffsets[i])
+		{
+			expectEquals<int>((int)multiOffsets[i], (int)singleOffsets[i], "Block offset mismatch at block " + String(i));
+			break;
+		}
+	}
+
+	// The block checksums are random, so we compare the decoded signals
+	for (auto mos : { &singleOutput, &multiOutput })
+	{
+		HlacDecoder decoder;
+		decoder.setupForDecompression();
+
+		auto dst = HiseSampleBuffer(true, numChannels, CompressionHelpers::getPaddedSampleSize(numSamples));
+
+		MemoryInputStream mis(mos->getData(), mos->getDataSize(), false);
+		decoder.decode(dst, numChannels > 1, mis);
+
+		auto diffBitRate = CompressionHelpers::checkBuffersEqual(*dst.getFloatBufferForFileReader(), signal);
+
+		expectEquals<int>((int)diffBitRate, 0, "Decoded signal mismatch");
+	}
+}
+
+void CodecTest::testDecodingWithOffset(int numChannels)
+{
+	beginTest("Testing decoding with offset with " + String(numChannels) + " channels");
+
+	Random r;
+
+	const int numSamples = r.nextInt(Range<int>(100000, 150000));
+	const int maxNumBlocks = numSamples / COMPRESSION_BLOCK_SIZE + 2;
+	const int numToRead = 3000;
+
+	auto signal = createTestSignal(numSamples, numChannels, SignalType::DecayingSineWithHarmonic, 0.8f);
+
+	for (int o = 0; o < (int)Option::numCompressorOptions; o++)
+	{
+		MemoryOutputStream output;
+
+		HeapBlock<uint32> blockOffsets;
+		blockOffsets.calloc(maxNumBlocks);
+
+		HlacEncoder encoder;
+		encoder.setOptions(options[o]);
+		encoder.compress(signal, output, blockOffsets);
+
+		HlacDecoder fullDecoder;
+		fullDecoder.setupForDecompression();
+
+		auto fullBuffer = HiseSampleBuffer(true, numChannels, CompressionHelpers::getPaddedSampleSize(numSamples));
+
+		MemoryInputStream fullInput(output.getData(), output.getDataSize(), false);
+		fullDecoder.decode(fullBuffer, numChannels > 1, fullInput);
+
+		auto& expected = *fullBuffer.getFloatBufferForFileReader();
+
+		for (int i = 0; i < 20; i++)
+		{
+			const int offset = r.nextInt(numSamples - numToRead);
+
+			HlacDecoder decoder;
+			decoder.setupForDecompression();
+
+			MemoryInputStream input(output.getData(), output.getDataSize(), false);
+			decoder.seekToPosition(input, (uint32)offset, blockOffsets[offset / COMPRESSION_BLOCK_SIZE]);
+
+			auto dst = HiseSampleBuffer(true, numChannels, numToRead);
+			decoder.decode(dst, numChannels > 1, input, offset, numToRead);
+
+			auto& actual = *dst.getFloatBufferForFileReader();
+
+			AudioSampleBuffer expectedPart(numChannels, numToRead);
+
+			for (int c = 0; c < numChannels; c++)
+				expectedPart.copyFrom(c, 0, expected, c, offset, numToRead);
+
+			auto diffBitRate = CompressionHelpers::checkBuffersEqual(actual, expectedPart);
+
+			if (diffBitRate != 0)
+			{
+				expectEquals<int>((int)diffBitRate, 0, getNameForOption((Option)o) + ": Mismatch at offset " + String(offset));
+				break;
+			}
+
+			expectEquals<int>((int)decoder.getCurrentReadPosition() / COMPRESSION_BLOCK_SIZE, (offset + numToRead - 1) / COMPRESSION_BLOCK_SIZE + 1, "Read position");
+		}
+	}
+}
+
 void CodecTest::testCopyWithNormalisation()
 {
 	beginTest("Testing copying with normalisation");
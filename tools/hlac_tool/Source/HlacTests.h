@@ -49,6 +49,11 @@ struct BitCompressors::UnitTests : public UnitTest
 
 	void testAutomaticCompression(uint8 maxBitSize);
 
+	/** Checks that the SIMD kernels create the same output as the scalar implementation. */
+	void testSIMDKernels(Base* compressor);
+
+	void testSIMDDiffKernels();
+
 };
 
 struct CodecTest : public UnitTest
@@ -81,6 +86,12 @@ struct CodecTest : public UnitTest
 
 	void testCodec(SignalType type, Option option, bool testStereo);
 
+	/** Checks that the parallel block encoding creates the same data as the single threaded encoder. */
+	void testMultithreadedEncoding(int numChannels);
+
+	/** Checks that decoding from an offset within a block (which skips the cycles before the offset) matches a full decode. */
+	void testDecodingWithOffset(int numChannels);
+
 	void testCopyWithNormalisation();
 
 	void testHiseSampleBuffer();